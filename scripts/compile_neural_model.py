@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Compiles a neural model from JSON into BYOD's binary model format,
+so that the plugin doesn't need to parse the JSON weights at runtime.
+
+Usage: compile_neural_model.py <input.json> <output.bnnm>
+
+The binary format is documented in src/processors/drive/neural_utils/BinaryModelData.h,
+and this script needs to stay in sync with BinaryModelData::convertJSON().
+"""
+
+import json
+import struct
+import sys
+
+MAGIC = b'BNNM'
+VERSION = 1
+HEADER_FORMAT = '<4sIIIIIII'
+TENSOR_ENTRY_FORMAT = '<48sIIII'
+MAX_NAME_LENGTH = 47
+ALIGNMENT = 16
+
+
+def align(offset):
+    return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def is_number(value):
+    return isinstance(value, (int, float)) and not isinstance(value, bool)
+
+
+def is_vector(value):
+    return isinstance(value, list) and len(value) > 0 and all(is_number(x) for x in value)
+
+
+def is_matrix(value):
+    return (isinstance(value, list) and len(value) > 0
+            and all(is_vector(row) for row in value)
+            and all(len(row) == len(value[0]) for row in value))
+
+
+def escape_key(key):
+    return str(key).replace('~', '~0').replace('/', '~1')
+
+
+def extract_tensors(value, path, tensors):
+    """Replaces all the numeric vectors and matrices in the JSON with nulls, and collects them as tensors."""
+    if is_vector(value):
+        tensors.append((path, 1, len(value), 1, [float(x) for x in value]))
+        return None
+
+    if is_matrix(value):
+        tensors.append((path, 2, len(value), len(value[0]), [float(x) for row in value for x in row]))
+        return None
+
+    if isinstance(value, dict):
+        return {key: extract_tensors(child, path + '/' + escape_key(key), tensors) for key, child in value.items()}
+
+    if isinstance(value, list):
+        return [extract_tensors(child, path + '/' + str(idx), tensors) for idx, child in enumerate(value)]
+
+    return value
+
+
+def compile_model(model_json):
+    tensors = []
+    metadata = extract_tensors(model_json, '', tensors)
+    metadata_bytes = json.dumps(metadata, separators=(',', ':')).encode('utf-8')
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    metadata_offset = header_size
+    tensor_table_offset = align(metadata_offset + len(metadata_bytes))
+    data_offset = align(tensor_table_offset + len(tensors) * struct.calcsize(TENSOR_ENTRY_FORMAT))
+
+    tensor_table = b''
+    tensor_data = b''
+    for name, num_dims, num_rows, num_cols, values in tensors:
+        name_bytes = name.encode('utf-8')
+        if len(name_bytes) > MAX_NAME_LENGTH:
+            raise ValueError(f'Tensor name is too long: {name}')
+
+        tensor_data += b'\0' * (align(data_offset + len(tensor_data)) - (data_offset + len(tensor_data)))
+        tensor_table += struct.pack(TENSOR_ENTRY_FORMAT, name_bytes, num_dims, num_rows, num_cols, data_offset + len(tensor_data))
+        tensor_data += struct.pack(f'<{len(values)}f', *values)
+
+    total_size = data_offset + len(tensor_data)
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(tensors), metadata_offset, len(metadata_bytes),
+                         tensor_table_offset, total_size, 0)
+
+    model_bytes = bytearray(total_size)
+    model_bytes[0:header_size] = header
+    model_bytes[metadata_offset:metadata_offset + len(metadata_bytes)] = metadata_bytes
+    model_bytes[tensor_table_offset:tensor_table_offset + len(tensor_table)] = tensor_table
+    model_bytes[data_offset:] = tensor_data
+    return bytes(model_bytes)
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+
+    with open(sys.argv[1], 'r') as json_file:
+        model_json = json.load(json_file)
+
+    with open(sys.argv[2], 'wb') as binary_file:
+        binary_file.write(compile_model(model_json))
+
+
+if __name__ == '__main__':
+    main()
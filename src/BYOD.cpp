@@ -27,6 +27,12 @@ BYOD::BYOD() : chowdsp::PluginBase<BYOD> (&undoManager),
 #endif
 }
 
+BYOD::~BYOD()
+{
+    // the preset setlist builds its standby boards from the processor chain, so it needs to go first
+    presetManager.reset();
+}
+
 void BYOD::addParameters (Parameters& params)
 {
     ProcessorChain::createParameters (params);
@@ -0,0 +1,56 @@
+#include "ProcessorCpuMeter.h"
+
+ProcessorCpuMeter::ProcessorCpuMeter (BaseProcessor& proc) : profiler (proc.getProfiler())
+{
+    setInterceptsMouseClicks (false, false);
+
+    pluginSettings->addProperties<&ProcessorCpuMeter::globalSettingChanged> ({ { showModuleCpuUsageID, false } }, *this);
+    globalSettingChanged (showModuleCpuUsageID);
+}
+
+ProcessorCpuMeter::~ProcessorCpuMeter()
+{
+    pluginSettings->removePropertyListener (*this);
+}
+
+void ProcessorCpuMeter::globalSettingChanged (SettingID settingID)
+{
+    if (settingID != showModuleCpuUsageID)
+        return;
+
+    const auto shouldShow = pluginSettings->getProperty<bool> (showModuleCpuUsageID);
+    setVisible (shouldShow);
+
+    if (shouldShow)
+    {
+        profilingEnabler.emplace();
+        profiler.clearMeasurements();
+        stats = {};
+        startTimerHz (5);
+    }
+    else
+    {
+        stopTimer();
+        profilingEnabler.reset();
+    }
+}
+
+void ProcessorCpuMeter::timerCallback()
+{
+    profiler.collectMeasurements();
+    stats = profiler.getStats();
+    repaint();
+}
+
+void ProcessorCpuMeter::paint (Graphics& g)
+{
+    g.setColour (Colours::black.withAlpha (0.6f));
+    g.fillRoundedRectangle (getLocalBounds().toFloat(), 3.0f);
+
+    const auto text = stats.numBlocks == 0 ? String ("CPU: --")
+                                           : "CPU: " + String (stats.meanLoad * 100.0, 1) + "% | Max: " + String (stats.worstLoad * 100.0, 1) + "%";
+
+    g.setColour (Colours::white);
+    g.setFont (Font ((float) getHeight() * 0.75f));
+    g.drawFittedText (text, getLocalBounds().reduced (2, 0), Justification::centred, 1);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "processors/BaseProcessor.h"
+
+/** Overlay showing how much of the real-time budget a processor is using. */
+class ProcessorCpuMeter : public Component,
+                          private Timer
+{
+    using SettingID = chowdsp::GlobalPluginSettings::SettingID;
+
+public:
+    explicit ProcessorCpuMeter (BaseProcessor& proc);
+    ~ProcessorCpuMeter() override;
+
+    void globalSettingChanged (SettingID settingID);
+
+    void paint (Graphics& g) override;
+
+    static constexpr SettingID showModuleCpuUsageID = "show_module_cpu_usage";
+
+private:
+    void timerCallback() override;
+
+    ProcessorProfiler& profiler;
+    ProcessorProfiler::Stats stats;
+    std::optional<ProcessorProfiler::ScopedEnable> profilingEnabler;
+
+    chowdsp::SharedPluginSettings pluginSettings;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorCpuMeter)
+};
@@ -18,7 +18,8 @@ ProcessorEditor::ProcessorEditor (BaseProcessor& baseProc,
                                                                                               contrastColour,
                                                                                               procUI.powerColour,
                                                                                               hostContextProvider),
-                                                                                       powerButton (procUI.powerColour)
+                                                                                       powerButton (procUI.powerColour),
+                                                                                       cpuMeter (baseProc)
 {
     addAndMakeVisible (knobs);
     setBroughtToFrontOnMouseClick (true);
@@ -71,6 +72,8 @@ ProcessorEditor::ProcessorEditor (BaseProcessor& baseProc,
         addAndMakeVisible (newPort);
     }
 
+    addChildComponent (cpuMeter); // the meter shows itself when CPU usage display is turned on
+
     for (int i = 0; i < proc.getNumInputs(); ++i)
         toggleParamsEnabledOnInputConnectionChange (i, false);
 
@@ -205,6 +208,9 @@ void ProcessorEditor::resized()
 
     placePorts (-portDim / 2, inputPorts);
     placePorts (width - portDim / 2, outputPorts);
+
+    cpuMeter.setBounds (Rectangle { proportionOfWidth (0.6f), proportionOfHeight (0.1f) }
+                            .withCentre ({ width / 2, height - proportionOfHeight (0.08f) }));
 }
 
 void ProcessorEditor::mouseDown (const MouseEvent& e)
@@ -3,6 +3,7 @@
 #include "KnobsComponent.h"
 #include "Port.h"
 #include "PowerButton.h"
+#include "ProcessorCpuMeter.h"
 #include "processors/chain/ProcessorChain.h"
 
 class ProcessorEditor : public Component
@@ -58,6 +59,8 @@ private:
 
     DrawableButton settingsButton { "Settings", DrawableButton::ImageFitted };
 
+    ProcessorCpuMeter cpuMeter;
+
     chowdsp::ScopedCallback uiOptionsChangedCallback;
 
     chowdsp::SharedLNFAllocator lnfAllocator;
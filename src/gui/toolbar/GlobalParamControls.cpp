@@ -37,6 +37,7 @@ GlobalParamControls::GlobalParamControls (AudioProcessorValueTreeState& vts,
     };
 
     addComboBox (GlobalParamTags::monoModeTag);
+    addComboBox (GlobalParamTags::osFilterTag);
 
     auto addSlider = [this, &vts, &hostContextProvider] (const String& paramTag, const String& name)
     {
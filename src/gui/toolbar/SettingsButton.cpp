@@ -1,7 +1,9 @@
 #include "SettingsButton.h"
 #include "BYOD.h"
 #include "gui/pedalboard/BoardViewport.h"
+#include "gui/pedalboard/editors/ProcessorCpuMeter.h"
 #include "processors/chain/ProcessorChainPortMagnitudesHelper.h"
+#include "processors/chain/ProcessorChainThreadPool.h"
 
 namespace
 {
@@ -55,6 +57,8 @@ void SettingsButton::showSettingsMenu()
     cableVizMenu (menu, 100);
     defaultZoomMenu (menu, 200);
     openGLManu (menu, 300);
+    multiCoreMenu (menu, 400);
+    moduleCpuUsageMenu (menu, 500);
 
     menu.addSeparator();
     menu.addItem ("View Source Code", []
@@ -91,6 +95,34 @@ void SettingsButton::cableVizMenu (PopupMenu& menu, int itemID)
     menu.addItem (item);
 }
 
+void SettingsButton::multiCoreMenu (PopupMenu& menu, int itemID)
+{
+    const auto isCurrentlyOn = pluginSettings->getProperty<bool> (ProcessorChainThreadPool::multiCoreOnOffID);
+
+    PopupMenu::Item item;
+    item.itemID = ++itemID;
+    item.text = "Multi-Core Processing";
+    item.action = [=]
+    { pluginSettings->setProperty (ProcessorChainThreadPool::multiCoreOnOffID, ! isCurrentlyOn); };
+    item.colour = isCurrentlyOn ? onColour : offColour;
+
+    menu.addItem (item);
+}
+
+void SettingsButton::moduleCpuUsageMenu (PopupMenu& menu, int itemID)
+{
+    const auto isCurrentlyOn = pluginSettings->getProperty<bool> (ProcessorCpuMeter::showModuleCpuUsageID);
+
+    PopupMenu::Item item;
+    item.itemID = ++itemID;
+    item.text = "Show Module CPU Usage";
+    item.action = [=]
+    { pluginSettings->setProperty (ProcessorCpuMeter::showModuleCpuUsageID, ! isCurrentlyOn); };
+    item.colour = isCurrentlyOn ? onColour : offColour;
+
+    menu.addItem (item);
+}
+
 void SettingsButton::defaultZoomMenu (PopupMenu& menu, int itemID)
 {
     PopupMenu defaultZoomMenu;
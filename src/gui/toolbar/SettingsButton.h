@@ -19,6 +19,8 @@ public:
 private:
     void showSettingsMenu();
     void cableVizMenu (PopupMenu& menu, int itemID);
+    void multiCoreMenu (PopupMenu& menu, int itemID);
+    void moduleCpuUsageMenu (PopupMenu& menu, int itemID);
     void defaultZoomMenu (PopupMenu& menu, int itemID);
     void openGLManu (PopupMenu& menu, int itemID);
     void copyDiagnosticInfo();
@@ -0,0 +1,125 @@
+#include "ConvolutionBenchmarks.h"
+#include "processors/tone/ir_utils/DirectFIR.h"
+#include "processors/tone/ir_utils/IRConvolution.h"
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+constexpr double secondsPerRun = 1.0;
+constexpr int numChannels = 2;
+constexpr int maxLoadWaitMs = 2000;
+const Array<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024 };
+const Array<int> irLengths { 32, 64, 128, 192, 256, 384, 512, 768, 1024, 2048 };
+
+AudioBuffer<float> makeTestIR (int irLength)
+{
+    AudioBuffer<float> ir (numChannels, irLength);
+    Random rand { 0x1234 };
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* h = ir.getWritePointer (ch);
+        for (int n = 0; n < irLength; ++n)
+            h[n] = (rand.nextFloat() * 2.0f - 1.0f) * std::exp (-4.0f * (float) n / (float) irLength);
+    }
+
+    return ir;
+}
+
+/** Returns the processing time in nanoseconds per sample. */
+template <typename ProcessFunc>
+double timeEngine (int blockSize, ProcessFunc&& process)
+{
+    AudioBuffer<float> buffer (numChannels, blockSize);
+    Random rand { 0x4321 };
+    const auto numBlocks = jmax (1, (int) (secondsPerRun * sampleRate / (double) blockSize));
+
+    int64 totalTicks = 0;
+    for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* x = buffer.getWritePointer (ch);
+            for (int n = 0; n < blockSize; ++n)
+                x[n] = (rand.nextFloat() * 2.0f - 1.0f) * 0.5f;
+        }
+
+        auto&& block = dsp::AudioBlock<float> { buffer };
+        const auto startTicks = Time::getHighResolutionTicks();
+        process (block);
+        totalTicks += Time::getHighResolutionTicks() - startTicks;
+    }
+
+    return Time::highResolutionTicksToSeconds (totalTicks) * 1.0e9 / ((double) numBlocks * (double) blockSize);
+}
+
+double timeDirectFIR (const AudioBuffer<float>& ir, int blockSize)
+{
+    DirectFIR fir;
+    fir.setImpulseResponse (ir);
+    return timeEngine (blockSize, [&fir] (const dsp::AudioBlock<float>& block)
+                       { fir.process (block); });
+}
+
+double timeFFTConvolution (const AudioBuffer<float>& ir, int blockSize)
+{
+    dsp::Convolution convolution;
+    convolution.prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+    convolution.loadImpulseResponse (AudioBuffer<float> { ir }, sampleRate, dsp::Convolution::Stereo::yes, dsp::Convolution::Trim::no, dsp::Convolution::Normalise::no);
+
+    // the IR gets loaded in the background, and swapped in on the next call to process()
+    AudioBuffer<float> buffer (numChannels, blockSize);
+    for (int waitMs = 0; convolution.getCurrentIRSize() != ir.getNumSamples(); ++waitMs)
+    {
+        if (waitMs > maxLoadWaitMs)
+            ConsoleApplication::fail ("Timed out waiting for the convolution to load the IR!");
+
+        auto&& block = dsp::AudioBlock<float> { buffer };
+        convolution.process (dsp::ProcessContextReplacing<float> { block });
+        Thread::sleep (1);
+    }
+
+    return timeEngine (blockSize, [&convolution] (const dsp::AudioBlock<float>& block)
+                       {
+                           auto convolutionBlock = block;
+                           convolution.process (dsp::ProcessContextReplacing<float> { convolutionBlock });
+                       });
+}
+} // namespace
+
+ConvolutionBenchmarks::ConvolutionBenchmarks()
+{
+    this->commandOption = "--benchmark-convolution";
+    this->argumentDescription = "--benchmark-convolution";
+    this->shortDescription = "Compares the direct FIR and FFT convolution engines";
+    this->longDescription = "Times both convolution engines with stereo IRs of different lengths, at each block size, "
+                            "and prints the longest IR that is cheaper to run through the direct FIR. "
+                            "These are the crossover points that IRConvolution::shouldUseDirectFIR() should be using.";
+    this->command = [=] (const ArgumentList& args)
+    { runBenchmarks (args); };
+}
+
+void ConvolutionBenchmarks::runBenchmarks (const ArgumentList&)
+{
+    for (auto blockSize : blockSizes)
+    {
+        std::cout << "Block size: " << blockSize << std::endl;
+
+        int crossoverLength = 0;
+        for (auto irLength : irLengths)
+        {
+            const auto ir = makeTestIR (irLength);
+            const auto firTime = timeDirectFIR (ir, blockSize);
+            const auto fftTime = timeFFTConvolution (ir, blockSize);
+            const auto firIsFaster = firTime < fftTime;
+            if (firIsFaster)
+                crossoverLength = irLength;
+
+            std::cout << "    IR length " << irLength << ": direct FIR " << String (firTime, 1) << " ns/sample, FFT "
+                      << String (fftTime, 1) << " ns/sample" << (firIsFaster ? " (FIR)" : "")
+                      << (IRConvolution::shouldUseDirectFIR (irLength, blockSize) == firIsFaster ? "" : " <- doesn't match shouldUseDirectFIR()")
+                      << std::endl;
+        }
+
+        std::cout << "    Direct FIR is cheaper up to " << crossoverLength << " samples" << std::endl;
+    }
+}
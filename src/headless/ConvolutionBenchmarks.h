@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../pch.h"
+
+class ConvolutionBenchmarks : public ConsoleApplication::Command
+{
+public:
+    ConvolutionBenchmarks();
+
+private:
+    /** Compares the direct FIR and FFT convolution engines, to find where one gets cheaper than the other */
+    static void runBenchmarks (const ArgumentList& args);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionBenchmarks)
+};
@@ -0,0 +1,125 @@
+#include "IRFileOptimiser.h"
+#include "processors/SharedAssetCache.h"
+#include "processors/tone/ir_utils/IROptimiser.h"
+
+namespace
+{
+const String irFileWildcard = "*.wav;*.aif;*.aiff;*.flac";
+
+Array<File> getInputFiles (const ArgumentList& args)
+{
+    Array<File> inputFiles;
+    for (const auto& arg : args.arguments)
+    {
+        if (arg.isOption() || arg.isLongOption())
+            continue;
+
+        const auto file = arg.resolveAsFile();
+        if (file.isDirectory())
+        {
+            for (const auto& entry : RangedDirectoryIterator (file, false, irFileWildcard))
+                inputFiles.add (entry.getFile());
+        }
+        else if (file.hasFileExtension (irFileWildcard))
+        {
+            inputFiles.add (file);
+        }
+        else
+        {
+            std::cout << "Skipping " << file.getFullPathName() << ", not an IR file!" << std::endl;
+        }
+    }
+
+    return inputFiles;
+}
+
+bool writeIRFile (const SharedAssetCache::DecodedIR& ir, const File& outputFile)
+{
+    outputFile.deleteFile();
+    auto stream = std::make_unique<FileOutputStream> (outputFile);
+    if (! stream->openedOk())
+        return false;
+
+    // 32-bit floating point, so that the optimised IR isn't quantized again
+    std::unique_ptr<AudioFormatWriter> writer { WavAudioFormat().createWriterFor (stream.get(), ir.sampleRate, (unsigned int) ir.buffer.getNumChannels(), 32, {}, 0) };
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // the writer owns the stream now
+    return writer->writeFromAudioSampleBuffer (ir.buffer, 0, ir.buffer.getNumSamples());
+}
+} // namespace
+
+IRFileOptimiser::IRFileOptimiser()
+{
+    this->commandOption = "--optimise-irs";
+    this->argumentDescription = "--optimise-irs --out=[DIR] [--tail-threshold=-60] [--max-error=[DB]] [--no-min-phase] [--sample-rate=[RATE]] [FILES OR DIRS...]";
+    this->shortDescription = "Converts IR files to minimum phase, and truncates them";
+    this->longDescription = "Converts each IR to minimum phase (unless --no-min-phase is given), and truncates it once the energy left in the tail is below "
+                            "the tail threshold (in dB), or at the shortest length that keeps the spectral error below --max-error (in dB). "
+                            "With --sample-rate, the IRs are also resampled and normalised the same way that the Amp IRs processor would do it. "
+                            "The optimised IRs are saved as 32-bit WAV files in the output directory.";
+    this->command = [=] (const ArgumentList& args)
+    { optimiseFiles (args); };
+}
+
+void IRFileOptimiser::optimiseFiles (const ArgumentList& args)
+{
+    const auto outputDir = args.getExistingFolderForOption ("--out");
+
+    IROptimiser::Settings settings;
+    settings.minimumPhase = ! args.containsOption ("--no-min-phase");
+    if (args.containsOption ("--tail-threshold"))
+        settings.tailEnergyThresholdDB = args.getValueForOption ("--tail-threshold").getFloatValue();
+    if (args.containsOption ("--max-error"))
+        settings.maxSpectralErrorDB = args.getValueForOption ("--max-error").getFloatValue();
+
+    const auto targetSampleRate = args.containsOption ("--sample-rate") ? args.getValueForOption ("--sample-rate").getDoubleValue() : 0.0;
+    if (settings.tailEnergyThresholdDB >= 0.0f || settings.maxSpectralErrorDB < 0.0f || targetSampleRate < 0.0)
+        ConsoleApplication::fail ("Invalid optimiser settings!");
+
+    const auto inputFiles = getInputFiles (args);
+    if (inputFiles.isEmpty())
+        ConsoleApplication::fail ("No IR files to optimise!");
+
+    SharedResourcePointer<SharedAssetCache> assetCache;
+    int numFailedFiles = 0;
+    for (const auto& inputFile : inputFiles)
+    {
+        MemoryBlock fileData;
+        auto sourceIR = inputFile.loadFileAsData (fileData) ? assetCache->getIRFromFileData (fileData) : nullptr;
+        if (sourceIR == nullptr)
+        {
+            std::cout << "Unable to read IR file: " << inputFile.getFullPathName() << std::endl;
+            numFailedFiles++;
+            continue;
+        }
+
+        auto result = IROptimiser::optimise (sourceIR->buffer, sourceIR->sampleRate, settings);
+
+        auto optimisedIR = std::make_shared<SharedAssetCache::DecodedIR>();
+        optimisedIR->buffer = std::move (result.ir);
+        optimisedIR->sampleRate = sourceIR->sampleRate;
+        optimisedIR->sourceID = sourceIR->sourceID + "_" + IROptimiser::getSettingsID (settings);
+
+        // resampling after the IR has been truncated means there's less to resample, and it only happens once
+        std::shared_ptr<const SharedAssetCache::DecodedIR> outputIR = optimisedIR;
+        if (targetSampleRate > 0.0)
+            outputIR = assetCache->getPreparedIR (optimisedIR, targetSampleRate);
+
+        const auto outputFile = outputDir.getChildFile (inputFile.getFileNameWithoutExtension() + ".wav");
+        if (! writeIRFile (*outputIR, outputFile))
+        {
+            std::cout << "Unable to write IR file: " << outputFile.getFullPathName() << std::endl;
+            numFailedFiles++;
+            continue;
+        }
+
+        std::cout << inputFile.getFileName() << ": " << result.originalLength << " -> " << result.optimisedLength << " samples"
+                  << " (estimated CPU saving: " << String (100.0f * result.getTapReduction(), 1) << "%)"
+                  << ", spectral error: " << String (result.spectralErrorDB, 2) << " dB" << std::endl;
+    }
+
+    if (numFailedFiles > 0)
+        ConsoleApplication::fail (String (numFailedFiles) + " IR files could not be optimised!");
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../pch.h"
+
+class IRFileOptimiser : public ConsoleApplication::Command
+{
+public:
+    IRFileOptimiser();
+
+private:
+    /** Converts a batch of impulse response files to minimum phase, and truncates them */
+    static void optimiseFiles (const ArgumentList& args);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IRFileOptimiser)
+};
@@ -0,0 +1,208 @@
+#include "OfflineRenderer.h"
+#include "BYOD.h"
+
+namespace
+{
+constexpr int defaultBlockSize = 512;
+const String audioFileWildcard = "*.wav;*.flac";
+
+Array<File> getInputFiles (const ArgumentList& args)
+{
+    Array<File> inputFiles;
+    for (const auto& arg : args.arguments)
+    {
+        if (arg.isOption() || arg.isLongOption())
+            continue;
+
+        const auto file = arg.resolveAsFile();
+        if (file.isDirectory())
+        {
+            for (const auto& entry : RangedDirectoryIterator (file, false, audioFileWildcard))
+                inputFiles.add (entry.getFile());
+        }
+        else if (file.hasFileExtension (audioFileWildcard))
+        {
+            inputFiles.add (file);
+        }
+        else
+        {
+            std::cout << "Skipping " << file.getFullPathName() << ", not a WAV or FLAC file!" << std::endl;
+        }
+    }
+
+    return inputFiles;
+}
+
+/** Runs a function on the message thread, and waits for it to finish. */
+void callOnMessageThread (const std::function<void()>& func)
+{
+    WaitableEvent finished;
+    MessageManager::callAsync ([&func, &finished]
+                               {
+                                   func();
+                                   finished.signal(); });
+    finished.wait();
+}
+
+struct RenderJob
+{
+    const File& outputDir;
+    const Array<File>& inputFiles;
+    const int blockSize;
+
+    std::atomic_int nextFileIndex { 0 };
+    std::atomic_int numFailedFiles { 0 };
+    CriticalSection printLock;
+
+    void print (const String& message)
+    {
+        const ScopedLock sl (printLock);
+        std::cout << message << std::endl;
+    }
+};
+
+bool renderFile (BYOD& plugin, AudioFormatManager& formatManager, const File& inputFile, RenderJob& job)
+{
+    std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (inputFile));
+    if (reader == nullptr)
+    {
+        job.print ("Unable to read audio file: " + inputFile.getFullPathName());
+        return false;
+    }
+
+    // the host would usually prepare the plugin from the message thread
+    callOnMessageThread ([&plugin, &reader, &job]
+                         { plugin.prepareToPlay (reader->sampleRate, job.blockSize); });
+
+    const auto outputFile = job.outputDir.getChildFile (inputFile.getFileName());
+    auto* format = formatManager.findFormatForFileExtension (outputFile.getFileExtension());
+    outputFile.deleteFile();
+    std::unique_ptr<OutputStream> outputStream = std::make_unique<FileOutputStream> (outputFile);
+
+    const auto numChannels = jmax (plugin.getTotalNumInputChannels(), plugin.getTotalNumOutputChannels());
+    const auto numOutputChannels = plugin.getTotalNumOutputChannels();
+    std::unique_ptr<AudioFormatWriter> writer (format == nullptr ? nullptr : format->createWriterFor (outputStream.get(), reader->sampleRate, (unsigned int) numOutputChannels, (int) reader->bitsPerSample, {}, 0));
+    if (writer == nullptr)
+    {
+        job.print ("Unable to write audio file: " + outputFile.getFullPathName());
+        return false;
+    }
+    outputStream.release(); // the writer owns the stream now
+
+    AudioBuffer<float> buffer (numChannels, job.blockSize);
+    MidiBuffer midi;
+
+    // process some extra samples at the end, and skip them at the start, so the output lines up with the input
+    const auto latencySamples = (int64) plugin.getLatencySamples();
+    const auto totalNumSamples = reader->lengthInSamples + latencySamples;
+    for (int64 sampleIndex = 0; sampleIndex < totalNumSamples; sampleIndex += job.blockSize)
+    {
+        const auto numSamples = (int) jmin ((int64) job.blockSize, totalNumSamples - sampleIndex);
+        buffer.setSize (numChannels, numSamples, false, false, true);
+        buffer.clear();
+        reader->read (&buffer, 0, numSamples, sampleIndex, true, true);
+
+        plugin.processBlock (buffer, midi);
+
+        const auto numLatencySamplesInBlock = (int) jlimit ((int64) 0, (int64) numSamples, latencySamples - sampleIndex);
+        if (numLatencySamplesInBlock < numSamples)
+            writer->writeFromAudioSampleBuffer (buffer, numLatencySamplesInBlock, numSamples - numLatencySamplesInBlock);
+    }
+
+    return true;
+}
+
+void runRenderWorker (RenderJob& job, BYOD& plugin)
+{
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    while (true)
+    {
+        const auto fileIndex = job.nextFileIndex.fetch_add (1);
+        if (fileIndex >= job.inputFiles.size())
+            return;
+
+        const auto& inputFile = job.inputFiles.getReference (fileIndex);
+        const auto startTime = Time::getMillisecondCounterHiRes();
+        if (! renderFile (plugin, formatManager, inputFile, job))
+        {
+            job.numFailedFiles.fetch_add (1);
+            continue;
+        }
+
+        const auto duration = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        job.print ("Rendered " + inputFile.getFileName() + " in " + String (duration, 2) + " seconds");
+    }
+}
+} // namespace
+
+OfflineRenderer::OfflineRenderer()
+{
+    this->commandOption = "--render";
+    this->argumentDescription = "--render --preset=[PRESET FILE] --out=[DIR] [--block-size=512] [--jobs=N] [FILES OR DIRS...]";
+    this->shortDescription = "Renders WAV or FLAC files through a preset";
+    this->longDescription = "Loads a preset, and processes each of the input files through it, writing the outputs to the output directory. "
+                            "Files are rendered in parallel, with one plugin instance per job.";
+    this->command = [=] (const ArgumentList& args)
+    { renderFiles (args); };
+}
+
+void OfflineRenderer::renderFiles (const ArgumentList& args)
+{
+    const auto presetFile = args.getExistingFileForOption ("--preset");
+
+    File outputDir = File::getCurrentWorkingDirectory();
+    if (args.containsOption ("--out"))
+        outputDir = args.getExistingFolderForOption ("--out");
+
+    const auto blockSize = args.containsOption ("--block-size") ? args.getValueForOption ("--block-size").getIntValue() : defaultBlockSize;
+    if (blockSize <= 0)
+        ConsoleApplication::fail ("Block size must be greater than zero!");
+
+    const auto inputFiles = getInputFiles (args);
+    if (inputFiles.isEmpty())
+        ConsoleApplication::fail ("No input files to render!");
+
+    const auto numJobs = jlimit (1,
+                                 inputFiles.size(),
+                                 args.containsOption ("--jobs") ? args.getValueForOption ("--jobs").getIntValue() : SystemStats::getNumPhysicalCpus());
+
+    std::cout << "Rendering " << inputFiles.size() << " files with preset " << presetFile.getFileName()
+              << ", using " << numJobs << " jobs... Saving to " << outputDir.getFullPathName() << std::endl;
+
+    const chowdsp::Preset preset { presetFile };
+    if (! preset.isValid())
+        ConsoleApplication::fail ("Unable to load preset: " + presetFile.getFullPathName());
+
+    // plugin instances are created and loaded here, since preset loading happens on the message thread
+    std::vector<std::unique_ptr<BYOD>> plugins;
+    for (int i = 0; i < numJobs; ++i)
+    {
+        auto& plugin = plugins.emplace_back (std::make_unique<BYOD>());
+        plugin->setNonRealtime (true);
+        plugin->getPresetManager().loadPreset (preset);
+    }
+    MessageManager::getInstance()->runDispatchLoopUntil (100); // pump dispatch loop so changes propagate...
+
+    RenderJob job { outputDir, inputFiles, blockSize };
+    const auto startTime = Time::getMillisecondCounterHiRes();
+
+    std::vector<std::future<void>> workers;
+    for (auto& plugin : plugins)
+        workers.push_back (std::async (std::launch::async, [&job, &plugin]
+                                       { runRenderWorker (job, *plugin); }));
+
+    // keep the message thread running while the workers are busy
+    for (auto& worker : workers)
+    {
+        while (worker.wait_for (std::chrono::milliseconds (0)) != std::future_status::ready)
+            MessageManager::getInstance()->runDispatchLoopUntil (20);
+    }
+
+    const auto duration = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    std::cout << "Rendered " << inputFiles.size() - job.numFailedFiles.load() << " files in " << duration << " seconds" << std::endl;
+
+    if (job.numFailedFiles.load() > 0)
+        ConsoleApplication::fail (String (job.numFailedFiles.load()) + " files failed to render!");
+}
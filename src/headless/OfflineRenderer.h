@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../pch.h"
+
+class OfflineRenderer : public ConsoleApplication::Command
+{
+public:
+    OfflineRenderer();
+
+private:
+    /** Renders a batch of audio files through a preset */
+    static void renderFiles (const ArgumentList& args);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
@@ -0,0 +1,103 @@
+#include "PresetProfiler.h"
+#include "BYOD.h"
+
+namespace
+{
+constexpr double defaultSampleRate = 48000.0;
+constexpr int defaultBlockSize = 512;
+constexpr double defaultLengthSeconds = 10.0;
+
+String padColumn (const String& text, int width)
+{
+    return text.paddedRight (' ', width);
+}
+
+void printStats (const String& name, const ProcessorProfiler::Stats& stats)
+{
+    std::cout << padColumn (name, 24)
+              << padColumn (String (stats.meanMicroseconds, 2), 12)
+              << padColumn (String (stats.p50Microseconds, 2), 12)
+              << padColumn (String (stats.p95Microseconds, 2), 12)
+              << padColumn (String (stats.p99Microseconds, 2), 12)
+              << padColumn (String (stats.worstMicroseconds, 2), 12)
+              << padColumn (String (stats.meanLoad * 100.0, 2) + "%", 10)
+              << padColumn (String (stats.worstLoad * 100.0, 2) + "%", 10)
+              << String (stats.cyclesPerSample, 1) << std::endl;
+}
+} // namespace
+
+PresetProfiler::PresetProfiler()
+{
+    this->commandOption = "--profile-preset";
+    this->argumentDescription = "--profile-preset --preset=[PRESET FILE] [--sample-rate=48000] [--block-size=512] [--seconds=10]";
+    this->shortDescription = "Measures the CPU usage of each processor in a preset";
+    this->longDescription = "Processes white noise through a preset, and prints timing statistics (in microseconds per block) for each processor. "
+                            "Load is measured as a fraction of the real-time budget for each block.";
+    this->command = [=] (const ArgumentList& args)
+    { profilePreset (args); };
+}
+
+void PresetProfiler::profilePreset (const ArgumentList& args)
+{
+    const auto presetFile = args.getExistingFileForOption ("--preset");
+    const auto sampleRate = args.containsOption ("--sample-rate") ? args.getValueForOption ("--sample-rate").getDoubleValue() : defaultSampleRate;
+    const auto blockSize = args.containsOption ("--block-size") ? args.getValueForOption ("--block-size").getIntValue() : defaultBlockSize;
+    const auto lengthSeconds = args.containsOption ("--seconds") ? args.getValueForOption ("--seconds").getDoubleValue() : defaultLengthSeconds;
+    if (sampleRate <= 0.0 || blockSize <= 0 || lengthSeconds <= 0.0)
+        ConsoleApplication::fail ("Sample rate, block size, and length must be greater than zero!");
+
+    const chowdsp::Preset preset { presetFile };
+    if (! preset.isValid())
+        ConsoleApplication::fail ("Unable to load preset: " + presetFile.getFullPathName());
+
+    BYOD plugin;
+    plugin.getPresetManager().loadPreset (preset);
+    plugin.prepareToPlay (sampleRate, blockSize);
+    MessageManager::getInstance()->runDispatchLoopUntil (100); // pump dispatch loop so changes propagate...
+
+    auto& procChain = plugin.getProcChain();
+    std::vector<BaseProcessor*> processors { &procChain.getInputProcessor() };
+    for (auto* proc : procChain.getProcessors())
+        processors.push_back (proc);
+    processors.push_back (&procChain.getOutputProcessor());
+
+    std::cout << "Profiling preset " << preset.getName() << " at " << sampleRate << " Hz, with block size " << blockSize << "..." << std::endl;
+
+    const ProcessorProfiler::ScopedEnable profilingEnabler;
+    for (auto* proc : processors)
+        proc->getProfiler().clearMeasurements();
+
+    AudioBuffer<float> buffer (2, blockSize);
+    MidiBuffer midi;
+    Random rand;
+    const auto numBlocks = (int) std::ceil (lengthSeconds * sampleRate / (double) blockSize);
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* x = buffer.getWritePointer (ch);
+            for (int n = 0; n < blockSize; ++n)
+                x[n] = (rand.nextFloat() * 2.0f - 1.0f) * 0.5f;
+        }
+
+        plugin.processBlock (buffer, midi);
+
+        for (auto* proc : processors)
+            proc->getProfiler().collectMeasurements();
+    }
+
+    std::cout << padColumn ("Processor", 24)
+              << padColumn ("Mean (us)", 12)
+              << padColumn ("p50 (us)", 12)
+              << padColumn ("p95 (us)", 12)
+              << padColumn ("p99 (us)", 12)
+              << padColumn ("Worst (us)", 12)
+              << padColumn ("Load", 10)
+              << padColumn ("Max Load", 10)
+              << "Cycles/Sample" << std::endl;
+
+    for (auto* proc : processors)
+        printStats (proc->getName(), proc->getProfiler().getStats());
+
+    std::cout << "Total plugin load: " << String (plugin.getLoadMeasurer().getLoadAsPercentage(), 2) << "%" << std::endl;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../pch.h"
+
+class PresetProfiler : public ConsoleApplication::Command
+{
+public:
+    PresetProfiler();
+
+private:
+    /** Prints the CPU usage for each processor in a preset */
+    static void profilePreset (const ArgumentList& args);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetProfiler)
+};
@@ -0,0 +1,158 @@
+#include "ProcessorBenchmarks.h"
+#include "BYOD.h"
+
+namespace
+{
+constexpr double defaultSampleRate = 48000.0;
+constexpr double defaultSecondsPerRun = 0.25;
+constexpr int numWarmUpBlocks = 4;
+const Array<int> defaultBlockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+const Array<int> defaultOSFactors { 1, 2, 4, 8, 16 }; // matches the oversampling options in ChainIOProcessor
+
+Array<int> getIntListForOption (const ArgumentList& args, StringRef option, const Array<int>& defaultValues)
+{
+    if (! args.containsOption (option))
+        return defaultValues;
+
+    Array<int> values;
+    for (const auto& value : StringArray::fromTokens (args.getValueForOption (option), ",", {}))
+    {
+        if (value.getIntValue() > 0)
+            values.add (value.getIntValue());
+    }
+
+    return values;
+}
+
+struct BenchmarkConfig
+{
+    int numChannels;
+    int blockSize;
+    int osFactor;
+    bool modulated;
+};
+
+/** Returns the processing time in seconds, for enough blocks to cover the requested length of audio. */
+double timeProcessor (BaseProcessor& proc, const BenchmarkConfig& config, double sampleRate, double secondsPerRun)
+{
+    const auto osBlockSize = config.blockSize * config.osFactor;
+    proc.prepareProcessing (sampleRate * config.osFactor, osBlockSize);
+
+    Array<AudioParameterFloat*> floatParams;
+    for (auto* param : proc.getParameters())
+    {
+        if (auto* floatParam = dynamic_cast<AudioParameterFloat*> (param))
+            floatParams.add (floatParam);
+
+        param->setValueNotifyingHost (param->getDefaultValue());
+    }
+
+    AudioBuffer<float> buffer (config.numChannels, osBlockSize);
+    Random rand { 0x1234 };
+    const auto numBlocks = jmax (1, (int) std::ceil (secondsPerRun * sampleRate / (double) config.blockSize));
+
+    int64 totalTicks = 0;
+    for (int blockIndex = -numWarmUpBlocks; blockIndex < numBlocks; ++blockIndex)
+    {
+        buffer.setSize (config.numChannels, osBlockSize, false, false, true);
+        for (int ch = 0; ch < config.numChannels; ++ch)
+        {
+            auto* x = buffer.getWritePointer (ch);
+            for (int n = 0; n < osBlockSize; ++n)
+                x[n] = (rand.nextFloat() * 2.0f - 1.0f) * 0.5f;
+        }
+
+        if (config.modulated)
+        {
+            // sweep all the continuous parameters with a slow sine wave
+            const auto lfoPhase = MathConstants<double>::twoPi * 2.0 * (double) (blockIndex * config.blockSize) / sampleRate;
+            for (auto* param : floatParams)
+                param->setValueNotifyingHost (0.5f + 0.5f * (float) std::sin (lfoPhase));
+        }
+
+        const auto startTicks = Time::getHighResolutionTicks();
+        proc.processAudioBlock (buffer);
+        if (blockIndex >= 0)
+            totalTicks += Time::getHighResolutionTicks() - startTicks;
+    }
+
+    return Time::highResolutionTicksToSeconds (totalTicks) / ((double) numBlocks * (double) config.blockSize / sampleRate);
+}
+} // namespace
+
+ProcessorBenchmarks::ProcessorBenchmarks()
+{
+    this->commandOption = "--benchmark-processors";
+    this->argumentDescription = "--benchmark-processors [--out=[JSON FILE]] [--procs=NAME1,NAME2] [--block-sizes=16,...,2048] [--os-factors=1,2,4,8,16] [--sample-rate=48000] [--seconds=0.25]";
+    this->shortDescription = "Measures the real-time factor for each processor";
+    this->longDescription = "Runs each processor in the store with mono and stereo inputs, at every block size and oversampling factor, "
+                            "with static and modulated parameters. The results are written as JSON, so they can be compared between builds. "
+                            "Progress messages go to stderr, so the JSON printed to stdout can be piped straight into a parser.";
+    this->command = [=] (const ArgumentList& args)
+    { runBenchmarks (args); };
+}
+
+void ProcessorBenchmarks::runBenchmarks (const ArgumentList& args)
+{
+    const auto sampleRate = args.containsOption ("--sample-rate") ? args.getValueForOption ("--sample-rate").getDoubleValue() : defaultSampleRate;
+    const auto secondsPerRun = args.containsOption ("--seconds") ? args.getValueForOption ("--seconds").getDoubleValue() : defaultSecondsPerRun;
+    const auto blockSizes = getIntListForOption (args, "--block-sizes", defaultBlockSizes);
+    const auto osFactors = getIntListForOption (args, "--os-factors", defaultOSFactors);
+    const auto procsToRun = StringArray::fromTokens (args.getValueForOption ("--procs"), ",", {});
+    if (sampleRate <= 0.0 || secondsPerRun <= 0.0 || blockSizes.isEmpty() || osFactors.isEmpty())
+        ConsoleApplication::fail ("Invalid benchmark settings!");
+
+    Array<var> results;
+    for (auto [name, factory] : ProcessorStore::getStoreMap())
+    {
+        if (! procsToRun.isEmpty() && ! procsToRun.contains (name))
+            continue;
+
+        std::cerr << "Benchmarking processor: " << name << std::endl;
+        auto proc = factory (nullptr);
+
+        for (auto numChannels : { 1, 2 })
+        {
+            for (auto blockSize : blockSizes)
+            {
+                for (auto osFactor : osFactors)
+                {
+                    for (auto modulated : { false, true })
+                    {
+                        const auto processingTimeRatio = timeProcessor (*proc, { numChannels, blockSize, osFactor, modulated }, sampleRate, secondsPerRun);
+
+                        auto result = std::make_unique<DynamicObject>();
+                        result->setProperty ("processor", name);
+                        result->setProperty ("channels", numChannels);
+                        result->setProperty ("block_size", blockSize);
+                        result->setProperty ("os_factor", osFactor);
+                        result->setProperty ("modulated", modulated);
+                        result->setProperty ("real_time_factor", processingTimeRatio > 0.0 ? 1.0 / processingTimeRatio : 0.0);
+                        result->setProperty ("ns_per_sample", processingTimeRatio * 1.0e9 / sampleRate);
+                        results.add (result.release());
+                    }
+                }
+            }
+        }
+    }
+
+    auto benchmarks = std::make_unique<DynamicObject>();
+    benchmarks->setProperty ("version", ProjectInfo::versionString);
+    benchmarks->setProperty ("sample_rate", sampleRate);
+    benchmarks->setProperty ("seconds_per_run", secondsPerRun);
+    benchmarks->setProperty ("results", results);
+
+    const auto json = JSON::toString (var { benchmarks.release() });
+    if (args.containsOption ("--out"))
+    {
+        const auto outFile = args.getFileForOption ("--out");
+        if (! outFile.replaceWithText (json))
+            ConsoleApplication::fail ("Unable to write benchmark results to " + outFile.getFullPathName());
+
+        std::cerr << "Benchmark results saved to " << outFile.getFullPathName() << std::endl;
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../pch.h"
+
+class ProcessorBenchmarks : public ConsoleApplication::Command
+{
+public:
+    ProcessorBenchmarks();
+
+private:
+    /** Measures the real-time factor for every processor in the store */
+    static void runBenchmarks (const ArgumentList& args);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorBenchmarks)
+};
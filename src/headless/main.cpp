@@ -1,5 +1,10 @@
+#include "ConvolutionBenchmarks.h"
+#include "IRFileOptimiser.h"
+#include "OfflineRenderer.h"
+#include "PresetProfiler.h"
 #include "PresetResaver.h"
 #include "PresetSaveLoadTime.h"
+#include "ProcessorBenchmarks.h"
 #include "ScreenshotGenerator.h"
 #include "tests/UnitTests.h"
 
@@ -29,6 +34,11 @@ int main (int argc, char* argv[])
     app.addCommand (ScreenshotGenerator());
     app.addCommand (PresetResaver());
     app.addCommand (PresetSaveLoadTime());
+    app.addCommand (OfflineRenderer());
+    app.addCommand (PresetProfiler());
+    app.addCommand (ProcessorBenchmarks());
+    app.addCommand (ConvolutionBenchmarks());
+    app.addCommand (IRFileOptimiser());
     app.addCommand (UnitTests());
 
     // ArgumentList args { "--unit-tests", "--all" };
@@ -0,0 +1,153 @@
+#include "processors/drive/neural_utils/BatchedRNN.h"
+
+namespace
+{
+constexpr int numTestSamples = 2000;
+constexpr float tolerance = 1.0e-4f;
+} // namespace
+
+/**
+ * Checks that the stereo-batched RNN models give the same output
+ * as running an RTNeural model for each channel.
+ */
+class BatchedRNNTest : public UnitTest
+{
+public:
+    BatchedRNNTest() : UnitTest ("Batched RNN Test")
+    {
+    }
+
+    batched_rnn::Vec2d randomWeights (int rows, int cols)
+    {
+        batched_rnn::Vec2d weights ((size_t) rows, std::vector<float> ((size_t) cols));
+        for (auto& row : weights)
+            for (auto& w : row)
+                w = (rand.nextFloat() - 0.5f) * 0.5f;
+        return weights;
+    }
+
+    template <typename BatchedModel, typename RefModel>
+    void loadDense (BatchedModel& model, std::array<RefModel, 2>& refModels, int hiddenSize)
+    {
+        const auto denseWeights = randomWeights (1, hiddenSize);
+        const auto denseBias = randomWeights (1, 1)[0];
+
+        model.getDenseLayer().setWeights (denseWeights);
+        model.getDenseLayer().setBias (denseBias.data());
+        for (auto& refModel : refModels)
+        {
+            refModel.template get<1>().setWeights (denseWeights);
+            refModel.template get<1>().setBias (denseBias.data());
+        }
+    }
+
+    template <typename BatchedModel, typename RefModel>
+    void compareModels (BatchedModel& model, std::array<RefModel, 2>& refModels, int numInputs, int numChannels)
+    {
+        typename BatchedModel::InputType inputMat;
+        alignas (RTNEURAL_DEFAULT_ALIGNMENT) float refInput[4] {};
+        for (int n = 0; n < numTestSamples; ++n)
+        {
+            const auto condition = rand.nextFloat();
+            for (int ch = 0; ch < numChannels; ++ch)
+                inputMat (0, ch) = rand.nextFloat() * 2.0f - 1.0f;
+            if (numInputs == 2)
+                inputMat.row (1).setConstant (condition);
+
+            const auto& y = numChannels == 1 ? model.template forward<1> (inputMat) : model.template forward<2> (inputMat);
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                refInput[0] = inputMat (0, ch);
+                refInput[1] = condition;
+                const auto expected = refModels[(size_t) ch].forward (refInput);
+                expectWithinAbsoluteError (y (ch), expected, tolerance, "Batched model output is incorrect!");
+            }
+        }
+    }
+
+    template <int numInputs, RTNeural::SampleRateCorrectionMode srcMode>
+    void lstmTest (int numChannels, float delaySamples)
+    {
+        constexpr int hiddenSize = 28;
+        batched_rnn::Model<batched_rnn::LSTMLayer<numInputs, hiddenSize, srcMode>> model;
+        std::array<RTNeural::ModelT<float, numInputs, 1, RTNeural::LSTMLayerT<float, numInputs, hiddenSize, srcMode>, RTNeural::DenseT<float, hiddenSize, 1>>, 2> refModels;
+
+        const auto wVals = randomWeights (numInputs, 4 * hiddenSize);
+        const auto uVals = randomWeights (hiddenSize, 4 * hiddenSize);
+        const auto bVals = randomWeights (1, 4 * hiddenSize)[0];
+
+        model.getRecurrentLayer().setWVals (wVals);
+        model.getRecurrentLayer().setUVals (uVals);
+        model.getRecurrentLayer().setBVals (bVals);
+        model.getRecurrentLayer().prepare (delaySamples);
+        for (auto& refModel : refModels)
+        {
+            auto& lstm = refModel.template get<0>();
+            lstm.setWVals (wVals);
+            lstm.setUVals (uVals);
+            lstm.setBVals (bVals);
+            if constexpr (srcMode == RTNeural::SampleRateCorrectionMode::NoInterp)
+                lstm.prepare ((int) delaySamples);
+            else
+                lstm.prepare (delaySamples);
+            refModel.reset();
+        }
+
+        loadDense (model, refModels, hiddenSize);
+        compareModels (model, refModels, numInputs, numChannels);
+    }
+
+    void gruTest (int numChannels, int delaySamples)
+    {
+        constexpr int hiddenSize = 8;
+        constexpr auto srcMode = RTNeural::SampleRateCorrectionMode::NoInterp;
+        batched_rnn::Model<batched_rnn::GRULayer<1, hiddenSize, srcMode>> model;
+        std::array<RTNeural::ModelT<float, 1, 1, RTNeural::GRULayerT<float, 1, hiddenSize, srcMode>, RTNeural::DenseT<float, hiddenSize, 1>>, 2> refModels;
+
+        const auto wVals = randomWeights (1, 3 * hiddenSize);
+        const auto uVals = randomWeights (hiddenSize, 3 * hiddenSize);
+        const auto bVals = randomWeights (2, 3 * hiddenSize);
+
+        model.getRecurrentLayer().setWVals (wVals);
+        model.getRecurrentLayer().setUVals (uVals);
+        model.getRecurrentLayer().setBVals (bVals);
+        model.getRecurrentLayer().prepare ((float) delaySamples);
+        for (auto& refModel : refModels)
+        {
+            auto& gru = refModel.get<0>();
+            gru.setWVals (wVals);
+            gru.setUVals (uVals);
+            gru.setBVals (bVals);
+            gru.prepare (delaySamples);
+            refModel.reset();
+        }
+
+        loadDense (model, refModels, hiddenSize);
+        compareModels (model, refModels, 1, numChannels);
+    }
+
+    void runTest() override
+    {
+        rand = getRandom();
+
+        for (int numChannels : { 1, 2 })
+        {
+            beginTest ("LSTM, " + String (numChannels) + " channel(s)");
+            lstmTest<1, RTNeural::SampleRateCorrectionMode::NoInterp> (numChannels, 1.0f);
+            lstmTest<1, RTNeural::SampleRateCorrectionMode::NoInterp> (numChannels, 3.0f);
+
+            beginTest ("Conditioned LSTM, " + String (numChannels) + " channel(s)");
+            lstmTest<2, RTNeural::SampleRateCorrectionMode::LinInterp> (numChannels, 1.0f);
+            lstmTest<2, RTNeural::SampleRateCorrectionMode::LinInterp> (numChannels, 2.18f);
+
+            beginTest ("GRU, " + String (numChannels) + " channel(s)");
+            gruTest (numChannels, 1);
+            gruTest (numChannels, 2);
+        }
+    }
+
+private:
+    Random rand;
+};
+
+static BatchedRNNTest batchedRnnTest;
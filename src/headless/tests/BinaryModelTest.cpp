@@ -0,0 +1,105 @@
+#include "processors/drive/neural_utils/BinaryModelData.h"
+
+/** Checks that neural models survive the trip through the binary model format. */
+class BinaryModelTest : public UnitTest
+{
+public:
+    BinaryModelTest() : UnitTest ("Binary Model Test")
+    {
+    }
+
+    static nlohmann::json getTestModelJson()
+    {
+        return nlohmann::json::parse (R"({
+            "model_data": { "input_size": 1, "hidden_size": 2, "sample_rate": 48000.0 },
+            "state_dict": {
+                "rec.weight_ih_l0": [[0.5], [-0.25]],
+                "rec.bias_ih_l0": [0.125, 1.0]
+            },
+            "layers": [ { "shape": [null, 2], "weights": [ [[1.0, 2.0, 3.0]], [4.0] ] } ]
+        })");
+    }
+
+    void conversionTest()
+    {
+        const auto modelJson = getTestModelJson();
+        const auto model = BinaryModelData::fromJSON (modelJson);
+        expect (model != nullptr, "Unable to convert model!");
+
+        const auto weights = model->getTensor ("/state_dict/rec.weight_ih_l0");
+        expectEquals (weights.numDims, 2, "Incorrect number of dimensions!");
+        expectEquals (weights.numRows, 2, "Incorrect number of rows!");
+        expectEquals (weights.numCols, 1, "Incorrect number of columns!");
+        expectEquals (weights.toVec2d (true)[0][1], -0.25f, "Incorrect transposed weights!");
+
+        const auto bias = model->getTensor ("/state_dict/rec.bias_ih_l0");
+        expectEquals (bias.numDims, 1, "Incorrect number of dimensions!");
+        expectEquals (bias[1], 1.0f, "Incorrect bias value!");
+
+        expect (! model->getTensor ("/layers/0/shape").isValid(), "Shape with nulls should not be a tensor!");
+        expectEquals (model->getMetadata()["model_data"].value ("hidden_size", 0), 2, "Incorrect metadata!");
+        expect (model->toJSON() == modelJson, "Model JSON did not survive the round trip!");
+    }
+
+    void invalidDataTest()
+    {
+        auto modelData = BinaryModelData::convertJSON (getTestModelJson());
+        expect (BinaryModelData::fromMemory (modelData.getData(), modelData.getSize() - 4) == nullptr, "Truncated model should not load!");
+
+        static_cast<char*> (modelData.getData())[4] = 99; // unknown format version
+        expect (BinaryModelData::fromMemory (modelData.getData(), modelData.getSize()) == nullptr, "Model with unknown version should not load!");
+    }
+
+    void cacheTest()
+    {
+        TemporaryFile cacheDirectory;
+        const auto modelJsonText = getTestModelJson().dump();
+
+        const auto model = BinaryModelData::fromJSONText (modelJsonText, cacheDirectory.getFile());
+        expectEquals (cacheDirectory.getFile().getNumberOfChildFiles (File::findFiles), 1, "Converted model was not cached!");
+
+        const auto cachedModel = BinaryModelData::fromJSONText (modelJsonText, cacheDirectory.getFile());
+        expect (cachedModel->toJSON() == model->toJSON(), "Cached model is different from the original!");
+
+        cacheDirectory.getFile().deleteRecursively();
+    }
+
+    void bundledModelsTest()
+    {
+        for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
+        {
+            if (! String { BinaryData::originalFilenames[i] }.endsWith (".bnnm"))
+                continue;
+
+            int dataSize = 0;
+            const auto* data = BinaryData::getNamedResource (BinaryData::namedResourceList[i], dataSize);
+            if (! BinaryModelData::isBinaryModel (data, (size_t) dataSize))
+            {
+                // built without Python, so the model was bundled as JSON
+                MemoryInputStream jsonInputStream (data, (size_t) dataSize, false);
+                expect (BinaryModelData::fromJSON (nlohmann::json::parse (jsonInputStream.readEntireStreamAsString().toStdString())) != nullptr,
+                        "Unable to convert bundled model: " + String { BinaryData::originalFilenames[i] });
+                continue;
+            }
+
+            expect (BinaryModelData::fromMemory (data, (size_t) dataSize) != nullptr, "Unable to load bundled model: " + String { BinaryData::originalFilenames[i] });
+        }
+    }
+
+    void runTest() override
+    {
+        beginTest ("Conversion Test");
+        conversionTest();
+
+        beginTest ("Invalid Data Test");
+        invalidDataTest();
+
+        beginTest ("Cache Test");
+        cacheTest();
+
+        beginTest ("Bundled Models Test");
+        bundledModelsTest();
+    }
+};
+
+static BinaryModelTest binaryModelTest;
@@ -0,0 +1,202 @@
+#include "UnitTests.h"
+#include "processors/tone/ir_utils/DirectFIR.h"
+#include "processors/tone/ir_utils/IRConvolution.h"
+
+namespace
+{
+constexpr int numTestSamples = 2000;
+constexpr int maxBlockSize = 256;
+constexpr int numSwitchTestSamples = 48000;
+constexpr int switchSample = 4096;
+constexpr int numSettledSamples = 8192;
+} // namespace
+
+/** Checks the direct FIR engine against a naive convolution, and the engine choice and switching in IRConvolution. */
+class DirectFIRTest : public UnitTest
+{
+public:
+    DirectFIRTest() : UnitTest ("Direct FIR Test")
+    {
+    }
+
+    static AudioBuffer<float> makeNoise (int numChannels, int numSamples, Random& rand)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int n = 0; n < numSamples; ++n)
+                buffer.setSample (ch, n, rand.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    static AudioBuffer<float> naiveConvolution (const AudioBuffer<float>& ir, const AudioBuffer<float>& input)
+    {
+        AudioBuffer<float> output (input.getNumChannels(), input.getNumSamples());
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+        {
+            const auto* h = ir.getReadPointer (ch % ir.getNumChannels());
+            const auto* x = input.getReadPointer (ch);
+            auto* y = output.getWritePointer (ch);
+            for (int n = 0; n < input.getNumSamples(); ++n)
+            {
+                y[n] = 0.0f;
+                for (int k = 0; k < jmin (ir.getNumSamples(), n + 1); ++k)
+                    y[n] += h[k] * x[n - k];
+            }
+        }
+
+        return output;
+    }
+
+    void checkAgainstNaiveConvolution (const AudioBuffer<float>& ir, const AudioBuffer<float>& input, const AudioBuffer<float>& output)
+    {
+        const auto expected = naiveConvolution (ir, input);
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+            for (int n = 0; n < input.getNumSamples(); ++n)
+                expectWithinAbsoluteError (output.getSample (ch, n), expected.getSample (ch, n), 1.0e-4f, "Filtered signal is incorrect!");
+    }
+
+    void directFIRTest (int irLength, int numIRChannels, int numChannels)
+    {
+        Random rand { 0x1234 + irLength };
+        const auto ir = makeNoise (numIRChannels, irLength, rand);
+        const auto input = makeNoise (numChannels, numTestSamples, rand);
+
+        DirectFIR fir;
+        fir.setImpulseResponse (ir);
+        expectEquals (fir.getNumTaps(), irLength, "Incorrect number of taps!");
+
+        // process in uneven blocks, to make sure the filter state carries over properly
+        auto output = input;
+        for (int start = 0, blockSize = 1; start < numTestSamples; start += blockSize, blockSize = (blockSize * 7 + 3) % maxBlockSize + 1)
+        {
+            const auto numSamples = jmin (blockSize, numTestSamples - start);
+            fir.process (dsp::AudioBlock<float> { output }.getSubBlock ((size_t) start, (size_t) numSamples));
+        }
+
+        checkAgainstNaiveConvolution (ir, input, output);
+    }
+
+    void irConvolutionTest()
+    {
+        dsp::ConvolutionMessageQueue queue;
+        TimeSliceThread warmUpThread { "IR Convolution Test" };
+        IRConvolution convolution { queue, warmUpThread };
+
+        Random rand { 0x4321 };
+        auto preparedIR = std::make_shared<SharedAssetCache::DecodedIR>();
+        preparedIR->buffer = makeNoise (2, 100, rand);
+        preparedIR->sampleRate = 48000.0;
+        expect (IRConvolution::shouldUseDirectFIR (preparedIR->buffer.getNumSamples(), maxBlockSize), "Short IR should use the direct FIR!");
+
+        // a short IR is loaded straight into the direct FIR, so there shouldn't be any latency
+        convolution.prepare ({ preparedIR->sampleRate, (uint32) maxBlockSize, 2 }, preparedIR);
+        const auto input = makeNoise (2, numTestSamples, rand);
+        auto output = input;
+        for (int start = 0; start < numTestSamples; start += maxBlockSize)
+            convolution.process (dsp::AudioBlock<float> { output }.getSubBlock ((size_t) start, (size_t) jmin (maxBlockSize, numTestSamples - start)));
+
+        checkAgainstNaiveConvolution (preparedIR->buffer, input, output);
+    }
+
+    static std::shared_ptr<SharedAssetCache::DecodedIR> makePreparedIR (int irLength, Random& rand)
+    {
+        auto preparedIR = std::make_shared<SharedAssetCache::DecodedIR>();
+        preparedIR->buffer = makeNoise (2, irLength, rand);
+        preparedIR->buffer.applyGain (1.0f / std::sqrt ((float) irLength));
+        preparedIR->sampleRate = 48000.0;
+        return preparedIR;
+    }
+
+    void engineSwitchTest (int fromIRLength, int toIRLength)
+    {
+        dsp::ConvolutionMessageQueue queue;
+        TimeSliceThread warmUpThread { "IR Convolution Test" };
+        warmUpThread.startThread();
+        IRConvolution convolution { queue, warmUpThread };
+
+        Random rand { 0x5678 + toIRLength };
+        const auto fromIR = makePreparedIR (fromIRLength, rand);
+        const auto toIR = makePreparedIR (toIRLength, rand);
+        expect (IRConvolution::shouldUseDirectFIR (fromIRLength, maxBlockSize) != IRConvolution::shouldUseDirectFIR (toIRLength, maxBlockSize),
+                "The two IRs should use different engines!");
+
+        convolution.prepare ({ fromIR->sampleRate, (uint32) maxBlockSize, 2 }, fromIR);
+        const auto input = makeNoise (2, numSwitchTestSamples, rand);
+        auto output = input;
+        for (int start = 0; start < numSwitchTestSamples; start += maxBlockSize)
+        {
+            if (start == switchSample)
+                convolution.loadImpulseResponse (toIR);
+
+            convolution.process (dsp::AudioBlock<float> { output }.getSubBlock ((size_t) start, (size_t) jmin (maxBlockSize, numSwitchTestSamples - start)));
+            Thread::sleep (1); // give the warm-up thread time to set up the new engine
+        }
+
+        const auto fromOutput = naiveConvolution (fromIR->buffer, input);
+        const auto toOutput = naiveConvolution (toIR->buffer, input);
+
+        // The new engine only gets crossfaded in once it's ready, so the output should never drop out.
+        // The two outputs are uncorrelated, so even halfway through the crossfade there's plenty of signal.
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int start = 0; start < numSwitchTestSamples; start += maxBlockSize)
+            {
+                const auto numSamples = jmin (maxBlockSize, numSwitchTestSamples - start);
+                const auto outputRMS = output.getRMSLevel (ch, start, numSamples);
+                const auto minRMS = jmin (fromOutput.getRMSLevel (ch, start, numSamples), toOutput.getRMSLevel (ch, start, numSamples));
+                expectGreaterThan (outputRMS, 0.5f * minRMS, "Output dropped out while switching engines!");
+            }
+        }
+
+        // by the end, only the new IR should be in use
+        for (int ch = 0; ch < 2; ++ch)
+            for (int n = numSwitchTestSamples - numSettledSamples; n < numSwitchTestSamples; ++n)
+                expectWithinAbsoluteError (output.getSample (ch, n), toOutput.getSample (ch, n), 1.0e-3f, "New IR was not loaded!");
+    }
+
+    void engineChoiceTest()
+    {
+        for (int blockSize : { 16, 32, 64, 128, 256, 512, 1024 })
+        {
+            expect (IRConvolution::shouldUseDirectFIR (32, blockSize), "Very short IRs should always use the direct FIR!");
+            expect (! IRConvolution::shouldUseDirectFIR (4096, blockSize), "Long IRs should always use the FFT convolution!");
+
+            // if an IR uses the direct FIR, then any shorter IR should too
+            for (int irLength = 1; irLength < 2048; ++irLength)
+            {
+                if (IRConvolution::shouldUseDirectFIR (irLength + 1, blockSize))
+                    expect (IRConvolution::shouldUseDirectFIR (irLength, blockSize), "Engine choice should be monotonic in IR length!");
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        for (int irLength : { 1, 3, 8, 13, 100, 257 })
+        {
+            for (int numIRChannels : { 1, 2 })
+            {
+                for (int numChannels : { 1, 2 })
+                {
+                    beginTest ("Direct FIR Test, IR length " + String (irLength) + ", " + String (numIRChannels) + " IR channel(s), " + String (numChannels) + " channel(s)");
+                    directFIRTest (irLength, numIRChannels, numChannels);
+                }
+            }
+        }
+
+        beginTest ("IR Convolution Test");
+        irConvolutionTest();
+
+        beginTest ("FIR to FFT Switch Test");
+        engineSwitchTest (100, 1024);
+
+        beginTest ("FFT to FIR Switch Test");
+        engineSwitchTest (1024, 100);
+
+        beginTest ("Engine Choice Test");
+        engineChoiceTest();
+    }
+};
+
+static DirectFIRTest directFIRTest;
@@ -0,0 +1,134 @@
+#include "UnitTests.h"
+#include "processors/utility/FastMath.h"
+
+namespace
+{
+constexpr int numTestPoints = 5000;
+
+using FastMath::Accuracy;
+
+template <typename T>
+T getTolerance (Accuracy accuracy)
+{
+    if (accuracy == Accuracy::Fast)
+        return (T) 3.0e-4;
+    if (accuracy == Accuracy::Balanced)
+        return (T) 5.0e-6;
+    return std::is_same_v<T, float> ? (T) 1.0e-6 : (T) 1.0e-12;
+}
+} // namespace
+
+/** Checks each of the fast math functions against the standard library, for each accuracy tier, with scalars and SIMD batches. */
+class FastMathTest : public UnitTest
+{
+public:
+    FastMathTest() : UnitTest ("Fast Math Test")
+    {
+    }
+
+    template <typename T, typename FuncType, typename RefFuncType>
+    void checkFunction (FuncType&& func, RefFuncType&& referenceFunc, T low, T high, T tolerance, bool relativeError)
+    {
+        using Batch = xsimd::batch<T>;
+
+        std::vector<T> inputs ((size_t) numTestPoints);
+        for (int i = 0; i < numTestPoints; ++i)
+            inputs[(size_t) i] = low + (high - low) * (T) i / (T) (numTestPoints - 1);
+
+        auto checkOutput = [&] (T x, T actual)
+        {
+            const auto expected = (T) referenceFunc ((double) x);
+            const auto errorScale = relativeError ? jmax (std::abs (expected), std::numeric_limits<T>::min()) : (T) 1;
+            expectLessOrEqual (std::abs (actual - expected) / errorScale, tolerance, "Incorrect output for input " + String (x));
+        };
+
+        for (auto x : inputs)
+            checkOutput (x, func (x));
+
+        T outputs[Batch::size];
+        for (size_t i = 0; i + Batch::size <= inputs.size(); i += Batch::size)
+        {
+            func (Batch::load_unaligned (&inputs[i])).store_unaligned (outputs);
+            for (size_t j = 0; j < Batch::size; ++j)
+                checkOutput (inputs[i + j], outputs[j]);
+        }
+    }
+
+    template <typename T, Accuracy accuracy>
+    void accuracyTest (const String& testSuffix)
+    {
+        const auto tolerance = getTolerance<T> (accuracy);
+
+        beginTest ("Exp Test, " + testSuffix);
+        checkFunction<T> ([] (auto x)
+                          { return FastMath::exp<accuracy> (x); },
+                          [] (double x)
+                          { return std::exp (x); },
+                          (T) -80,
+                          (T) 80,
+                          tolerance,
+                          true);
+
+        beginTest ("Log Test, " + testSuffix);
+        checkFunction<T> ([] (auto x)
+                          { return FastMath::log<accuracy> (x); },
+                          [] (double x)
+                          { return std::log (x); },
+                          (T) 1.0e-30,
+                          (T) 1.0e4,
+                          tolerance,
+                          false);
+
+        beginTest ("Signed Pow Test, " + testSuffix);
+        checkFunction<T> ([] (auto x)
+                          { return FastMath::signedPow<accuracy> (x, decltype (x) (0.33)); },
+                          [] (double x)
+                          { return x == 0.0 ? 0.0 : std::copysign (std::pow (std::abs (x), (double) (T) 0.33), x); },
+                          (T) -100,
+                          (T) 100,
+                          tolerance,
+                          true);
+
+        beginTest ("Asinh Test, " + testSuffix);
+        checkFunction<T> ([] (auto x)
+                          { return FastMath::asinh<accuracy> (x); },
+                          [] (double x)
+                          { return std::asinh (x); },
+                          (T) -1000,
+                          (T) 1000,
+                          tolerance,
+                          true);
+
+        beginTest ("Small Asinh Test, " + testSuffix);
+        checkFunction<T> ([] (auto x)
+                          { return FastMath::asinh<accuracy> (x); },
+                          [] (double x)
+                          { return std::asinh (x); },
+                          (T) -1.0e-3,
+                          (T) 1.0e-3,
+                          tolerance,
+                          true);
+
+        beginTest ("Tanh Test, " + testSuffix);
+        checkFunction<T> ([] (auto x)
+                          { return FastMath::tanh<accuracy> (x); },
+                          [] (double x)
+                          { return std::tanh (x); },
+                          (T) -20,
+                          (T) 20,
+                          tolerance,
+                          true);
+    }
+
+    void runTest() override
+    {
+        accuracyTest<float, Accuracy::Fast> ("Float, Fast");
+        accuracyTest<float, Accuracy::Balanced> ("Float, Balanced");
+        accuracyTest<float, Accuracy::Exact> ("Float, Exact");
+        accuracyTest<double, Accuracy::Fast> ("Double, Fast");
+        accuracyTest<double, Accuracy::Balanced> ("Double, Balanced");
+        accuracyTest<double, Accuracy::Exact> ("Double, Exact");
+    }
+};
+
+static FastMathTest fastMathTest;
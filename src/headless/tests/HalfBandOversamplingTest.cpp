@@ -0,0 +1,68 @@
+#include "UnitTests.h"
+#include "processors/chain/HalfBandOversampler.h"
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int numBlocks = 16;
+constexpr double testFreq = 100.0;
+} // namespace
+
+/** Checks that the half-band IIR oversampler is transparent at low frequencies, with the latency that it reports. */
+class HalfBandOversamplingTest : public UnitTest
+{
+public:
+    HalfBandOversamplingTest() : UnitTest ("Half-Band Oversampling Test")
+    {
+    }
+
+    void roundTripTest (int numStages, int numChannels)
+    {
+        HalfBandOversampler oversampler;
+        oversampler.prepare (blockSize);
+        oversampler.setNumStages (numStages);
+        expectEquals (oversampler.getOSFactor(), 1 << numStages, "Incorrect oversampling factor!");
+
+        const auto latency = (double) oversampler.getLatencySamples();
+        const auto getInputSample = [] (double n)
+        { return (float) std::sin (MathConstants<double>::twoPi * testFreq * n / sampleRate); };
+
+        AudioBuffer<float> buffer (numChannels, blockSize);
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int n = 0; n < blockSize; ++n)
+                    buffer.setSample (ch, n, getInputSample ((double) (i * blockSize + n)));
+
+            auto&& block = dsp::AudioBlock<float> { buffer };
+            auto&& osBlock = oversampler.processSamplesUp (block);
+            expectEquals ((int) osBlock.getNumSamples(), blockSize << numStages, "Incorrect oversampled block size!");
+            oversampler.processSamplesDown (block);
+        }
+
+        // after the filters have settled, the output should be the input, delayed by the reported latency
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int n = 0; n < blockSize; ++n)
+            {
+                const auto expected = getInputSample ((double) ((numBlocks - 1) * blockSize + n) - latency);
+                expectWithinAbsoluteError (buffer.getSample (ch, n), expected, 0.01f, "Oversampled signal is incorrect!");
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        for (int numChannels : { 1, 2 })
+        {
+            for (int numStages = 0; numStages <= HalfBandOversampler::maxNumStages; ++numStages)
+            {
+                beginTest ("Round Trip Test, " + String (numChannels) + " channel(s), " + String (1 << numStages) + "x");
+                roundTripTest (numStages, numChannels);
+            }
+        }
+    }
+};
+
+static HalfBandOversamplingTest halfBandOversamplingTest;
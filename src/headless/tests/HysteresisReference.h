@@ -0,0 +1,338 @@
+#pragma once
+
+#include <cmath>
+#include <pch.h>
+
+/**
+ * The original double-precision hysteresis model, kept exactly as it was before
+ * HysteresisProcessing was moved over to float SIMD, so that HysteresisTest can
+ * check the new solvers against it. Don't change anything in here!
+ */
+namespace HysteresisReference
+{
+#define HYSTERESIS_USE_SIMD 1
+
+namespace HysteresisOps
+{
+using namespace chowdsp::SIMDUtils;
+
+struct HysteresisState
+{
+    // parameter values
+    double M_s = 1.0;
+    double a = M_s / 4.0;
+    static constexpr double alpha = 1.6e-3;
+    double k = 0.47875;
+    double c = 1.7e-1;
+
+    // Save calculations
+    double nc = 1 - c;
+    double M_s_oa = M_s / a;
+    double M_s_oa_talpha = alpha * M_s / a;
+    double M_s_oa_tc = c * M_s / a;
+    double M_s_oa_tc_talpha = alpha * c * M_s / a;
+    double M_s_oaSq_tc_talpha = alpha * c * M_s / (a * a);
+    double M_s_oaSq_tc_talphaSq = alpha * alpha * c * M_s / (a * a);
+
+    // temp vars
+#if HYSTERESIS_USE_SIMD
+    xsimd::batch<double> Q, M_diff, L_prime, kap1, f1Denom, f1, f2, f3;
+    xsimd::batch<double> coth = 0.0;
+    xsimd::batch_bool<double> nearZero;
+#else
+    double Q, M_diff, L_prime, kap1, f1Denom, f1, f2, f3;
+    double coth = 0.0;
+    bool nearZero = false;
+#endif
+};
+
+constexpr double ONE_THIRD = 1.0 / 3.0;
+constexpr double NEG_TWO_OVER_15 = -2.0 / 15.0;
+
+constexpr inline int sign (double x)
+{
+    return int (x > 0.0) - int (x < 0.0);
+}
+
+/** Langevin function */
+template <typename Float, typename Bool>
+static inline Float langevin (Float x, Float coth, Bool nearZero) noexcept
+{
+#if HYSTERESIS_USE_SIMD
+    return xsimd::select (nearZero, x / 3.0, coth - ((Float) 1.0 / x));
+#else
+    return ! nearZero ? (coth) - (1.0 / x) : x / 3.0;
+#endif
+}
+
+/** Derivative of Langevin function */
+template <typename Float, typename Bool>
+static inline Float langevinD (Float x, Float coth, Bool nearZero) noexcept
+{
+#if HYSTERESIS_USE_SIMD
+    return xsimd::select (nearZero, (Float) ONE_THIRD, ((Float) 1.0 / (x * x)) - (coth * coth) + 1.0);
+#else
+    return ! nearZero ? (1.0 / (x * x)) - (coth * coth) + 1.0 : ONE_THIRD;
+#endif
+}
+
+/** 2nd derivative of Langevin function */
+template <typename Float, typename Bool>
+static inline Float langevinD2 (Float x, Float coth, Bool nearZero) noexcept
+{
+#if HYSTERESIS_USE_SIMD
+    return xsimd::select (nearZero, x * NEG_TWO_OVER_15, (Float) 2.0 * coth * (coth * coth - 1.0) - ((Float) 2.0 / (x * x * x)));
+#else
+    return ! nearZero
+               ? 2.0 * coth * (coth * coth - 1.0) - (2.0 / (x * x * x))
+               : NEG_TWO_OVER_15 * x;
+#endif
+}
+
+/** Derivative by alpha transform */
+template <typename Float>
+static inline Float deriv (Float x_n, Float x_n1, Float x_d_n1, Float T) noexcept
+{
+    const Float dAlpha = 0.75;
+    return ((((Float) 1.0 + dAlpha) / T) * (x_n - x_n1)) - dAlpha * x_d_n1;
+}
+
+/** hysteresis function dM/dt */
+template <typename Float>
+static inline Float hysteresisFunc (Float M, Float H, Float H_d, HysteresisState& hp) noexcept
+{
+    hp.Q = (H + M * HysteresisOps::HysteresisState::alpha) * (1.0 / hp.a);
+
+#if HYSTERESIS_USE_SIMD
+    hp.coth = (Float) 1.0 / xsimd::tanh (hp.Q);
+    hp.nearZero = (hp.Q < 0.001) && (hp.Q > -0.001);
+#else
+    hp.coth = 1.0 / std::tanh (hp.Q);
+    hp.nearZero = hp.Q < 0.001 && hp.Q > -0.001;
+#endif
+
+    hp.M_diff = langevin (hp.Q, hp.coth, hp.nearZero) * hp.M_s - M;
+
+#if HYSTERESIS_USE_SIMD
+    const auto delta = xsimd::select (H_d >= 0.0, (Float) 1, (Float) -1);
+    const auto delta_M = chowdsp::Math::sign (delta) == chowdsp::Math::sign (hp.M_diff);
+    hp.kap1 = xsimd::select (delta_M, (Float) hp.nc, (Float) 0);
+#else
+    const auto delta = (Float) ((H_d >= 0.0) - (H_d < 0.0));
+    const auto delta_M = (Float) (sign (delta) == sign (hp.M_diff));
+    hp.kap1 = (Float) hp.nc * delta_M;
+#endif
+
+    hp.L_prime = langevinD (hp.Q, hp.coth, hp.nearZero);
+
+    hp.f1Denom = ((Float) hp.nc * delta) * hp.k - (Float) HysteresisOps::HysteresisState::alpha * hp.M_diff;
+    hp.f1 = hp.kap1 * hp.M_diff / hp.f1Denom;
+    hp.f2 = hp.L_prime * hp.M_s_oa_tc;
+    hp.f3 = (Float) 1.0 - (hp.L_prime * hp.M_s_oa_tc_talpha);
+
+    return H_d * (hp.f1 + hp.f2) / hp.f3;
+}
+
+// derivative of hysteresis func w.r.t M (depends on cached values from computing hysteresisFunc)
+template <typename Float>
+static inline Float hysteresisFuncPrime (Float H_d, Float dMdt, HysteresisState& hp) noexcept
+{
+    const Float L_prime2 = langevinD2 (hp.Q, hp.coth, hp.nearZero);
+    const Float M_diff2 = hp.L_prime * hp.M_s_oa_talpha - 1.0;
+
+    const Float f1_p = hp.kap1 * ((M_diff2 / hp.f1Denom) + hp.M_diff * HysteresisOps::HysteresisState::alpha * M_diff2 / (hp.f1Denom * hp.f1Denom));
+    const Float f2_p = L_prime2 * hp.M_s_oaSq_tc_talpha;
+    const Float f3_p = L_prime2 * (-hp.M_s_oaSq_tc_talphaSq);
+
+    return H_d * (f1_p + f2_p) / hp.f3 - dMdt * f3_p / hp.f3;
+}
+
+} // namespace HysteresisOps
+
+/*
+    Hysteresis processing for a model of an analog tape machine.
+    For more information on the DSP happening here, see:
+    https://ccrma.stanford.edu/~jatin/420/tape/TapeModel_DAFx.pdf
+*/
+class HysteresisProcessing
+{
+public:
+    HysteresisProcessing() = default;
+
+    void reset();
+    void setSampleRate (double newSR);
+
+    void setParameters (float drive, float width, float sat);
+
+    void processBlock (double* bufferL, double* bufferR, const int numSamples);
+
+private:
+    // newton-raphson solvers
+    template <int nIterations, typename Float>
+    inline Float NRSolver (Float H, Float H_d) noexcept
+    {
+        using namespace chowdsp::SIMDUtils;
+
+        Float M = M_n1;
+        const Float last_dMdt = HysteresisOps::hysteresisFunc (M_n1, H_n1, H_d_n1, hpState);
+
+        Float dMdt;
+        Float dMdtPrime;
+        Float deltaNR;
+        for (int n = 0; n < nIterations; ++n)
+        {
+            dMdt = HysteresisOps::hysteresisFunc (M, H, H_d, hpState);
+            dMdtPrime = HysteresisOps::hysteresisFuncPrime (H_d, dMdt, hpState);
+            deltaNR = (M - M_n1 - (Float) Talpha * (dMdt + last_dMdt)) / (Float (1.0) - (Float) Talpha * dMdtPrime);
+            M -= deltaNR;
+        }
+
+        return M;
+    }
+
+    void cook (float drive, float width, float sat);
+
+    SmoothedValue<float, ValueSmoothingTypes::Linear> driveSmooth, satSmooth, widthSmooth;
+
+    // parameter values
+    double fs = 48000.0;
+    double T = 1.0 / fs;
+    double Talpha = T / 1.9;
+    double upperLim = 20.0;
+
+    // state variables
+#if HYSTERESIS_USE_SIMD
+    xsimd::batch<double> M_n1 = 0.0;
+    xsimd::batch<double> H_n1 = 0.0;
+    xsimd::batch<double> H_d_n1 = 0.0;
+#else
+    double M_n1 = 0.0;
+    double H_n1 = 0.0;
+    double H_d_n1 = 0.0;
+#endif
+
+    HysteresisOps::HysteresisState hpState;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HysteresisProcessing)
+};
+
+inline void HysteresisProcessing::reset()
+{
+    M_n1 = 0.0;
+    H_n1 = 0.0;
+    H_d_n1 = 0.0;
+
+    hpState.coth = 0.0;
+    hpState.nearZero = false;
+}
+
+inline void HysteresisProcessing::setSampleRate (double newSR)
+{
+    fs = newSR;
+    T = 1.0 / fs;
+    Talpha = T / 1.9;
+
+    driveSmooth.reset (newSR, 0.01);
+    satSmooth.reset (newSR, 0.01);
+    widthSmooth.reset (newSR, 0.01);
+}
+
+inline void HysteresisProcessing::setParameters (float drive, float width, float sat)
+{
+    driveSmooth.setTargetValue (drive);
+    satSmooth.setTargetValue (sat);
+    widthSmooth.setTargetValue (width);
+}
+
+inline void HysteresisProcessing::cook (float drive, float width, float sat)
+{
+    hpState.M_s = 0.5 + 1.5 * (1.0 - (double) sat);
+    hpState.a = hpState.M_s / (0.01 + 6.0 * (double) drive);
+    hpState.c = std::sqrt (1.0f - (double) width) - 0.01;
+    hpState.k = 0.47875;
+    upperLim = 20.0;
+
+    constexpr auto alpha = HysteresisOps::HysteresisState::alpha;
+    hpState.nc = 1.0 - hpState.c;
+    hpState.M_s_oa = hpState.M_s / hpState.a;
+    hpState.M_s_oa_talpha = alpha * hpState.M_s_oa;
+    hpState.M_s_oa_tc = hpState.c * hpState.M_s_oa;
+    hpState.M_s_oa_tc_talpha = alpha * hpState.M_s_oa_tc;
+    hpState.M_s_oaSq_tc_talpha = hpState.M_s_oa_tc_talpha / hpState.a;
+    hpState.M_s_oaSq_tc_talphaSq = alpha * hpState.M_s_oaSq_tc_talpha;
+}
+
+inline void HysteresisProcessing::processBlock (double* bufferLeft, double* bufferRight, const int numSamples)
+{
+    using Float = xsimd::batch<double>;
+
+    bool needsSmoothing = driveSmooth.isSmoothing() || widthSmooth.isSmoothing() || satSmooth.isSmoothing();
+
+    double stereoVec alignas (16)[2];
+
+    if (needsSmoothing)
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            cook (driveSmooth.getNextValue(), widthSmooth.getNextValue(), satSmooth.getNextValue());
+
+            stereoVec[0] = bufferLeft[n];
+            stereoVec[1] = bufferRight[n];
+            auto H = xsimd::load_aligned (stereoVec);
+            auto H_d = HysteresisOps::deriv (H, H_n1, H_d_n1, (Float) T);
+            auto M = NRSolver<4> (H, H_d);
+
+            // check for instability
+#if HYSTERESIS_USE_SIMD
+            auto notIllCondition = ! (xsimd::isnan (M) || (M > upperLim));
+            M = xsimd::select (notIllCondition, M, (Float) 0.0);
+            H_d = xsimd::select (notIllCondition, H_d, (Float) 0.0);
+#else
+            bool illCondition = std::isnan (M) || M > upperLim;
+            M = illCondition ? 0.0 : M;
+            H_d = illCondition ? 0.0 : H_d;
+#endif
+
+            M_n1 = M;
+            H_n1 = H;
+            H_d_n1 = H_d;
+
+            M.store_aligned (stereoVec);
+            bufferLeft[n] = stereoVec[0];
+            bufferRight[n] = stereoVec[1];
+        }
+    }
+    else
+    {
+        cook (driveSmooth.getNextValue(), widthSmooth.getNextValue(), satSmooth.getNextValue());
+        for (int n = 0; n < numSamples; ++n)
+        {
+            stereoVec[0] = bufferLeft[n];
+            stereoVec[1] = bufferRight[n];
+            auto H = xsimd::load_aligned (stereoVec);
+            auto H_d = HysteresisOps::deriv (H, H_n1, H_d_n1, (Float) T);
+            auto M = NRSolver<4> (H, H_d);
+
+            // check for instability
+#if HYSTERESIS_USE_SIMD
+            auto notIllCondition = ! (xsimd::isnan (M) || (M > upperLim));
+            M = xsimd::select (notIllCondition, M, (Float) 0.0);
+            H_d = xsimd::select (notIllCondition, H_d, (Float) 0.0);
+#else
+            bool illCondition = std::isnan (M) || M > upperLim;
+            M = illCondition ? 0.0 : M;
+            H_d = illCondition ? 0.0 : H_d;
+#endif
+
+            M_n1 = M;
+            H_n1 = H;
+            H_d_n1 = H_d;
+
+            M.store_aligned (stereoVec);
+            bufferLeft[n] = stereoVec[0];
+            bufferRight[n] = stereoVec[1];
+        }
+    }
+}
+
+} // namespace HysteresisReference
@@ -0,0 +1,92 @@
+#include "UnitTests.h"
+#include "HysteresisReference.h"
+#include "processors/drive/hysteresis/HysteresisProcessing.h"
+
+namespace
+{
+constexpr double testSampleRate = 48000.0;
+constexpr int numTestSamples = 24000;
+
+using FloatProcessor = HysteresisProcessing<xsimd::batch<float>>;
+using ReferenceProcessor = HysteresisReference::HysteresisProcessing;
+} // namespace
+
+/** Checks the float hysteresis solvers against the original double-precision model. */
+class HysteresisTest : public UnitTest
+{
+public:
+    HysteresisTest() : UnitTest ("Hysteresis Test")
+    {
+    }
+
+    template <typename T>
+    static AudioBuffer<T> makeTestSignal()
+    {
+        AudioBuffer<T> buffer (2, numTestSamples);
+        for (int n = 0; n < numTestSamples; ++n)
+        {
+            const auto t = (double) n / testSampleRate;
+            const auto left = 2.0 * (0.8 * std::sin (MathConstants<double>::twoPi * 110.0 * t) * std::sin (MathConstants<double>::twoPi * t) + 0.2 * std::sin (MathConstants<double>::twoPi * 1234.5 * t));
+            const auto right = 1.5 * std::sin (MathConstants<double>::twoPi * 220.0 * t);
+            buffer.setSample (0, n, (T) left);
+            buffer.setSample (1, n, (T) right);
+        }
+
+        return buffer;
+    }
+
+    void solverTest (FloatProcessor::Solver solver, float drive, float width, float sat, float maxErrorDB)
+    {
+        ReferenceProcessor reference;
+        reference.reset();
+        reference.setSampleRate (testSampleRate);
+        reference.setParameters (drive, width, sat);
+
+        FloatProcessor proc;
+        proc.reset();
+        proc.setSampleRate (testSampleRate);
+        proc.setParameters (drive, width, sat);
+        proc.setSolver (solver);
+
+        auto referenceBuffer = makeTestSignal<double>();
+        reference.processBlock (referenceBuffer.getWritePointer (0), referenceBuffer.getWritePointer (1), numTestSamples);
+
+        auto buffer = makeTestSignal<float>();
+        proc.processBlock (buffer);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            double errorEnergy = 0.0;
+            double referenceEnergy = 0.0;
+            for (int n = 0; n < numTestSamples; ++n)
+            {
+                const auto expected = referenceBuffer.getSample (ch, n);
+                const auto error = (double) buffer.getSample (ch, n) - expected;
+                errorEnergy += error * error;
+                referenceEnergy += expected * expected;
+            }
+
+            const auto errorDB = 10.0 * std::log10 (errorEnergy / referenceEnergy + 1.0e-30);
+            expectLessThan (errorDB, (double) maxErrorDB, "Output is too far from the reference solver on channel " + String (ch));
+        }
+    }
+
+    void runTest() override
+    {
+        for (auto drive : { 0.1f, 0.5f, 0.9f })
+        {
+            for (auto sat : { 0.1f, 0.9f })
+            {
+                const auto paramString = "drive = " + String (drive) + ", sat = " + String (sat);
+
+                beginTest ("Newton-Raphson Test, " + paramString);
+                solverTest (FloatProcessor::Solver::NewtonRaphson, drive, 0.5f, sat, -50.0f);
+
+                beginTest ("Runge-Kutta Test, " + paramString);
+                solverTest (FloatProcessor::Solver::RungeKutta2, drive, 0.5f, sat, -45.0f);
+            }
+        }
+    }
+};
+
+static HysteresisTest hysteresisTest;
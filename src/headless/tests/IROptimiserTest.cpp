@@ -0,0 +1,86 @@
+#include "UnitTests.h"
+#include "processors/tone/ir_utils/IROptimiser.h"
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+} // namespace
+
+/** Checks that the IR optimiser shortens IRs, without changing their frequency response too much. */
+class IROptimiserTest : public UnitTest
+{
+public:
+    IROptimiserTest() : UnitTest ("IR Optimiser Test")
+    {
+    }
+
+    /** Noise with an exponential decay, which is roughly what the tail of a cab IR looks like. */
+    static AudioBuffer<float> makeDecayingNoise (int numChannels, int numSamples, float decayTimeSeconds)
+    {
+        Random rand { 0x1234 };
+        AudioBuffer<float> ir (numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* h = ir.getWritePointer (ch);
+            for (int n = 0; n < numSamples; ++n)
+                h[n] = (rand.nextFloat() * 2.0f - 1.0f) * std::exp (-(float) n / (decayTimeSeconds * (float) sampleRate));
+        }
+
+        return ir;
+    }
+
+    void minimumPhaseTest()
+    {
+        // a delayed impulse, with an echo: the minimum-phase version should start right away
+        AudioBuffer<float> ir (1, 256);
+        ir.clear();
+        ir.setSample (0, 50, 1.0f);
+        ir.setSample (0, 100, 0.5f);
+
+        const auto minPhaseIR = IROptimiser::makeMinimumPhase (ir);
+        expectWithinAbsoluteError (minPhaseIR.getSample (0, 0), 1.0f, 0.01f, "Minimum-phase IR should start with the impulse!");
+        expectWithinAbsoluteError (minPhaseIR.getSample (0, 50), 0.5f, 0.01f, "Minimum-phase IR should keep the echo!");
+        expectLessThan (IROptimiser::getSpectralErrorDB (ir, minPhaseIR, sampleRate), 0.1f, "Minimum-phase IR should have the same magnitude response!");
+    }
+
+    void truncationTest (int numChannels)
+    {
+        const auto ir = makeDecayingNoise (numChannels, (int) sampleRate, 0.02f);
+        const auto result = IROptimiser::optimise (ir, sampleRate);
+
+        expectEquals (result.originalLength, ir.getNumSamples(), "Incorrect original length!");
+        expectEquals (result.optimisedLength, result.ir.getNumSamples(), "Incorrect optimised length!");
+        expectEquals (result.ir.getNumChannels(), numChannels, "Incorrect number of channels!");
+        expectGreaterThan (result.getTapReduction(), 0.5f, "IR should be much shorter after optimisation!");
+        expectLessThan (result.spectralErrorDB, 1.0f, "Optimised IR sounds too different!");
+    }
+
+    void maxErrorTest()
+    {
+        const auto ir = makeDecayingNoise (1, (int) sampleRate / 2, 0.02f);
+
+        IROptimiser::Settings settings;
+        settings.maxSpectralErrorDB = 0.5f;
+        const auto result = IROptimiser::optimise (ir, sampleRate, settings);
+
+        expectLessThan (result.optimisedLength, result.originalLength, "IR should be shorter after optimisation!");
+        expectLessOrEqual (result.spectralErrorDB, settings.maxSpectralErrorDB, "Spectral error is above the maximum!");
+    }
+
+    void runTest() override
+    {
+        beginTest ("Minimum Phase Test");
+        minimumPhaseTest();
+
+        beginTest ("Truncation Test, Mono");
+        truncationTest (1);
+
+        beginTest ("Truncation Test, Stereo");
+        truncationTest (2);
+
+        beginTest ("Max Error Test");
+        maxErrorTest();
+    }
+};
+
+static IROptimiserTest irOptimiserTest;
@@ -1,4 +1,5 @@
 #include "UnitTests.h"
+#include "state/presets/PresetManager.h"
 
 namespace
 {
@@ -54,10 +55,128 @@ public:
         std::cout << "Processed " << bufferCount << " buffers while loading presets" << std::endl;
     }
 
+    void presetReloadTest()
+    {
+        BYOD plugin;
+        plugin.prepareToPlay (sampleRateToUse, blockSize);
+
+        auto& chain = plugin.getProcChain();
+        const auto getProcessors = [&chain]
+        { return std::vector<const BaseProcessor*> { chain.getProcessors().begin(), chain.getProcessors().end() }; };
+
+        int numPrograms = plugin.getNumPrograms();
+        for (int i = 0; i < numPrograms; ++i)
+        {
+            plugin.setCurrentProgram (i);
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+
+            const auto procsBeforeReload = getProcessors();
+            const auto chainState = chain.getStateHelper().saveProcChain();
+            chain.getStateHelper().loadProcChain (chainState.get(), chowdsp::Version { JucePlugin_VersionString }, true);
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+
+            expect (getProcessors() == procsBeforeReload, "Processors were not re-used when re-loading preset: " + plugin.getProgramName (i));
+            expect (chain.getStateHelper().saveProcChain()->isEquivalentTo (chainState.get(), false), "State changed when re-loading preset: " + plugin.getProgramName (i));
+        }
+    }
+
+    void stateLoadUndoTest()
+    {
+        BYOD plugin;
+        plugin.prepareToPlay (sampleRateToUse, blockSize);
+
+        auto& chain = plugin.getProcChain();
+        auto* undoManager = plugin.getVTS().undoManager;
+
+        int numPrograms = plugin.getNumPrograms();
+        for (int i = 0; i + 1 < numPrograms; ++i)
+        {
+            plugin.setCurrentProgram (i + 1);
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+            const auto nextState = chain.getStateHelper().saveProcChain();
+
+            plugin.setCurrentProgram (i);
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+            const auto chainState = chain.getStateHelper().saveProcChain();
+
+            chain.getStateHelper().loadProcChain (nextState.get(), chowdsp::Version { JucePlugin_VersionString });
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+            expect (undoManager->undo(), "Unable to undo loading state over preset: " + plugin.getProgramName (i));
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+
+            expect (chain.getStateHelper().saveProcChain()->isEquivalentTo (chainState.get(), false), "State was not restored by undo for preset: " + plugin.getProgramName (i));
+        }
+    }
+
+    void setlistTest()
+    {
+        BYOD plugin;
+        plugin.prepareToPlay (sampleRateToUse, blockSize);
+
+        auto& chain = plugin.getProcChain();
+        auto& presetManager = dynamic_cast<PresetManager&> (plugin.getPresetManager());
+        auto& setlist = presetManager.getSetlist();
+
+        std::vector<chowdsp::Preset> setlistPresets;
+        for (const auto& [_, preset] : presetManager.getPresetMap())
+        {
+            setlistPresets.push_back (preset);
+            if (setlistPresets.size() == 4)
+                break;
+        }
+
+        setlist.setNumStandbyPresets (2);
+        setlist.setPresets (std::move (setlistPresets));
+        setlist.loadPresetAtIndex (0);
+
+        const auto waitForStandbyBoard = [&setlist] (int index, int timeoutMs = 10000)
+        {
+            for (int waitedMs = 0; waitedMs < timeoutMs && ! setlist.isStandbyBoardReady (index); waitedMs += 50)
+                MessageManager::getInstance()->runDispatchLoopUntil (50);
+            return setlist.isStandbyBoardReady (index);
+        };
+
+        for (int index = 1; index < (int) setlist.getPresets().size(); ++index)
+        {
+            const auto& preset = setlist.getPresets()[(size_t) index];
+            expect (waitForStandbyBoard (index), "Standby board was not built for preset: " + preset.getName());
+
+            setlist.loadPresetAtIndex (index);
+            expectEquals (presetManager.getCurrentPreset()->getName(), preset.getName(), "Current preset is incorrect!");
+
+            StringArray expectedProcNames;
+            for (auto* procXml : preset.getState()->getChildIterator())
+            {
+                const auto procName = procXml->getTagName().replaceCharacter ('_', ' ');
+                if (procName != chain.getInputProcessor().getName() && procName != chain.getOutputProcessor().getName())
+                    expectedProcNames.add (procName);
+            }
+
+            StringArray procNames;
+            for (auto* proc : chain.getProcessors())
+                procNames.add (proc->getName());
+            expect (procNames == expectedProcNames, "Incorrect processors after switching to preset: " + preset.getName());
+        }
+
+        // with no memory budget, there should be no standby boards
+        setlist.setMemoryBudget (0);
+        setlist.loadPresetAtIndex (0);
+        expect (! waitForStandbyBoard (1, 1000), "Standby board was built without any memory budget!");
+    }
+
     void runTest() override
     {
         beginTest ("Presets Test");
         presetsTest();
+
+        beginTest ("Preset Reload Test");
+        presetReloadTest();
+
+        beginTest ("State Load Undo Test");
+        stateLoadUndoTest();
+
+        beginTest ("Preset Setlist Test");
+        setlistTest();
     }
 };
 
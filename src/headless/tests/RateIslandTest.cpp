@@ -0,0 +1,159 @@
+#include "UnitTests.h"
+#include "processors/chain/ProcessorChainSchedule.h"
+#include "processors/chain/RateIslandResampler.h"
+
+namespace
+{
+constexpr double baseSampleRate = 48000.0;
+constexpr int osFactor = 4;
+constexpr int baseBlockSize = 512;
+constexpr float testFreq = 1000.0f;
+} // namespace
+
+/** Checks that linear processors are grouped into rate islands, and that the island resampling is transparent. */
+class RateIslandTest : public UnitTest
+{
+public:
+    RateIslandTest() : UnitTest ("Rate Island Test")
+    {
+    }
+
+    static void fillSine (AudioBuffer<float>& buffer, int startSample, double sampleRate)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* x = buffer.getWritePointer (ch);
+            for (int n = 0; n < buffer.getNumSamples(); ++n)
+                x[n] = std::sin (MathConstants<float>::twoPi * testFreq * float ((double) (startSample + n) / sampleRate));
+        }
+    }
+
+    void resamplerTest()
+    {
+        RateIslandResampler resampler;
+        resampler.prepare (osFactor, baseBlockSize * osFactor);
+
+        constexpr int numBlocks = 20;
+        AudioBuffer<float> buffer (2, baseBlockSize * osFactor);
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            fillSine (buffer, i * buffer.getNumSamples(), baseSampleRate * osFactor);
+
+            const auto& islandBuffer = resampler.processIn (buffer);
+            expectEquals (islandBuffer.getNumSamples(), baseBlockSize, "Incorrect island block size!");
+
+            const auto& outBuffer = resampler.processOut (islandBuffer);
+            expectEquals (outBuffer.getNumSamples(), buffer.getNumSamples(), "Incorrect output block size!");
+
+            if (i == numBlocks - 1)
+            {
+                const auto outMagnitude = outBuffer.getMagnitude (0, outBuffer.getNumSamples());
+                expectWithinAbsoluteError (outMagnitude, 1.0f, 0.01f, "Resampling changed the signal level!");
+            }
+        }
+    }
+
+    void islandGroupingTest()
+    {
+        InputProcessor inputProc;
+        OutputProcessor outputProc;
+
+        auto eq = ProcessorStore::getStoreMap().at ("Graphic EQ") (nullptr);
+        auto highCut = ProcessorStore::getStoreMap().at ("High Cut") (nullptr);
+        auto drive = ProcessorStore::getStoreMap().at ("Tube Screamer") (nullptr);
+        auto cab = ProcessorStore::getStoreMap().at ("Amp IRs") (nullptr);
+
+        for (auto* proc : std::initializer_list<BaseProcessor*> { &inputProc, &outputProc, eq.get(), highCut.get(), drive.get(), cab.get() })
+            proc->prepareProcessing (baseSampleRate * osFactor, baseBlockSize * osFactor, osFactor);
+
+        expectEquals (eq->getRateDivisor(), osFactor, "Linear processor should run at the base rate!");
+        expectEquals (drive->getRateDivisor(), 1, "Nonlinear processor should run at the chain's rate!");
+
+        // input -> EQ -> high cut -> drive -> cab -> output
+        inputProc.addConnection ({ &inputProc, 0, eq.get(), 0 });
+        eq->addConnection ({ eq.get(), 0, highCut.get(), 0 });
+        highCut->addConnection ({ highCut.get(), 0, drive.get(), 0 });
+        drive->addConnection ({ drive.get(), 0, cab.get(), 0 });
+        cab->addConnection ({ cab.get(), 0, &outputProc, 0 });
+
+        OwnedArray<BaseProcessor> procs;
+        for (auto* proc : { eq.get(), highCut.get(), drive.get(), cab.get() })
+            procs.add (proc);
+
+        ProcessorChainSchedule schedule;
+        schedule.compile (inputProc, outputProc, procs, baseBlockSize * osFactor);
+        expectEquals (schedule.getNumRateIslands(), 2, "EQ and high cut should share an island, with the cab in another!");
+
+        AudioBuffer<float> buffer (2, baseBlockSize * osFactor);
+        fillSine (buffer, 0, baseSampleRate * osFactor);
+        expect (schedule.process (buffer), "Schedule did not reach the output!");
+
+        auto* outBuffer = outputProc.getOutputBuffer();
+        expect (outBuffer != nullptr, "Output buffer is null!");
+        expectEquals (outBuffer->getNumSamples(), baseBlockSize * osFactor, "Output is at the wrong sample rate!");
+
+        // the processors are owned by the unique_ptrs
+        procs.clear (false);
+    }
+
+    void fanOutTest()
+    {
+        InputProcessor inputProc;
+        OutputProcessor outputProc;
+
+        auto eq = ProcessorStore::getStoreMap().at ("Graphic EQ") (nullptr);
+        auto highCut = ProcessorStore::getStoreMap().at ("High Cut") (nullptr);
+        auto drive = ProcessorStore::getStoreMap().at ("Tube Screamer") (nullptr);
+        auto mixer = ProcessorStore::getStoreMap().at ("Mixer") (nullptr);
+
+        for (auto* proc : std::initializer_list<BaseProcessor*> { &inputProc, &outputProc, eq.get(), highCut.get(), drive.get(), mixer.get() })
+            proc->prepareProcessing (baseSampleRate * osFactor, baseBlockSize * osFactor, osFactor);
+
+        // input -> EQ -> high cut -> mixer -> output
+        //             -> drive    ->
+        inputProc.addConnection ({ &inputProc, 0, eq.get(), 0 });
+        eq->addConnection ({ eq.get(), 0, highCut.get(), 0 });
+        eq->addConnection ({ eq.get(), 0, drive.get(), 0 });
+        highCut->addConnection ({ highCut.get(), 0, mixer.get(), 0 });
+        drive->addConnection ({ drive.get(), 0, mixer.get(), 1 });
+        mixer->addConnection ({ mixer.get(), 0, &outputProc, 0 });
+
+        OwnedArray<BaseProcessor> procs;
+        for (auto* proc : { eq.get(), highCut.get(), drive.get(), mixer.get() })
+            procs.add (proc);
+
+        ProcessorChainSchedule schedule;
+        schedule.compile (inputProc, outputProc, procs, baseBlockSize * osFactor);
+        expectEquals (schedule.getNumRateIslands(), 2, "The drive needs the EQ output at the chain's rate, so the high cut can't join the EQ's island!");
+
+        constexpr int numBlocks = 20;
+        AudioBuffer<float> buffer (2, baseBlockSize * osFactor);
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            fillSine (buffer, i * buffer.getNumSamples(), baseSampleRate * osFactor);
+            expect (schedule.process (buffer), "Schedule did not reach the output!");
+        }
+
+        auto* outBuffer = outputProc.getOutputBuffer();
+        expect (outBuffer != nullptr, "Output buffer is null!");
+        expectEquals (outBuffer->getNumSamples(), baseBlockSize * osFactor, "Output is at the wrong sample rate!");
+        expectGreaterThan (outBuffer->getMagnitude (0, outBuffer->getNumSamples()), 0.1f, "Output should not be silent!");
+
+        // the processors are owned by the unique_ptrs
+        procs.clear (false);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Resampler Test");
+        resamplerTest();
+
+        beginTest ("Island Grouping Test");
+        islandGroupingTest();
+
+        beginTest ("Fan-Out Test");
+        fanOutTest();
+    }
+};
+
+static RateIslandTest rateIslandTest;
@@ -0,0 +1,155 @@
+#include "processors/SharedAssetCache.h"
+#include "processors/drive/neural_utils/BinaryModelData.h"
+
+/** Checks that assets are shared while they're in use, and freed once they're not. */
+class SharedAssetCacheTest : public UnitTest
+{
+public:
+    SharedAssetCacheTest() : UnitTest ("Shared Asset Cache Test")
+    {
+    }
+
+    void sharingTest()
+    {
+        SharedAssetCache cache;
+        int numCreated = 0;
+        const auto createAsset = [&numCreated]
+        {
+            numCreated++;
+            return std::make_unique<std::vector<float>> (16, 1.0f);
+        };
+
+        auto asset1 = cache.getOrCreate<std::vector<float>> ("test_asset", createAsset);
+        auto asset2 = cache.getOrCreate<std::vector<float>> ("test_asset", createAsset);
+        expect (asset1 == asset2, "Asset was not shared!");
+        expectEquals (numCreated, 1, "Asset was created more than once!");
+
+        auto otherAsset = cache.getOrCreate<std::vector<float>> ("other_asset", createAsset);
+        expect (otherAsset != asset1, "Assets with different IDs were shared!");
+        expectEquals (cache.getNumAssets(), 2, "Incorrect number of assets!");
+    }
+
+    void lifetimeTest()
+    {
+        SharedAssetCache cache;
+        int numCreated = 0;
+        const auto createAsset = [&numCreated]
+        {
+            numCreated++;
+            return std::make_unique<int> (numCreated);
+        };
+
+        std::weak_ptr<const int> weakAsset = cache.getOrCreate<int> ("test_asset", createAsset);
+        expect (weakAsset.expired(), "Asset was kept alive by the cache!");
+        expectEquals (cache.getNumAssets(), 0, "Cache still has an asset that isn't being used!");
+
+        auto asset = cache.getOrCreate<int> ("test_asset", createAsset);
+        expectEquals (*asset, 2, "Asset was not re-created!");
+    }
+
+    void embeddedModelTest()
+    {
+        SharedAssetCache cache;
+        auto weights1 = cache.getEmbeddedModel (BinaryData::centaur_0_bnnm, BinaryData::centaur_0_bnnmSize);
+        auto weights2 = cache.getEmbeddedModel (BinaryData::centaur_0_bnnm, BinaryData::centaur_0_bnnmSize);
+        expect (weights1 == weights2, "Model weights were loaded twice!");
+        expect (weights1->getTensor ("/layers/0/weights/0").isValid(), "Model weights were not loaded correctly!");
+    }
+
+    void preparedIRTest()
+    {
+        SharedAssetCache cache;
+        int irDataSize;
+        auto* irData = BinaryData::getNamedResource ("Fender_wav", irDataSize);
+        auto sourceIR = cache.getEmbeddedIR (irData, irDataSize);
+        expect (sourceIR != nullptr, "IR was not decoded!");
+
+        auto preparedIR1 = cache.getPreparedIR (sourceIR, 48000.0);
+        auto preparedIR2 = cache.getPreparedIR (sourceIR, 48000.0);
+        expect (preparedIR1 == preparedIR2, "IR was prepared twice!");
+        expectEquals (preparedIR1->sampleRate, 48000.0, "IR was not resampled!");
+        expect (preparedIR1->buffer.getNumSamples() <= sourceIR->buffer.getNumSamples() * 48000.0 / sourceIR->sampleRate + 1, "Resampled IR is too long!");
+
+        auto otherRateIR = cache.getPreparedIR (sourceIR, 96000.0);
+        expect (otherRateIR != preparedIR1, "IRs for different sample rates were shared!");
+
+        // the same file contents should only be decoded once
+        const MemoryBlock fileData { irData, (size_t) irDataSize };
+        auto fileIR1 = cache.getIRFromFileData (fileData);
+        auto fileIR2 = cache.getIRFromFileData (MemoryBlock { fileData });
+        expect (fileIR1 != nullptr && fileIR1 == fileIR2, "IR file was decoded twice!");
+        expect (cache.getIRFromFileData (MemoryBlock { "not an IR", 9 }) == nullptr, "Invalid IR file was decoded!");
+    }
+
+    void diskCacheTest()
+    {
+        const auto cacheDirectory = File::createTempFile ("ir_cache");
+        int irDataSize;
+        auto* irData = BinaryData::getNamedResource ("Fender_wav", irDataSize);
+        const MemoryBlock fileData { irData, (size_t) irDataSize };
+
+        AudioBuffer<float> preparedBuffer;
+        {
+            SharedAssetCache cache;
+            auto preparedIR = cache.getPreparedIR (cache.getIRFromFileData (fileData), 44100.0, cacheDirectory);
+            preparedBuffer.makeCopyOf (preparedIR->buffer);
+        }
+        expectEquals (cacheDirectory.getNumberOfChildFiles (File::findFiles), 1, "Prepared IR was not cached on disk!");
+
+        {
+            SharedAssetCache cache;
+            auto preparedIR = cache.getPreparedIR (cache.getIRFromFileData (fileData), 44100.0, cacheDirectory);
+            expectEquals (preparedIR->buffer.getNumSamples(), preparedBuffer.getNumSamples(), "Cached IR has the wrong length!");
+            for (int ch = 0; ch < preparedBuffer.getNumChannels(); ++ch)
+                for (int n = 0; n < preparedBuffer.getNumSamples(); ++n)
+                    expectEquals (preparedIR->buffer.getSample (ch, n), preparedBuffer.getSample (ch, n), "Cached IR is incorrect!");
+        }
+
+        cacheDirectory.deleteRecursively();
+    }
+
+    void diskCacheTrimTest()
+    {
+        const auto cacheDirectory = File::createTempFile ("trim_cache");
+        cacheDirectory.createDirectory();
+
+        const MemoryBlock fileData { 1000, true };
+        const auto now = Time::getCurrentTime();
+        for (int i = 0; i < 5; ++i)
+        {
+            const auto cacheFile = cacheDirectory.getChildFile ("file" + String (i));
+            cacheFile.replaceWithData (fileData.getData(), fileData.getSize());
+            cacheFile.setLastModificationTime (now - RelativeTime::minutes (i)); // file0 is the most recently used
+        }
+
+        SharedAssetCache::trimDiskCache (cacheDirectory, 3500);
+        expectEquals (cacheDirectory.getNumberOfChildFiles (File::findFiles), 3, "Cache was not trimmed to size!");
+        for (int i = 0; i < 5; ++i)
+            expectEquals (cacheDirectory.getChildFile ("file" + String (i)).existsAsFile(), i < 3, "Wrong file was trimmed from the cache!");
+
+        cacheDirectory.deleteRecursively();
+    }
+
+    void runTest() override
+    {
+        beginTest ("Sharing Test");
+        sharingTest();
+
+        beginTest ("Lifetime Test");
+        lifetimeTest();
+
+        beginTest ("Embedded Model Test");
+        embeddedModelTest();
+
+        beginTest ("Prepared IR Test");
+        preparedIRTest();
+
+        beginTest ("Disk Cache Test");
+        diskCacheTest();
+
+        beginTest ("Disk Cache Trim Test");
+        diskCacheTrimTest();
+    }
+};
+
+static SharedAssetCacheTest sharedAssetCacheTest;
@@ -0,0 +1,111 @@
+#include "processors/ProcessorStateWarmer.h"
+
+namespace
+{
+constexpr int timeoutMs = 2000;
+} // namespace
+
+/** Checks that warmed-up states are handed over to the audio thread. */
+class StateWarmerTest : public UnitTest
+{
+public:
+    StateWarmerTest() : UnitTest ("State Warmer Test")
+    {
+    }
+
+    struct TestState
+    {
+        int numWarmUps = 0;
+        double sampleRate = 0.0;
+    };
+
+    void warmUpNowTest()
+    {
+        TimeSliceThread thread { "Warm-Up Test Thread" };
+        std::atomic_int numWarmUps { 0 };
+        ProcessorStateWarmer<TestState> warmer { thread, [&numWarmUps] (TestState& state, double sampleRate, int)
+                                                 {
+                                                     state.numWarmUps = ++numWarmUps;
+                                                     state.sampleRate = sampleRate;
+                                                 } };
+
+        warmer.warmUpNow (44100.0, 512);
+        expectEquals (warmer.getStateForBlock().numWarmUps, 1, "State was not warmed up!");
+        expectEquals (warmer.getStateForBlock().sampleRate, 44100.0, "State was warmed up at the wrong sample rate!");
+    }
+
+    void backgroundWarmUpTest()
+    {
+        TimeSliceThread thread { "Warm-Up Test Thread" };
+        thread.startThread();
+
+        std::atomic_int numWarmUps { 0 };
+        ProcessorStateWarmer<TestState> warmer { thread, [&numWarmUps] (TestState& state, double sampleRate, int)
+                                                 {
+                                                     state.numWarmUps = ++numWarmUps;
+                                                     state.sampleRate = sampleRate;
+                                                 } };
+
+        warmer.warmUpNow (48000.0, 512);
+        warmer.requestWarmUp();
+        expectEquals (warmer.getActiveState().numWarmUps, 1, "Background warm-up should not change the active state!");
+
+        const auto startTime = Time::getMillisecondCounter();
+        while (warmer.getStateForBlock().numWarmUps < 2 && Time::getMillisecondCounter() - startTime < (uint32) timeoutMs)
+            Thread::sleep (1);
+
+        expectEquals (warmer.getActiveState().numWarmUps, 2, "Warmed-up state was never handed over!");
+        expectEquals (warmer.getActiveState().sampleRate, 48000.0, "State was warmed up at the wrong sample rate!");
+    }
+
+    void previousStateTest()
+    {
+        TimeSliceThread thread { "Warm-Up Test Thread" };
+        thread.startThread();
+
+        std::atomic_int numWarmUps { 0 };
+        ProcessorStateWarmer<TestState> warmer {
+            thread,
+            [&numWarmUps] (TestState& state, double sampleRate, int)
+            {
+                state.numWarmUps = ++numWarmUps;
+                state.sampleRate = sampleRate;
+            },
+            true
+        };
+
+        warmer.warmUpNow (48000.0, 512);
+        expect (warmer.getPreviousState() == nullptr, "There should be no previous state after warming up now!");
+
+        warmer.requestWarmUp();
+        const auto startTime = Time::getMillisecondCounter();
+        while (warmer.getStateForBlock().numWarmUps < 2 && Time::getMillisecondCounter() - startTime < (uint32) timeoutMs)
+            Thread::sleep (1);
+
+        expectEquals (warmer.getActiveState().numWarmUps, 2, "Warmed-up state was never handed over!");
+        expect (warmer.getPreviousState() != nullptr, "Previous state was not kept!");
+        expectEquals (warmer.getPreviousState()->numWarmUps, 1, "Incorrect previous state!");
+
+        // no new state should be swapped in while the previous state is still in use
+        warmer.requestWarmUp();
+        Thread::sleep (100);
+        expectEquals (warmer.getStateForBlock().numWarmUps, 2, "New state was swapped in before the previous state was released!");
+
+        warmer.releasePreviousState();
+        expect (warmer.getPreviousState() == nullptr, "Previous state was not released!");
+    }
+
+    void runTest() override
+    {
+        beginTest ("Warm Up Now Test");
+        warmUpNowTest();
+
+        beginTest ("Background Warm Up Test");
+        backgroundWarmUpTest();
+
+        beginTest ("Previous State Test");
+        previousStateTest();
+    }
+};
+
+static StateWarmerTest stateWarmerTest;
@@ -192,11 +192,88 @@ public:
         expectLessThan (rightMinMax.getStart(), -0.4f, "Right channel minimum should be < 0!");
     }
 
+    void monoWideningTest()
+    {
+        BYOD plugin;
+        auto* undoManager = plugin.getVTS().undoManager;
+        auto& chain = plugin.getProcChain();
+        auto& actionHelper = chain.getActionHelper();
+
+        plugin.prepareToPlay (sampleRate, blockSize);
+
+        auto& mergerFactory = ProcessorStore::getStoreMap().at ("Stereo Merger");
+        actionHelper.addProcessor (mergerFactory (undoManager));
+
+        auto* input = &chain.getInputProcessor();
+        auto* merger = chain.getProcessors()[0];
+        auto* output = &chain.getOutputProcessor();
+
+        // the mono input only goes to the left side of the merger
+        actionHelper.removeConnection ({ input, 0, output, 0 });
+        actionHelper.addConnection ({ input, 0, merger, 0 });
+        actionHelper.addConnection ({ merger, 0, output, 0 });
+
+        // set to mono
+        plugin.getVTS().getParameter ("mono_mode")->setValueNotifyingHost (0.0f);
+        MessageManager::getInstance()->runDispatchLoopUntil (100);
+
+        AudioBuffer<float> buffer (2, blockSize);
+        buffer.clear();
+        chain.processAudio (buffer);
+
+        FloatVectorOperations::fill (buffer.getWritePointer (0), 1.0f, blockSize);
+        FloatVectorOperations::fill (buffer.getWritePointer (1), 1.0f, blockSize);
+        chain.processAudio (buffer);
+
+        auto leftMinMax = FloatVectorOperations::findMinAndMax (buffer.getReadPointer (0) + blockSize / 2, blockSize / 2);
+        auto rightMagnitude = buffer.getMagnitude (1, blockSize / 2, blockSize / 2);
+
+        expectGreaterThan (leftMinMax.getStart(), 0.4f, "Left channel minimum should be > 0!");
+        expectLessThan (rightMagnitude, 0.01f, "Right channel should be silent, since the chain made the mono input stereo!");
+    }
+
+    void monoToStereoSwitchTest()
+    {
+        BYOD plugin;
+        auto& chain = plugin.getProcChain();
+
+        plugin.prepareToPlay (sampleRate, blockSize);
+
+        // fully dry, so that the output is just the delayed dry signal
+        plugin.getVTS().getParameter ("dry_wet")->setValueNotifyingHost (0.0f);
+        plugin.getVTS().getParameter ("mono_mode")->setValueNotifyingHost (0.35f); // stereo
+        MessageManager::getInstance()->runDispatchLoopUntil (100);
+
+        AudioBuffer<float> buffer (2, blockSize);
+        for (int i = 0; i < 2; ++i)
+        {
+            buffer.clear();
+            FloatVectorOperations::fill (buffer.getWritePointer (1), 1.0f, blockSize);
+            chain.processAudio (buffer);
+        }
+
+        // only the left channel gets processed, so the right channel's state is left behind
+        plugin.getVTS().getParameter ("mono_mode")->setValueNotifyingHost (0.7f); // left
+        MessageManager::getInstance()->runDispatchLoopUntil (100);
+        buffer.clear();
+        chain.processAudio (buffer);
+
+        plugin.getVTS().getParameter ("mono_mode")->setValueNotifyingHost (0.35f); // stereo
+        MessageManager::getInstance()->runDispatchLoopUntil (100);
+        buffer.clear();
+        chain.processAudio (buffer);
+
+        expectLessThan (buffer.getMagnitude (1, 0, blockSize), 1.0e-3f, "Right channel should be silent after switching back to stereo!");
+    }
+
     void runTest() override
     {
         beginTest ("Mono Input Test");
         monoInputTest();
 
+        beginTest ("Mono Widening Test");
+        monoWideningTest();
+
         beginTest ("Stereo Input Test (in order)");
         stereoInputTest (true);
 
@@ -208,6 +285,9 @@ public:
 
         beginTest ("Right Channel Test");
         rightChannelTest();
+
+        beginTest ("Mono To Stereo Switch Test");
+        monoToStereoSwitchTest();
     }
 };
 
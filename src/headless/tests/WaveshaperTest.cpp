@@ -43,10 +43,55 @@ public:
         }
     }
 
+    void statelessBlockTest (int numChannels, int shapeIndex)
+    {
+        // odd block size, so that the leftover samples get processed as well
+        constexpr int blockSize = 1021;
+
+        Waveshaper waveshaper;
+        waveshaper.getVTS().getParameter ("shape")->setValueNotifyingHost ((float) shapeIndex / (float) (n_ws_types - 1));
+        waveshaper.getVTS().getParameter ("drive")->setValueNotifyingHost (0.5f);
+        waveshaper.prepare (sampleRate, blockSize);
+
+        AudioBuffer<float> buffer (numChannels, blockSize);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int n = 0; n < blockSize; ++n)
+                buffer.setSample (ch, n, rand.nextFloat() * 2.0f - 1.0f);
+        }
+        AudioBuffer<float> refBuffer;
+        refBuffer.makeCopyOf (buffer);
+
+        waveshaper.processAudio (buffer);
+
+        QuadFilterWaveshaperState wss {};
+        const auto drive = Vec4 (Decibels::decibelsToGain (waveshaper.getVTS().getRawParameterValue ("drive")->load()));
+        auto wsptr = GetQFPtrWaveshaper (shapeIndex);
+        alignas (Vec4::arch_type::alignment()) float expected[Vec4::size];
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int n = 0; n < blockSize; ++n)
+            {
+                wsptr (&wss, Vec4 (refBuffer.getSample (ch, n)), drive).store_aligned (expected);
+                expectWithinAbsoluteError (buffer.getSample (ch, n), expected[0], 1.0e-6f, "Block processing output is incorrect!");
+            }
+        }
+    }
+
     void runTest() override
     {
         rand = getRandom();
 
+        for (int shapeIdx = 0; shapeIdx < ws_type::n_ws_types; ++shapeIdx)
+        {
+            if (! IsStatelessWaveshaper (shapeIdx))
+                continue;
+
+            beginTest (String (wst_names[shapeIdx]) + " Block Processing");
+            statelessBlockTest (1, shapeIdx);
+            statelessBlockTest (2, shapeIdx);
+        }
+
         for (int shapeIdx = 0; shapeIdx < ws_type::n_ws_types; ++shapeIdx)
         {
             beginTest (String (wst_names[shapeIdx]));
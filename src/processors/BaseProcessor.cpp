@@ -15,21 +15,55 @@ BaseProcessor::BaseProcessor (const String& name,
     outputBuffers.fill (nullptr);
     outputConnections.resize (numOutputs);
 
-    inputBuffers.resize (numInputs);
+    inputBufferViews.resize (numInputs);
+    inputBufferViews.fill (nullptr);
     inputsConnected.resize (0);
     portMagnitudes.resize (numInputs);
 }
 
-void BaseProcessor::prepareProcessing (double sampleRate, int numSamples)
+int BaseProcessor::computeRateDivisor (double sampleRate, int chainOSFactor)
 {
-    prepare (sampleRate, numSamples);
+    // the schedule can only resample processors with one audio input and one audio output
+    if (chainOSFactor <= 1 || numInputs != 1 || numOutputs != 1 || isInputModulationPort (0) || isOutputModulationPort (0))
+        return 1;
 
-    for (auto& b : inputBuffers)
+    const auto preferredRate = getPreferredProcessingRate();
+    auto osFactor = chainOSFactor;
+    switch (preferredRate.type)
     {
-        b.setSize (2, numSamples);
-        b.clear();
+        case ProcessingRate::Type::ChainRate:
+            break;
+
+        case ProcessingRate::Type::BaseRate:
+            osFactor = 1;
+            break;
+
+        case ProcessingRate::Type::FixedFactor:
+            osFactor = jmin (chainOSFactor, nextPowerOfTwo (jmax (1, preferredRate.osFactor)));
+            break;
+
+        case ProcessingRate::Type::ModelRate:
+        {
+            const auto baseSampleRate = sampleRate / (double) chainOSFactor;
+            osFactor = 1;
+            while (osFactor < chainOSFactor && baseSampleRate * (double) osFactor < preferredRate.modelSampleRate)
+                osFactor *= 2;
+            break;
+        }
     }
 
+    return chainOSFactor / osFactor;
+}
+
+void BaseProcessor::prepareProcessing (double sampleRate, int numSamples, int chainOSFactor)
+{
+    rateDivisor = computeRateDivisor (sampleRate, chainOSFactor);
+    sampleRate /= (double) rateDivisor;
+    numSamples /= rateDivisor;
+
+    prepare (sampleRate, numSamples);
+    profiler.prepare (sampleRate);
+
     for (auto& mag : portMagnitudes)
     {
         mag.smoother.prepare ({ sampleRate, (uint32) numSamples, 1 });
@@ -67,10 +101,14 @@ void BaseProcessor::processAudioBlock (AudioBuffer<float>& buffer)
         else if (numInputs > 1)
         {
             for (int i = 0; i < numInputs; ++i)
-                updateBufferMag (getInputBuffer (i), i);
+            {
+                if (isInputConnected (i))
+                    updateBufferMag (getInputBuffer (i), i);
+            }
         }
     }
 
+    ProcessorProfiler::ScopedBlockTimer profilerTimer { profiler, buffer.getNumSamples() };
     if (isBypassed())
         processAudioBypassed (buffer);
     else
@@ -154,13 +192,21 @@ void BaseProcessor::removeConnection (const ConnectionInfo& info)
         {
             connections.remove (cIdx);
             info.endProc->inputsConnected.removeFirstMatchingValue (info.endPort);
-            info.endProc->inputBuffers[info.endPort].clear();
             info.endProc->inputConnectionChanged (info.endPort, false);
             break;
         }
     }
 }
 
+uint32_t BaseProcessor::getConnectedInputsMask() const noexcept
+{
+    uint32_t mask = 0;
+    for (auto portIndex : inputsConnected)
+        mask |= (uint32_t) 1 << portIndex;
+
+    return mask;
+}
+
 const std::vector<String>* BaseProcessor::getParametersToDisableWhenInputIsConnected (int portIndex) const noexcept
 {
     if (auto iter = paramsToDisableWhenInputConnected.find (portIndex); iter != paramsToDisableWhenInputConnected.end())
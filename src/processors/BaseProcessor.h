@@ -1,6 +1,9 @@
 #pragma once
 
 #include "JuceProcWrapper.h"
+#include "ProcessorProfiler.h"
+#include "ProcessorStateWarmer.h"
+#include "SharedAssetCache.h"
 
 enum ProcessorType
 {
@@ -26,6 +29,29 @@ struct ProcessorUIOptions
     } info;
 };
 
+/**
+ * The sample rate that a processor would like to run at, when the chain is oversampled.
+ *
+ * Processors that don't benefit from oversampling (e.g. linear filters) can
+ * run at a lower rate, in a "rate island" within the oversampled chain. The
+ * chain resamples the signal at the edges of each island, and neighbouring
+ * processors that run at the same rate share an island.
+ */
+struct ProcessingRate
+{
+    enum class Type
+    {
+        ChainRate, // the chain's oversampling factor (for nonlinear processors)
+        BaseRate, // the host sample rate (for linear processors)
+        FixedFactor, // a fixed oversampling factor (or the chain's factor, if that's lower)
+        ModelRate, // the lowest oversampled rate that's at least as high as a neural model's sample rate (only for processors that are nothing but the model)
+    };
+
+    Type type = Type::ChainRate;
+    int osFactor = 1;
+    double modelSampleRate = 0.0;
+};
+
 class BaseProcessor;
 struct ConnectionInfo
 {
@@ -52,13 +78,39 @@ public:
 
     // audio processing methods
     bool isBypassed() const { return ! static_cast<bool> (onOffParam->load()); }
-    void prepareProcessing (double sampleRate, int numSamples);
     void processAudioBlock (AudioBuffer<float>& buffer);
 
+    /**
+     * Prepares the processor to run in a chain with this (oversampled) sample rate
+     * and block size. If the chain is oversampled, the processor may be prepared
+     * to run at a lower rate, depending on its preferred processing rate. In that
+     * case, the processor must only be run through the chain's processing schedule,
+     * which resamples its input and output.
+     */
+    void prepareProcessing (double sampleRate, int numSamples, int chainOSFactor = 1);
+
+    /** Processors can override this to run at a lower rate when the chain is oversampled. */
+    virtual ProcessingRate getPreferredProcessingRate() const { return {}; }
+
+    /** Returns how much lower than the chain's sample rate the processor was prepared to run at. */
+    int getRateDivisor() const noexcept { return rateDivisor; }
+
     // methods for working with port input levels
     float getInputLevelDB (int portIndex) const noexcept;
     void resetPortMagnitudes (bool shouldPortMagsBeOn);
 
+    // per-block CPU usage measurements
+    auto& getProfiler() noexcept { return profiler; }
+
+    /**
+     * Returns a rough estimate of how much memory the processor is using for audio.
+     * The processor's inputs live in the processing schedule's buffer pool, so by
+     * default this returns zero, and processors that allocate a lot of memory in
+     * prepare() (delay lines, impulse responses, etc.) should override this and
+     * add up their own allocations.
+     */
+    virtual size_t getMemoryFootprint() const { return 0; }
+
     // state save/load methods
     virtual std::unique_ptr<XmlElement> toXML();
     virtual void fromXML (XmlElement* xml, const chowdsp::Version& version, bool loadPosition = true);
@@ -85,16 +137,36 @@ public:
     /** add options to the processor's popup menu */
     virtual void addToPopupMenu (PopupMenu& menu);
 
-    AudioBuffer<float>& getInputBuffer (int idx = 0) { return inputBuffers.getReference (idx); }
+    /** Returns the buffer for one of the inputs. This is only valid while the processing schedule is running the processor, and the input is connected. */
+    AudioBuffer<float>& getInputBuffer (int idx = 0)
+    {
+        jassert (inputBufferViews[idx] != nullptr); // this input isn't connected in the processing schedule!
+        return *inputBufferViews[idx];
+    }
     AudioBuffer<float>* getOutputBuffer (int idx = 0) { return outputBuffers[idx]; }
     const ConnectionInfo& getOutputConnection (int portIdx, int connectionIdx) const { return outputConnections[portIdx].getReference (connectionIdx); }
 
     int getNumOutputConnections (int portIdx) const { return outputConnections[portIdx].size(); }
     int getNumInputConnections() const { return inputsConnected.size(); };
 
-    int incrementNumInputsReady() { return numInputsReady++; }
-    int getNumInputsReady() const { return numInputsReady; }
-    void clearNumInputsReady() { numInputsReady = 0; }
+    /**
+     * Points one of the processor's inputs at a buffer owned by somebody else
+     * (the processing schedule's buffer pool, or the output of an upstream
+     * processor). Processors don't own any input buffers of their own, so
+     * the schedule points each connected input at a buffer before running
+     * the processor, and clears the view again afterwards.
+     */
+    void setInputBufferView (int idx, AudioBuffer<float>* buffer) { inputBufferViews.set (idx, buffer); }
+
+    /** Returns a bit mask of the inputs that are connected right now (message thread only). */
+    uint32_t getConnectedInputsMask() const noexcept;
+
+    /**
+     * Tells the processor which inputs are connected in the schedule that is running it.
+     * This is set by the processing schedule before each block, so that the processor
+     * keeps seeing the connections it was scheduled with while the graph is being edited.
+     */
+    void setConnectedInputsMask (uint32_t mask) noexcept { connectedInputsMask = mask; }
 
     void addConnection (ConnectionInfo&& info);
     void removeConnection (const ConnectionInfo& info);
@@ -147,6 +219,9 @@ protected:
     Array<AudioBuffer<float>*> outputBuffers;
     Array<int> inputsConnected;
 
+    /** Returns true if an input is connected in the schedule that is running this processor (audio thread only). */
+    bool isInputConnected (int portIndex) const noexcept { return (connectedInputsMask & ((uint32_t) 1 << portIndex)) != 0; }
+
     chowdsp::SharedLNFAllocator lnfAllocator;
 
     /**
@@ -156,15 +231,30 @@ protected:
      */
     auto& getSharedConvolutionMessageQueue() { return convolutionMessageQueue.get(); }
 
+    /**
+     * Background thread shared by all processors that warm up
+     * their state with a ProcessorStateWarmer.
+     */
+    TimeSliceThread& getSharedWarmUpThread() { return warmUpThread.get(); }
+
+    /**
+     * Cache for read-only assets (model weights, IRs, lookup tables)
+     * that can be shared between all instances of a processor.
+     */
+    SharedAssetCache& getSharedAssetCache() { return assetCache.get(); }
+
 private:
+    int computeRateDivisor (double sampleRate, int chainOSFactor);
+
     std::atomic<float>* onOffParam = nullptr;
 
     const int numInputs;
     const int numOutputs;
+    int rateDivisor = 1;
+    uint32_t connectedInputsMask = 0;
 
     std::vector<Array<ConnectionInfo>> outputConnections;
-    Array<AudioBuffer<float>> inputBuffers;
-    int numInputsReady = 0;
+    Array<AudioBuffer<float>*> inputBufferViews;
 
     juce::Point<float> editorPosition;
 
@@ -174,6 +264,14 @@ private:
     };
     SharedResourcePointer<ConvolutionMessageQueue> convolutionMessageQueue;
 
+    struct WarmUpThread : public TimeSliceThread
+    {
+        WarmUpThread() : TimeSliceThread ("BYOD Processor Warm-Up Thread") { startThread(); }
+    };
+    SharedResourcePointer<WarmUpThread> warmUpThread;
+
+    SharedResourcePointer<SharedAssetCache> assetCache;
+
     struct PortMagnitude
     {
         PortMagnitude() = default;
@@ -186,6 +284,8 @@ private:
     bool portMagnitudesOn = false;
     std::vector<PortMagnitude> portMagnitudes;
 
+    ProcessorProfiler profiler;
+
     StringArray popupMenuParameterIDs;
     OwnedArray<ParameterAttachment> popupMenuParameterAttachments;
 
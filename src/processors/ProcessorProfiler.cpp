@@ -0,0 +1,87 @@
+#include "ProcessorProfiler.h"
+
+void ProcessorProfiler::prepare (double sampleRate)
+{
+    currentSampleRate.store (sampleRate);
+}
+
+void ProcessorProfiler::pushMeasurement (int64 ticks, int numSamples) noexcept
+{
+    const auto seconds = Time::highResolutionTicksToSeconds (ticks);
+    const auto blockSeconds = (double) numSamples / currentSampleRate.load (std::memory_order_relaxed);
+
+    // if the consumer isn't keeping up, the measurement gets dropped
+    const auto scope = fifo.write (1);
+    if (scope.blockSize1 > 0)
+        fifoData[(size_t) scope.startIndex1] = { float (seconds * 1.0e6), float (seconds / blockSeconds), numSamples };
+    else if (scope.blockSize2 > 0)
+        fifoData[(size_t) scope.startIndex2] = { float (seconds * 1.0e6), float (seconds / blockSeconds), numSamples };
+}
+
+void ProcessorProfiler::collectMeasurements()
+{
+    const auto scope = fifo.read (fifo.getNumReady());
+    auto addToHistory = [this] (int startIndex, int numItems)
+    {
+        for (int i = startIndex; i < startIndex + numItems; ++i)
+        {
+            const auto& measurement = fifoData[(size_t) i];
+            worstMicroseconds = jmax (worstMicroseconds, (double) measurement.microseconds);
+            worstLoad = jmax (worstLoad, (double) measurement.load);
+
+            if (history.size() < historySize)
+                history.push_back (measurement);
+            else
+                history[historyWritePosition] = measurement;
+            historyWritePosition = (historyWritePosition + 1) % historySize;
+        }
+    };
+
+    addToHistory (scope.startIndex1, scope.blockSize1);
+    addToHistory (scope.startIndex2, scope.blockSize2);
+}
+
+ProcessorProfiler::Stats ProcessorProfiler::getStats() const
+{
+    Stats stats;
+    if (history.empty())
+        return stats;
+
+    std::vector<float> times;
+    times.reserve (history.size());
+
+    double totalLoad = 0.0;
+    int64 totalSamples = 0;
+    for (const auto& measurement : history)
+    {
+        times.push_back (measurement.microseconds);
+        totalLoad += (double) measurement.load;
+        totalSamples += measurement.numSamples;
+    }
+    std::sort (times.begin(), times.end());
+
+    auto percentile = [&times] (double p)
+    { return (double) times[(size_t) std::round (p * double (times.size() - 1))]; };
+
+    const auto totalMicroseconds = std::accumulate (times.begin(), times.end(), 0.0);
+    stats.numBlocks = (int) times.size();
+    stats.meanMicroseconds = totalMicroseconds / (double) times.size();
+    stats.p50Microseconds = percentile (0.5);
+    stats.p95Microseconds = percentile (0.95);
+    stats.p99Microseconds = percentile (0.99);
+    stats.worstMicroseconds = worstMicroseconds;
+    stats.meanLoad = totalLoad / (double) times.size();
+    stats.worstLoad = worstLoad;
+    stats.cyclesPerSample = totalMicroseconds * (double) SystemStats::getCpuSpeedInMegahertz() / (double) jmax ((int64) 1, totalSamples);
+
+    return stats;
+}
+
+void ProcessorProfiler::clearMeasurements()
+{
+    collectMeasurements();
+    history.clear();
+    historyWritePosition = 0;
+    worstMicroseconds = 0.0;
+    worstLoad = 0.0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Measures how long a processor takes to process each block.
+ *
+ * Measurements are made on the audio thread and pushed through a
+ * lock-free FIFO, so that the statistics can be computed somewhere
+ * else (usually the message thread). Profiling is only turned on
+ * while somebody is holding a ProcessorProfiler::ScopedEnable.
+ */
+class ProcessorProfiler
+{
+public:
+    ProcessorProfiler() = default;
+
+    struct Stats
+    {
+        int numBlocks = 0;
+        double meanMicroseconds = 0.0;
+        double p50Microseconds = 0.0;
+        double p95Microseconds = 0.0;
+        double p99Microseconds = 0.0;
+        double worstMicroseconds = 0.0;
+        double meanLoad = 0.0; // fraction of the real-time budget for each block
+        double worstLoad = 0.0;
+        double cyclesPerSample = 0.0; // estimated from the CPU clock speed
+    };
+
+    /** Turns profiling on for all processors, for as long as this object is alive. */
+    struct ScopedEnable
+    {
+        ScopedEnable() { numEnablers.fetch_add (1); }
+        ~ScopedEnable() { numEnablers.fetch_sub (1); }
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEnable)
+    };
+
+    static bool isEnabled() noexcept { return numEnablers.load (std::memory_order_relaxed) > 0; }
+
+    /** Times a single processing block (audio thread only). */
+    struct ScopedBlockTimer
+    {
+        ScopedBlockTimer (ProcessorProfiler& p, int numSamples) noexcept
+            : profiler (isEnabled() ? &p : nullptr),
+              blockNumSamples (numSamples),
+              startTicks (profiler != nullptr ? Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedBlockTimer()
+        {
+            if (profiler != nullptr)
+                profiler->pushMeasurement (Time::getHighResolutionTicks() - startTicks, blockNumSamples);
+        }
+
+    private:
+        ProcessorProfiler* profiler;
+        const int blockNumSamples;
+        const int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBlockTimer)
+    };
+
+    void prepare (double sampleRate);
+
+    /** Pulls in any new measurements from the audio thread (single consumer only). */
+    void collectMeasurements();
+
+    /** Computes statistics over the most recent blocks. Call collectMeasurements() first! */
+    Stats getStats() const;
+
+    /** Forgets all the measurements collected so far. */
+    void clearMeasurements();
+
+private:
+    void pushMeasurement (int64 ticks, int numSamples) noexcept;
+
+    struct Measurement
+    {
+        float microseconds;
+        float load;
+        int numSamples;
+    };
+
+    static constexpr int fifoSize = 1024;
+    AbstractFifo fifo { fifoSize };
+    std::array<Measurement, (size_t) fifoSize> fifoData {};
+    std::atomic<double> currentSampleRate { 48000.0 };
+
+    static constexpr size_t historySize = 4096;
+    std::vector<Measurement> history; // owned by the consumer
+    size_t historyWritePosition = 0;
+    double worstMicroseconds = 0.0;
+    double worstLoad = 0.0;
+
+    static inline std::atomic_int numEnablers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorProfiler)
+};
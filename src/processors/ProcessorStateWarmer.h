@@ -0,0 +1,165 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Holds the DSP state for a processor, and hands freshly warmed-up
+ * copies of that state over to the audio thread.
+ *
+ * Some processors have state that takes a while to settle after it has
+ * been reset (recurrent networks, circuits with a DC bias, etc.). Rather
+ * than running silence through the processor on the audio thread, the
+ * processor can request a warm-up, which builds a new copy of the state on
+ * a background thread and runs the warm-up function on it. The new state
+ * is then published for the audio thread to swap in at the start of its
+ * next block. The state that gets swapped out is deleted on the message thread.
+ *
+ * The warm-up function runs on the background thread, so it should only
+ * read processor settings that are safe to read from any thread (e.g.
+ * parameter values), along with the sample rate and block size it is given.
+ *
+ * Processors that want to crossfade from the old state to the new one can
+ * ask the warmer to keep the previous state. The state that gets swapped
+ * out then stays available to the audio thread (from getPreviousState())
+ * until the audio thread calls releasePreviousState(), and no newer state
+ * will be swapped in until then.
+ */
+template <typename StateType>
+class ProcessorStateWarmer : private TimeSliceClient,
+                             private Timer
+{
+public:
+    using WarmUpFunction = std::function<void (StateType& state, double sampleRate, int samplesPerBlock)>;
+
+    ProcessorStateWarmer (TimeSliceThread& warmUpThread, WarmUpFunction&& warmUpFunc, bool shouldKeepPreviousState = false)
+        : thread (warmUpThread),
+          warmUpFunction (std::move (warmUpFunc)),
+          keepPreviousState (shouldKeepPreviousState),
+          activeState (std::make_unique<StagedState>())
+    {
+        thread.addTimeSliceClient (this);
+        startTimer (reclaimIntervalMs);
+    }
+
+    ~ProcessorStateWarmer() override
+    {
+        thread.removeTimeSliceClient (this); // waits for any warm-up that's in progress
+        stopTimer();
+        delete pendingState.exchange (nullptr);
+        delete retiredState.exchange (nullptr);
+    }
+
+    /**
+     * Warms up a new state right away, on the calling thread. Any state that
+     * is being warmed up in the background will be thrown away. This should only
+     * be called while the audio thread is not processing, i.e. from prepare().
+     */
+    void warmUpNow (double sampleRate, int samplesPerBlock)
+    {
+        warmUpSampleRate.store (sampleRate);
+        warmUpBlockSize.store (samplesPerBlock);
+        const auto newGeneration = ++generation;
+        warmUpRequested.store (false);
+
+        auto newState = std::make_unique<StagedState>();
+        newState->generation = newGeneration;
+        warmUpFunction (newState->state, sampleRate, samplesPerBlock);
+
+        delete pendingState.exchange (nullptr);
+        previousState.reset();
+        activeState = std::move (newState);
+    }
+
+    /** Asks the background thread for a new warmed-up state (safe to call from any thread). */
+    void requestWarmUp() noexcept { warmUpRequested.store (true); }
+
+    /** Returns the state to use for this block, swapping in a newly warmed-up state if one is ready (audio thread only). */
+    StateType& getStateForBlock() noexcept
+    {
+        // wait for the message thread to clean up the last state that was swapped out, and for any crossfade to finish
+        if (pendingState.load() == nullptr || retiredState.load() != nullptr || previousState != nullptr)
+            return activeState->state;
+
+        std::unique_ptr<StagedState> newState { pendingState.exchange (nullptr) };
+        if (newState == nullptr)
+            return activeState->state;
+
+        if (newState->generation == generation.load())
+        {
+            std::swap (activeState, newState);
+            if (keepPreviousState)
+            {
+                previousState = std::move (newState);
+                return activeState->state;
+            }
+        }
+
+        retiredState.store (newState.release());
+        return activeState->state;
+    }
+
+    /** Returns the state that was swapped out by getStateForBlock(), or nullptr if it has already been released (audio thread only). */
+    StateType* getPreviousState() noexcept { return previousState == nullptr ? nullptr : &previousState->state; }
+
+    /**
+     * Hands the previous state over to the message thread to be deleted (audio thread only).
+     * If the last retired state hasn't been deleted yet, the previous state is kept
+     * around, and this should be called again on the next block.
+     */
+    void releasePreviousState() noexcept
+    {
+        if (previousState == nullptr || retiredState.load() != nullptr)
+            return;
+
+        retiredState.store (previousState.release());
+    }
+
+    /** Returns the state that is currently active, without checking for a new one. */
+    StateType& getActiveState() noexcept { return activeState->state; }
+
+private:
+    struct StagedState
+    {
+        StateType state;
+        uint32_t generation = 0;
+    };
+
+    int useTimeSlice() override
+    {
+        if (! warmUpRequested.exchange (false))
+            return pollIntervalMs;
+
+        const auto warmUpGeneration = generation.load();
+        auto newState = std::make_unique<StagedState>();
+        newState->generation = warmUpGeneration;
+        warmUpFunction (newState->state, warmUpSampleRate.load(), warmUpBlockSize.load());
+
+        // if a newer warm-up was published before the audio thread picked this one up, it can be deleted right away
+        delete pendingState.exchange (newState.release());
+        return 0;
+    }
+
+    void timerCallback() override
+    {
+        delete retiredState.exchange (nullptr);
+    }
+
+    static constexpr int pollIntervalMs = 10;
+    static constexpr int reclaimIntervalMs = 100;
+
+    TimeSliceThread& thread;
+    const WarmUpFunction warmUpFunction;
+    const bool keepPreviousState;
+
+    std::unique_ptr<StagedState> activeState; // owned by the audio thread
+    std::unique_ptr<StagedState> previousState; // owned by the audio thread
+    std::atomic<StagedState*> pendingState { nullptr };
+    std::atomic<StagedState*> retiredState { nullptr };
+
+    std::atomic_bool warmUpRequested { false };
+    std::atomic<uint32_t> generation { 0 };
+    std::atomic<double> warmUpSampleRate { 48000.0 };
+    std::atomic<int> warmUpBlockSize { 512 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorStateWarmer)
+};
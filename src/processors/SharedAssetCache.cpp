@@ -0,0 +1,230 @@
+#include "SharedAssetCache.h"
+#include "drive/neural_utils/BinaryModelData.h"
+
+namespace
+{
+/** Embedded data lives in the plugin binary, so its address is a unique ID for the lifetime of the process. */
+String getEmbeddedAssetID (const void* data, int dataSize)
+{
+    return String::toHexString ((pointer_sized_int) data) + "_" + String (dataSize);
+}
+
+std::unique_ptr<SharedAssetCache::DecodedIR> decodeIR (std::unique_ptr<InputStream>&& stream, const String& sourceID)
+{
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    std::unique_ptr<AudioFormatReader> reader { formatManager.createReaderFor (std::move (stream)) };
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return {};
+
+    auto ir = std::make_unique<SharedAssetCache::DecodedIR>();
+    ir->buffer.setSize (jlimit (1, 2, (int) reader->numChannels), (int) reader->lengthInSamples);
+    reader->read (&ir->buffer, 0, (int) reader->lengthInSamples, 0, true, true);
+    ir->sampleRate = reader->sampleRate;
+    ir->sourceID = sourceID;
+    return ir;
+}
+
+// The IR processing below matches what dsp::Convolution does when an IR is loaded with Trim::yes and Normalise::yes.
+AudioBuffer<float> trimImpulseResponse (const AudioBuffer<float>& buffer)
+{
+    const auto threshold = Decibels::decibelsToGain (-80.0f);
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+
+    auto offsetBegin = numSamples;
+    auto offsetEnd = numSamples;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* x = buffer.getReadPointer (ch);
+        const auto isAboveThreshold = [threshold] (float sample)
+        { return std::abs (sample) >= threshold; };
+
+        offsetBegin = jmin (offsetBegin, (int) std::distance (x, std::find_if (x, x + numSamples, isAboveThreshold)));
+        offsetEnd = jmin (offsetEnd, (int) std::distance (std::make_reverse_iterator (x + numSamples), std::find_if (std::make_reverse_iterator (x + numSamples), std::make_reverse_iterator (x), isAboveThreshold)));
+    }
+
+    if (offsetBegin == numSamples)
+    {
+        AudioBuffer<float> silentBuffer (numChannels, 1);
+        silentBuffer.clear();
+        return silentBuffer;
+    }
+
+    AudioBuffer<float> trimmedBuffer (numChannels, jmax (1, numSamples - (offsetBegin + offsetEnd)));
+    for (int ch = 0; ch < numChannels; ++ch)
+        trimmedBuffer.copyFrom (ch, 0, buffer, ch, offsetBegin, trimmedBuffer.getNumSamples());
+
+    return trimmedBuffer;
+}
+
+AudioBuffer<float> resampleImpulseResponse (AudioBuffer<float>& buffer, double sourceSampleRate, double targetSampleRate)
+{
+    if (approximatelyEqual (sourceSampleRate, targetSampleRate))
+        return std::move (buffer);
+
+    const auto resampleRatio = sourceSampleRate / targetSampleRate;
+    MemoryAudioSource memorySource (buffer, false);
+    ResamplingAudioSource resamplingSource (&memorySource, false, buffer.getNumChannels());
+
+    const auto resampledLength = roundToInt (jmax (1.0, buffer.getNumSamples() / resampleRatio));
+    resamplingSource.setResamplingRatio (resampleRatio);
+    resamplingSource.prepareToPlay (resampledLength, sourceSampleRate);
+
+    AudioBuffer<float> resampledBuffer (buffer.getNumChannels(), resampledLength);
+    resamplingSource.getNextAudioBlock ({ &resampledBuffer, 0, resampledLength });
+
+    return resampledBuffer;
+}
+
+void normaliseImpulseResponse (AudioBuffer<float>& buffer)
+{
+    float maxSumSquared = 0.0f;
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        const auto* x = buffer.getReadPointer (ch);
+        maxSumSquared = jmax (maxSumSquared, std::inner_product (x, x + buffer.getNumSamples(), x, 0.0f));
+    }
+
+    if (maxSumSquared > 0.0f)
+        buffer.applyGain (0.125f / std::sqrt (maxSumSquared));
+}
+
+File getDiskCacheFile (const File& diskCacheDirectory, const String& preparedIRID)
+{
+    return diskCacheDirectory.getChildFile (File::createLegalFileName (preparedIRID) + ".wav");
+}
+
+void writeToDiskCache (const SharedAssetCache::DecodedIR& ir, const File& cacheFile)
+{
+    if (! cacheFile.getParentDirectory().createDirectory())
+        return;
+
+    // write to a temporary file first, so that another instance never reads a half-written IR
+    TemporaryFile tempFile { cacheFile };
+    {
+        auto stream = std::make_unique<FileOutputStream> (tempFile.getFile());
+        if (! stream->openedOk())
+            return;
+
+        // 32-bit floating point, so that nothing is lost
+        std::unique_ptr<AudioFormatWriter> writer { WavAudioFormat().createWriterFor (stream.get(), ir.sampleRate, (unsigned int) ir.buffer.getNumChannels(), 32, {}, 0) };
+        if (writer == nullptr)
+            return;
+
+        stream.release(); // the writer owns the stream now
+        if (! writer->writeFromAudioSampleBuffer (ir.buffer, 0, ir.buffer.getNumSamples()))
+            return;
+    }
+
+    if (tempFile.overwriteTargetFileWithTemporary())
+        SharedAssetCache::trimDiskCache (cacheFile.getParentDirectory(), SharedAssetCache::maxIRDiskCacheSize);
+}
+} // namespace
+
+std::shared_ptr<const BinaryModelData> SharedAssetCache::getEmbeddedModel (const void* data, int dataSize)
+{
+    return getOrCreate<BinaryModelData> (getEmbeddedAssetID (data, dataSize),
+                                         [data, dataSize]
+                                         {
+                                             if (BinaryModelData::isBinaryModel (data, (size_t) dataSize))
+                                                 return BinaryModelData::fromMemory (data, (size_t) dataSize);
+
+                                             MemoryInputStream jsonInputStream (data, (size_t) dataSize, false);
+                                             return BinaryModelData::fromJSON (nlohmann::json::parse (jsonInputStream.readEntireStreamAsString().toStdString()));
+                                         });
+}
+
+std::shared_ptr<const SharedAssetCache::DecodedIR> SharedAssetCache::getEmbeddedIR (const void* data, int dataSize)
+{
+    const auto assetID = getEmbeddedAssetID (data, dataSize);
+    return getOrCreate<DecodedIR> (assetID,
+                                   [data, dataSize, &assetID]
+                                   {
+                                       auto ir = decodeIR (std::make_unique<MemoryInputStream> (data, (size_t) dataSize, false), "embedded_" + assetID);
+                                       jassert (ir != nullptr); // unable to read the IR file!
+                                       return ir;
+                                   });
+}
+
+std::shared_ptr<const SharedAssetCache::DecodedIR> SharedAssetCache::getIRFromFileData (const MemoryBlock& fileData)
+{
+    const auto assetID = "ir_" + getContentHash (fileData.getData(), fileData.getSize());
+    return getOrCreate<DecodedIR> (assetID,
+                                   [&fileData, &assetID]
+                                   { return decodeIR (std::make_unique<MemoryInputStream> (fileData, false), assetID); });
+}
+
+std::shared_ptr<const SharedAssetCache::DecodedIR> SharedAssetCache::getPreparedIR (const std::shared_ptr<const DecodedIR>& sourceIR, double targetSampleRate, const File& diskCacheDirectory)
+{
+    if (sourceIR == nullptr)
+        return {};
+
+    const auto preparedIRID = sourceIR->sourceID + "_" + String (targetSampleRate) + "Hz";
+    return getOrCreate<DecodedIR> (preparedIRID,
+                                   [&sourceIR, targetSampleRate, &diskCacheDirectory, &preparedIRID]
+                                   {
+                                       const auto cacheFile = diskCacheDirectory == File {} ? File {} : getDiskCacheFile (diskCacheDirectory, preparedIRID);
+                                       if (cacheFile.existsAsFile())
+                                       {
+                                           auto cachedIR = decodeIR (cacheFile.createInputStream(), sourceIR->sourceID);
+                                           if (cachedIR != nullptr && approximatelyEqual (cachedIR->sampleRate, targetSampleRate))
+                                           {
+                                               cacheFile.setLastModificationTime (Time::getCurrentTime()); // so that the most recently used IRs stay in the cache
+                                               return cachedIR;
+                                           }
+                                       }
+
+                                       auto trimmedBuffer = trimImpulseResponse (sourceIR->buffer);
+
+                                       auto ir = std::make_unique<DecodedIR>();
+                                       ir->buffer = resampleImpulseResponse (trimmedBuffer, sourceIR->sampleRate, targetSampleRate);
+                                       ir->sampleRate = targetSampleRate;
+                                       ir->sourceID = sourceIR->sourceID;
+                                       normaliseImpulseResponse (ir->buffer);
+
+                                       if (cacheFile != File {})
+                                           writeToDiskCache (*ir, cacheFile);
+
+                                       return ir;
+                                   });
+}
+
+int SharedAssetCache::getNumAssets() const
+{
+    const ScopedLock sl { lock };
+    return (int) std::count_if (assets.begin(), assets.end(), [] (const auto& asset)
+                                { return ! asset.second.expired(); });
+}
+
+String SharedAssetCache::getContentHash (const void* data, size_t dataSize)
+{
+    // the hash also names the files in the disk cache, so it needs to be the same on every platform and build
+    return MD5 (data, dataSize).toHexString() + "_" + String ((int64) dataSize);
+}
+
+void SharedAssetCache::trimDiskCache (const File& cacheDirectory, int64 maxSizeBytes)
+{
+    auto cacheFiles = cacheDirectory.findChildFiles (File::findFiles, false);
+    std::sort (cacheFiles.begin(), cacheFiles.end(), [] (const File& a, const File& b)
+               { return a.getLastModificationTime() > b.getLastModificationTime(); });
+
+    int64 totalSizeBytes = 0;
+    for (const auto& file : cacheFiles)
+    {
+        totalSizeBytes += file.getSize();
+        if (totalSizeBytes > maxSizeBytes)
+            file.deleteFile();
+    }
+}
+
+void SharedAssetCache::removeExpiredAssets()
+{
+    for (auto iter = assets.begin(); iter != assets.end();)
+    {
+        if (iter->second.expired())
+            iter = assets.erase (iter);
+        else
+            ++iter;
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <pch.h>
+#include <typeindex>
+
+class BinaryModelData;
+
+/**
+ * A process-wide cache for read-only assets, like neural network
+ * weights, impulse responses, and lookup tables.
+ *
+ * Without the cache, every processor instance parses and stores its own
+ * copy of these assets, even though the data never changes. The cache
+ * hands out shared pointers to const assets instead, so all instances
+ * (in all plugin instances in the process) share the same copy. Once an
+ * asset has been created, it can be read from any thread without locking.
+ *
+ * The cache only holds weak references to its assets, so an asset stays
+ * alive for as long as some processor is holding onto it, and is freed
+ * once the last of those processors lets go.
+ *
+ * Use the cache through a SharedResourcePointer, or from a processor with
+ * BaseProcessor::getSharedAssetCache().
+ */
+class SharedAssetCache
+{
+public:
+    SharedAssetCache() = default;
+
+    /**
+     * Returns the asset of this type with this ID, or creates it if it's not
+     * in the cache. The creation function should return a (unique or shared)
+     * pointer to the new asset, or nullptr if the asset can't be created.
+     *
+     * The creation function is called with the cache locked, so it must
+     * not call back into the cache.
+     */
+    template <typename AssetType, typename CreateFunc>
+    std::shared_ptr<const AssetType> getOrCreate (const String& assetID, CreateFunc&& createAsset)
+    {
+        const ScopedLock sl { lock };
+
+        auto& cachedAsset = assets[{ std::type_index (typeid (AssetType)), assetID }];
+        if (auto asset = cachedAsset.lock())
+            return std::static_pointer_cast<const AssetType> (asset);
+
+        std::shared_ptr<const AssetType> asset { createAsset() };
+        cachedAsset = asset;
+
+        removeExpiredAssets();
+        return asset;
+    }
+
+    /** Returns the asset of this type with this ID, or nullptr if it's not in the cache. */
+    template <typename AssetType>
+    std::shared_ptr<const AssetType> find (const String& assetID) const
+    {
+        const ScopedLock sl { lock };
+
+        const auto cachedAsset = assets.find ({ std::type_index (typeid (AssetType)), assetID });
+        if (cachedAsset == assets.end())
+            return {};
+
+        return std::static_pointer_cast<const AssetType> (cachedAsset->second.lock());
+    }
+
+    /** Returns the weights for a neural model that is embedded in the plugin (i.e. from BinaryData), in either the binary or JSON format. */
+    std::shared_ptr<const BinaryModelData> getEmbeddedModel (const void* data, int dataSize);
+
+    struct DecodedIR
+    {
+        AudioBuffer<float> buffer;
+        double sampleRate = 48000.0;
+        String sourceID; // identifies the IR file that this audio came from
+    };
+
+    /** Returns the decoded audio from an impulse response file that is embedded in the plugin (i.e. from BinaryData). */
+    std::shared_ptr<const DecodedIR> getEmbeddedIR (const void* data, int dataSize);
+
+    /**
+     * Returns the decoded audio from the contents of an impulse response file (e.g. a user IR).
+     * IRs are identified by a hash of the file contents, so the same file is only decoded once,
+     * no matter where it was loaded from. Returns nullptr if the file can't be decoded.
+     */
+    std::shared_ptr<const DecodedIR> getIRFromFileData (const MemoryBlock& fileData);
+
+    /**
+     * Returns an IR that has been trimmed, resampled to the target sample rate, and normalised,
+     * the same way that dsp::Convolution would do it. Load the result into a dsp::Convolution
+     * that is prepared at the target sample rate (with Trim::no), so it doesn't get processed again.
+     *
+     * If a cache directory is given, the prepared IR is also cached on disk, so that it
+     * doesn't need to be resampled again the next time the plugin is loaded. The cache
+     * directory is then trimmed down to maxIRDiskCacheSize (least recently used IRs first).
+     */
+    std::shared_ptr<const DecodedIR> getPreparedIR (const std::shared_ptr<const DecodedIR>& sourceIR, double targetSampleRate, const File& diskCacheDirectory = {});
+
+    static constexpr int64 maxIRDiskCacheSize = 64 * 1024 * 1024;
+
+    /** Returns the number of assets that are currently alive. */
+    int getNumAssets() const;
+
+    /**
+     * Identifies data from outside the plugin by its contents, so that the same data is never
+     * loaded twice. The hash is the same on every platform, so it can also name disk cache files.
+     */
+    static String getContentHash (const void* data, size_t dataSize);
+
+    /**
+     * Deletes the least recently used files from a disk cache directory, until the files
+     * that are left add up to no more than the given size. Files count as used when they
+     * were last modified, so touch a cache file whenever it gets read from the cache.
+     */
+    static void trimDiskCache (const File& cacheDirectory, int64 maxSizeBytes);
+
+private:
+    void removeExpiredAssets();
+
+    using Key = std::pair<std::type_index, String>;
+    std::map<Key, std::weak_ptr<const void>> assets;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedAssetCache)
+};
@@ -3,11 +3,21 @@
 
 using namespace GlobalParamTags;
 
+namespace
+{
+int getNumHalfBandStages (int osFactor)
+{
+    return jlimit (0, HalfBandOversampler::maxNumStages, roundToInt (std::log2 ((double) osFactor)));
+}
+} // namespace
+
 ChainIOProcessor::ChainIOProcessor (AudioProcessorValueTreeState& vts, std::function<void (int)>&& latencyChangedCallback) : latencyChangedCallbackFunc (std::move (latencyChangedCallback)),
-                                                                                                                             oversampling (vts, true)
+                                                                                                                             oversampling (vts, true),
+                                                                                                                             spareOversampling (vts, true)
 {
     using namespace ParameterHelpers;
     monoModeParam = vts.getRawParameterValue (monoModeTag);
+    osFilterParam = vts.getRawParameterValue (osFilterTag);
     loadParameterPointer (inGainParam, vts, inGainTag);
     loadParameterPointer (outGainParam, vts, outGainTag);
     loadParameterPointer (dryWetParam, vts, dryWetTag);
@@ -19,7 +29,7 @@ void ChainIOProcessor::createParameters (Parameters& params)
     using OSMode = chowdsp::VariableOversampling<float>::OSMode;
 
     chowdsp::VariableOversampling<float>::createParameterLayout (params,
-                                                                 { OSFactor::OneX, OSFactor::TwoX, OSFactor::FourX, OSFactor::EightX, OSFactor::SixteenX },
+                                                                 { OSFactor::OneX, OSFactor::TwoX, OSFactor::FourX, OSFactor::EightX, OSFactor::SixteenX }, // update maxOversamplingFactor if this changes!
                                                                  { OSMode::MinPhase, OSMode::LinPhase },
                                                                  OSFactor::TwoX,
                                                                  OSMode::MinPhase,
@@ -33,11 +43,25 @@ void ChainIOProcessor::createParameters (Parameters& params)
     createGainDBParameter (params, { inGainTag, 100 }, "In Gain", -72.0f, 18.0f, 0.0f, 0.0f);
     createGainDBParameter (params, { outGainTag, 100 }, "Out Gain", -72.0f, 18.0f, 0.0f, 0.0f);
     createPercentParameter (params, { dryWetTag, 100 }, "Dry/Wet", 1.0f);
+
+    // added in v1.1.1, so it goes at the end to keep the host's parameter indices the same
+    params.push_back (std::make_unique<AudioParameterChoice> (juce::ParameterID { osFilterTag, 111 },
+                                                              "Oversampling Filter",
+                                                              StringArray { "FIR", "Half-band IIR" },
+                                                              0));
 }
 
 void ChainIOProcessor::prepare (double sampleRate, int samplesPerBlock)
 {
     oversampling.prepareToPlay (sampleRate, samplesPerBlock, 2);
+    spareOversampling.prepareToPlay (sampleRate, samplesPerBlock, 2);
+    for (auto* os : { &oversampler, &spareOversampler })
+    {
+        os->iir.prepare (samplesPerBlock);
+        os->useIIR = osFilterParam->load() == 1.0f;
+        os->iir.setNumStages (getNumHalfBandStages (os->fir.getOSFactor()));
+    }
+    activeOversampling.store (&oversampler);
 
     dsp::ProcessSpec spec { sampleRate, (uint32) samplesPerBlock, 2 };
     inGain.setGainDecibels (inGainParam->getCurrentValue());
@@ -49,21 +73,96 @@ void ChainIOProcessor::prepare (double sampleRate, int samplesPerBlock)
     }
 
     ioBuffer.setSize (2, samplesPerBlock);
+    numInputChannelsProcessed = 2;
     dryWetMixer.prepare (spec);
-    latencyChangedCallbackFunc ((int) oversampling.getLatencySamples());
+    latencyChangedCallbackFunc (oversampler.getLatencySamples());
 
     isPrepared = true;
 }
 
+int ChainIOProcessor::Oversampler::getOSFactor() const
+{
+    return fir.getOSFactor();
+}
+
+int ChainIOProcessor::Oversampler::getLatencySamples() const
+{
+    if (useIIR)
+        return roundToInt (iir.getLatencySamples());
+
+    return (int) fir.getLatencySamples();
+}
+
+void ChainIOProcessor::Oversampler::reset()
+{
+    fir.reset();
+    iir.reset();
+}
+
+dsp::AudioBlock<float> ChainIOProcessor::Oversampler::processSamplesUp (const dsp::AudioBlock<const float>& block)
+{
+    if (useIIR)
+        return iir.processSamplesUp (block);
+
+    return fir.processSamplesUp (block);
+}
+
+void ChainIOProcessor::Oversampler::processSamplesDown (dsp::AudioBlock<float>& block)
+{
+    if (useIIR)
+        iir.processSamplesDown (block);
+    else
+        fir.processSamplesDown (block);
+}
+
 int ChainIOProcessor::getOversamplingFactor() const
 {
     if (! isPrepared)
         return 1;
 
-    return oversampling.getOSFactor();
+    return activeOversampling.load()->getOSFactor();
 }
 
-bool ChainIOProcessor::processChannelInputs (const AudioBuffer<float>& buffer)
+ChainIOProcessor::Oversampler& ChainIOProcessor::getNextOversampling()
+{
+    return activeOversampling.load() == &oversampler ? spareOversampler : oversampler;
+}
+
+bool ChainIOProcessor::prepareNextOversampling()
+{
+    if (! isPrepared)
+        return false;
+
+    auto& nextOversampling = getNextOversampling();
+    nextOversampling.fir.updateOSFactor();
+    nextOversampling.useIIR = osFilterParam->load() == 1.0f;
+
+    if (nextOversampling.iir.getOSFactor() != nextOversampling.getOSFactor())
+        nextOversampling.iir.setNumStages (getNumHalfBandStages (nextOversampling.getOSFactor()));
+
+    auto& currentOversampling = *activeOversampling.load();
+    if (nextOversampling.useIIR == currentOversampling.useIIR
+        && nextOversampling.getOSFactor() == currentOversampling.getOSFactor()
+        && nextOversampling.getLatencySamples() == currentOversampling.getLatencySamples())
+        return false;
+
+    latencyChangedCallbackFunc (nextOversampling.getLatencySamples());
+    return true;
+}
+
+int ChainIOProcessor::getNextOversamplingFactor()
+{
+    return getNextOversampling().getOSFactor();
+}
+
+void ChainIOProcessor::swapInNextOversampling()
+{
+    auto& nextOversampling = getNextOversampling();
+    nextOversampling.reset();
+    activeOversampling.store (&nextOversampling);
+}
+
+int ChainIOProcessor::processChannelInputs (const AudioBuffer<float>& buffer)
 {
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
@@ -72,52 +171,48 @@ bool ChainIOProcessor::processChannelInputs (const AudioBuffer<float>& buffer)
     const auto useLeft = monoModeParam->load() == 2.0f;
     const auto useRight = monoModeParam->load() == 3.0f;
 
-    // we need this buffer to be stereo so that the oversampling processing is always stereo
-    ioBuffer.setSize (2, numSamples, false, false, true);
-
     // simple case: stereo input!
     if (useStereo)
     {
+        ioBuffer.setSize (2, numSamples, false, false, true);
         for (int ch = 0; ch < 2; ++ch)
             ioBuffer.copyFrom (ch, 0, buffer, ch % numChannels, 0, numSamples);
+
+        return 2;
     }
-    else
+
+    // Mono output, but which mono? Either way, only one channel gets oversampled and processed.
+    ioBuffer.setSize (1, numSamples, false, false, true);
+    if (useMono)
     {
-        // Mono output, but which mono?
-        ioBuffer.clear();
-        if (useMono)
-        {
-            for (int ch = 0; ch < numChannels; ++ch)
-                ioBuffer.addFrom (0, 0, buffer, ch, 0, numSamples);
-
-            ioBuffer.applyGain (1.0f / (float) numChannels);
-        }
-        else if (useLeft)
-        {
-            ioBuffer.copyFrom (0, 0, buffer, 0, 0, numSamples);
-        }
-        else if (useRight)
-        {
-            ioBuffer.copyFrom (0, 0, buffer, 1 % numChannels, 0, numSamples);
-        }
-
-        ioBuffer.copyFrom (1, 0, ioBuffer, 0, 0, numSamples);
+        ioBuffer.copyFrom (0, 0, buffer, 0, 0, numSamples);
+        for (int ch = 1; ch < numChannels; ++ch)
+            ioBuffer.addFrom (0, 0, buffer, ch, 0, numSamples);
+
+        ioBuffer.applyGain (1.0f / (float) numChannels);
+    }
+    else if (useLeft)
+    {
+        ioBuffer.copyFrom (0, 0, buffer, 0, 0, numSamples);
+    }
+    else if (useRight)
+    {
+        ioBuffer.copyFrom (0, 0, buffer, 1 % numChannels, 0, numSamples);
     }
 
-    return useStereo;
+    return 1;
 }
 
-dsp::AudioBlock<float> ChainIOProcessor::processAudioInput (const AudioBuffer<float>& buffer, bool& sampleRateChanged)
+dsp::AudioBlock<float> ChainIOProcessor::processAudioInput (const AudioBuffer<float>& buffer)
 {
-    if (oversampling.updateOSFactor())
+    const auto numInputChannels = processChannelInputs (buffer);
+    if (numInputChannels > numInputChannelsProcessed)
     {
-        sampleRateChanged = true;
-        mainThreadAction->call ([this]
-                                { latencyChangedCallbackFunc ((int) oversampling.getLatencySamples()); },
-                                true);
+        // the second channel of the dry delay line and the oversampler hasn't been running in the mono modes
+        activeOversampling.load()->reset();
+        dryWetMixer.reset();
     }
-
-    const auto useStereo = processChannelInputs (buffer);
+    numInputChannelsProcessed = numInputChannels;
 
     auto&& block = dsp::AudioBlock<float> { ioBuffer };
     auto&& context = dsp::ProcessContextReplacing<float> { block };
@@ -128,35 +223,39 @@ dsp::AudioBlock<float> ChainIOProcessor::processAudioInput (const AudioBuffer<fl
     dryWetMixer.setDryWet (dryWetParam->getCurrentValue());
     dryWetMixer.copyDryBuffer (ioBuffer);
 
-    processBlock = oversampling.processSamplesUp (block);
-
-    if (useStereo)
-        return processBlock; // return stereo block
+    // the oversampler is prepared for stereo, but only processes as many channels as are in the block
+    processBlock = activeOversampling.load()->processSamplesUp (block);
 
-    return processBlock.getSingleChannelBlock (0); // return mono block
+    return processBlock.getSubsetChannelBlock (0, (size_t) numInputChannels);
 }
 
-void ChainIOProcessor::processChannelOutputs (AudioBuffer<float>& buffer, int numChannelsProcessed) const
+void ChainIOProcessor::processChannelOutputs (AudioBuffer<float>& buffer) const
 {
+    const auto numChannelsProcessed = ioBuffer.getNumChannels();
     for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
         buffer.copyFrom (ch, 0, ioBuffer, ch % numChannelsProcessed, 0, buffer.getNumSamples());
 }
 
 void ChainIOProcessor::processAudioOutput (const AudioBuffer<float>& processedBuffer, AudioBuffer<float>& outputBuffer)
 {
+    // A mono input can still come out of the chain in stereo (e.g. through a stereo widener), in which case the
+    // output is stereo too. The oversampled block always has room for both channels, even if only one went in.
     const auto numProcessedChannels = processedBuffer.getNumChannels();
+    jassert ((size_t) numProcessedChannels <= processBlock.getNumChannels());
     auto&& processedBlock = dsp::AudioBlock<const float> { processedBuffer };
-    for (size_t ch = 0; ch < 2; ++ch)
-        processBlock.getSingleChannelBlock (ch).copyFrom (processedBlock.getSingleChannelBlock (ch % (size_t) numProcessedChannels));
+    for (size_t ch = 0; ch < (size_t) numProcessedChannels; ++ch)
+        processBlock.getSingleChannelBlock (ch).copyFrom (processedBlock.getSingleChannelBlock (ch));
 
+    ioBuffer.setSize (numProcessedChannels, outputBuffer.getNumSamples(), false, false, true);
     auto&& outputBlock = dsp::AudioBlock<float> { ioBuffer };
-    oversampling.processSamplesDown (outputBlock);
+    auto& currentOversampling = *activeOversampling.load();
+    currentOversampling.processSamplesDown (outputBlock);
 
-    const auto latencySamples = (int) oversampling.getLatencySamples();
+    const auto latencySamples = currentOversampling.getLatencySamples();
     dryWetMixer.processBlock (ioBuffer, latencySamples);
 
     outGain.setGainDecibels (outGainParam->getCurrentValue());
     outGain.process (dsp::ProcessContextReplacing<float> { outputBlock });
 
-    processChannelOutputs (outputBuffer, numProcessedChannels);
+    processChannelOutputs (outputBuffer);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DryWetProcessor.h"
+#include "HalfBandOversampler.h"
 
 namespace GlobalParamTags
 {
@@ -8,6 +9,7 @@ const String monoModeTag = "mono_mode";
 const String inGainTag = "in_gain";
 const String outGainTag = "out_gain";
 const String dryWetTag = "dry_wet";
+const String osFilterTag = "os_filter";
 } // namespace GlobalParamTags
 
 class ChainIOProcessor
@@ -16,24 +18,75 @@ public:
     explicit ChainIOProcessor (AudioProcessorValueTreeState& vts, std::function<void (int)>&& latencyChangedCallback);
 
     static void createParameters (Parameters& params);
+
+    /** The largest oversampling factor that can be chosen in the oversampling parameters. */
+    static constexpr int maxOversamplingFactor = 16;
+
     void prepare (double sampleRate, int samplesPerBlock);
 
     int getOversamplingFactor() const;
-    dsp::AudioBlock<float> processAudioInput (const AudioBuffer<float>& buffer, bool& sampleRateChanged);
+    dsp::AudioBlock<float> processAudioInput (const AudioBuffer<float>& buffer);
     void processAudioOutput (const AudioBuffer<float>& processedBuffer, AudioBuffer<float>& outputBuffer);
 
+    /**
+     * Updates the oversampler that is not being used by the audio thread to match
+     * the oversampling parameters. Returns true if it no longer matches the one
+     * being used by the audio thread, and needs to be swapped in.
+     *
+     * Only call this from the message thread, and never while a swap is in progress.
+     */
+    bool prepareNextOversampling();
+
+    /** Returns the oversampling factor for the oversampler prepared in prepareNextOversampling(). */
+    int getNextOversamplingFactor();
+
+    /** Swaps in the oversampler prepared in prepareNextOversampling() (audio thread only). */
+    void swapInNextOversampling();
+
+    /** The oversampling object that owns the oversampling parameters, for use by the UI. */
     auto& getOversampling() { return oversampling; }
 
 private:
-    bool processChannelInputs (const AudioBuffer<float>& buffer);
-    void processChannelOutputs (AudioBuffer<float>& buffer, int numChannelsProcessed) const;
+    /** Fills the I/O buffer from the plugin input, and returns the number of channels to process (1 or 2). */
+    int processChannelInputs (const AudioBuffer<float>& buffer);
+    void processChannelOutputs (AudioBuffer<float>& buffer) const;
 
     const std::function<void (int)> latencyChangedCallbackFunc;
 
+    /**
+     * One of the FIR oversamplers (which also holds the oversampling factor),
+     * along with a half-band IIR oversampler that can be used instead.
+     */
+    struct Oversampler
+    {
+        explicit Oversampler (chowdsp::VariableOversampling<float>& firOS) : fir (firOS) {}
+
+        int getOSFactor() const;
+        int getLatencySamples() const;
+        void reset();
+
+        dsp::AudioBlock<float> processSamplesUp (const dsp::AudioBlock<const float>& block);
+        void processSamplesDown (dsp::AudioBlock<float>& block);
+
+        chowdsp::VariableOversampling<float>& fir;
+        HalfBandOversampler iir;
+        bool useIIR = false;
+    };
+
+    Oversampler& getNextOversampling();
+
+    // Two oversamplers, so that the one not being used by the audio
+    // thread can be prepared when the oversampling settings change.
     chowdsp::VariableOversampling<float> oversampling;
+    chowdsp::VariableOversampling<float> spareOversampling;
+    Oversampler oversampler { oversampling };
+    Oversampler spareOversampler { spareOversampling };
+    std::atomic<Oversampler*> activeOversampling { &oversampler };
 
     std::atomic<float>* monoModeParam = nullptr;
-    AudioBuffer<float> ioBuffer;
+    std::atomic<float>* osFilterParam = nullptr;
+    AudioBuffer<float> ioBuffer; // only holds one channel, unless the chain is processing in stereo
+    int numInputChannelsProcessed = 2; // the number of channels that went through the dry delay and oversampler in the last block
     dsp::AudioBlock<float> processBlock;
 
     chowdsp::FloatParameter* inGainParam = nullptr;
@@ -45,7 +98,5 @@ private:
 
     bool isPrepared = false;
 
-    chowdsp::SharedDeferredAction mainThreadAction;
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChainIOProcessor)
 };
@@ -10,6 +10,7 @@ void DryWetProcessor::prepare (const dsp::ProcessSpec& spec)
 void DryWetProcessor::reset()
 {
     lastDryWet = dryWet;
+    dryDelay.reset();
 }
 
 void DryWetProcessor::copyDryBuffer (const AudioBuffer<float>& buffer)
@@ -21,6 +22,7 @@ void DryWetProcessor::processBlock (AudioBuffer<float>& buffer, int latencySampl
 {
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
+    const auto numDryChannels = dryBuffer.getNumChannels(); // the dry signal may be mono, even if the wet signal is stereo
 
     dryDelay.setDelay ((float) latencySamples);
     dsp::AudioBlock<float> dryBlock (dryBuffer);
@@ -31,14 +33,14 @@ void DryWetProcessor::processBlock (AudioBuffer<float>& buffer, int latencySampl
     {
         buffer.applyGain (dryWet);
         for (int ch = 0; ch < numChannels; ++ch)
-            buffer.addFrom (ch, 0, dryBuffer.getReadPointer (ch), numSamples, (1.0f - dryWet));
+            buffer.addFrom (ch, 0, dryBuffer.getReadPointer (ch % numDryChannels), numSamples, (1.0f - dryWet));
     }
     else
     {
         for (int ch = 0; ch < numChannels; ++ch)
         {
             buffer.applyGainRamp (ch, 0, numSamples, lastDryWet, dryWet);
-            buffer.addFromWithRamp (ch, 0, dryBuffer.getReadPointer (ch), numSamples, (1.0f - lastDryWet), (1.0f - dryWet));
+            buffer.addFromWithRamp (ch, 0, dryBuffer.getReadPointer (ch % numDryChannels), numSamples, (1.0f - lastDryWet), (1.0f - dryWet));
         }
 
         lastDryWet = dryWet;
@@ -0,0 +1,159 @@
+#include "HalfBandIIR.h"
+
+namespace
+{
+/**
+ * Designs the allpass coefficients for a half-band filter with this many
+ * coefficients and this transition bandwidth (relative to the higher sample rate),
+ * following PolyphaseIir2Designer from HIIR.
+ */
+std::array<float, HalfBandIIR::numCoefs> designCoefficients (double transitionBandwidth)
+{
+    const auto computeAccNum = [] (double q, int order, int c)
+    {
+        double acc = 0.0;
+        double term;
+        int sign = 1;
+        int i = 0;
+        do
+        {
+            term = std::pow (q, i * (i + 1)) * std::sin ((i * 2 + 1) * c * MathConstants<double>::pi / order) * sign;
+            acc += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs (term) > 1.0e-100);
+
+        return acc;
+    };
+
+    const auto computeAccDen = [] (double q, int order, int c)
+    {
+        double acc = 0.0;
+        double term;
+        int sign = -1;
+        int i = 1;
+        do
+        {
+            term = std::pow (q, i * i) * std::cos (i * 2 * c * MathConstants<double>::pi / order) * sign;
+            acc += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs (term) > 1.0e-100);
+
+        return acc;
+    };
+
+    auto k = std::tan ((1.0 - transitionBandwidth * 2.0) * MathConstants<double>::pi / 4.0);
+    k *= k;
+    const auto kksqrt = std::pow (1.0 - k * k, 0.25);
+    const auto e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    const auto e4 = e * e * e * e;
+    const auto q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    constexpr auto order = HalfBandIIR::numCoefs * 2 + 1;
+    std::array<float, HalfBandIIR::numCoefs> coefs {};
+    for (int index = 0; index < HalfBandIIR::numCoefs; ++index)
+    {
+        const auto c = index + 1;
+        const auto num = computeAccNum (q, order, c) * std::pow (q, 0.25);
+        const auto den = computeAccDen (q, order, c) + 0.5;
+        const auto ww = num / den;
+        const auto wwsq = ww * ww;
+
+        const auto x = std::sqrt ((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+        coefs[(size_t) index] = (float) ((1.0 - x) / (1.0 + x));
+    }
+
+    return coefs;
+}
+
+constexpr auto alignment = xsimd::batch<float>::arch_type::alignment();
+} // namespace
+
+const std::array<float, HalfBandIIR::numCoefs>& HalfBandIIR::getCoefficients()
+{
+    static const auto coefs = designCoefficients (0.05);
+    return coefs;
+}
+
+HalfBandIIR::HalfBandIIR()
+{
+    // each allpass in a path gets its coefficient spread across the SIMD lanes
+    const auto& hbCoefs = getCoefficients();
+    for (int i = 0; i < numAllpassesPerPath; ++i)
+    {
+        alignas (alignment) float laneCoefs[Vec::size] {};
+        for (size_t lane = 0; lane < Vec::size; ++lane)
+            laneCoefs[lane] = hbCoefs[(size_t) (2 * i) + lane % 2];
+        coefs[i] = xsimd::load_aligned (laneCoefs);
+    }
+
+    reset();
+}
+
+void HalfBandIIR::reset() noexcept
+{
+    std::fill (std::begin (x1), std::end (x1), Vec (0.0f));
+    std::fill (std::begin (y1), std::end (y1), Vec (0.0f));
+}
+
+HalfBandIIR::Vec HalfBandIIR::processSample (Vec x) noexcept
+{
+    for (int i = 0; i < numAllpassesPerPath; ++i)
+    {
+        const auto y = coefs[i] * (x - y1[i]) + x1[i];
+        x1[i] = x;
+        y1[i] = y;
+        x = y;
+    }
+
+    return x;
+}
+
+void HalfBandIIR::decimate (const dsp::AudioBlock<const float>& input, dsp::AudioBlock<float>& output) noexcept
+{
+    const auto numChannels = (int) output.getNumChannels();
+    const auto numOutputSamples = (int) output.getNumSamples();
+    jassert (numChannels <= maxNumChannels && (int) input.getNumSamples() == 2 * numOutputSamples);
+
+    alignas (alignment) float frame[Vec::size] {};
+    for (int n = 0; n < numOutputSamples; ++n)
+    {
+        // the odd samples go through the first path, and the even samples through the second
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* x = input.getChannelPointer ((size_t) ch);
+            frame[2 * ch] = x[2 * n + 1];
+            frame[2 * ch + 1] = x[2 * n];
+        }
+
+        processSample (xsimd::load_aligned (frame)).store_aligned (frame);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            output.setSample (ch, n, 0.5f * (frame[2 * ch] + frame[2 * ch + 1]));
+    }
+}
+
+void HalfBandIIR::interpolate (const dsp::AudioBlock<const float>& input, dsp::AudioBlock<float>& output) noexcept
+{
+    const auto numChannels = (int) input.getNumChannels();
+    const auto numInputSamples = (int) input.getNumSamples();
+    jassert (numChannels <= maxNumChannels && (int) output.getNumSamples() == 2 * numInputSamples);
+
+    alignas (alignment) float frame[Vec::size] {};
+    for (int n = 0; n < numInputSamples; ++n)
+    {
+        // both paths of each channel get the same input sample
+        for (int ch = 0; ch < numChannels; ++ch)
+            frame[2 * ch] = frame[2 * ch + 1] = input.getSample (ch, n);
+
+        processSample (xsimd::load_aligned (frame)).store_aligned (frame);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* y = output.getChannelPointer ((size_t) ch);
+            y[2 * n] = frame[2 * ch];
+            y[2 * n + 1] = frame[2 * ch + 1];
+        }
+    }
+}
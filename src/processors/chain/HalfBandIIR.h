@@ -0,0 +1,50 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * A polyphase half-band IIR filter, for resampling by a factor of two.
+ *
+ * The filter is split into two chains of first-order allpass filters
+ * that run at the lower of the two sample rates (see Laurent de Soras'
+ * HIIR library), which makes it much cheaper than a FIR filter with
+ * the same stopband attenuation, at the cost of some phase distortion
+ * near the top of the passband.
+ *
+ * Both paths of both channels run together, with one lane of a SIMD
+ * register for each path of each channel.
+ *
+ * The filter passes everything below 0.225 * the higher sample rate,
+ * with more than 100 dB of attenuation above 0.275 * the higher sample rate.
+ */
+class HalfBandIIR
+{
+public:
+    static constexpr int numCoefs = 8;
+    static constexpr int maxNumChannels = 2;
+
+    HalfBandIIR();
+
+    /** Returns the allpass coefficients, with the even coefficients in the first path, and the odd coefficients in the second. */
+    static const std::array<float, numCoefs>& getCoefficients();
+
+    void reset() noexcept;
+
+    /** Filters and decimates the input, down to the output, which should have half as many samples. The output can be the same memory as the input. */
+    void decimate (const dsp::AudioBlock<const float>& input, dsp::AudioBlock<float>& output) noexcept;
+
+    /** Interpolates and filters the input, up to the output, which should have twice as many samples. The output must not overlap the input. */
+    void interpolate (const dsp::AudioBlock<const float>& input, dsp::AudioBlock<float>& output) noexcept;
+
+private:
+    using Vec = xsimd::batch<float>;
+    static_assert (Vec::size >= 2 * maxNumChannels, "SIMD registers must be wide enough for both paths of a stereo signal!");
+    static constexpr int numAllpassesPerPath = numCoefs / 2;
+
+    Vec processSample (Vec x) noexcept;
+
+    // lanes are { ch0 path0, ch0 path1, ch1 path0, ch1 path1 }
+    Vec coefs[numAllpassesPerPath];
+    Vec x1[numAllpassesPerPath];
+    Vec y1[numAllpassesPerPath];
+};
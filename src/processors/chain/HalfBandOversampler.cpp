@@ -0,0 +1,97 @@
+#include "HalfBandOversampler.h"
+
+void HalfBandOversampler::prepare (int maxNumSamples)
+{
+    for (int stage = 0; stage < maxNumStages; ++stage)
+        stageBuffers[stage].setSize (maxNumChannels, maxNumSamples << (stage + 1));
+
+    reset();
+}
+
+void HalfBandOversampler::setNumStages (int newNumStages)
+{
+    jassert (isPositiveAndNotGreaterThan (newNumStages, maxNumStages));
+    numStages = newNumStages;
+    reset();
+}
+
+float HalfBandOversampler::getLatencySamples() const noexcept
+{
+    // At low frequencies, each first-order allpass delays its path by 2 * (1 - c) / (1 + c)
+    // samples at the higher rate of its stage. The interpolator and decimator each delay the
+    // signal by the average of the two path delays (plus and minus half a sample respectively).
+    float stageRoundTripDelay = 0.0f;
+    for (auto c : HalfBandIIR::getCoefficients())
+        stageRoundTripDelay += 2.0f * (1.0f - c) / (1.0f + c);
+
+    float latency = 0.0f;
+    for (int stage = 0; stage < numStages; ++stage)
+        latency += stageRoundTripDelay / (float) (2 << stage);
+
+    return latency;
+}
+
+void HalfBandOversampler::reset() noexcept
+{
+    for (auto& stage : upStages)
+        stage.reset();
+    for (auto& stage : downStages)
+        stage.reset();
+}
+
+dsp::AudioBlock<float> HalfBandOversampler::processSamplesUp (const dsp::AudioBlock<const float>& block) noexcept
+{
+    jassert (block.getNumChannels() <= (size_t) maxNumChannels);
+
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+    if (numStages == 0)
+    {
+        auto&& outBlock = dsp::AudioBlock<float> { stageBuffers[0] }.getSubBlock (0, numSamples);
+        outBlock.getSubsetChannelBlock (0, numChannels).copyFrom (block);
+        return outBlock;
+    }
+
+    auto stageInput = block;
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        auto&& stageOutput = dsp::AudioBlock<float> { stageBuffers[stage] }
+                                 .getSubsetChannelBlock (0, numChannels)
+                                 .getSubBlock (0, numSamples << (stage + 1));
+        upStages[stage].interpolate (stageInput, stageOutput);
+        stageInput = stageOutput;
+    }
+
+    return dsp::AudioBlock<float> { stageBuffers[numStages - 1] }.getSubBlock (0, numSamples << numStages);
+}
+
+void HalfBandOversampler::processSamplesDown (dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() <= (size_t) maxNumChannels);
+
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+    if (numStages == 0)
+    {
+        block.copyFrom (dsp::AudioBlock<float> { stageBuffers[0] }.getSubsetChannelBlock (0, numChannels).getSubBlock (0, numSamples));
+        return;
+    }
+
+    for (int stage = numStages - 1; stage >= 0; --stage)
+    {
+        auto&& stageInput = dsp::AudioBlock<const float> { stageBuffers[stage] }
+                                .getSubsetChannelBlock (0, numChannels)
+                                .getSubBlock (0, numSamples << (stage + 1));
+        if (stage == 0)
+        {
+            downStages[stage].decimate (stageInput, block);
+        }
+        else
+        {
+            auto&& stageOutput = dsp::AudioBlock<float> { stageBuffers[stage - 1] }
+                                     .getSubsetChannelBlock (0, numChannels)
+                                     .getSubBlock (0, numSamples << stage);
+            downStages[stage].decimate (stageInput, stageOutput);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "HalfBandIIR.h"
+
+/**
+ * Oversampling by cascaded 2x stages of polyphase half-band IIR filters (see HalfBandIIR).
+ *
+ * Compared to the FIR oversampling modes, this has a fraction of the
+ * multiplies and much lower latency, but the phase response isn't linear
+ * near the top of the passband.
+ */
+class HalfBandOversampler
+{
+public:
+    static constexpr int maxNumStages = 4; // up to 16x
+    static constexpr int maxNumChannels = 2;
+
+    HalfBandOversampler() = default;
+
+    /** Allocates enough memory for any number of stages, for blocks of up to maxNumSamples at the base rate. */
+    void prepare (int maxNumSamples);
+
+    /** Sets the number of 2x stages. Call this before processing (it isn't real-time safe). */
+    void setNumStages (int newNumStages);
+    int getOSFactor() const noexcept { return 1 << numStages; }
+
+    /** Returns the round-trip group delay at low frequencies, in samples at the base rate. */
+    float getLatencySamples() const noexcept;
+
+    void reset() noexcept;
+
+    /**
+     * Upsamples the block, and returns a block with the oversampled signal.
+     * Like juce::dsp::Oversampling, the returned block always has maxNumChannels channels.
+     */
+    dsp::AudioBlock<float> processSamplesUp (const dsp::AudioBlock<const float>& block) noexcept;
+
+    /** Downsamples the oversampled signal back into the block. */
+    void processSamplesDown (dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    HalfBandIIR upStages[maxNumStages];
+    HalfBandIIR downStages[maxNumStages];
+    AudioBuffer<float> stageBuffers[maxNumStages]; // the output of each upsampling stage
+
+    int numStages = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HalfBandOversampler)
+};
@@ -6,6 +6,10 @@
 
 namespace
 {
+constexpr int osChangeCheckIntervalMs = 20;
+constexpr double osChangeFadeTimeSeconds = 0.01;
+constexpr double osChangeWarmUpTimeSeconds = 0.1;
+
 [[maybe_unused]] void printBufferLevels (const AudioBuffer<float>& buffer)
 {
     const auto numChannels = buffer.getNumChannels();
@@ -36,135 +40,241 @@ ProcessorChain::ProcessorChain (ProcessorStore& store,
     portMagsHelper = std::make_unique<ProcessorChainPortMagnitudesHelper> (*this);
 
     procs.ensureStorageAllocated (100);
+    rebuildSchedule();
+
+    startTimer (osChangeCheckIntervalMs);
 }
 
-ProcessorChain::~ProcessorChain() = default;
+ProcessorChain::~ProcessorChain()
+{
+    stopTimer();
+    osChangeBuildPool.removeAllJobs (true, -1); // the build job uses the oversampling board, so we need to wait for it
+}
 
 void ProcessorChain::createParameters (Parameters& params)
 {
     ChainIOProcessor::createParameters (params);
 }
 
-void ProcessorChain::initializeProcessors()
+void ProcessorChain::initializeProcessors (const std::vector<BaseProcessor*>& processorsToInitialize)
 {
-    const auto osFactor = ioProcessor.getOversamplingFactor();
     const double osSampleRate = mySampleRate * osFactor;
     const int osSamplesPerBlock = mySamplesPerBlock * osFactor;
 
-    inputProcessor.prepareProcessing (osSampleRate, osSamplesPerBlock);
-    outputProcessor.prepareProcessing (osSampleRate, osSamplesPerBlock);
+    inputProcessor.prepareProcessing (osSampleRate, osSamplesPerBlock, osFactor);
+    outputProcessor.prepareProcessing (osSampleRate, osSamplesPerBlock, osFactor);
 
-    for (int i = procs.size() - 1; i >= 0; --i)
-    {
-        if (auto* proc = procs[i])
-            proc->prepareProcessing (osSampleRate, osSamplesPerBlock);
-    }
+    for (auto iter = processorsToInitialize.rbegin(); iter != processorsToInitialize.rend(); ++iter)
+        (*iter)->prepareProcessing (osSampleRate, osSamplesPerBlock, osFactor);
+
+    scheduleSwapper.prepareCrossfade (osSampleRate);
+    osChangeFadeGain.reset (osSampleRate, osChangeFadeTimeSeconds);
 }
 
 void ProcessorChain::prepare (double sampleRate, int samplesPerBlock)
 {
+    const ScopedLock sl (osChangeLock);
+
+    // any board that was being built for an oversampling change is for the old sample rate,
+    // so the timer will drop it, and start again if the oversampling still needs to change
+    osChangeBuildPool.removeAllJobs (true, -1);
+
     mySampleRate = sampleRate;
     mySamplesPerBlock = samplesPerBlock;
 
-    inputBuffer.setSize (2, samplesPerBlock * 16); // allocate extra space for upsampled buffers
+    // allocate extra space for upsampled buffers
+    const auto maxNumProcessingSamples = getMaxNumProcessingSamples();
+    inputBuffer.setSize (2, maxNumProcessingSamples);
+    outgoingInputBuffer.setSize (2, maxNumProcessingSamples);
+    outgoingOutputBuffer.setSize (2, maxNumProcessingSamples);
 
     ioProcessor.prepare (sampleRate, samplesPerBlock);
+    osFactor = ioProcessor.getOversamplingFactor();
+    osChangeState.store (OSChangeState::Idle);
+
+    initializeProcessors ({ procs.begin(), procs.end() });
 
-    SpinLock::ScopedLockType scopedProcessingLock (processingLock);
-    initializeProcessors();
+    // the schedule's buffer pool needs to be big enough for the new block size,
+    // and its rate islands need to match the rates that the processors were prepared for
+    rebuildSchedule();
+
+    // the audio thread is not running, so we can swap in the latest schedule directly
+    scheduleSwapper.adoptPendingSchedule();
+    osChangeFadeGain.setCurrentAndTargetValue (1.0f);
 }
 
-void ProcessorChain::runProcessor (BaseProcessor* proc, AudioBuffer<float>& buffer, bool& outProcessed)
+void ProcessorChain::timerCallback()
 {
-    int nextNumProcs = 0;
-    const int numOutputs = proc->getNumOutputs();
-    for (int i = 0; i < numOutputs; ++i)
+    const ScopedLock sl (osChangeLock);
+    switch (osChangeState.load())
     {
-        const int numOutProcs = proc->getNumOutputConnections (i);
-        for (int j = 0; j < numOutProcs; ++j)
-            nextNumProcs += 1;
+        case OSChangeState::Idle:
+            osChangeBoard.reset();
+            osChangeBoardState.reset();
+            if (ioProcessor.prepareNextOversampling())
+                startBuildingOversamplingBoard();
+            break;
+
+        case OSChangeState::Building:
+            if (osChangeBoardReady.load())
+                finishBuildingOversamplingBoard();
+            break;
+
+        case OSChangeState::Swapping:
+            swapInOversamplingBoard();
+            break;
+
+        case OSChangeState::FadingOut:
+        case OSChangeState::Ready:
+            break;
     }
+}
 
-    if (proc == &outputProcessor) // we've reached the output processor, so we're done!
+void ProcessorChain::startBuildingOversamplingBoard()
+{
+    osChangeBoard.reset();
+    osChangeBoardState.reset();
+
+    const auto nextOSFactor = ioProcessor.getNextOversamplingFactor();
+    if (nextOSFactor == osFactor)
     {
-        proc->processAudioBlock (buffer);
-        outProcessed = true;
+        // only the oversampling filter has changed, so the processors can stay as they are
+        osChangeState.store (OSChangeState::FadingOut);
         return;
     }
 
-    if (numOutputs == 0) // this processor has no outputs, so after we process, we're done!
+    // some processors need the message thread in their constructors, so the board gets
+    // created here, and only the preparing and warming up happens on the build thread
+    osChangeBoardState = stateHelper->saveProcChain();
+    osChangeBoard = stateHelper->createStandbyBoard (osChangeBoardState.get(), chowdsp::Version { JucePlugin_VersionString });
+    if (osChangeBoard == nullptr)
     {
-        proc->processAudioBlock (buffer);
+        // the processors will have to be prepared in-place instead
+        osChangeState.store (OSChangeState::FadingOut);
         return;
     }
 
-    if (nextNumProcs == 0) // the output of this processor is connected to nothing, so let's not waste our processing...
-    {
-        if (proc == &inputProcessor)
-            inputProcessor.resetLevels();
+    osChangeBoardReady.store (false);
+    osChangeState.store (OSChangeState::Building);
+    osChangeBuildPool.addJob (
+        [this, sampleRate = mySampleRate * nextOSFactor, samplesPerBlock = mySamplesPerBlock * nextOSFactor, nextOSFactor]
+        {
+            osChangeBoard->prepare (sampleRate, samplesPerBlock, nextOSFactor);
+            osChangeBoard->warmUp (osChangeWarmUpTimeSeconds);
+            osChangeBoardReady.store (true);
+        });
+}
 
+void ProcessorChain::finishBuildingOversamplingBoard()
+{
+    // the oversampling parameters might have changed again while the board was being built
+    if (! ioProcessor.prepareNextOversampling())
+    {
+        osChangeState.store (OSChangeState::Idle);
         return;
     }
 
-    proc->processAudioBlock (buffer);
-
-    auto processBuffer = [&] (BaseProcessor* nextProc, int inputIndex, AudioBuffer<float>& nextBuffer)
+    const auto nextOSFactor = ioProcessor.getNextOversamplingFactor();
+    if (! osChangeBoard->isPreparedFor (mySampleRate * nextOSFactor, mySamplesPerBlock * nextOSFactor, nextOSFactor)
+        || ! stateHelper->matchesChainLayout (*osChangeBoard, *osChangeBoardState))
     {
-        int nextNumInputs = nextProc->getNumInputs();
-        if (nextNumProcs == 1 && nextNumInputs == 1)
-        {
-            runProcessor (nextProc, nextBuffer, outProcessed);
-        }
-        else if (nextNumProcs > 1 && nextNumInputs == 1)
-        {
-            auto& copyNextBuffer = nextProc->getInputBuffer();
-            copyNextBuffer.makeCopyOf (nextBuffer, true);
-            runProcessor (nextProc, copyNextBuffer, outProcessed);
-        }
-        else
-        {
-            auto& copyNextBuffer = nextProc->getInputBuffer (inputIndex);
-            copyNextBuffer.makeCopyOf (nextBuffer, true);
+        startBuildingOversamplingBoard();
+        return;
+    }
 
-            nextProc->incrementNumInputsReady();
-            if (nextProc->getNumInputsReady() < nextProc->getNumInputConnections())
-                return; // not all the inputs are ready yet...
+    osChangeState.store (OSChangeState::FadingOut);
+}
 
-            runProcessor (nextProc, copyNextBuffer, outProcessed);
-        }
-    };
+void ProcessorChain::swapInOversamplingBoard()
+{
+    // the audio thread has stopped using the processors, so they can be swapped out here
+    const auto previousOSFactor = std::exchange (osFactor, ioProcessor.getNextOversamplingFactor());
+    initializeProcessors ({});
 
-    for (int i = 0; i < numOutputs; ++i)
+    const auto boardLoaded = osChangeBoard != nullptr && stateHelper->loadOversamplingBoard (*osChangeBoard, *osChangeBoardState);
+    if (! boardLoaded && osFactor != previousOSFactor)
     {
-        auto* outBuffer = proc->getOutputBuffer (i);
-        if (outBuffer == nullptr)
-            outBuffer = &buffer;
+        // the processors have changed since the board was built, so they need to be prepared in-place
+        initializeProcessors ({ procs.begin(), procs.end() });
+    }
 
-        const int numOutProcs = proc->getNumOutputConnections (i);
-        for (int j = numOutProcs - 1; j >= 0; --j)
-        {
-            const auto& connectionInfo = proc->getOutputConnection (i, j);
-            processBuffer (connectionInfo.endProc, connectionInfo.endPort, *outBuffer);
+    // the processors' rate islands depend on the oversampling factor
+    rebuildSchedule();
+    scheduleSwapper.adoptPendingSchedule();
+    osChangeState.store (OSChangeState::Ready);
+}
 
-            nextNumProcs -= 1;
-        }
+bool ProcessorChain::updateOversamplingChange()
+{
+    // The message thread can change the state at any time, so we only act on the state that
+    // we loaded here. Returns false if the processors can't be used for this block.
+    switch (osChangeState.load())
+    {
+        case OSChangeState::Idle:
+        case OSChangeState::Building:
+            return true;
+
+        case OSChangeState::FadingOut:
+            if (osChangeFadeGain.getTargetValue() != 0.0f)
+            {
+                osChangeFadeGain.setTargetValue (0.0f);
+            }
+            else if (! osChangeFadeGain.isSmoothing())
+            {
+                // from here on, the message thread might be swapping out the processors
+                osChangeState.store (OSChangeState::Swapping);
+                return false;
+            }
+            return true;
+
+        case OSChangeState::Swapping:
+            return false;
+
+        case OSChangeState::Ready:
+            // the processors have been prepared for the new oversampling factor, so they can only run through the new oversampler
+            ioProcessor.swapInNextOversampling();
+            osChangeFadeGain.setCurrentAndTargetValue (0.0f);
+            osChangeFadeGain.setTargetValue (1.0f);
+            osChangeState.store (OSChangeState::Idle);
+            return true;
     }
+
+    jassertfalse;
+    return false;
+}
+
+void ProcessorChain::processSilentChain (AudioBuffer<float>& buffer)
+{
+    // keep the input/output processing (and the dry signal) running while the processors are unavailable
+    auto osBlock = ioProcessor.processAudioInput (buffer);
+    inputBuffer.setSize ((int) osBlock.getNumChannels(), (int) osBlock.getNumSamples(), false, false, true);
+    inputBuffer.clear();
+    ioProcessor.processAudioOutput (inputBuffer, buffer);
+}
+
+void ProcessorChain::rebuildSchedule (double overlapTimeSeconds)
+{
+    auto newSchedule = std::make_unique<ProcessorChainSchedule>();
+    newSchedule->compile (inputProcessor, outputProcessor, procs, getMaxNumProcessingSamples());
+    newSchedule->setOverlapTime (overlapTimeSeconds);
+    scheduleSwapper.publish (std::move (newSchedule));
 }
 
 void ProcessorChain::processAudio (AudioBuffer<float>& buffer)
 {
-    SpinLock::ScopedTryLockType tryProcessingLock (processingLock);
-    if (! tryProcessingLock.isLocked())
+    if (! updateOversamplingChange())
+    {
+        processSilentChain (buffer);
         return;
+    }
+
+    auto& schedule = scheduleSwapper.getScheduleForBlock();
 
     // process input (oversampling, input gain, etc)
-    bool sampleRateChange = false;
-    auto osBlock = ioProcessor.processAudioInput (buffer, sampleRateChange);
-    if (sampleRateChange)
-        initializeProcessors();
+    auto osBlock = ioProcessor.processAudioInput (buffer);
 
     // prepare port magnitudes
-    portMagsHelper->preparePortMagnitudes();
+    portMagsHelper->preparePortMagnitudes (schedule.getProcessors());
 
     const auto osNumSamples = (int) osBlock.getNumSamples();
     const auto inputNumChannels = (int) osBlock.getNumChannels();
@@ -178,33 +288,56 @@ void ProcessorChain::processAudio (AudioBuffer<float>& buffer)
             inputBuffer.copyFrom (ch, 0, osBlock.getChannelPointer ((size_t) ch), osNumSamples);
     }
 
-    // process standalone modulation ports
-    bool outProcessed = false;
-    for (auto* processor : procs)
+    // if a standby board has just been swapped in, keep the old board running while it fades out
+    auto* outgoingSchedule = scheduleSwapper.getOutgoingSchedule();
+    if (outgoingSchedule != nullptr)
     {
-        auto noInputsConnected = processor->getNumInputConnections() == 0;
-        auto modOutputConnected = processor->isOutputModulationPortConnected();
-        if (noInputsConnected && modOutputConnected)
-            runProcessor (processor, inputBuffer, outProcessed);
+        outgoingInputBuffer.makeCopyOf (inputBuffer, true);
+        const auto outgoingProcessed = threadPool->isEnabled() ? outgoingSchedule->process (outgoingInputBuffer, *threadPool)
+                                                              : outgoingSchedule->process (outgoingInputBuffer);
+
+        auto* outgoingOutput = outputProcessor.getOutputBuffer();
+        if (outgoingProcessed && outgoingOutput != nullptr)
+        {
+            outgoingOutputBuffer.makeCopyOf (*outgoingOutput, true);
+        }
+        else
+        {
+            outgoingOutputBuffer.setSize (inputNumChannels, osNumSamples, false, false, true);
+            outgoingOutputBuffer.clear();
+        }
     }
 
     // run processing chain
-    runProcessor (&inputProcessor, inputBuffer, outProcessed);
-
-    for (auto* processor : procs)
-        processor->clearNumInputsReady();
+    const auto outProcessed = threadPool->isEnabled() ? schedule.process (inputBuffer, *threadPool)
+                                                     : schedule.process (inputBuffer);
 
     if (! outProcessed)
     {
+        osChangeFadeGain.skip (osNumSamples);
         outputProcessor.resetLevels();
         inputBuffer.clear();
+
+        if (outgoingSchedule != nullptr)
+            scheduleSwapper.applyOverlap (inputBuffer, outgoingOutputBuffer);
+
         ioProcessor.processAudioOutput (inputBuffer, buffer);
     }
     else
     {
         // do output processing (downsampling, output gain)
         if (auto* outBuffer = outputProcessor.getOutputBuffer())
+        {
+            if (outgoingSchedule != nullptr)
+                scheduleSwapper.applyOverlap (*outBuffer, outgoingOutputBuffer);
+
+            if (osChangeFadeGain.isSmoothing())
+                osChangeFadeGain.applyGain (*outBuffer, outBuffer->getNumSamples());
+            else if (osChangeFadeGain.getTargetValue() == 0.0f)
+                outBuffer->clear();
+
             ioProcessor.processAudioOutput (*outBuffer, buffer);
+        }
         else
             jassertfalse; // output buffer is null after output was processed?
     }
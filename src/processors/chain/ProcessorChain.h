@@ -2,6 +2,8 @@
 
 #include "../ProcessorStore.h"
 #include "ChainIOProcessor.h"
+#include "ProcessorChainScheduleSwapper.h"
+#include "ProcessorChainThreadPool.h"
 
 #include "../utility/InputProcessor.h"
 #include "../utility/OutputProcessor.h"
@@ -9,8 +11,10 @@
 class ProcessorChainActionHelper;
 class ProcessorChainPortMagnitudesHelper;
 class ProcessorChainStateHelper;
+class ProcessorChainStandbyBoard;
 class ParamForwardManager;
-class ProcessorChain : private AudioProcessorValueTreeState::Listener
+class ProcessorChain : private AudioProcessorValueTreeState::Listener,
+                       private Timer
 {
 public:
     ProcessorChain (ProcessorStore& store,
@@ -35,6 +39,12 @@ public:
     auto& getStateHelper() { return *stateHelper; }
     auto& getOversampling() { return ioProcessor.getOversampling(); }
 
+    /** Returns the (oversampled) sample rate and block size that the processors are prepared for. */
+    std::pair<double, int> getProcessingSpec() const noexcept { return { mySampleRate * osFactor, mySamplesPerBlock * osFactor }; }
+
+    /** Returns the oversampling factor that the processors are prepared for. */
+    int getOversamplingFactor() const noexcept { return osFactor; }
+
     chowdsp::Broadcaster<void (BaseProcessor*)> processorAddedBroadcaster;
     chowdsp::Broadcaster<void (const BaseProcessor*)> processorRemovedBroadcaster;
     chowdsp::Broadcaster<void()> refreshConnectionsBroadcaster;
@@ -42,21 +52,63 @@ public:
     chowdsp::Broadcaster<void (const ConnectionInfo&)> connectionRemovedBroadcaster;
 
 private:
-    void initializeProcessors();
-    void runProcessor (BaseProcessor* proc, AudioBuffer<float>& buffer, bool& outProcessed);
+    void initializeProcessors (const std::vector<BaseProcessor*>& processorsToInitialize);
+    void rebuildSchedule (double overlapTimeSeconds = 0.0);
+
+    /** The largest block that the processors might have to run on, so that the buffers don't need to be resized when the oversampling factor changes. */
+    int getMaxNumProcessingSamples() const noexcept { return mySamplesPerBlock * ChainIOProcessor::maxOversamplingFactor; }
     void parameterChanged (const juce::String& parameterID, float newValue) override;
 
+    void timerCallback() override;
+    void startBuildingOversamplingBoard();
+    void finishBuildingOversamplingBoard();
+    void swapInOversamplingBoard();
+    bool updateOversamplingChange();
+    void processSilentChain (AudioBuffer<float>& buffer);
+
     double mySampleRate = 48000.0;
     int mySamplesPerBlock = 512;
+    int osFactor = 1; // the oversampling factor that the processors are prepared for
+
+    /**
+     * When the oversampling factor changes, the message thread builds a copy of the
+     * board from the chain's state, and a background thread prepares it for the new
+     * sample rate and warms it up, while the audio thread keeps running the old
+     * processors through the old oversampler. Once the board is ready, the audio
+     * thread fades out the chain and stops using the processors, so the message thread
+     * can swap the new board into the chain. The audio thread then swaps in the new
+     * oversampler at the next block boundary, and fades the chain back in. The wet
+     * signal is only silent during the swap itself (only the dry signal gets through).
+     */
+    enum class OSChangeState
+    {
+        Idle,
+        Building,
+        FadingOut,
+        Swapping,
+        Ready,
+    };
+    std::atomic<OSChangeState> osChangeState { OSChangeState::Idle };
+    CriticalSection osChangeLock; // stops prepare() from running in the middle of an oversampling change on the message thread
+    std::unique_ptr<ProcessorChainStandbyBoard> osChangeBoard;
+    std::unique_ptr<XmlElement> osChangeBoardState; // the chain state that the board was built from
+    std::atomic<bool> osChangeBoardReady { false };
+    ThreadPool osChangeBuildPool { 1 };
+    SmoothedValue<float, ValueSmoothingTypes::Linear> osChangeFadeGain;
 
     OwnedArray<BaseProcessor> procs;
     ProcessorStore& procStore;
-    SpinLock processingLock;
+    SharedResourcePointer<ProcessorChainThreadPool> threadPool;
+    ProcessorChainScheduleSwapper scheduleSwapper { *threadPool };
     UndoManager* um;
 
     InputProcessor inputProcessor;
     AudioBuffer<float> inputBuffer;
     OutputProcessor outputProcessor;
+
+    // buffers for the board that is being crossfaded out when a standby board is swapped in
+    AudioBuffer<float> outgoingInputBuffer;
+    AudioBuffer<float> outgoingOutputBuffer;
     ChainIOProcessor ioProcessor;
 
     std::unique_ptr<chowdsp::PresetManager>& presetManager;
@@ -64,6 +116,7 @@ private:
     friend class ProcChainActions;
     friend class AddOrRemoveProcessor;
     friend class AddOrRemoveConnection;
+    friend class ReorderProcessors;
 
     friend class ProcessorChainActionHelper;
     std::unique_ptr<ProcessorChainActionHelper> actionHelper;
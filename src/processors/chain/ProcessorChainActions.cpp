@@ -25,14 +25,10 @@ public:
     {
         Logger::writeToLog (String ("Creating processor: ") + newProc->getName());
 
-        auto osFactor = chain.ioProcessor.getOversamplingFactor();
-        newProc->prepareProcessing (osFactor * chain.mySampleRate, osFactor * chain.mySamplesPerBlock);
+        const auto osFactor = chain.osFactor;
+        newProc->prepareProcessing (osFactor * chain.mySampleRate, osFactor * chain.mySamplesPerBlock, osFactor);
 
-        BaseProcessor* newProcPtr = nullptr;
-        {
-            SpinLock::ScopedLockType scopedProcessingLock (chain.processingLock);
-            newProcPtr = chain.procs.add (std::move (newProc));
-        }
+        auto* newProcPtr = chain.procs.add (std::move (newProc));
 
         for (auto* param : newProcPtr->getParameters())
         {
@@ -40,6 +36,8 @@ public:
                 newProcPtr->getVTS().addParameterListener (paramCast->paramID, &chain);
         }
 
+        chain.rebuildSchedule();
+
         chain.processorAddedBroadcaster (newProcPtr);
     }
 
@@ -57,8 +55,8 @@ public:
                 procToRemove->getVTS().removeParameterListener (paramCast->paramID, &chain);
         }
 
-        SpinLock::ScopedLockType scopedProcessingLock (chain.processingLock);
         saveProc.reset (chain.procs.removeAndReturn (chain.procs.indexOf (procToRemove)));
+        chain.rebuildSchedule();
     }
 
     static void addConnection (ProcessorChain& chain, const ConnectionInfo& info)
@@ -68,6 +66,7 @@ public:
                             + String (info.endPort));
 
         info.startProc->addConnection (ConnectionInfo (info));
+        chain.rebuildSchedule();
         chain.connectionAddedBroadcaster (info);
     }
 
@@ -78,6 +77,7 @@ public:
                             + String (info.endPort));
 
         info.startProc->removeConnection (info);
+        chain.rebuildSchedule();
         chain.connectionRemovedBroadcaster (info);
     }
 
@@ -108,6 +108,12 @@ AddOrRemoveProcessor::AddOrRemoveProcessor (ProcessorChain& procChain, BaseProce
 {
 }
 
+AddOrRemoveProcessor::~AddOrRemoveProcessor()
+{
+    // the audio thread might still be running an old schedule that uses this processor
+    chain.scheduleSwapper.retireProcessor (std::move (actionProc));
+}
+
 template <typename PointerType>
 bool waitForPointerCheck (const PointerType& pointer, int waitCycles = 6)
 {
@@ -217,3 +223,60 @@ bool AddOrRemoveConnection::undo()
 
     return true;
 }
+
+//=========================================================
+LoadProcessorState::LoadProcessorState (BaseProcessor* proc, const XmlElement& stateToLoad, const chowdsp::Version& stateVersion)
+    : processor (proc),
+      oldState (proc->toXML()),
+      newState (stateToLoad),
+      version (stateVersion)
+{
+}
+
+bool LoadProcessorState::perform()
+{
+    processor->fromXML (&newState, version);
+    return true;
+}
+
+bool LoadProcessorState::undo()
+{
+    processor->fromXML (oldState.get(), chowdsp::Version { JucePlugin_VersionString });
+    return true;
+}
+
+//=========================================================
+ReorderProcessors::ReorderProcessors (ProcessorChain& procChain, std::vector<BaseProcessor*>&& order)
+    : chain (procChain),
+      newOrder (std::move (order))
+{
+}
+
+void ReorderProcessors::applyOrder (const std::vector<BaseProcessor*>& order)
+{
+    // processors that aren't in the chain any more are skipped, and any that aren't in the order stay at the end
+    int targetIdx = 0;
+    for (auto* proc : order)
+    {
+        const auto currentIdx = chain.procs.indexOf (proc);
+        if (currentIdx < 0)
+            continue;
+
+        if (currentIdx != targetIdx)
+            chain.procs.move (currentIdx, targetIdx);
+        targetIdx++;
+    }
+}
+
+bool ReorderProcessors::perform()
+{
+    oldOrder.assign (chain.procs.begin(), chain.procs.end());
+    applyOrder (newOrder);
+    return true;
+}
+
+bool ReorderProcessors::undo()
+{
+    applyOrder (oldOrder);
+    return true;
+}
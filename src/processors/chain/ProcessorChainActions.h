@@ -12,6 +12,7 @@ class AddOrRemoveProcessor : public UndoableAction
 public:
     AddOrRemoveProcessor (ProcessorChain& procChain, BaseProcessor::Ptr newProc);
     AddOrRemoveProcessor (ProcessorChain& procChain, BaseProcessor* procToRemove);
+    ~AddOrRemoveProcessor() override;
 
     bool perform() override;
     bool undo() override;
@@ -45,3 +46,42 @@ private:
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AddOrRemoveConnection)
 };
+
+/** Loads a new state into a processor that is already in the chain, keeping the old state for undo. */
+class LoadProcessorState : public UndoableAction
+{
+public:
+    LoadProcessorState (BaseProcessor* proc, const XmlElement& newState, const chowdsp::Version& stateVersion);
+
+    bool perform() override;
+    bool undo() override;
+    int getSizeInUnits() override { return (int) sizeof (*this); }
+
+private:
+    BaseProcessor* processor;
+    const std::unique_ptr<XmlElement> oldState;
+    XmlElement newState;
+    const chowdsp::Version version;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadProcessorState)
+};
+
+/** Moves the processors in the chain into a new order, keeping the old order for undo. */
+class ReorderProcessors : public UndoableAction
+{
+public:
+    ReorderProcessors (ProcessorChain& procChain, std::vector<BaseProcessor*>&& order);
+
+    bool perform() override;
+    bool undo() override;
+    int getSizeInUnits() override { return (int) sizeof (*this); }
+
+private:
+    void applyOrder (const std::vector<BaseProcessor*>& order);
+
+    ProcessorChain& chain;
+    const std::vector<BaseProcessor*> newOrder;
+    std::vector<BaseProcessor*> oldOrder;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReorderProcessors)
+};
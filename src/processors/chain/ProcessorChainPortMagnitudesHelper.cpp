@@ -28,7 +28,7 @@ void ProcessorChainPortMagnitudesHelper::globalSettingChanged (SettingID setting
     portMagsOn.store (isNowOn);
 }
 
-void ProcessorChainPortMagnitudesHelper::preparePortMagnitudes()
+void ProcessorChainPortMagnitudesHelper::preparePortMagnitudes (const std::vector<BaseProcessor*>& processors)
 {
     if (portMagsOn.load() == prevPortMagsOn)
         return;
@@ -37,6 +37,6 @@ void ProcessorChainPortMagnitudesHelper::preparePortMagnitudes()
 
     chain.getInputProcessor().resetPortMagnitudes (prevPortMagsOn);
     chain.getOutputProcessor().resetPortMagnitudes (prevPortMagsOn);
-    for (auto* proc : chain.getProcessors())
+    for (auto* proc : processors)
         proc->resetPortMagnitudes (prevPortMagsOn);
 }
@@ -0,0 +1,629 @@
+#include "ProcessorChainSchedule.h"
+#include "ProcessorChainThreadPool.h"
+#include "processors/utility/InputProcessor.h"
+#include "processors/utility/OutputProcessor.h"
+
+void ProcessorChainSchedule::compile (InputProcessor& inputProc, OutputProcessor& outputProc, const OwnedArray<BaseProcessor>& procs, int maxNumSamples)
+{
+    inputProcessor = &inputProc;
+    outputProcessor = &outputProc;
+    inputConnected = false;
+    outputReached = false;
+
+    processors.assign (procs.begin(), procs.end());
+
+    steps.clear();
+    steps.reserve ((size_t) procs.size() + 2);
+    connections.clear();
+
+    std::unordered_map<BaseProcessor*, int> numInputsReady;
+
+    // standalone modulation processors are scheduled first
+    for (auto* proc : procs)
+    {
+        auto noInputsConnected = proc->getNumInputConnections() == 0;
+        auto modOutputConnected = proc->isOutputModulationPortConnected();
+        if (noInputsConnected && modOutputConnected)
+            scheduleProcessor (proc, {}, numInputsReady);
+    }
+
+    scheduleProcessor (&inputProc, {}, numInputsReady);
+
+    stepBuffers.resize (steps.size(), nullptr);
+    resolveConnections();
+    computeDependencies();
+    assignPoolBuffers (maxNumSamples);
+    assignRateIslands (maxNumSamples);
+    assignConnectionFades();
+    connections.clear();
+}
+
+void ProcessorChainSchedule::resolveConnections()
+{
+    std::unordered_map<BaseProcessor*, int> stepIndices;
+    for (int stepIndex = 0; stepIndex < (int) steps.size(); ++stepIndex)
+        stepIndices[steps[(size_t) stepIndex].proc] = stepIndex;
+
+    // multi-input processors whose inputs are not all ready will never be scheduled,
+    // and single-input processors with nothing connected to their outputs are skipped
+    for (auto& connection : connections)
+    {
+        if (auto iter = stepIndices.find (connection.toProc); iter != stepIndices.end())
+            connection.toStep = iter->second;
+    }
+
+    auto isChainInputStep = [] (const Step& step)
+    { return step.sourceStep < 0 && step.sourceConnection < 0; };
+
+    int lastChainInputStep = -1;
+    for (int stepIndex = 0; stepIndex < (int) steps.size(); ++stepIndex)
+    {
+        if (isChainInputStep (steps[(size_t) stepIndex]))
+            lastChainInputStep = stepIndex;
+    }
+
+    // The chain input buffer gets overwritten by every step that works on it directly,
+    // so views of a buffer that might be the chain input are only safe once nothing
+    // else is going to write to the chain input later on.
+    std::vector<bool> mightUseChainInput (steps.size(), false);
+    for (int stepIndex = 0; stepIndex < (int) steps.size(); ++stepIndex)
+    {
+        const auto& step = steps[(size_t) stepIndex];
+        bool usesChainInput = isChainInputStep (step) || (step.sourceStep >= 0 && mightUseChainInput[(size_t) step.sourceStep]);
+
+        for (auto& connection : connections)
+        {
+            if (connection.toStep != stepIndex || ! connection.isView)
+                continue;
+
+            if (mightUseChainInput[(size_t) connection.fromStep])
+            {
+                if (connection.fromStep < lastChainInputStep)
+                    connection.isView = false;
+                else
+                    usesChainInput = true;
+            }
+        }
+
+        mightUseChainInput[(size_t) stepIndex] = usesChainInput;
+    }
+
+    for (int connectionIndex = 0; connectionIndex < (int) connections.size(); ++connectionIndex)
+    {
+        const auto& connection = connections[(size_t) connectionIndex];
+        if (connection.toStep < 0)
+            continue;
+
+        auto& toStep = steps[(size_t) connection.toStep];
+        if (toStep.proc->getNumInputs() > 1)
+        {
+            toStep.inputRoutes.resize ((size_t) toStep.proc->getNumInputs());
+            if (connection.isView)
+                toStep.inputRoutes[(size_t) connection.toInput] = { -1, connection.fromStep, connection.fromPort };
+        }
+    }
+}
+
+void ProcessorChainSchedule::computeDependencies()
+{
+    auto addDependency = [this] (int fromStep, int toStep)
+    {
+        steps[(size_t) fromStep].dependents.push_back (toStep);
+        steps[(size_t) toStep].numDependencies++;
+    };
+
+    for (int stepIndex = 0; stepIndex < (int) steps.size(); ++stepIndex)
+    {
+        const auto& step = steps[(size_t) stepIndex];
+        if (step.sourceConnection < 0)
+        {
+            if (step.sourceStep >= 0)
+            {
+                addDependency (step.sourceStep, stepIndex);
+            }
+            else
+            {
+                // steps that work on the chain input buffer need to run after everything that was scheduled before them
+                for (int prevStepIndex = 0; prevStepIndex < stepIndex; ++prevStepIndex)
+                    addDependency (prevStepIndex, stepIndex);
+            }
+        }
+    }
+
+    for (const auto& connection : connections)
+    {
+        if (connection.toStep >= 0)
+            addDependency (connection.fromStep, connection.toStep);
+    }
+
+    stepStates = std::make_unique<std::atomic<uint64_t>[]> (steps.size());
+    for (size_t stepIndex = 0; stepIndex < steps.size(); ++stepIndex)
+        stepStates[stepIndex].store (makeStepState (0, steps[stepIndex].numDependencies, true));
+}
+
+void ProcessorChainSchedule::assignPoolBuffers (int maxNumSamples)
+{
+    const auto numSteps = steps.size();
+
+    // steps are always ordered after their dependencies, so we can find
+    // everything that is guaranteed to run before each step in one pass
+    std::vector<std::vector<bool>> runsBefore (numSteps, std::vector<bool> (numSteps, false));
+    for (size_t stepIndex = 0; stepIndex < numSteps; ++stepIndex)
+    {
+        for (auto dependent : steps[stepIndex].dependents)
+        {
+            auto& dependentRunsBefore = runsBefore[(size_t) dependent];
+            dependentRunsBefore[stepIndex] = true;
+            for (size_t i = 0; i < stepIndex; ++i)
+            {
+                if (runsBefore[stepIndex][i])
+                    dependentRunsBefore[i] = true;
+            }
+        }
+    }
+
+    // steps that keep working on the buffer that was handed to another step, either in-place or through a view
+    std::vector<std::vector<int>> bufferUsers (numSteps);
+    for (int stepIndex = 0; stepIndex < (int) numSteps; ++stepIndex)
+    {
+        if (const auto& step = steps[(size_t) stepIndex]; step.sourceConnection < 0 && step.sourceStep >= 0)
+            bufferUsers[(size_t) step.sourceStep].push_back (stepIndex);
+    }
+    for (const auto& connection : connections)
+    {
+        if (connection.toStep >= 0 && connection.isView)
+            bufferUsers[(size_t) connection.fromStep].push_back (connection.toStep);
+    }
+
+    std::vector<int> poolCopies;
+    for (int connectionIndex = 0; connectionIndex < (int) connections.size(); ++connectionIndex)
+    {
+        const auto& connection = connections[(size_t) connectionIndex];
+        if (connection.toStep >= 0 && ! connection.isView)
+            poolCopies.push_back (connectionIndex);
+    }
+    std::stable_sort (poolCopies.begin(), poolCopies.end(), [this] (int a, int b)
+                      { return connections[(size_t) a].fromStep < connections[(size_t) b].fromStep; });
+
+    // Each pool buffer is live from the step that copies into it, until every step that works on
+    // it has finished. A pool buffer can be re-used once all of its previous users are guaranteed
+    // to have finished before the next copy is made, no matter how the steps get spread across threads.
+    std::vector<std::vector<int>> poolBufferUsers;
+    for (auto connectionIndex : poolCopies)
+    {
+        auto& connection = connections[(size_t) connectionIndex];
+
+        std::vector<int> liveSteps { connection.fromStep, connection.toStep };
+        for (size_t i = 1; i < liveSteps.size(); ++i)
+        {
+            for (auto user : bufferUsers[(size_t) liveSteps[i]])
+                liveSteps.push_back (user);
+        }
+
+        const auto& writerRunsAfter = runsBefore[(size_t) connection.fromStep];
+        for (int poolIndex = 0; poolIndex < (int) poolBufferUsers.size(); ++poolIndex)
+        {
+            auto& prevUsers = poolBufferUsers[(size_t) poolIndex];
+            if (std::all_of (prevUsers.begin(), prevUsers.end(), [&writerRunsAfter] (int user)
+                             { return writerRunsAfter[(size_t) user]; }))
+            {
+                connection.poolIndex = poolIndex;
+                prevUsers.insert (prevUsers.end(), liveSteps.begin(), liveSteps.end());
+                break;
+            }
+        }
+
+        if (connection.poolIndex < 0)
+        {
+            connection.poolIndex = (int) poolBufferUsers.size();
+            poolBufferUsers.push_back (std::move (liveSteps));
+        }
+
+        steps[(size_t) connection.fromStep].copies.push_back ({ connection.fromPort, connection.poolIndex });
+
+        auto& toStep = steps[(size_t) connection.toStep];
+        if (toStep.sourceConnection == connectionIndex)
+            toStep.poolIndex = connection.poolIndex;
+        if (! toStep.inputRoutes.empty())
+            toStep.inputRoutes[(size_t) connection.toInput] = { connection.poolIndex, -1, 0 };
+    }
+
+    bufferPool.resize (poolBufferUsers.size());
+    for (auto& buffer : bufferPool)
+    {
+        buffer.setSize (2, maxNumSamples);
+        buffer.clear();
+    }
+}
+
+void ProcessorChainSchedule::assignRateIslands (int maxNumSamples)
+{
+    // everything downstream that reads each step's output: steps working in-place on it, copies, and views
+    std::vector<int> numOutputReaders (steps.size(), 0);
+    for (const auto& step : steps)
+    {
+        if (step.sourceConnection < 0 && step.sourceStep >= 0)
+            numOutputReaders[(size_t) step.sourceStep]++;
+
+        for (const auto& route : step.inputRoutes)
+        {
+            if (route.poolIndex < 0 && route.sourceStep >= 0)
+                numOutputReaders[(size_t) route.sourceStep]++;
+        }
+    }
+    for (size_t stepIndex = 0; stepIndex < steps.size(); ++stepIndex)
+        numOutputReaders[stepIndex] += (int) steps[stepIndex].copies.size();
+
+    rateIslands.clear();
+    for (int stepIndex = 0; stepIndex < (int) steps.size(); ++stepIndex)
+    {
+        auto& step = steps[(size_t) stepIndex];
+        const auto rateDivisor = step.proc->getRateDivisor();
+        if (rateDivisor <= 1)
+            continue;
+
+        // A step that works in-place on the output of a step at the same rate can join its island,
+        // as long as nothing else reads that step's output, since the island's output doesn't get
+        // resampled back to the chain's rate until the end of the island.
+        if (step.sourceConnection < 0 && step.sourceStep >= 0 && numOutputReaders[(size_t) step.sourceStep] == 1)
+        {
+            auto& sourceStep = steps[(size_t) step.sourceStep];
+            if (sourceStep.rateIsland >= 0 && sourceStep.proc->getRateDivisor() == rateDivisor)
+            {
+                step.rateIsland = sourceStep.rateIsland;
+                sourceStep.resamplesOutput = false;
+                step.resamplesOutput = true;
+                continue;
+            }
+        }
+
+        step.rateIsland = (int) rateIslands.size();
+        step.resamplesInput = true;
+        step.resamplesOutput = true;
+
+        auto& resampler = rateIslands.emplace_back (std::make_unique<RateIslandResampler>());
+        resampler->prepare (rateDivisor, maxNumSamples);
+    }
+}
+
+void ProcessorChainSchedule::assignConnectionFades()
+{
+    connectionFades.clear();
+    for (const auto& step : steps)
+    {
+        if (step.sourceConnection < 0 && step.sourceStep >= 0)
+            connectionFades.push_back ({ steps[(size_t) step.sourceStep].proc, step.sourcePort, step.proc, 0 });
+    }
+    for (const auto& connection : connections)
+    {
+        if (connection.toStep >= 0)
+            connectionFades.push_back ({ steps[(size_t) connection.fromStep].proc, connection.fromPort, connection.toProc, connection.toInput });
+    }
+
+    std::sort (connectionFades.begin(), connectionFades.end(), [] (const ConnectionFade& a, const ConnectionFade& b)
+               { return a.getKey() < b.getKey(); });
+
+    auto findFade = [this] (int fromStep, int fromPort, const BaseProcessor* toProc, int toPort)
+    {
+        const auto key = std::make_tuple ((const BaseProcessor*) steps[(size_t) fromStep].proc, fromPort, toProc, toPort);
+        const auto iter = std::lower_bound (connectionFades.begin(), connectionFades.end(), key, [] (const ConnectionFade& fade, const auto& k)
+                                            { return fade.getKey() < k; });
+        jassert (iter != connectionFades.end() && iter->getKey() == key);
+        return (int) std::distance (connectionFades.begin(), iter);
+    };
+
+    for (auto& step : steps)
+    {
+        step.connectedInputs = step.proc->getConnectedInputsMask();
+        if (step.sourceConnection < 0 && step.sourceStep >= 0)
+            step.inputFade = findFade (step.sourceStep, step.sourcePort, step.proc, 0);
+    }
+
+    for (int connectionIndex = 0; connectionIndex < (int) connections.size(); ++connectionIndex)
+    {
+        const auto& connection = connections[(size_t) connectionIndex];
+        if (connection.toStep < 0)
+            continue;
+
+        const auto fadeIndex = findFade (connection.fromStep, connection.fromPort, connection.toProc, connection.toInput);
+        auto& toStep = steps[(size_t) connection.toStep];
+        if (! toStep.inputRoutes.empty())
+            toStep.inputRoutes[(size_t) connection.toInput].fade = fadeIndex;
+        else if (toStep.sourceConnection == connectionIndex)
+            toStep.inputFade = fadeIndex;
+    }
+}
+
+void ProcessorChainSchedule::scheduleProcessor (BaseProcessor* proc, BufferSource source, std::unordered_map<BaseProcessor*, int>& numInputsReady)
+{
+    int nextNumProcs = 0;
+    const int numOutputs = proc->getNumOutputs();
+    for (int i = 0; i < numOutputs; ++i)
+        nextNumProcs += proc->getNumOutputConnections (i);
+
+    auto addStep = [this, proc, &source]
+    {
+        for (const auto& step : steps)
+        {
+            if (step.proc == proc)
+            {
+                jassertfalse; // this processor has already been scheduled! Is there a feedback loop?
+                return -1;
+            }
+        }
+
+        auto& step = steps.emplace_back();
+        step.proc = proc;
+        step.sourceStep = source.step;
+        step.sourcePort = source.port;
+        step.sourceConnection = source.connection;
+        return (int) steps.size() - 1;
+    };
+
+    if (proc == outputProcessor) // we've reached the output processor, so we're done!
+    {
+        outputReached = addStep() >= 0;
+        return;
+    }
+
+    if (numOutputs == 0) // this processor has no outputs, so after we process, we're done!
+    {
+        addStep();
+        return;
+    }
+
+    if (nextNumProcs == 0) // the output of this processor is connected to nothing, so let's not waste our processing...
+        return;
+
+    if (proc == inputProcessor)
+        inputConnected = true;
+
+    const auto stepIndex = addStep();
+    if (stepIndex < 0)
+        return;
+
+    auto addConnection = [this, stepIndex] (int port, const ConnectionInfo& info, bool isView)
+    {
+        connections.push_back ({ stepIndex, port, info.endProc, info.endPort, isView });
+        return (int) connections.size() - 1;
+    };
+
+    for (int i = 0; i < numOutputs; ++i)
+    {
+        const int numOutProcs = proc->getNumOutputConnections (i);
+        for (int j = numOutProcs - 1; j >= 0; --j)
+        {
+            const auto& connectionInfo = proc->getOutputConnection (i, j);
+            auto* nextProc = connectionInfo.endProc;
+            const auto nextNumInputs = nextProc->getNumInputs();
+
+            if (nextNumProcs == 1 && nextNumInputs == 1)
+            {
+                // last connection from this processor, so the next processor can work on our output buffer directly
+                scheduleProcessor (nextProc, { stepIndex, i, -1 }, numInputsReady);
+            }
+            else if (nextNumInputs == 1)
+            {
+                const auto connectionIndex = addConnection (i, connectionInfo, false);
+                scheduleProcessor (nextProc, { -1, 0, connectionIndex }, numInputsReady);
+            }
+            else if (++numInputsReady[nextProc] == nextProc->getNumInputConnections())
+            {
+                // only schedule a multi-input processor once all of its inputs are ready,
+                // and give it its own buffer to work with
+                const auto connectionIndex = addConnection (i, connectionInfo, false);
+                scheduleProcessor (nextProc, { -1, 0, connectionIndex }, numInputsReady);
+            }
+            else
+            {
+                // if this is our last connection, the next processor can read from our output buffer directly
+                addConnection (i, connectionInfo, nextNumProcs == 1);
+            }
+
+            nextNumProcs -= 1;
+        }
+    }
+}
+
+AudioBuffer<float>& ProcessorChainSchedule::getStepOutputBuffer (int stepIndex, int port)
+{
+    // steps at the edge of a rate island hand on their output after it has been resampled
+    const auto& step = steps[(size_t) stepIndex];
+    if (! step.resamplesOutput)
+    {
+        if (auto* outBuffer = step.proc->getOutputBuffer (port))
+            return *outBuffer;
+    }
+
+    return *stepBuffers[(size_t) stepIndex];
+}
+
+void ProcessorChainSchedule::runStep (int stepIndex, AudioBuffer<float>& chainInputBuffer)
+{
+    const auto& step = steps[(size_t) stepIndex];
+
+    auto* buffer = &chainInputBuffer;
+    if (step.poolIndex >= 0)
+        buffer = &bufferPool[(size_t) step.poolIndex];
+    else if (step.sourceStep >= 0)
+        buffer = &getStepOutputBuffer (step.sourceStep, step.sourcePort);
+
+    for (int i = 0; i < (int) step.inputRoutes.size(); ++i)
+    {
+        const auto& route = step.inputRoutes[(size_t) i];
+        AudioBuffer<float>* routeBuffer = nullptr;
+        if (route.poolIndex >= 0)
+            routeBuffer = &bufferPool[(size_t) route.poolIndex];
+        else if (route.sourceStep >= 0)
+            routeBuffer = &getStepOutputBuffer (route.sourceStep, route.sourcePort);
+
+        if (routeBuffer != nullptr)
+        {
+            applyConnectionFade (route.fade, *routeBuffer);
+            step.proc->setInputBufferView (i, routeBuffer);
+        }
+    }
+
+    if (step.inputRoutes.empty())
+        applyConnectionFade (step.inputFade, *buffer);
+
+    step.proc->setConnectedInputsMask (step.connectedInputs);
+
+    if (step.resamplesInput)
+        buffer = &rateIslands[(size_t) step.rateIsland]->processIn (*buffer);
+
+    stepBuffers[(size_t) stepIndex] = buffer;
+    step.proc->processAudioBlock (*buffer);
+
+    if (step.resamplesOutput)
+    {
+        auto* islandOutput = step.proc->getOutputBuffer (0);
+        stepBuffers[(size_t) stepIndex] = &rateIslands[(size_t) step.rateIsland]->processOut (islandOutput != nullptr ? *islandOutput : *buffer);
+    }
+
+    for (const auto& copy : step.copies)
+        bufferPool[(size_t) copy.poolIndex].makeCopyOf (getStepOutputBuffer (stepIndex, copy.outputPort), true);
+
+    // the views are only valid while the schedule is running
+    for (int i = 0; i < (int) step.inputRoutes.size(); ++i)
+        step.proc->setInputBufferView (i, nullptr);
+}
+
+void ProcessorChainSchedule::applyConnectionFade (int fadeIndex, AudioBuffer<float>& buffer) noexcept
+{
+    if (fadeIndex < 0)
+        return;
+
+    // each connection only gets read by one step, so this runs once per block
+    auto& fade = connectionFades[(size_t) fadeIndex];
+    if (fade.gain == fade.targetGain)
+    {
+        if (fade.gain == 0.0f)
+            buffer.clear();
+        return;
+    }
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto fadeAmount = connectionFadeIncrement * (float) numSamples;
+    const auto nextGain = fade.targetGain > fade.gain ? jmin (fade.targetGain, fade.gain + fadeAmount)
+                                                      : jmax (fade.targetGain, fade.gain - fadeAmount);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        buffer.applyGainRamp (ch, 0, numSamples, fade.gain, nextGain);
+    fade.gain = nextGain;
+}
+
+bool ProcessorChainSchedule::fadeOutConnectionsMissingFrom (const ProcessorChainSchedule& nextSchedule, float fadeIncrementPerSample) noexcept
+{
+    connectionFadeIncrement = fadeIncrementPerSample;
+
+    // both lists of connections are sorted, so we can walk through them together
+    bool missingConnectionsAreSilent = true;
+    const auto& nextFades = nextSchedule.connectionFades;
+    size_t nextIndex = 0;
+    for (auto& fade : connectionFades)
+    {
+        const auto key = fade.getKey();
+        while (nextIndex < nextFades.size() && nextFades[nextIndex].getKey() < key)
+            ++nextIndex;
+
+        const auto isInNextSchedule = nextIndex < nextFades.size() && nextFades[nextIndex].getKey() == key;
+        fade.targetGain = isInNextSchedule ? 1.0f : 0.0f;
+        if (! isInNextSchedule && fade.gain > 0.0f)
+            missingConnectionsAreSilent = false;
+    }
+
+    return missingConnectionsAreSilent;
+}
+
+void ProcessorChainSchedule::fadeInConnectionsMissingFrom (const ProcessorChainSchedule& previousSchedule, float fadeIncrementPerSample) noexcept
+{
+    connectionFadeIncrement = fadeIncrementPerSample;
+
+    const auto& previousFades = previousSchedule.connectionFades;
+    size_t previousIndex = 0;
+    for (auto& fade : connectionFades)
+    {
+        const auto key = fade.getKey();
+        while (previousIndex < previousFades.size() && previousFades[previousIndex].getKey() < key)
+            ++previousIndex;
+
+        const auto wasInPreviousSchedule = previousIndex < previousFades.size() && previousFades[previousIndex].getKey() == key;
+        fade.gain = wasInPreviousSchedule ? previousFades[previousIndex].gain : 0.0f;
+        fade.targetGain = 1.0f;
+    }
+}
+
+bool ProcessorChainSchedule::process (AudioBuffer<float>& chainInputBuffer)
+{
+    if (! inputConnected && inputProcessor != nullptr)
+        inputProcessor->resetLevels();
+
+    for (int stepIndex = 0; stepIndex < (int) steps.size(); ++stepIndex)
+        runStep (stepIndex, chainInputBuffer);
+
+    return outputReached;
+}
+
+bool ProcessorChainSchedule::process (AudioBuffer<float>& chainInputBuffer, ProcessorChainThreadPool& threadPool)
+{
+    if (! inputConnected && inputProcessor != nullptr)
+        inputProcessor->resetLevels();
+
+    parallelChainInputBuffer = &chainInputBuffer;
+    numStepsDone.store (0);
+
+    // workers can only start claiming steps once every step has been set up for the new block
+    const auto epoch = blockEpoch.load() + 1;
+    for (size_t stepIndex = 0; stepIndex < steps.size(); ++stepIndex)
+        stepStates[stepIndex].store (makeStepState (epoch, steps[stepIndex].numDependencies, false));
+    blockEpoch.store (epoch);
+
+    threadPool.process (*this);
+
+    return outputReached;
+}
+
+int ProcessorChainSchedule::claimReadyStep (uint32_t epoch)
+{
+    const auto readyState = makeStepState (epoch, 0, false);
+    for (size_t stepIndex = 0; stepIndex < steps.size(); ++stepIndex)
+    {
+        auto state = stepStates[stepIndex].load();
+        if (state == readyState && stepStates[stepIndex].compare_exchange_strong (state, makeStepState (epoch, 0, true)))
+            return (int) stepIndex;
+    }
+
+    return -1;
+}
+
+int ProcessorChainSchedule::processReadySteps (bool isBlockOwner)
+{
+    // A worker that turns up late (or early) has a stale epoch,
+    // so it won't be able to claim any steps from another block.
+    const auto epoch = blockEpoch.load();
+    const auto numSteps = (int) steps.size();
+
+    int numStepsProcessed = 0;
+    while (numStepsDone.load() < numSteps)
+    {
+        const auto stepIndex = claimReadyStep (epoch);
+        if (stepIndex < 0)
+        {
+            // Workers go back to the pool instead of waiting. The thread that owns the
+            // block only gets here when every remaining step depends on a step that
+            // a worker is processing right now, so it checks again straight away.
+            if (! isBlockOwner)
+                break;
+            continue;
+        }
+
+        runStep (stepIndex, *parallelChainInputBuffer);
+        ++numStepsProcessed;
+
+        for (auto dependent : steps[(size_t) stepIndex].dependents)
+            stepStates[(size_t) dependent].fetch_sub (1);
+        numStepsDone.fetch_add (1);
+    }
+
+    return numStepsProcessed;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "RateIslandResampler.h"
+#include "processors/BaseProcessor.h"
+
+class InputProcessor;
+class OutputProcessor;
+class ProcessorChainThreadPool;
+
+/**
+ * A flattened version of the processor graph.
+ *
+ * The schedule is compiled on the message thread whenever the graph
+ * changes, so that the audio thread only needs to run through a flat
+ * list of steps, without walking the graph or counting connections.
+ *
+ * Buffers that need to be passed between processors come from a pool
+ * owned by the schedule. Pool buffers are shared between connections
+ * whose lifetimes don't overlap, and a processor that is the last one
+ * to read from an upstream buffer reads from it directly instead of
+ * getting its own copy.
+ *
+ * Processors that were prepared to run at a lower rate than the chain
+ * (see ProcessingRate) are grouped into rate islands. A chain of processors
+ * that run in-place one after another at the same rate share an island,
+ * so the signal only gets resampled on the way into the first processor
+ * in the island, and on the way out of the last one.
+ *
+ * Every connection in the schedule has its own fade gain, so that when the
+ * graph is edited, the connections that are going away can be faded out,
+ * and the new connections faded in, while the rest of the graph keeps running.
+ */
+class ProcessorChainSchedule
+{
+public:
+    ProcessorChainSchedule() = default;
+
+    /** Sorts the graph into a list of processing steps, with all the buffer copies resolved ahead of time. */
+    void compile (InputProcessor& inputProc, OutputProcessor& outputProc, const OwnedArray<BaseProcessor>& procs, int maxNumSamples);
+
+    /**
+     * Runs all the steps in the schedule.
+     *
+     * Returns true if the output processor was reached.
+     */
+    bool process (AudioBuffer<float>& chainInputBuffer);
+
+    /**
+     * Runs the steps in the schedule, spreading the independent
+     * branches of the graph across the thread pool.
+     *
+     * Returns true if the output processor was reached.
+     */
+    bool process (AudioBuffer<float>& chainInputBuffer, ProcessorChainThreadPool& threadPool);
+
+    /**
+     * Called by each thread in the pool to process steps as they become ready.
+     *
+     * The thread that owns the block keeps going until every step has been
+     * processed, while worker threads return as soon as there's nothing left
+     * for them to claim. Returns the number of steps that were processed.
+     */
+    int processReadySteps (bool isBlockOwner);
+
+    bool reachesOutput() const noexcept { return outputReached; }
+    int getNumSteps() const noexcept { return (int) steps.size(); }
+    int getNumPoolBuffers() const noexcept { return (int) bufferPool.size(); }
+    int getNumRateIslands() const noexcept { return (int) rateIslands.size(); }
+
+    /** Returns all the processors in the chain at the time when the schedule was compiled. */
+    const auto& getProcessors() const noexcept { return processors; }
+
+    void setID (uint64_t newID) noexcept { scheduleID = newID; }
+    uint64_t getID() const noexcept { return scheduleID; }
+
+    /**
+     * If the overlap time is greater than zero, the schedule that was running before
+     * this one keeps running alongside it, and is crossfaded out over this many seconds.
+     * Otherwise the old schedule is faded out before this one is faded in.
+     */
+    void setOverlapTime (double overlapSeconds) noexcept { overlapTimeSeconds = overlapSeconds; }
+    double getOverlapTime() const noexcept { return overlapTimeSeconds; }
+
+    /**
+     * Starts fading out the connections that are missing from the next schedule, and fades
+     * back in any connections that are still there (audio thread only). Returns true once
+     * all the connections that are missing from the next schedule are silent.
+     */
+    bool fadeOutConnectionsMissingFrom (const ProcessorChainSchedule& nextSchedule, float fadeIncrementPerSample) noexcept;
+
+    /**
+     * Fades in the connections that weren't in the previous schedule, and picks up the
+     * fade gains of the connections that were (audio thread only).
+     */
+    void fadeInConnectionsMissingFrom (const ProcessorChainSchedule& previousSchedule, float fadeIncrementPerSample) noexcept;
+
+private:
+    struct Connection
+    {
+        int fromStep;
+        int fromPort;
+        BaseProcessor* toProc;
+        int toInput;
+        bool isView; // the downstream processor reads from the upstream buffer directly
+        int toStep = -1;
+        int poolIndex = -1;
+    };
+
+    struct BufferCopy
+    {
+        int outputPort;
+        int poolIndex;
+    };
+
+    struct InputRoute
+    {
+        // either a pool buffer, or a view of the output of another step
+        int poolIndex = -1;
+        int sourceStep = -1;
+        int sourcePort = 0;
+        int fade = -1;
+    };
+
+    struct Step
+    {
+        BaseProcessor* proc = nullptr;
+
+        // if poolIndex >= 0, the processor runs in-place on a pool buffer,
+        // otherwise it runs in-place on the output of sourceStep (or the chain input if sourceStep < 0)
+        int sourceStep = -1;
+        int sourcePort = 0;
+        int sourceConnection = -1;
+        int poolIndex = -1;
+
+        // copies to make into pool buffers for downstream processors
+        std::vector<BufferCopy> copies;
+
+        // for multi-input processors, where to find each of the inputs
+        std::vector<InputRoute> inputRoutes;
+
+        // steps that can't run until this one is done
+        std::vector<int> dependents;
+        int numDependencies = 0;
+
+        // the rate island that this step runs in (if any), and whether the signal needs to be resampled on the way in or out
+        int rateIsland = -1;
+        bool resamplesInput = false;
+        bool resamplesOutput = false;
+
+        // the inputs that were connected when the schedule was compiled, and the fade for a single-input processor's input
+        uint32_t connectedInputs = 0;
+        int inputFade = -1;
+    };
+
+    struct ConnectionFade
+    {
+        const BaseProcessor* startProc;
+        int startPort;
+        const BaseProcessor* endProc;
+        int endPort;
+
+        float gain = 1.0f;
+        float targetGain = 1.0f;
+
+        auto getKey() const noexcept { return std::make_tuple (startProc, startPort, endProc, endPort); }
+    };
+
+    struct BufferSource
+    {
+        int step = -1;
+        int port = 0;
+        int connection = -1;
+    };
+
+    void scheduleProcessor (BaseProcessor* proc, BufferSource source, std::unordered_map<BaseProcessor*, int>& numInputsReady);
+    void resolveConnections();
+    void computeDependencies();
+    void assignPoolBuffers (int maxNumSamples);
+    void assignRateIslands (int maxNumSamples);
+    void assignConnectionFades();
+    void applyConnectionFade (int fadeIndex, AudioBuffer<float>& buffer) noexcept;
+    AudioBuffer<float>& getStepOutputBuffer (int stepIndex, int port);
+    void runStep (int stepIndex, AudioBuffer<float>& chainInputBuffer);
+    int claimReadyStep (uint32_t epoch);
+
+    std::vector<BaseProcessor*> processors;
+    std::vector<Step> steps;
+    std::vector<Connection> connections; // only used while compiling
+    std::vector<AudioBuffer<float>*> stepBuffers;
+    std::vector<AudioBuffer<float>> bufferPool;
+    std::vector<std::unique_ptr<RateIslandResampler>> rateIslands;
+    std::vector<ConnectionFade> connectionFades; // sorted by connection, so that two schedules can be compared quickly
+    float connectionFadeIncrement = 0.0f;
+
+    // State for multi-core processing. Each step has the block epoch in the upper 32 bits,
+    // a "claimed" flag, and the number of dependencies that haven't been processed yet.
+    // A step is ready to be claimed when it has no pending dependencies, and hasn't been
+    // claimed yet in the current block.
+    static constexpr uint64_t claimedFlag = (uint64_t) 1 << 31;
+    static constexpr uint64_t makeStepState (uint32_t epoch, int numPending, bool isClaimed) noexcept
+    {
+        return ((uint64_t) epoch << 32) | (isClaimed ? claimedFlag : 0) | (uint64_t) numPending;
+    }
+    std::unique_ptr<std::atomic<uint64_t>[]> stepStates;
+    std::atomic<uint32_t> blockEpoch { 0 };
+    std::atomic_int numStepsDone { 0 };
+    AudioBuffer<float>* parallelChainInputBuffer = nullptr;
+
+    InputProcessor* inputProcessor = nullptr;
+    OutputProcessor* outputProcessor = nullptr;
+    bool inputConnected = false;
+    bool outputReached = false;
+    uint64_t scheduleID = 0;
+    double overlapTimeSeconds = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorChainSchedule)
+};
@@ -0,0 +1,176 @@
+#include "ProcessorChainScheduleSwapper.h"
+
+namespace
+{
+constexpr double crossfadeTimeSeconds = 0.01;
+constexpr int reclaimIntervalMs = 100;
+} // namespace
+
+ProcessorChainScheduleSwapper::ProcessorChainScheduleSwapper (const ProcessorChainThreadPool& pool) : threadPool (pool)
+{
+    startTimer (reclaimIntervalMs);
+}
+
+ProcessorChainScheduleSwapper::~ProcessorChainScheduleSwapper()
+{
+    stopTimer();
+    deleteSchedules ([] (const ProcessorChainSchedule&)
+                     { return true; });
+}
+
+void ProcessorChainScheduleSwapper::publish (std::unique_ptr<ProcessorChainSchedule> newSchedule)
+{
+    newSchedule->setID (++nextScheduleID);
+    auto* newSchedulePtr = liveSchedules.emplace_back (std::move (newSchedule)).get();
+
+    // If the audio thread never picked up the previous schedule, it might still be
+    // comparing it against the active schedule, so it gets reclaimed along with the
+    // other old schedules once the audio thread has moved on to a newer one.
+    pendingSchedule.store (newSchedulePtr);
+}
+
+void ProcessorChainScheduleSwapper::retireProcessor (BaseProcessor::Ptr proc)
+{
+    if (proc == nullptr)
+        return;
+
+    retiredProcessors.push_back ({ nextScheduleID, std::move (proc) });
+}
+
+void ProcessorChainScheduleSwapper::adoptPendingSchedule()
+{
+    finishOverlap();
+    swapInPendingSchedule();
+}
+
+void ProcessorChainScheduleSwapper::swapInPendingSchedule()
+{
+    if (auto* newSchedule = pendingSchedule.exchange (nullptr))
+    {
+        activeSchedule = newSchedule;
+        oldestScheduleInUseID.store (outgoingSchedule != nullptr ? outgoingSchedule->getID() : newSchedule->getID());
+    }
+}
+
+bool ProcessorChainScheduleSwapper::swapInSchedule (ProcessorChainSchedule* newSchedule)
+{
+    // if a newer schedule has been published in the meantime, we need to fade towards that one instead
+    if (! pendingSchedule.compare_exchange_strong (newSchedule, nullptr))
+        return false;
+
+    activeSchedule = newSchedule;
+    oldestScheduleInUseID.store (newSchedule->getID());
+    return true;
+}
+
+void ProcessorChainScheduleSwapper::prepareCrossfade (double sampleRate)
+{
+    crossfadeSampleRate = sampleRate;
+}
+
+ProcessorChainSchedule& ProcessorChainScheduleSwapper::getScheduleForBlock()
+{
+    if (activeSchedule == nullptr)
+    {
+        swapInPendingSchedule();
+        jassert (activeSchedule != nullptr); // no schedule has been published yet!
+        return *activeSchedule;
+    }
+
+    // wait for the overlap to finish before changing schedules again
+    if (outgoingSchedule != nullptr)
+        return *activeSchedule;
+
+    if (auto* nextSchedule = pendingSchedule.load())
+    {
+        if (nextSchedule->getOverlapTime() > 0.0 && activeSchedule->reachesOutput())
+        {
+            startOverlap();
+            return *activeSchedule;
+        }
+
+        // Fade out the connections that are going away, while everything else keeps running.
+        // Once they're silent, swap in the new schedule, and fade in the new connections.
+        const auto fadeIncrement = (float) (1.0 / (crossfadeTimeSeconds * crossfadeSampleRate));
+        auto* previousSchedule = activeSchedule;
+        const auto isReadyToSwap = activeSchedule->fadeOutConnectionsMissingFrom (*nextSchedule, fadeIncrement) || ! activeSchedule->reachesOutput();
+        if (isReadyToSwap && swapInSchedule (nextSchedule))
+            activeSchedule->fadeInConnectionsMissingFrom (*previousSchedule, fadeIncrement);
+    }
+
+    return *activeSchedule;
+}
+
+void ProcessorChainScheduleSwapper::startOverlap()
+{
+    outgoingSchedule = activeSchedule;
+    swapInPendingSchedule();
+
+    // the schedule that was picked up might have been published after the one that asked for the overlap
+    overlapGain.reset (crossfadeSampleRate, jmax (activeSchedule->getOverlapTime(), crossfadeTimeSeconds));
+    overlapGain.setCurrentAndTargetValue (0.0f);
+    overlapGain.setTargetValue (1.0f);
+}
+
+void ProcessorChainScheduleSwapper::finishOverlap()
+{
+    outgoingSchedule = nullptr;
+    if (activeSchedule != nullptr)
+        oldestScheduleInUseID.store (activeSchedule->getID());
+}
+
+void ProcessorChainScheduleSwapper::applyOverlap (AudioBuffer<float>& buffer, const AudioBuffer<float>& outgoingBuffer)
+{
+    const auto numChannels = buffer.getNumChannels();
+    const auto numOutgoingChannels = outgoingBuffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+    jassert (outgoingBuffer.getNumSamples() >= numSamples);
+
+    auto* const* x = buffer.getArrayOfWritePointers();
+    const auto* const* y = outgoingBuffer.getArrayOfReadPointers();
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const auto gain = overlapGain.getNextValue();
+        for (int ch = 0; ch < numChannels; ++ch)
+            x[ch][n] = gain * x[ch][n] + (1.0f - gain) * y[ch % numOutgoingChannels][n];
+    }
+
+    if (! overlapGain.isSmoothing())
+        finishOverlap();
+}
+
+void ProcessorChainScheduleSwapper::timerCallback()
+{
+    reclaimRetiredObjects();
+}
+
+void ProcessorChainScheduleSwapper::reclaimRetiredObjects()
+{
+    // once the audio thread has stopped using a schedule, it will never go back to an older one
+    const auto activeID = oldestScheduleInUseID.load();
+
+    deleteSchedules ([activeID] (const ProcessorChainSchedule& schedule)
+                     { return schedule.getID() < activeID; });
+
+    retiredProcessors.erase (std::remove_if (retiredProcessors.begin(),
+                                             retiredProcessors.end(),
+                                             [activeID] (const auto& retired)
+                                             { return retired.retireAfterID <= activeID; }),
+                             retiredProcessors.end());
+}
+
+void ProcessorChainScheduleSwapper::deleteSchedules (std::function<bool (const ProcessorChainSchedule&)>&& shouldDelete)
+{
+    liveSchedules.erase (std::remove_if (liveSchedules.begin(),
+                                         liveSchedules.end(),
+                                         [this, &shouldDelete] (const auto& schedule)
+                                         {
+                                             if (! shouldDelete (*schedule))
+                                                 return false;
+
+                                             // a worker thread might still be looking at the schedule from the last block
+                                             threadPool.waitUntilReleased (schedule.get());
+                                             return true;
+                                         }),
+                         liveSchedules.end());
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ProcessorChainSchedule.h"
+#include "ProcessorChainThreadPool.h"
+
+/**
+ * Hands processing schedules from the message thread over to the
+ * audio thread without locking.
+ *
+ * When a new schedule is published, the audio thread fades out the
+ * connections that are missing from the new schedule, swaps in the new
+ * schedule at the next block boundary, and fades in the connections that
+ * weren't in the old schedule. The old and new graphs share the same
+ * processors, so they can't both run at once, but the parts of the graph
+ * that haven't changed keep running the whole time. If the new schedule
+ * has an overlap time (i.e. a new board with its own processors), the old
+ * graph keeps running instead, and the audio thread crossfades from the
+ * old graph to the new one. Old schedules, along with any processors
+ * that were removed from the chain, are kept alive until the audio
+ * thread has moved on, and are then deleted off the audio thread.
+ */
+class ProcessorChainScheduleSwapper : private Timer
+{
+public:
+    explicit ProcessorChainScheduleSwapper (const ProcessorChainThreadPool& threadPool);
+    ~ProcessorChainScheduleSwapper() override;
+
+    /** Publishes a new schedule for the audio thread to pick up (message thread only). */
+    void publish (std::unique_ptr<ProcessorChainSchedule> newSchedule);
+
+    /** Holds on to a processor until no schedule on the audio thread can be using it (message thread only). */
+    void retireProcessor (BaseProcessor::Ptr proc);
+
+    /** Swaps in any pending schedule. Must not be called while the audio thread is running! */
+    void adoptPendingSchedule();
+
+    /** Sets up the crossfade for the processing sample rate. */
+    void prepareCrossfade (double sampleRate);
+
+    /** Returns the schedule to use for this block (audio thread only). */
+    ProcessorChainSchedule& getScheduleForBlock();
+
+    /** Returns the schedule that is being crossfaded out, or nullptr if there isn't one (audio thread only). */
+    ProcessorChainSchedule* getOutgoingSchedule() noexcept { return outgoingSchedule; }
+
+    /** Crossfades from the output of the outgoing schedule to the output of the active schedule (audio thread only). */
+    void applyOverlap (AudioBuffer<float>& buffer, const AudioBuffer<float>& outgoingBuffer);
+
+private:
+    void timerCallback() override;
+    void reclaimRetiredObjects();
+    void swapInPendingSchedule();
+    bool swapInSchedule (ProcessorChainSchedule* newSchedule);
+    void startOverlap();
+    void finishOverlap();
+    void deleteSchedules (std::function<bool (const ProcessorChainSchedule&)>&& shouldDelete);
+
+    const ProcessorChainThreadPool& threadPool;
+    std::vector<std::unique_ptr<ProcessorChainSchedule>> liveSchedules; // owned by the message thread
+
+    struct RetiredProcessor
+    {
+        uint64_t retireAfterID;
+        BaseProcessor::Ptr proc;
+    };
+    std::vector<RetiredProcessor> retiredProcessors; // owned by the message thread
+
+    uint64_t nextScheduleID = 0;
+    std::atomic<ProcessorChainSchedule*> pendingSchedule { nullptr };
+    std::atomic<uint64_t> oldestScheduleInUseID { 0 };
+
+    ProcessorChainSchedule* activeSchedule = nullptr; // owned by the audio thread
+    ProcessorChainSchedule* outgoingSchedule = nullptr; // owned by the audio thread
+    SmoothedValue<float, ValueSmoothingTypes::Linear> overlapGain;
+    double crossfadeSampleRate = 48000.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorChainScheduleSwapper)
+};
@@ -0,0 +1,74 @@
+#include "ProcessorChainStandbyBoard.h"
+
+ProcessorChainStandbyBoard::ProcessorChainStandbyBoard() = default;
+
+void ProcessorChainStandbyBoard::prepare (double sampleRate, int samplesPerBlock, int osFactor)
+{
+    inputProcessor.prepareProcessing (sampleRate, samplesPerBlock, osFactor);
+    outputProcessor.prepareProcessing (sampleRate, samplesPerBlock, osFactor);
+
+    for (auto* proc : procs)
+        proc->prepareProcessing (sampleRate, samplesPerBlock, osFactor);
+
+    preparedSampleRate = sampleRate;
+    preparedSamplesPerBlock = samplesPerBlock;
+    preparedOSFactor = osFactor;
+}
+
+bool ProcessorChainStandbyBoard::isPreparedFor (double sampleRate, int samplesPerBlock, int osFactor) const noexcept
+{
+    return preparedSampleRate == sampleRate && preparedSamplesPerBlock == samplesPerBlock && preparedOSFactor == osFactor;
+}
+
+void ProcessorChainStandbyBoard::warmUp (double warmUpTimeSeconds)
+{
+    jassert (preparedSamplesPerBlock > 0); // board must be prepared before warming up!
+
+    connect();
+
+    ProcessorChainSchedule schedule;
+    schedule.compile (inputProcessor, outputProcessor, procs, preparedSamplesPerBlock);
+
+    AudioBuffer<float> buffer { 2, preparedSamplesPerBlock };
+    const auto numBlocks = (int) std::ceil (warmUpTimeSeconds * preparedSampleRate / (double) preparedSamplesPerBlock);
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        buffer.setSize (2, preparedSamplesPerBlock, false, false, true);
+        buffer.clear();
+        schedule.process (buffer);
+    }
+
+    inputProcessor.resetLevels();
+    outputProcessor.resetLevels();
+}
+
+size_t ProcessorChainStandbyBoard::getMemoryFootprint() const
+{
+    size_t numBytes = 0;
+    for (const auto* proc : procs)
+        numBytes += proc->getMemoryFootprint();
+
+    return numBytes;
+}
+
+void ProcessorChainStandbyBoard::connect()
+{
+    if (isConnected)
+        return;
+
+    for (auto info : connections)
+        info.startProc->addConnection (std::move (info));
+
+    isConnected = true;
+}
+
+void ProcessorChainStandbyBoard::disconnect()
+{
+    if (! isConnected)
+        return;
+
+    for (const auto& info : connections)
+        info.startProc->removeConnection (info);
+
+    isConnected = false;
+}
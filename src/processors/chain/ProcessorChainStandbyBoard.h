@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ProcessorChainSchedule.h"
+#include "processors/utility/InputProcessor.h"
+#include "processors/utility/OutputProcessor.h"
+
+/**
+ * A complete set of processors for a preset that isn't loaded yet.
+ *
+ * Standby boards are built from a preset's state, prepared, and warmed up
+ * on a background thread, so that the processor chain can swap the whole
+ * board in at once, without constructing or preparing anything. The board
+ * has its own input and output processors, so that it can be run on its own
+ * while it is warming up. When the board is swapped into the chain, any
+ * connections to the board's input and output are moved over to the chain's
+ * input and output.
+ */
+class ProcessorChainStandbyBoard
+{
+public:
+    ProcessorChainStandbyBoard();
+
+    /** Prepares all the processors in the board for the (oversampled) processing sample rate. */
+    void prepare (double sampleRate, int samplesPerBlock, int osFactor);
+    bool isPreparedFor (double sampleRate, int samplesPerBlock, int osFactor) const noexcept;
+
+    /** Runs some silence through the board, so that the processors can settle. */
+    void warmUp (double warmUpTimeSeconds);
+
+    /** Returns an estimate of the memory used by the processors in the board. */
+    size_t getMemoryFootprint() const;
+
+    const auto& getProcessors() const noexcept { return procs; }
+
+private:
+    friend class ProcessorChainStateHelper;
+
+    /** Wires up the connections within the board, including the board's own input and output. */
+    void connect();
+
+    /** Removes all the connections within the board, so that the processors can be moved into a chain. */
+    void disconnect();
+
+    OwnedArray<BaseProcessor> procs;
+    std::vector<ConnectionInfo> connections;
+    bool isConnected = false;
+
+    InputProcessor inputProcessor;
+    OutputProcessor outputProcessor;
+
+    double preparedSampleRate = 0.0;
+    int preparedSamplesPerBlock = 0;
+    int preparedOSFactor = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorChainStandbyBoard)
+};
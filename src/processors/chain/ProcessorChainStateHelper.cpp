@@ -29,6 +29,32 @@ String getProcessorName (const String& tag)
 {
     return tag.replaceCharacter ('_', ' ');
 }
+
+/**
+ * Reads the connections from one processor's saved state. The state refers to
+ * the connected processors by their index in the state, or -1 for the output.
+ */
+template <typename ProcLookupFunc>
+void readConnectionsFromXML (const XmlElement* procXml, BaseProcessor* proc, ProcLookupFunc&& getProcForIndex, std::vector<ConnectionInfo>& connections)
+{
+    for (int portIdx = 0; portIdx < proc->getNumOutputs(); ++portIdx)
+    {
+        auto* portElement = procXml->getChildByName (getPortTag (portIdx));
+        if (portElement == nullptr)
+            continue; // no connections!
+
+        const auto numConnections = portElement->getNumAttributes() / 2;
+        for (int cIdx = 0; cIdx < numConnections; ++cIdx)
+        {
+            const auto processorIdx = portElement->getIntAttribute (getConnectionTag (cIdx));
+            const auto endPort = portElement->getIntAttribute (getConnectionEndTag (cIdx));
+
+            auto* procToConnect = getProcForIndex (processorIdx);
+            if (procToConnect != nullptr && procToConnect != proc)
+                connections.push_back ({ proc, portIdx, procToConnect, endPort });
+        }
+    }
+}
 } // namespace
 
 ProcessorChainStateHelper::ProcessorChainStateHelper (ProcessorChain& thisChain, chowdsp::DeferredAction& deferredAction)
@@ -109,52 +135,21 @@ void ProcessorChainStateHelper::loadProcChainInternal (const XmlElement* xml,
     if (! loadingPreset)
         um->beginNewTransaction();
 
-    for (auto* proc : chain.procs)
-        ProcessorChainHelpers::removeOutputConnectionsFromProcessor (chain, proc, chain.um);
-    ProcessorChainHelpers::removeOutputConnectionsFromProcessor (chain, &chain.inputProcessor, chain.um);
-
-    while (! chain.procs.isEmpty())
-        um->perform (new AddOrRemoveProcessor (chain, chain.procs.getLast()));
+    // Undoing a removed processor adds it back at the end of the chain, so this puts
+    // all the processors back in their original order once everything else is undone.
+    um->perform (new ReorderProcessors (chain, { chain.procs.begin(), chain.procs.end() }));
 
-    using PortMap = std::vector<std::pair<int, int>>;
-    using ProcConnectionMap = std::unordered_map<int, PortMap>;
-    auto loadProcessorState = [this, &stateVersion] (XmlElement* procXml, BaseProcessor* newProc, auto& connectionMaps, bool shouldLoadState = true)
+    // collect the processors in the new state, in the order that the connections refer to them by
+    struct ProcessorEntry
     {
-        if (procXml->getNumChildElements() > 0)
-        {
-            if (shouldLoadState)
-                newProc->fromXML (procXml->getChildElement (0), stateVersion);
-            else // don't load state, only load position
-                newProc->loadPositionInfoFromXML (procXml->getChildElement (0));
-        }
-
-        ProcConnectionMap connectionMap;
-        for (int portIdx = 0; portIdx < newProc->getNumOutputs(); ++portIdx)
-        {
-            if (auto* portElement = procXml->getChildByName (getPortTag (portIdx)))
-            {
-                auto numConnections = portElement->getNumAttributes() / 2;
-                PortMap portConnections (numConnections);
-                for (int cIdx = 0; cIdx < numConnections; ++cIdx)
-                {
-                    auto processorIdx = portElement->getIntAttribute (getConnectionTag (cIdx));
-                    auto endPort = portElement->getIntAttribute (getConnectionEndTag (cIdx));
-                    portConnections[cIdx] = std::make_pair (processorIdx, endPort);
-                }
-
-                connectionMap.insert ({ portIdx, std::move (portConnections) });
-            }
-        }
-
-        if (newProc == &chain.outputProcessor)
-            return;
-
-        int procIdx = newProc == &chain.inputProcessor ? -1 : chain.procs.size();
-        connectionMaps.insert ({ procIdx, std::move (connectionMap) });
+        XmlElement* xml = nullptr;
+        String name;
+        BaseProcessor* proc = nullptr;
+        bool isNew = false;
     };
-
-    std::unordered_map<int, ProcConnectionMap> connectionMaps;
-    StringArray unavailableProcessors;
+    std::vector<ProcessorEntry> newProcEntries;
+    XmlElement* inputProcXml = nullptr;
+    XmlElement* outputProcXml = nullptr;
     for (auto* procXml : xml->getChildIterator())
     {
         if (procXml == nullptr)
@@ -165,35 +160,154 @@ void ProcessorChainStateHelper::loadProcChainInternal (const XmlElement* xml,
 
         const auto procName = getProcessorName (procXml->getTagName());
         if (procName == chain.inputProcessor.getName())
+            inputProcXml = procXml;
+        else if (procName == chain.outputProcessor.getName())
+            outputProcXml = procXml;
+        else
+            newProcEntries.push_back ({ procXml, procName });
+    }
+
+    // re-use the processors that are already in the chain, first by matching position, then by matching type
+    std::vector<BaseProcessor*> unmatchedProcs { chain.procs.begin(), chain.procs.end() };
+    for (size_t idx = 0; idx < newProcEntries.size() && (int) idx < chain.procs.size(); ++idx)
+    {
+        auto* proc = chain.procs[(int) idx];
+        if (proc->getName() == newProcEntries[idx].name)
         {
-            loadProcessorState (procXml, &chain.inputProcessor, connectionMaps, ! loadingPreset);
-            continue;
+            newProcEntries[idx].proc = proc;
+            unmatchedProcs.erase (std::find (unmatchedProcs.begin(), unmatchedProcs.end(), proc));
         }
+    }
 
-        if (procName == chain.outputProcessor.getName())
-        {
-            loadProcessorState (procXml, &chain.outputProcessor, connectionMaps, ! loadingPreset);
+    for (auto& entry : newProcEntries)
+    {
+        if (entry.proc != nullptr)
             continue;
+
+        auto procIter = std::find_if (unmatchedProcs.begin(), unmatchedProcs.end(), [&entry] (const BaseProcessor* proc)
+                                      { return proc->getName() == entry.name; });
+        if (procIter != unmatchedProcs.end())
+        {
+            entry.proc = *procIter;
+            unmatchedProcs.erase (procIter);
         }
+    }
 
-        if (! chain.procStore.isModuleAvailable (procName))
+    // create the processors that couldn't be matched
+    std::vector<BaseProcessor::Ptr> procsToAdd;
+    StringArray unavailableProcessors;
+    for (auto& entry : newProcEntries)
+    {
+        if (entry.proc != nullptr)
+            continue;
+
+        if (! chain.procStore.isModuleAvailable (entry.name))
         {
-            Logger::writeToLog ("Skipping loading processor: " + procName + ", since it is currently locked!");
-            unavailableProcessors.addIfNotAlreadyThere (procName);
+            Logger::writeToLog ("Skipping loading processor: " + entry.name + ", since it is currently locked!");
+            unavailableProcessors.addIfNotAlreadyThere (entry.name);
             continue;
         }
 
-        auto newProc = chain.procStore.createProcByName (procName);
+        auto newProc = chain.procStore.createProcByName (entry.name);
         if (newProc == nullptr)
         {
             jassertfalse; // unable to create this processor
             continue;
         }
 
-        loadProcessorState (procXml, newProc.get(), connectionMaps);
-        um->perform (new AddOrRemoveProcessor (chain, std::move (newProc)));
+        if (entry.xml->getNumChildElements() > 0)
+            newProc->fromXML (entry.xml->getChildElement (0), stateVersion);
+
+        entry.proc = newProc.get();
+        entry.isNew = true;
+        procsToAdd.push_back (std::move (newProc));
     }
 
+    // figure out which connections the new state needs
+    using ConnectionKey = std::tuple<BaseProcessor*, int, BaseProcessor*, int>;
+    std::vector<ConnectionInfo> newConnections;
+    const auto getNewProcForIndex = [this, &newProcEntries] (int processorIdx) -> BaseProcessor*
+    {
+        if (processorIdx < 0)
+            return &chain.outputProcessor;
+        return processorIdx < (int) newProcEntries.size() ? newProcEntries[(size_t) processorIdx].proc : nullptr;
+    };
+
+    if (inputProcXml != nullptr)
+        readConnectionsFromXML (inputProcXml, &chain.inputProcessor, getNewProcForIndex, newConnections);
+    for (const auto& entry : newProcEntries)
+        if (entry.proc != nullptr)
+            readConnectionsFromXML (entry.xml, entry.proc, getNewProcForIndex, newConnections);
+
+    const auto getConnectionKey = [] (const ConnectionInfo& info)
+    { return ConnectionKey { info.startProc, info.startPort, info.endProc, info.endPort }; };
+
+    std::set<ConnectionKey> newConnectionKeys;
+    for (const auto& info : newConnections)
+        newConnectionKeys.insert (getConnectionKey (info));
+
+    // remove the connections that are not in the new state
+    std::set<ConnectionKey> keptConnectionKeys;
+    auto removeStaleConnections = [this, &newConnectionKeys, &keptConnectionKeys, &getConnectionKey] (BaseProcessor* proc)
+    {
+        for (int portIdx = 0; portIdx < proc->getNumOutputs(); ++portIdx)
+        {
+            for (int cIdx = proc->getNumOutputConnections (portIdx) - 1; cIdx >= 0; --cIdx)
+            {
+                auto connection = proc->getOutputConnection (portIdx, cIdx);
+                const auto key = getConnectionKey (connection);
+                if (newConnectionKeys.find (key) != newConnectionKeys.end())
+                    keptConnectionKeys.insert (key);
+                else
+                    um->perform (new AddOrRemoveConnection (chain, std::move (connection), true));
+            }
+        }
+    };
+
+    removeStaleConnections (&chain.inputProcessor);
+    for (auto* proc : chain.procs)
+        removeStaleConnections (proc);
+
+    // remove the processors that are not in the new state
+    for (auto* proc : unmatchedProcs)
+        um->perform (new AddOrRemoveProcessor (chain, proc));
+
+    // load the new state into the processors that are being re-used
+    for (const auto& entry : newProcEntries)
+    {
+        if (entry.proc == nullptr || entry.isNew || entry.xml->getNumChildElements() == 0)
+            continue;
+
+        auto* procStateXml = entry.xml->getChildElement (0);
+        if (entry.proc->toXML()->isEquivalentTo (procStateXml, false))
+            continue; // nothing has changed!
+
+        um->perform (new LoadProcessorState (entry.proc, *procStateXml, stateVersion));
+    }
+
+    for (auto* ioProcXml : { inputProcXml, outputProcXml })
+    {
+        if (ioProcXml == nullptr || ioProcXml->getNumChildElements() == 0)
+            continue;
+
+        auto* ioProc = ioProcXml == inputProcXml ? static_cast<BaseProcessor*> (&chain.inputProcessor) : &chain.outputProcessor;
+        if (loadingPreset) // don't load state, only load position
+            ioProc->loadPositionInfoFromXML (ioProcXml->getChildElement (0));
+        else
+            ioProc->fromXML (ioProcXml->getChildElement (0), stateVersion);
+    }
+
+    // add the new processors
+    for (auto& newProc : procsToAdd)
+        um->perform (new AddOrRemoveProcessor (chain, std::move (newProc)));
+
+    // keep the processors in the same order as the state, so that it will be saved the same way
+    std::vector<BaseProcessor*> newOrder;
+    for (const auto& entry : newProcEntries)
+        if (entry.proc != nullptr)
+            newOrder.push_back (entry.proc);
+    um->perform (new ReorderProcessors (chain, std::move (newOrder)));
+
     if (loadingPreset && ! unavailableProcessors.isEmpty())
     {
         std::stringstream warningStream;
@@ -204,33 +318,220 @@ void ProcessorChainStateHelper::loadProcChainInternal (const XmlElement* xml,
         PresetManager::showErrorMessage ("Error Loading Preset", warningStream.str(), associatedComp);
     }
 
-    // wait until all the processors are created before connecting them
-    for (auto [procIdx, connectionMap] : connectionMaps)
+    // add the connections that are new in this state
+    for (auto& info : newConnections)
+    {
+        if (keptConnectionKeys.find (getConnectionKey (info)) == keptConnectionKeys.end())
+            um->perform (new AddOrRemoveConnection (chain, std::move (info)));
+    }
+
+    chain.refreshConnectionsBroadcaster();
+}
+
+std::unique_ptr<ProcessorChainStandbyBoard> ProcessorChainStateHelper::createStandbyBoard (const XmlElement* xml, const chowdsp::Version& stateVersion)
+{
+    if (xml == nullptr)
+    {
+        jassertfalse; // something has gone wrong!
+        return {};
+    }
+
+    auto board = std::make_unique<ProcessorChainStandbyBoard>();
+
+    std::vector<std::pair<XmlElement*, BaseProcessor*>> procEntries;
+    XmlElement* inputProcXml = nullptr;
+    for (auto* procXml : xml->getChildIterator())
     {
-        auto* proc = procIdx >= 0 ? chain.procs[(int) procIdx] : &chain.inputProcessor;
-        if (proc == nullptr)
+        const auto procName = getProcessorName (procXml->getTagName());
+        if (procName == board->inputProcessor.getName() || procName == board->outputProcessor.getName())
         {
-            jassertfalse;
+            BaseProcessor* ioProc = &board->outputProcessor;
+            if (procName == board->inputProcessor.getName())
+            {
+                ioProc = &board->inputProcessor;
+                inputProcXml = procXml;
+            }
+
+            // like when loading a preset, only the position of the input and output processors gets loaded
+            if (procXml->getNumChildElements() > 0)
+                ioProc->loadPositionInfoFromXML (procXml->getChildElement (0));
             continue;
         }
 
-        for (int portIdx = 0; portIdx < proc->getNumOutputs(); ++portIdx)
+        BaseProcessor* proc = nullptr;
+        if (! chain.procStore.isModuleAvailable (procName))
+        {
+            Logger::writeToLog ("Skipping loading processor: " + procName + ", since it is currently locked!");
+        }
+        else if (auto newProc = chain.procStore.createProcByName (procName))
         {
-            if (connectionMap.find (portIdx) == connectionMap.end())
-                continue; // no connections!
+            if (procXml->getNumChildElements() > 0)
+                newProc->fromXML (procXml->getChildElement (0), stateVersion);
+            proc = board->procs.add (std::move (newProc));
+        }
+
+        procEntries.emplace_back (procXml, proc);
+    }
+
+    const auto getBoardProcForIndex = [&board, &procEntries] (int processorIdx) -> BaseProcessor*
+    {
+        if (processorIdx < 0)
+            return &board->outputProcessor;
+        return processorIdx < (int) procEntries.size() ? procEntries[(size_t) processorIdx].second : nullptr;
+    };
+
+    if (inputProcXml != nullptr)
+        readConnectionsFromXML (inputProcXml, &board->inputProcessor, getBoardProcForIndex, board->connections);
+    for (const auto& [procXml, proc] : procEntries)
+        if (proc != nullptr)
+            readConnectionsFromXML (procXml, proc, getBoardProcForIndex, board->connections);
+
+    return board;
+}
+
+bool ProcessorChainStateHelper::loadStandbyBoard (ProcessorChainStandbyBoard& board, double crossfadeTimeSeconds)
+{
+    // the processors can't be swapped out while the chain is changing its oversampling factor
+    if (chain.osChangeState.load() != ProcessorChain::OSChangeState::Idle)
+        return false;
+
+    Logger::writeToLog ("Swapping in standby board with " + String (board.procs.size()) + " processors");
+
+    board.disconnect();
+    const auto [sampleRate, samplesPerBlock] = chain.getProcessingSpec();
+    const auto osFactor = chain.getOversamplingFactor();
+    if (! board.isPreparedFor (sampleRate, samplesPerBlock, osFactor))
+        board.prepare (sampleRate, samplesPerBlock, osFactor);
+
+    swapInStandbyBoard (board, crossfadeTimeSeconds);
+    return true;
+}
+
+bool ProcessorChainStateHelper::matchesChainLayout (const ProcessorChainStandbyBoard& board, const XmlElement& boardState)
+{
+    const auto chainState = saveProcChain();
+    if (board.procs.size() != chain.procs.size() || chainState->getNumChildElements() != boardState.getNumChildElements())
+        return false;
+
+    for (int procIdx = 0; procIdx < chainState->getNumChildElements(); ++procIdx)
+    {
+        const auto* chainProcXml = chainState->getChildElement (procIdx);
+        const auto* boardProcXml = boardState.getChildElement (procIdx);
+        if (! chainProcXml->hasTagName (boardProcXml->getTagName()))
+            return false;
+
+        // the first child is the processor's own state, and the rest are its connections
+        if (chainProcXml->getNumChildElements() != boardProcXml->getNumChildElements())
+            return false;
+
+        for (int portIdx = 1; portIdx < chainProcXml->getNumChildElements(); ++portIdx)
+            if (! chainProcXml->getChildElement (portIdx)->isEquivalentTo (boardProcXml->getChildElement (portIdx), false))
+                return false;
+    }
+
+    return true;
+}
 
-            const auto& connections = connectionMap.at (portIdx);
-            for (auto [cIdx, endPort] : connections)
+bool ProcessorChainStateHelper::loadOversamplingBoard (ProcessorChainStandbyBoard& board, const XmlElement& boardState)
+{
+    // the board can only replace the chain if nobody has added, removed, or re-connected any processors since it was built
+    if (! matchesChainLayout (board, boardState))
+        return false;
+
+    Logger::writeToLog ("Swapping in board for oversampling factor: " + String (chain.getOversamplingFactor()));
+
+    board.disconnect();
+    [[maybe_unused]] const auto [sampleRate, samplesPerBlock] = chain.getProcessingSpec();
+    jassert (board.isPreparedFor (sampleRate, samplesPerBlock, chain.getOversamplingFactor()));
+
+    // pick up any parameter changes (or editor moves) that happened while the board was being built
+    for (int procIdx = 0; procIdx < chain.procs.size(); ++procIdx)
+        board.procs[procIdx]->fromXML (chain.procs[procIdx]->toXML().get(), chowdsp::Version { JucePlugin_VersionString });
+    board.inputProcessor.loadPositionInfoFromXML (chain.inputProcessor.toXML().get());
+    board.outputProcessor.loadPositionInfoFromXML (chain.outputProcessor.toXML().get());
+
+    swapInStandbyBoard (board, 0.0);
+    return true;
+}
+
+void ProcessorChainStateHelper::swapInStandbyBoard (ProcessorChainStandbyBoard& board, double crossfadeTimeSeconds)
+{
+    ParamForwardManager::ScopedForceDeferHostNotifications scopedDeferNotifs { *chain.paramForwardManager };
+
+    // the undo history refers to processors that are about to be removed
+    if (um != nullptr)
+        um->clearUndoHistory();
+
+    // disconnect the old processors from the chain's input and output, but keep them
+    // connected to each other, so that the old board can keep running while it fades out
+    for (int portIdx = 0; portIdx < chain.inputProcessor.getNumOutputs(); ++portIdx)
+    {
+        for (int cIdx = chain.inputProcessor.getNumOutputConnections (portIdx) - 1; cIdx >= 0; --cIdx)
+        {
+            const auto connection = chain.inputProcessor.getOutputConnection (portIdx, cIdx);
+            chain.inputProcessor.removeConnection (connection);
+        }
+    }
+
+    std::vector<BaseProcessor::Ptr> oldProcs;
+    while (! chain.procs.isEmpty())
+    {
+        auto* proc = chain.procs.getLast();
+        for (int portIdx = 0; portIdx < proc->getNumOutputs(); ++portIdx)
+        {
+            for (int cIdx = proc->getNumOutputConnections (portIdx) - 1; cIdx >= 0; --cIdx)
             {
-                if (auto* procToConnect = cIdx >= 0 ? chain.procs[cIdx] : &chain.outputProcessor; procToConnect != nullptr && procToConnect != proc)
-                {
-                    ConnectionInfo info { proc, portIdx, procToConnect, endPort };
-                    um->perform (new AddOrRemoveConnection (chain, std::move (info)));
-                }
+                const auto connection = proc->getOutputConnection (portIdx, cIdx);
+                if (connection.endProc == &chain.outputProcessor)
+                    proc->removeConnection (connection);
             }
         }
+
+        chain.processorRemovedBroadcaster (proc);
+
+        for (auto* param : proc->getParameters())
+        {
+            if (auto* paramCast = dynamic_cast<juce::RangedAudioParameter*> (param))
+                proc->getVTS().removeParameterListener (paramCast->paramID, &chain);
+        }
+
+        oldProcs.emplace_back (chain.procs.removeAndReturn (chain.procs.size() - 1));
     }
 
+    chain.inputProcessor.loadPositionInfoFromXML (board.inputProcessor.toXML().get());
+    chain.outputProcessor.loadPositionInfoFromXML (board.outputProcessor.toXML().get());
+
+    // move the new processors into the chain, keeping them in the same order as the state
+    while (! board.procs.isEmpty())
+    {
+        auto* proc = chain.procs.add (board.procs.removeAndReturn (0));
+
+        for (auto* param : proc->getParameters())
+        {
+            if (auto* paramCast = dynamic_cast<juce::RangedAudioParameter*> (param))
+                proc->getVTS().addParameterListener (paramCast->paramID, &chain);
+        }
+
+        chain.processorAddedBroadcaster (proc);
+    }
+
+    for (auto info : board.connections)
+    {
+        if (info.startProc == &board.inputProcessor)
+            info.startProc = &chain.inputProcessor;
+        if (info.endProc == &board.outputProcessor)
+            info.endProc = &chain.outputProcessor;
+
+        info.startProc->addConnection (std::move (info));
+    }
+    board.connections.clear();
+
+    chain.rebuildSchedule (crossfadeTimeSeconds);
+
+    // the old processors need to stay alive until the audio thread has finished fading them out
+    for (auto& proc : oldProcs)
+        chain.scheduleSwapper.retireProcessor (std::move (proc));
+
     chain.refreshConnectionsBroadcaster();
 }
 
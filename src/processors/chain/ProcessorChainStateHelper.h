@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ProcessorChain.h"
+#include "ProcessorChainStandbyBoard.h"
 
 class ProcessorChainStateHelper
 {
@@ -15,7 +16,37 @@ public:
 
     bool validateProcChainState (const XmlElement* xml) const;
 
+    /**
+     * Builds a standby board from a saved processor chain state. The processors
+     * in the chain are left alone, but some processors need the message thread
+     * in their constructors, so only the board's prepare() and warmUp() can be
+     * called from a background thread.
+     */
+    std::unique_ptr<ProcessorChainStandbyBoard> createStandbyBoard (const XmlElement* xml, const chowdsp::Version& stateVersion);
+
+    /**
+     * Replaces all the processors in the chain with the processors from a standby board.
+     * The old processors keep running while the new ones are crossfaded in, and the undo
+     * history is cleared. Returns false if the board can't be swapped in right now.
+     */
+    bool loadStandbyBoard (ProcessorChainStandbyBoard& board, double crossfadeTimeSeconds);
+
+    /**
+     * Replaces the processors in the chain with a copy of the chain that has been
+     * prepared for a new oversampling factor. The board must have been built from
+     * boardState, and the chain must not be using its processors (or the old
+     * oversampler) on the audio thread. As with any standby board, the undo history
+     * is cleared. Returns false if the chain's processors or connections have changed
+     * since the board was built.
+     */
+    bool loadOversamplingBoard (ProcessorChainStandbyBoard& board, const XmlElement& boardState);
+
+    /** Returns true if a board built from boardState has the same processors and connections as the chain. */
+    bool matchesChainLayout (const ProcessorChainStandbyBoard& board, const XmlElement& boardState);
+
 private:
+    void swapInStandbyBoard (ProcessorChainStandbyBoard& board, double crossfadeTimeSeconds);
+
     void loadProcChainInternal (const XmlElement* xml,
                                 const chowdsp::Version& stateVersion,
                                 bool loadingPreset,
@@ -0,0 +1,137 @@
+#include "ProcessorChainThreadPool.h"
+#include "ProcessorChainSchedule.h"
+
+namespace
+{
+// How long a worker keeps spinning after the last step it processed, before going back
+// to sleeping between polls. This is short enough that idle workers don't hog the CPU
+// when several instances are running, and the audio thread never relies on a worker
+// being awake, since it runs any steps that haven't been claimed by itself.
+constexpr double workerSpinTimeMs = 1.0;
+} // namespace
+
+ProcessorChainThreadPool::ProcessorChainThreadPool()
+{
+    pluginSettings->addProperties<&ProcessorChainThreadPool::globalSettingChanged> ({ { multiCoreOnOffID, false } }, *this);
+    globalSettingChanged (multiCoreOnOffID);
+}
+
+ProcessorChainThreadPool::~ProcessorChainThreadPool()
+{
+    pluginSettings->removePropertyListener (*this);
+    stopWorkers();
+}
+
+void ProcessorChainThreadPool::globalSettingChanged (SettingID settingID)
+{
+    if (settingID != multiCoreOnOffID)
+        return;
+
+    const auto isNowOn = pluginSettings->getProperty<bool> (settingID);
+    if (isNowOn == enabled.load())
+        return;
+
+    Logger::writeToLog ("Turning multi-core processing: " + String (isNowOn ? "ON" : "OFF"));
+    isNowOn ? startWorkers() : stopWorkers();
+}
+
+void ProcessorChainThreadPool::startWorkers()
+{
+    // leave one core for the audio thread
+    const auto numWorkers = jlimit (1, 7, SystemStats::getNumPhysicalCpus() - 1);
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto& worker = workers.emplace_back (std::make_unique<Worker> (*this));
+        worker->startThread();
+    }
+
+    enabled.store (true);
+}
+
+void ProcessorChainThreadPool::stopWorkers()
+{
+    enabled.store (false);
+
+    // workers only exit between steps, so the audio thread will pick up any remaining work
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+    for (auto& worker : workers)
+        worker->stopThread (1000);
+
+    workers.clear();
+}
+
+void ProcessorChainThreadPool::process (ProcessorChainSchedule& schedule)
+{
+    // if all the job slots are taken, the calling thread just runs the schedule on its own
+    std::atomic<ProcessorChainSchedule*>* jobSlot = nullptr;
+    for (auto& slot : jobSlots)
+    {
+        ProcessorChainSchedule* emptySlot = nullptr;
+        if (slot.compare_exchange_strong (emptySlot, &schedule))
+        {
+            jobSlot = &slot;
+            break;
+        }
+    }
+
+    schedule.processReadySteps (true);
+
+    if (jobSlot != nullptr)
+        jobSlot->store (nullptr);
+}
+
+void ProcessorChainThreadPool::waitUntilReleased (const ProcessorChainSchedule* schedule) const
+{
+    // workers only hold on to a schedule for as long as they're processing steps from it
+    for (auto& worker : workers)
+    {
+        while (worker->scheduleInUse.load() == schedule)
+            Thread::yield();
+    }
+}
+
+//=========================================================
+ProcessorChainThreadPool::Worker::Worker (ProcessorChainThreadPool& threadPool) : Thread ("BYOD Processing Worker"),
+                                                                                   pool (threadPool)
+{
+}
+
+bool ProcessorChainThreadPool::Worker::processJobs()
+{
+    bool didWork = false;
+    for (auto& slot : pool.jobSlots)
+    {
+        auto* schedule = slot.load();
+        if (schedule == nullptr)
+            continue;
+
+        // Let the message thread know we're using this schedule, and then make sure that
+        // it's still running. Otherwise it might have been deleted in the meantime.
+        scheduleInUse.store (schedule);
+        if (slot.load() == schedule)
+            didWork |= schedule->processReadySteps (false) > 0;
+        scheduleInUse.store (nullptr);
+    }
+
+    return didWork;
+}
+
+void ProcessorChainThreadPool::Worker::run()
+{
+    auto lastWorkTime = Time::getMillisecondCounterHiRes();
+
+    while (! threadShouldExit())
+    {
+        if (processJobs())
+        {
+            lastWorkTime = Time::getMillisecondCounterHiRes();
+            continue;
+        }
+
+        if (Time::getMillisecondCounterHiRes() - lastWorkTime < workerSpinTimeMs)
+            Thread::yield();
+        else
+            Thread::sleep (1);
+    }
+}
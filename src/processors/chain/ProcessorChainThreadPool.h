@@ -0,0 +1,74 @@
+#pragma once
+
+#include <pch.h>
+
+class ProcessorChainSchedule;
+
+/**
+ * A pool of worker threads that can help the audio thread
+ * run independent branches of the processing schedule.
+ *
+ * There is one pool for the whole process (use it through a
+ * SharedResourcePointer), so that running several instances of
+ * the plugin doesn't multiply the number of worker threads.
+ *
+ * The audio thread never allocates, locks, or waits on the
+ * message thread here. It publishes its schedule in one of a
+ * fixed number of job slots, and then works through the schedule
+ * itself, so it never has to wait for a worker to pick anything up.
+ * Workers poll the job slots, and only spin for a short time after
+ * the last piece of work they did before going back to sleep.
+ */
+class ProcessorChainThreadPool
+{
+public:
+    using SettingID = chowdsp::GlobalPluginSettings::SettingID;
+
+    ProcessorChainThreadPool();
+    ~ProcessorChainThreadPool();
+
+    void globalSettingChanged (SettingID settingID);
+
+    /** Returns true if multi-core processing is turned on, and the worker threads are running. */
+    bool isEnabled() const noexcept { return enabled.load(); }
+
+    /**
+     * Runs the schedule's steps on the calling thread, with help from
+     * any worker threads that are free, returning once every step has
+     * been processed.
+     */
+    void process (ProcessorChainSchedule& schedule);
+
+    /** Waits until no worker thread is using the schedule, so that it can be deleted (message thread only). */
+    void waitUntilReleased (const ProcessorChainSchedule* schedule) const;
+
+    static constexpr SettingID multiCoreOnOffID = "multi_core_onoff";
+
+private:
+    void startWorkers();
+    void stopWorkers();
+
+    struct Worker : Thread
+    {
+        explicit Worker (ProcessorChainThreadPool& pool);
+        void run() override;
+        bool processJobs();
+
+        ProcessorChainThreadPool& pool;
+
+        // the schedule that this worker is using, so that it doesn't get deleted from under us
+        std::atomic<ProcessorChainSchedule*> scheduleInUse { nullptr };
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // schedules that are currently running on an audio thread
+    static constexpr int maxNumJobs = 16;
+    std::array<std::atomic<ProcessorChainSchedule*>, maxNumJobs> jobSlots {};
+
+    std::atomic_bool enabled { false };
+
+    chowdsp::SharedPluginSettings pluginSettings;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorChainThreadPool)
+};
@@ -0,0 +1,65 @@
+#include "RateIslandResampler.h"
+
+void RateIslandResampler::prepare (int newRateDivisor, int maxNumSamples)
+{
+    jassert (isPowerOfTwo (newRateDivisor));
+
+    rateDivisor = newRateDivisor;
+    numStages = roundToInt (std::log2 (rateDivisor));
+
+    downsamplers.assign ((size_t) numStages, {});
+    upsamplers.assign ((size_t) numStages, {});
+
+    for (auto* buffer : { &islandBuffer, &outputBuffer, &scratchBuffer })
+    {
+        buffer->setSize (HalfBandIIR::maxNumChannels, maxNumSamples);
+        buffer->clear();
+    }
+}
+
+AudioBuffer<float>& RateIslandResampler::processIn (const AudioBuffer<float>& chainRateBuffer) noexcept
+{
+    const auto numChannels = chainRateBuffer.getNumChannels();
+    const auto numSamples = chainRateBuffer.getNumSamples();
+    jassert (numChannels <= HalfBandIIR::maxNumChannels);
+    jassert (numSamples % rateDivisor == 0); // the chain's block size should always be a multiple of the oversampling factor!
+
+    islandBuffer.setSize (numChannels, numSamples / rateDivisor, false, false, true);
+    scratchBuffer.setSize (numChannels, numSamples / 2, false, false, true);
+
+    // the scratch buffer can be processed in-place, so every stage but the last one works there
+    dsp::AudioBlock<const float> stageInput { chainRateBuffer };
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        auto& stageBuffer = stage == numStages - 1 ? islandBuffer : scratchBuffer;
+        auto&& stageOutput = dsp::AudioBlock<float> { stageBuffer }.getSubBlock (0, stageInput.getNumSamples() / 2);
+        downsamplers[(size_t) stage].decimate (stageInput, stageOutput);
+        stageInput = stageOutput;
+    }
+
+    return islandBuffer;
+}
+
+AudioBuffer<float>& RateIslandResampler::processOut (const AudioBuffer<float>& islandRateBuffer) noexcept
+{
+    const auto numChannels = islandRateBuffer.getNumChannels();
+    const auto numSamples = islandRateBuffer.getNumSamples();
+    jassert (numChannels <= HalfBandIIR::maxNumChannels);
+
+    outputBuffer.setSize (numChannels, numSamples * rateDivisor, false, false, true);
+    scratchBuffer.setSize (numChannels, numSamples * rateDivisor / 2, false, false, true);
+
+    // upsampling can't be done in-place, so the stages alternate between the
+    // scratch buffer and the output buffer, finishing in the output buffer
+    dsp::AudioBlock<const float> stageInput { islandRateBuffer };
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const auto isOutputStage = (numStages - 1 - stage) % 2 == 0;
+        auto& stageBuffer = isOutputStage ? outputBuffer : scratchBuffer;
+        auto&& stageOutput = dsp::AudioBlock<float> { stageBuffer }.getSubBlock (0, stageInput.getNumSamples() * 2);
+        upsamplers[(size_t) stage].interpolate (stageInput, stageOutput);
+        stageInput = stageOutput;
+    }
+
+    return outputBuffer;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "HalfBandIIR.h"
+
+/**
+ * Resamples the signal going into a rate island down from the chain's
+ * processing rate by a power of two, and the signal coming out of the island
+ * back up to the chain's rate, with a cascade of half-band filters.
+ */
+class RateIslandResampler
+{
+public:
+    RateIslandResampler() = default;
+
+    /** Sets up the resampler for a rate divisor (a power of two), and a maximum block size at the chain's rate. */
+    void prepare (int rateDivisor, int maxNumSamples);
+
+    int getRateDivisor() const noexcept { return rateDivisor; }
+
+    /** Downsamples a block at the chain's rate, and returns the downsampled block. */
+    AudioBuffer<float>& processIn (const AudioBuffer<float>& chainRateBuffer) noexcept;
+
+    /** Upsamples a block from the island back to the chain's rate, and returns the upsampled block. */
+    AudioBuffer<float>& processOut (const AudioBuffer<float>& islandRateBuffer) noexcept;
+
+private:
+    int rateDivisor = 1;
+    int numStages = 0;
+
+    std::vector<HalfBandIIR> downsamplers;
+    std::vector<HalfBandIIR> upsamplers;
+
+    AudioBuffer<float> islandBuffer;
+    AudioBuffer<float> outputBuffer;
+    AudioBuffer<float> scratchBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RateIslandResampler)
+};
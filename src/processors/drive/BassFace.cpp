@@ -1,5 +1,6 @@
 #include "BassFace.h"
 #include "../ParameterHelpers.h"
+#include "neural_utils/BinaryModelData.h"
 
 BassFace::BassFace (UndoManager* um) : BaseProcessor ("Bass Face", createParameterLayout(), um)
 {
@@ -22,46 +23,23 @@ ParamLayout BassFace::createParameterLayout()
 }
 
 template <int hiddenSize, typename ModelType>
-void load_model (ModelType& model, const char* rnnData, int rnnDataSize)
+void load_model (ModelType& model, const BinaryModelData& weights)
 {
-    juce::MemoryInputStream jsonInputStream (rnnData, (size_t) rnnDataSize, false);
-    auto weights_json = nlohmann::json::parse (jsonInputStream.readEntireStreamAsString().toStdString());
-
-    using Vec2d = std::vector<std::vector<float>>;
-    auto transpose = [] (const Vec2d& x) -> Vec2d
-    {
-        auto outer_size = x.size();
-        auto inner_size = x[0].size();
-        Vec2d y (inner_size, std::vector<float> (outer_size, 0.0f));
-
-        for (size_t i = 0; i < outer_size; ++i)
-        {
-            for (size_t j = 0; j < inner_size; ++j)
-                y[j][i] = x[i][j];
-        }
-
-        return std::move (y);
-    };
-
     auto& lstm = model.template get<0>();
     auto& dense = model.template get<1>();
 
-    Vec2d lstm_weights_ih = weights_json["/state_dict/rec.weight_ih_l0"_json_pointer];
-    lstm.setWVals (transpose (lstm_weights_ih));
-
-    Vec2d lstm_weights_hh = weights_json["/state_dict/rec.weight_hh_l0"_json_pointer];
-    lstm.setUVals (transpose (lstm_weights_hh));
+    lstm.setWVals (weights.getRequiredTensor ("/state_dict/rec.weight_ih_l0").toVec2d (true));
+    lstm.setUVals (weights.getRequiredTensor ("/state_dict/rec.weight_hh_l0").toVec2d (true));
 
-    std::vector<float> lstm_bias_ih = weights_json["/state_dict/rec.bias_ih_l0"_json_pointer];
-    std::vector<float> lstm_bias_hh = weights_json["/state_dict/rec.bias_hh_l0"_json_pointer];
+    const auto lstm_bias_ih = weights.getRequiredTensor ("/state_dict/rec.bias_ih_l0").toVector();
+    auto lstm_bias_hh = weights.getRequiredTensor ("/state_dict/rec.bias_hh_l0").toVector();
     for (int i = 0; i < 4 * hiddenSize; ++i)
         lstm_bias_hh[(size_t) i] += lstm_bias_ih[(size_t) i];
     lstm.setBVals (lstm_bias_hh);
 
-    Vec2d dense_weights = weights_json["/state_dict/lin.weight"_json_pointer];
-    dense.setWeights (dense_weights);
+    dense.setWeights (weights.getRequiredTensor ("/state_dict/lin.weight").toVec2d());
 
-    std::vector<float> dense_bias = weights_json["/state_dict/lin.bias"_json_pointer];
+    const auto dense_bias = weights.getRequiredTensor ("/state_dict/lin.bias").toVector();
     dense.setBias (dense_bias.data());
 }
 
@@ -71,16 +49,17 @@ void BassFace::prepare (double sampleRate, int samplesPerBlock)
     {
         if ((int) sampleRate % 44100 == 0)
         {
-            for (auto& m : model)
-                load_model<hiddenSize> (m, BinaryData::bass_face_model_88_2k_json, BinaryData::bass_face_model_88_2k_jsonSize);
+            modelWeights = getSharedAssetCache().getEmbeddedModel (BinaryData::bass_face_model_88_2k_bnnm, BinaryData::bass_face_model_88_2k_bnnmSize);
             return 88200.0;
         }
 
-        for (auto& m : model)
-            load_model<hiddenSize> (m, BinaryData::bass_face_model_96k_json, BinaryData::bass_face_model_96k_jsonSize);
+        modelWeights = getSharedAssetCache().getEmbeddedModel (BinaryData::bass_face_model_96k_bnnm, BinaryData::bass_face_model_96k_bnnmSize);
         return 96000.0;
     }();
 
+    for (auto& m : model)
+        load_model<hiddenSize> (m, *modelWeights);
+
     const size_t oversamplingOrder = sampleRate <= 48000.0 ? 1 : 0;
     oversampling = std::make_unique<juce::dsp::Oversampling<float>> (2, oversamplingOrder, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR);
     oversampling->initProcessing (samplesPerBlock);
@@ -23,6 +23,7 @@ private:
                                    RTNeural::LSTMLayerT<float, 2, hiddenSize, RTNeural::SampleRateCorrectionMode::NoInterp>,
                                    RTNeural::DenseT<float, hiddenSize, 1>>;
     Model model[2];
+    std::shared_ptr<const BinaryModelData> modelWeights;
 
     std::unique_ptr<dsp::Oversampling<float>> oversampling;
 
@@ -5,9 +5,9 @@
 namespace
 {
 const juce::StringArray guitarMLModelResources {
-    "BluesJrAmp_VolKnob_json",
-    "TS9_DriveKnob_json",
-    "MesaRecMini_ModernChannel_GainKnob_json",
+    "BluesJrAmp_VolKnob_bnnm",
+    "TS9_DriveKnob_bnnm",
+    "MesaRecMini_ModernChannel_GainKnob_bnnm",
 };
 
 const juce::StringArray guitarMLModelNames {
@@ -24,28 +24,34 @@ const String conditionTag = "condition";
 const String customModelTag = "custom_model";
 constexpr std::string_view modelNameTag = "byod_guitarml_model_name";
 
-using Vec2d = std::vector<std::vector<float>>;
-auto transpose = [] (const Vec2d& x) -> Vec2d
-{
-    auto outer_size = x.size();
-    auto inner_size = x[0].size();
-    Vec2d y (inner_size, std::vector<float> (outer_size, 0.0f));
+constexpr double crossfadeTimeSeconds = 0.05;
+constexpr int numWarmUpSamples = 5000;
 
-    for (size_t i = 0; i < outer_size; ++i)
-    {
-        for (size_t j = 0; j < inner_size; ++j)
-            y[j][i] = x[i][j];
-    }
+/** User-loaded models are converted to the binary format the first time they're loaded, and cached here. */
+File getModelCacheDirectory()
+{
+    return File::getSpecialLocation (File::userApplicationDataDirectory).getChildFile ("ChowdhuryDSP/BYOD/ModelCache");
+}
 
-    return std::move (y);
-};
+/** Returns the model name that toXML() saved along with the model JSON, without parsing the whole model. */
+String getSavedModelName (const String& modelJsonText)
+{
+    const auto nameKey = "\"" + String (modelNameTag.data(), modelNameTag.size()) + "\":\"";
+    return modelJsonText.fromFirstOccurrenceOf (nameKey, false, false).upToFirstOccurrenceOf ("\"", false, false);
+}
 } // namespace
 
-GuitarMLAmp::GuitarMLAmp (UndoManager* um) : BaseProcessor ("GuitarML", createParameterLayout(), um)
+GuitarMLAmp::GuitarMLAmp (UndoManager* um) : BaseProcessor ("GuitarML", createParameterLayout(), um),
+                                              modelWarmer (
+                                                  getSharedWarmUpThread(),
+                                                  [this] (ModelState& state, double sampleRate, int samplesPerBlock)
+                                                  { warmUpModel (state, sampleRate, samplesPerBlock); },
+                                                  true)
 {
     using namespace ParameterHelpers;
     loadParameterPointer (gainParam, vts, gainTag);
-    conditionParam.setParameterHandle (getParameterPointer<chowdsp::FloatParameter*> (vts, conditionTag));
+    loadParameterPointer (conditionParamHandle, vts, conditionTag);
+    conditionParam.setParameterHandle (conditionParamHandle);
 
     loadModel (0); // load Blues Jr. model by default
 
@@ -69,92 +75,127 @@ ParamLayout GuitarMLAmp::createParameterLayout()
     return { params.begin(), params.end() };
 }
 
-void GuitarMLAmp::loadModelFromJson (const chowdsp::json& modelJson, const String& newModelName)
+GuitarMLAmp::ModelArch GuitarMLAmp::getModelArch (const BinaryModelData& modelData)
 {
-    const auto setModelWeights = [] (const chowdsp::json& weights_json, auto& model, int hiddenSize)
+    const auto& modelDataJson = modelData.getMetadata().at ("model_data");
+    const auto numInputs = modelDataJson.value ("input_size", 1);
+    const auto hiddenSize = modelDataJson.value ("hidden_size", 0);
+
+    if (numInputs == 1 && hiddenSize == 40) // non-conditioned LSMT40
+        return ModelArch::LSTM40NoCond;
+
+    if (numInputs == 2 && hiddenSize == 40) // conditioned LSMT40
+        return ModelArch::LSTM40Cond;
+
+    // unsupported number of inputs!
+    throw std::runtime_error ("Unsupported model architecture!");
+}
+
+void GuitarMLAmp::loadModelData (std::shared_ptr<const BinaryModelData> modelData, const String& newModelName, float newNormalizationGain)
+{
+    jassert (modelData != nullptr);
+
+    // check the model on this thread, so that any errors can be reported to the user
+    const auto newModelArch = getModelArch (*modelData);
+    for (const auto* tensorName : { "/state_dict/rec.weight_ih_l0",
+                                    "/state_dict/rec.weight_hh_l0",
+                                    "/state_dict/rec.bias_ih_l0",
+                                    "/state_dict/rec.bias_hh_l0",
+                                    "/state_dict/lin.weight",
+                                    "/state_dict/lin.bias" })
+        modelData->getRequiredTensor (tensorName);
+
+    if (newModelName.isNotEmpty())
+        currentModelName = newModelName;
+    else if (const auto& metadata = modelData->getMetadata(); metadata.contains (modelNameTag))
+        currentModelName = metadata.value (modelNameTag, std::string {});
+
     {
-        auto& lstm = model.template get<0>();
-        auto& dense = model.template get<1>();
+        SpinLock::ScopedLockType currentModelLocker { currentModelLock };
+        currentModel = std::move (modelData);
+        normalizationGain = newNormalizationGain;
+    }
+
+    modelArch = newModelArch;
+    modelWarmer.requestWarmUp();
+    modelChangeBroadcaster();
+}
 
-        Vec2d lstm_weights_ih = weights_json.at ("/state_dict/rec.weight_ih_l0"_json_pointer);
-        lstm.setWVals (transpose (lstm_weights_ih));
+void GuitarMLAmp::warmUpModel (ModelState& state, double sampleRate, int samplesPerBlock)
+{
+    const auto setModelWeights = [] (const BinaryModelData& weights, auto& model, int hiddenSize)
+    {
+        auto& lstm = model.getRecurrentLayer();
+        auto& dense = model.getDenseLayer();
 
-        Vec2d lstm_weights_hh = weights_json.at ("/state_dict/rec.weight_hh_l0"_json_pointer);
-        lstm.setUVals (transpose (lstm_weights_hh));
+        lstm.setWVals (weights.getRequiredTensor ("/state_dict/rec.weight_ih_l0").toVec2d (true));
+        lstm.setUVals (weights.getRequiredTensor ("/state_dict/rec.weight_hh_l0").toVec2d (true));
 
-        std::vector<float> lstm_bias_ih = weights_json.at ("/state_dict/rec.bias_ih_l0"_json_pointer);
-        std::vector<float> lstm_bias_hh = weights_json.at ("/state_dict/rec.bias_hh_l0"_json_pointer);
+        const auto lstm_bias_ih = weights.getRequiredTensor ("/state_dict/rec.bias_ih_l0").toVector();
+        auto lstm_bias_hh = weights.getRequiredTensor ("/state_dict/rec.bias_hh_l0").toVector();
         for (int i = 0; i < 4 * hiddenSize; ++i)
             lstm_bias_hh[(size_t) i] += lstm_bias_ih[(size_t) i];
         lstm.setBVals (lstm_bias_hh);
 
-        Vec2d dense_weights = weights_json.at ("/state_dict/lin.weight"_json_pointer);
-        dense.setWeights (dense_weights);
+        dense.setWeights (weights.getRequiredTensor ("/state_dict/lin.weight").toVec2d());
 
-        std::vector<float> dense_bias = weights_json.at ("/state_dict/lin.bias"_json_pointer);
+        const auto dense_bias = weights.getRequiredTensor ("/state_dict/lin.bias").toVector();
         dense.setBias (dense_bias.data());
     };
 
-    const auto& modelDataJson = modelJson.at ("model_data");
-    const auto numInputs = modelDataJson.value ("input_size", 1);
-    const auto hiddenSize = modelDataJson.value ("hidden_size", 0);
-    const auto modelSampleRate = modelDataJson.value ("sample_rate", 44100.0);
-    const auto rnnDelaySamples = jmax (1.0, processSampleRate / modelSampleRate);
-
-    if (numInputs == 1 && hiddenSize == 40) // non-conditioned LSMT40
     {
-        SpinLock::ScopedLockType modelChangingLock { modelChangingMutex };
-        for (auto& model : lstm40NoCondModels)
-            setModelWeights (modelJson, model, hiddenSize);
-
-        for (auto& model : lstm40NoCondModels)
-            model.get<0>().prepare ((float) rnnDelaySamples);
-
-        modelArch = ModelArch::LSTM40NoCond;
+        SpinLock::ScopedLockType currentModelLocker { currentModelLock };
+        state.modelData = currentModel;
+        state.normalizationGain = normalizationGain;
     }
-    else if (numInputs == 2 && hiddenSize == 40) // conditioned LSMT40
-    {
-        SpinLock::ScopedLockType modelChangingLock { modelChangingMutex };
-        for (auto& model : lstm40CondModels)
-            setModelWeights (modelJson, model, hiddenSize);
 
-        for (auto& model : lstm40CondModels)
-            model.get<0>().prepare ((float) rnnDelaySamples);
+    // the model has already been checked in loadModelData()
+    jassert (state.modelData != nullptr);
+    state.modelArch = getModelArch (*state.modelData);
 
-        modelArch = ModelArch::LSTM40Cond;
-        conditionParam.reset();
+    const auto modelSampleRate = state.modelData->getMetadata().at ("model_data").value ("sample_rate", 44100.0);
+    const auto rnnDelaySamples = jmax (1.0, sampleRate / modelSampleRate);
+
+    AudioBuffer<float> buffer (2, samplesPerBlock);
+    std::vector<float> conditionData ((size_t) samplesPerBlock, conditionParamHandle->getCurrentValue());
+    if (state.modelArch == ModelArch::LSTM40NoCond)
+    {
+        setModelWeights (*state.modelData, state.lstm40NoCondModel, 40);
+        state.lstm40NoCondModel.getRecurrentLayer().prepare ((float) rnnDelaySamples);
     }
     else
     {
-        // unsupported number of inputs!
-        throw std::exception();
+        setModelWeights (*state.modelData, state.lstm40CondModel, 40);
+        state.lstm40CondModel.getRecurrentLayer().prepare ((float) rnnDelaySamples);
     }
 
-    cachedModel = modelJson;
-    if (newModelName.isNotEmpty())
-        cachedModel[modelNameTag] = newModelName;
+    // run silence through the model until its state has settled
+    for (int i = 0; i < numWarmUpSamples; i += samplesPerBlock)
+    {
+        buffer.clear();
+        processModel (state, buffer, conditionData.data());
+    }
+}
 
-    modelChangeBroadcaster();
+void GuitarMLAmp::loadModelFromJsonText (const std::string& modelJsonText, const String& newModelName)
+{
+    loadModelData (BinaryModelData::fromJSONText (modelJsonText, getModelCacheDirectory()), newModelName);
 }
 
 void GuitarMLAmp::loadModel (int modelIndex, Component* parentComponent)
 {
-    normalizationGain = 1.0f;
-
     if (juce::isPositiveAndBelow (modelIndex, numBuiltInModels))
     {
         int modelDataSize = 0;
         const auto* modelData = BinaryData::getNamedResource (guitarMLModelResources[modelIndex].toRawUTF8(), modelDataSize);
         jassert (modelData != nullptr);
 
-        const auto modelJson = chowdsp::JSONUtils::fromBinaryData (modelData, modelDataSize);
-        loadModelFromJson (modelJson, guitarMLModelNames[modelIndex]);
-
         // The Mesa model is a bit loud, so let's normalize the level down a bit
         // Eventually it would be good to do this sort of thing programmatically.
         // so that it could work for custom loaded models as well.
-        if (modelIndex == 2)
-            normalizationGain = 0.5f;
+        const auto modelNormalizationGain = modelIndex == 2 ? 0.5f : 1.0f;
+
+        loadModelData (getSharedAssetCache().getEmbeddedModel (modelData, modelDataSize), guitarMLModelNames[modelIndex], modelNormalizationGain);
     }
     else if (modelIndex == numBuiltInModels)
     {
@@ -173,8 +214,7 @@ void GuitarMLAmp::loadModel (int modelIndex, Component* parentComponent)
                                              try
                                              {
                                                  auto chosenFileStream = chosenFile.createInputStream (URL::InputStreamOptions (URL::ParameterHandling::inAddress));
-                                                 const auto& modelJson = chowdsp::JSONUtils::fromInputStream (*chosenFileStream);
-                                                 loadModelFromJson (modelJson, chosenFile.getLocalFile().getFileNameWithoutExtension());
+                                                 loadModelFromJsonText (chosenFileStream->readEntireStreamAsString().toStdString(), chosenFile.getLocalFile().getFileNameWithoutExtension());
                                              }
 #else
                 const auto chosenFile = modelChooser.getResult();
@@ -186,8 +226,7 @@ void GuitarMLAmp::loadModel (int modelIndex, Component* parentComponent)
 
                 try
                 {
-                    const auto& modelJson = chowdsp::JSONUtils::fromFile (chosenFile);
-                    loadModelFromJson (modelJson, chosenFile.getFileNameWithoutExtension());
+                    loadModelFromJsonText (chosenFile.loadFileAsString().toStdString(), chosenFile.getFileNameWithoutExtension());
                 }
 #endif
                                              catch (const std::exception& exc)
@@ -211,7 +250,7 @@ void GuitarMLAmp::loadModel (int modelIndex, Component* parentComponent)
 
 String GuitarMLAmp::getCurrentModelName() const
 {
-    return cachedModel.value (modelNameTag, "");
+    return currentModelName;
 }
 
 void GuitarMLAmp::prepare (double sampleRate, int samplesPerBlock)
@@ -223,71 +262,178 @@ void GuitarMLAmp::prepare (double sampleRate, int samplesPerBlock)
     conditionParam.prepare (sampleRate, samplesPerBlock);
     conditionParam.setRampLength (0.05);
 
-    for (auto& model : lstm40NoCondModels)
-        model.get<0>().prepare (1.0f);
+    modelWarmer.warmUpNow (sampleRate, samplesPerBlock);
+    modelWarmer.getActiveState().needsCrossfade = false;
 
-    processSampleRate = sampleRate;
-    loadModelFromJson (cachedModel);
+    previousModelBuffer.setSize (2, samplesPerBlock);
+    crossfadeLengthSamples = (int) (sampleRate * crossfadeTimeSeconds);
+    crossfadeSamplesDone = 0;
 
     dcBlocker.prepare (sampleRate, samplesPerBlock);
+}
 
-    // pre-buffering
-    AudioBuffer<float> buffer (2, samplesPerBlock);
-    for (int i = 0; i < 5000; i += samplesPerBlock)
+size_t GuitarMLAmp::getMemoryFootprint() const
+{
+    std::shared_ptr<const BinaryModelData> model;
     {
-        buffer.clear();
-        processAudio (buffer);
+        SpinLock::ScopedLockType currentModelLocker { currentModelLock };
+        model = currentModel;
     }
+
+    // the warmer keeps the previous model state around while crossfading, along with the active one
+    const auto previousBufferBytes = (size_t) previousModelBuffer.getNumChannels() * (size_t) previousModelBuffer.getNumSamples() * sizeof (float);
+    const auto modelDataBytes = model != nullptr ? model->getOwnedDataSize() : 0;
+    return BaseProcessor::getMemoryFootprint() + 2 * sizeof (ModelState) + previousBufferBytes + modelDataBytes;
 }
 
-void GuitarMLAmp::processAudio (AudioBuffer<float>& buffer)
+void GuitarMLAmp::applyInputGain (const ModelState& state, AudioBuffer<float>& buffer)
 {
-    const SpinLock::ScopedTryLockType modelChangingLock { modelChangingMutex };
-    if (! modelChangingLock.isLocked())
-        return;
+    // only the non-conditioned models use the gain parameter
+    if (state.modelArch == ModelArch::LSTM40NoCond)
+        inGain.process (buffer);
+}
+
+void GuitarMLAmp::processModel (ModelState& state, AudioBuffer<float>& buffer, const float* conditionData)
+{
+    const auto numChannels = buffer.getNumChannels();
+
+    if (state.modelArch == ModelArch::LSTM40NoCond)
+    {
+        if (numChannels == 1)
+            processLSTM40NoCond<1> (state.lstm40NoCondModel, buffer);
+        else
+            processLSTM40NoCond<2> (state.lstm40NoCondModel, buffer);
+    }
+    else if (state.modelArch == ModelArch::LSTM40Cond)
+    {
+        if (numChannels == 1)
+            processLSTM40Cond<1> (state.lstm40CondModel, buffer, conditionData);
+        else
+            processLSTM40Cond<2> (state.lstm40CondModel, buffer, conditionData);
+    }
+
+    buffer.applyGain (state.normalizationGain);
+}
 
+void GuitarMLAmp::processAudio (AudioBuffer<float>& buffer)
+{
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
-    if (modelArch == ModelArch::LSTM40NoCond)
+    auto& state = modelWarmer.getStateForBlock();
+    if (state.needsCrossfade)
     {
-        inGain.setGainDecibels (gainParam->getCurrentValue() - 12.0f);
-        inGain.process (buffer);
+        state.needsCrossfade = false;
+        crossfadeSamplesDone = 0;
+    }
 
+    inGain.setGainDecibels (gainParam->getCurrentValue() - 12.0f);
+    conditionParam.process (numSamples);
+    const auto* conditionData = conditionParam.getSmoothedBuffer();
+
+    auto* previousState = modelWarmer.getPreviousState();
+    if (previousState == nullptr)
+    {
+        applyInputGain (state, buffer);
+        processModel (state, buffer, conditionData);
+    }
+    else
+    {
+        // make sure the input gain smoother only gets run once for this block
+        const auto isSameModelArch = previousState->modelArch == state.modelArch;
+        if (isSameModelArch)
+            applyInputGain (state, buffer);
+
+        previousModelBuffer.setSize (numChannels, numSamples, false, false, true);
         for (int ch = 0; ch < numChannels; ++ch)
+            previousModelBuffer.copyFrom (ch, 0, buffer, ch, 0, numSamples);
+
+        if (! isSameModelArch)
         {
-            auto* x = buffer.getWritePointer (ch);
-            for (int n = 0; n < numSamples; ++n)
-                x[n] += lstm40NoCondModels[ch].forward (&x[n]);
+            applyInputGain (state, buffer);
+            applyInputGain (*previousState, previousModelBuffer);
         }
+
+        processModel (*previousState, previousModelBuffer, conditionData);
+        processModel (state, buffer, conditionData);
+        crossfadeFromPreviousModel (buffer);
     }
-    else if (modelArch == ModelArch::LSTM40Cond)
-    {
-        conditionParam.process (numSamples);
-        const auto* conditionData = conditionParam.getSmoothedBuffer();
 
-        alignas (RTNEURAL_DEFAULT_ALIGNMENT) float inputVec[4] {};
-        for (int ch = 0; ch < numChannels; ++ch)
+    dcBlocker.processAudio (buffer);
+}
+
+void GuitarMLAmp::crossfadeFromPreviousModel (AudioBuffer<float>& buffer)
+{
+    const auto numSamples = buffer.getNumSamples();
+    const auto fadeIncrement = 1.0f / (float) jmax (1, crossfadeLengthSamples);
+    const auto fadeStart = (float) crossfadeSamplesDone * fadeIncrement;
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* x = buffer.getWritePointer (ch);
+        const auto* prevX = previousModelBuffer.getReadPointer (ch);
+        for (int n = 0; n < numSamples; ++n)
         {
-            auto* x = buffer.getWritePointer (ch);
-            for (int n = 0; n < numSamples; ++n)
-            {
-                inputVec[0] = x[n];
-                inputVec[1] = conditionData[n];
-                x[n] += lstm40CondModels[ch].forward (inputVec);
-            }
+            const auto newModelGain = jmin (1.0f, fadeStart + (float) n * fadeIncrement);
+            x[n] = prevX[n] + newModelGain * (x[n] - prevX[n]);
         }
     }
 
-    buffer.applyGain (normalizationGain);
+    crossfadeSamplesDone += numSamples;
+    if (crossfadeSamplesDone >= crossfadeLengthSamples)
+        modelWarmer.releasePreviousState();
+}
 
-    dcBlocker.processAudio (buffer);
+template <int numChannels>
+void GuitarMLAmp::processLSTM40NoCond (LSTM40NoCond& model, AudioBuffer<float>& buffer)
+{
+    auto* const* x = buffer.getArrayOfWritePointers();
+    LSTM40NoCond::InputType inputMat;
+    for (int n = 0; n < buffer.getNumSamples(); ++n)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            inputMat (0, ch) = x[ch][n];
+
+        const auto& y = model.forward<numChannels> (inputMat);
+        for (int ch = 0; ch < numChannels; ++ch)
+            x[ch][n] += y (ch);
+    }
+}
+
+template <int numChannels>
+void GuitarMLAmp::processLSTM40Cond (LSTM40Cond& model, AudioBuffer<float>& buffer, const float* conditionData)
+{
+    // the condition input is the same for both channels
+    auto* const* x = buffer.getArrayOfWritePointers();
+    LSTM40Cond::InputType inputMat;
+    for (int n = 0; n < buffer.getNumSamples(); ++n)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            inputMat (0, ch) = x[ch][n];
+            inputMat (1, ch) = conditionData[n];
+        }
+
+        const auto& y = model.forward<numChannels> (inputMat);
+        for (int ch = 0; ch < numChannels; ++ch)
+            x[ch][n] += y (ch);
+    }
 }
 
 std::unique_ptr<XmlElement> GuitarMLAmp::toXML()
 {
     auto xml = BaseProcessor::toXML();
-    xml->setAttribute (customModelTag, cachedModel.dump());
+
+    std::shared_ptr<const BinaryModelData> modelData;
+    {
+        SpinLock::ScopedLockType currentModelLocker { currentModelLock };
+        modelData = currentModel;
+    }
+
+    // the model is saved as JSON, so that the state can be loaded by older versions of the plugin
+    auto modelJson = modelData->toJSON();
+    modelJson[modelNameTag] = currentModelName.toStdString();
+    xml->setAttribute (customModelTag, modelJson.dump());
 
     return std::move (xml);
 }
@@ -297,8 +443,24 @@ void GuitarMLAmp::fromXML (XmlElement* xml, const chowdsp::Version& version, boo
     const auto modelJsonString = xml->getStringAttribute (customModelTag, {});
     try
     {
-        const auto& modelJson = chowdsp::json::parse (modelJsonString.toStdString());
-        loadModelFromJson (modelJson);
+        // The built-in models are saved as JSON too, but they shouldn't end up in the user model cache.
+        // If the saved model has the same name and weights as one of them, load the built-in model instead.
+        if (const auto builtInModelIndex = guitarMLModelNames.indexOf (getSavedModelName (modelJsonString)); builtInModelIndex >= 0)
+        {
+            int builtInModelDataSize = 0;
+            const auto* builtInModelData = BinaryData::getNamedResource (guitarMLModelResources[builtInModelIndex].toRawUTF8(), builtInModelDataSize);
+            const auto builtInModel = getSharedAssetCache().getEmbeddedModel (builtInModelData, builtInModelDataSize);
+
+            std::shared_ptr<const BinaryModelData> savedModel = BinaryModelData::fromJSONText (modelJsonString.toStdString(), {});
+            if (builtInModel != nullptr && builtInModel->hasSameWeights (*savedModel))
+                loadModel (builtInModelIndex);
+            else
+                loadModelData (std::move (savedModel));
+        }
+        else
+        {
+            loadModelFromJsonText (modelJsonString.toStdString());
+        }
     }
     catch (...)
     {
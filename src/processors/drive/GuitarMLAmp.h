@@ -2,6 +2,7 @@
 
 #include "../BaseProcessor.h"
 #include "../utility/DCBlocker.h"
+#include "neural_utils/BinaryModelData.h"
 #include "neural_utils/ResampledRNN.h"
 
 class GuitarMLAmp : public BaseProcessor
@@ -15,6 +16,7 @@ public:
 
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
     std::unique_ptr<XmlElement> toXML() override;
     void fromXML (XmlElement* xml, const chowdsp::Version& version, bool loadPosition) override;
@@ -26,40 +28,70 @@ public:
     String getCurrentModelName() const;
 
 private:
-    void loadModelFromJson (const chowdsp::json& modelJson, const String& newModelName = {});
+    void loadModelData (std::shared_ptr<const BinaryModelData> modelData, const String& newModelName = {}, float newNormalizationGain = 1.0f);
+    void loadModelFromJsonText (const std::string& modelJsonText, const String& newModelName = {});
     using ModelChangeBroadcaster = chowdsp::Broadcaster<void()>;
     ModelChangeBroadcaster modelChangeBroadcaster;
 
     chowdsp::FloatParameter* gainParam = nullptr;
+    chowdsp::FloatParameter* conditionParamHandle = nullptr;
     chowdsp::SmoothedBufferValue<float> conditionParam;
     chowdsp::Gain<float> inGain;
 
-    SpinLock modelChangingMutex;
-    double processSampleRate = 96000.0;
     std::shared_ptr<FileChooser> customModelChooser;
 
+    // each model processes both channels at once
     template <int numIns, int hiddenSize>
-    using GuitarML_LSTM = RTNeural::ModelT<float, numIns, 1, RTNeural::LSTMLayerT<float, numIns, hiddenSize, RTNeural::SampleRateCorrectionMode::LinInterp>, RTNeural::DenseT<float, hiddenSize, 1>>;
+    using GuitarML_LSTM = batched_rnn::Model<batched_rnn::LSTMLayer<numIns, hiddenSize, RTNeural::SampleRateCorrectionMode::LinInterp>>;
 
     using LSTM40Cond = GuitarML_LSTM<2, 40>;
     using LSTM40NoCond = GuitarML_LSTM<1, 40>;
 
-    std::array<LSTM40Cond, 2> lstm40CondModels;
-    std::array<LSTM40NoCond, 2> lstm40NoCondModels;
-
     enum class ModelArch
     {
         LSTM40Cond,
         LSTM40NoCond,
     };
 
-    ModelArch modelArch = ModelArch::LSTM40NoCond;
+    static ModelArch getModelArch (const BinaryModelData& modelData);
+
+    struct ModelState
+    {
+        LSTM40Cond lstm40CondModel;
+        LSTM40NoCond lstm40NoCondModel;
+        ModelArch modelArch = ModelArch::LSTM40NoCond;
+        std::shared_ptr<const BinaryModelData> modelData;
+        float normalizationGain = 1.0f;
+        bool needsCrossfade = true;
+    };
 
-    chowdsp::json cachedModel {};
+    void warmUpModel (ModelState& state, double sampleRate, int samplesPerBlock);
+    void applyInputGain (const ModelState& state, AudioBuffer<float>& buffer);
+    static void processModel (ModelState& state, AudioBuffer<float>& buffer, const float* conditionData);
+    void crossfadeFromPreviousModel (AudioBuffer<float>& buffer);
 
-    DCBlocker dcBlocker;
+    template <int numChannels>
+    static void processLSTM40NoCond (LSTM40NoCond& model, AudioBuffer<float>& buffer);
 
+    template <int numChannels>
+    static void processLSTM40Cond (LSTM40Cond& model, AudioBuffer<float>& buffer, const float* conditionData);
+
+    // the most recently loaded model (message thread)
+    ModelArch modelArch = ModelArch::LSTM40NoCond;
+    String currentModelName;
+
+    // the model for the warm-up thread to load next
+    std::shared_ptr<const BinaryModelData> currentModel;
     float normalizationGain = 1.0f;
+    SpinLock currentModelLock;
+
+    // new models are loaded and settled in the background, and then crossfaded in on the audio thread
+    ProcessorStateWarmer<ModelState> modelWarmer;
+    AudioBuffer<float> previousModelBuffer;
+    int crossfadeSamplesDone = 0;
+    int crossfadeLengthSamples = 0;
+
+    DCBlocker dcBlocker;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GuitarMLAmp)
 };
@@ -10,16 +10,20 @@ public:
     explicit MetalFace (UndoManager* um);
 
     ProcessorType getProcessorType() const override { return Drive; }
+    ProcessingRate getPreferredProcessingRate() const override { return { ProcessingRate::Type::ModelRate, 1, modelSampleRate }; }
     static ParamLayout createParameterLayout();
 
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
 private:
+    static constexpr double modelSampleRate = 96000.0;
+
     chowdsp::FloatParameter* gainDBParam = nullptr;
 
     dsp::Gain<float> gain;
-    ResampledRNN<28> rnn[2];
+    ResampledRNN<28> rnn; // processes both channels at once
 
     DCBlocker dcBlocker;
 
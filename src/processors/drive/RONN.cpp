@@ -3,6 +3,7 @@
 namespace
 {
 int randomSeeds[5] = { 1, 101, 2048, 5005, 9001 };
+constexpr float dcBlockerFreqHz = 30.0f; // same as the default for the DC Blocker module
 
 using Vec = std::vector<float>;
 using Vec2 = std::vector<Vec>;
@@ -31,15 +32,17 @@ Vec2 createRandomVec2 (std::default_random_engine& generator, DistType& distribu
 
 struct Orthogonal
 {
+    // shared by every orthogonal matrix in a model, so the draws match the original static distribution
+    std::normal_distribution<float> gaussian { 0.0f, 1.0f };
 };
 template <>
-Vec2 createRandomVec2<Orthogonal> (std::default_random_engine& generator, Orthogonal&, int size1, int size2)
+Vec2 createRandomVec2<Orthogonal> (std::default_random_engine& generator, Orthogonal& ortho, int size1, int size2)
 {
-    static std::normal_distribution<float> gaussian (0.0f, 1.0f);
+    auto& gaussian = ortho.gaussian;
 
     using namespace Eigen;
     const auto dim = jmax (size1, size2);
-    MatrixXf X = MatrixXf::Zero (dim, dim).unaryExpr ([&generator] (double)
+    MatrixXf X = MatrixXf::Zero (dim, dim).unaryExpr ([&generator, &gaussian] (double)
                                                       { return gaussian (generator); });
     MatrixXf XtX = X.transpose() * X;
     SelfAdjointEigenSolver<MatrixXf> es (XtX);
@@ -94,11 +97,14 @@ Vec3 createRandomVec3<GlorotUniform> (std::default_random_engine& generator, Glo
 }
 } // namespace
 
-RONN::RONN (UndoManager* um) : BaseProcessor ("RONN", createParameterLayout(), um)
+RONN::RONN (UndoManager* um) : BaseProcessor ("RONN", createParameterLayout(), um),
+                               stateWarmer (getSharedWarmUpThread(),
+                                            [this] (DSPState& state, double sampleRate, int samplesPerBlock)
+                                            { warmUpState (state, sampleRate, samplesPerBlock); })
 {
     chowdsp::ParamUtils::loadParameterPointer (inGainDbParam, vts, "gain_db");
+    seedParam = vts.getRawParameterValue ("seed");
     vts.addParameterListener ("seed", this);
-    parameterChanged ("seed", vts.getRawParameterValue ("seed")->load());
 
     uiOptions.backgroundColour = Colours::indianred;
     uiOptions.powerColour = Colours::cyan;
@@ -121,23 +127,23 @@ ParamLayout RONN::createParameterLayout()
     return { params.begin(), params.end() };
 }
 
-void RONN::parameterChanged (const String& parameterID, float newValue)
+void RONN::parameterChanged (const String& parameterID, float)
 {
     if (parameterID != "seed")
         return;
 
-    auto seedIdx = int (newValue);
-    reloadModel (randomSeeds[seedIdx]);
-    needsPrebuffering = true;
+    stateWarmer.requestWarmUp();
 }
 
-void RONN::reloadModel (int randomSeed)
+void RONN::reloadModel (DSPState& state, int randomSeed)
 {
-    // set up random distributions
+    // Set up random distributions. These used to be static, so a seed's weights depended on which
+    // models had been loaded before it in the same process. Now every load of a seed gets the weights
+    // it would have had as the first model loaded in the process.
     std::default_random_engine generator ((std::default_random_engine::result_type) randomSeed);
-    static std::normal_distribution<float> normal (0.0f, 0.05f);
-    static Orthogonal ortho;
-    static GlorotUniform glorot;
+    std::normal_distribution<float> normal (0.0f, 0.05f);
+    Orthogonal ortho;
+    GlorotUniform glorot;
 
     auto denseInWeights = createRandomVec2 (generator, normal, 8, 1);
     auto denseInBias = createRandomVec (generator, normal, 8);
@@ -152,35 +158,48 @@ void RONN::reloadModel (int randomSeed)
     auto denseOutWeights = createRandomVec2 (generator, ortho, 1, 8);
     auto denseOutBias = createRandomVec (generator, normal, 1);
 
+    for (auto& nn : state.neuralNet)
     {
-        SpinLock::ScopedLockType modelLoadingScopedLock (modelLoadingLock);
-        for (auto& nn : neuralNet)
-        {
-            nn.get<0>().setWeights (denseInWeights);
-            nn.get<0>().setBias (denseInBias.data());
+        nn.get<0>().setWeights (denseInWeights);
+        nn.get<0>().setBias (denseInBias.data());
 
-            nn.get<2>().setWeights (convWeights);
-            nn.get<2>().setBias (convBias);
+        nn.get<2>().setWeights (convWeights);
+        nn.get<2>().setBias (convBias);
 
-            nn.get<4>().setWVals (gruKernel);
-            nn.get<4>().setUVals (gruRecurrent);
-            nn.get<4>().setBVals (gruBias);
+        nn.get<4>().setWVals (gruKernel);
+        nn.get<4>().setUVals (gruRecurrent);
+        nn.get<4>().setBVals (gruBias);
 
-            nn.get<5>().setWeights (denseOutWeights);
-            nn.get<5>().setBias (denseOutBias.data());
+        nn.get<5>().setWeights (denseOutWeights);
+        nn.get<5>().setBias (denseOutBias.data());
 
-            nn.reset();
+        nn.reset();
 
-            float input[] = { 1.0f };
-            makeupGain = 1.0f / std::abs (nn.forward (input));
-            nn.reset();
-        }
+        float input[] = { 1.0f };
+        state.makeupGain = 1.0f / std::abs (nn.forward (input));
+        nn.reset();
     }
 
-    if (std::isnan (makeupGain) || std::isinf (makeupGain))
-        reloadModel (randomSeed + 1);
+    if (std::isnan (state.makeupGain) || std::isinf (state.makeupGain))
+        reloadModel (state, randomSeed + 1);
 
-    makeupGain = jmax (makeupGain, 30.0f);
+    state.makeupGain = jmax (state.makeupGain, 30.0f);
+}
+
+void RONN::warmUpState (DSPState& state, double sampleRate, int samplesPerBlock)
+{
+    reloadModel (state, randomSeeds[(int) seedParam->load()]);
+
+    state.dcBlocker.prepare ({ sampleRate, (uint32) samplesPerBlock, 2 });
+    state.dcBlocker.setCutoffFrequency (dcBlockerFreqHz);
+
+    // run silence through the network until its state has settled
+    AudioBuffer<float> buffer (2, samplesPerBlock);
+    for (int i = 0; i < 100000; i += samplesPerBlock)
+    {
+        buffer.clear();
+        processNeuralNet (state, buffer);
+    }
 }
 
 void RONN::prepare (double sampleRate, int samplesPerBlock)
@@ -191,41 +210,36 @@ void RONN::prepare (double sampleRate, int samplesPerBlock)
 
     outputGain.prepare (spec);
 
-    neuralNet[0].reset();
-    neuralNet[1].reset();
-
-    dcBlocker.prepare (sampleRate, samplesPerBlock);
-
-    maxBlockSize = samplesPerBlock;
-    doPrebuffering();
+    stateWarmer.warmUpNow (sampleRate, samplesPerBlock);
 }
 
-void RONN::doPrebuffering()
+void RONN::processNeuralNet (DSPState& state, AudioBuffer<float>& buffer)
 {
-    needsPrebuffering = false;
-
-    // pre-buffering
-    AudioBuffer<float> buffer (2, maxBlockSize);
-    for (int i = 0; i < 100000; i += maxBlockSize)
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
     {
-        buffer.clear();
-        processAudio (buffer);
+        auto* x = buffer.getWritePointer (ch);
+        for (int n = 0; n < buffer.getNumSamples(); ++n)
+        {
+            float input alignas (16)[] = { x[n] };
+            x[n] = state.neuralNet[ch].forward (input);
+        }
     }
 
-    outputGain.setRampDurationSeconds (0.0);
-    outputGain.setGainLinear (0.0f);
-    outputGain.setRampDurationSeconds (0.25);
-    outputGain.setGainLinear (makeupGain);
+    state.dcBlocker.processBlock (buffer);
 }
 
 void RONN::processAudio (AudioBuffer<float>& buffer)
 {
-    SpinLock::ScopedTryLockType modelLoadingTryLock (modelLoadingLock);
-    if (! modelLoadingTryLock.isLocked())
-        return;
-
-    if (needsPrebuffering)
-        doPrebuffering();
+    auto& state = stateWarmer.getStateForBlock();
+    if (state.needsFadeIn)
+    {
+        // fade in the output from a newly loaded network
+        state.needsFadeIn = false;
+        outputGain.setRampDurationSeconds (0.0);
+        outputGain.setGainLinear (0.0f);
+        outputGain.setRampDurationSeconds (0.25);
+        outputGain.setGainLinear (state.makeupGain);
+    }
 
     dsp::AudioBlock<float> block (buffer);
     dsp::ProcessContextReplacing<float> context (block);
@@ -233,17 +247,7 @@ void RONN::processAudio (AudioBuffer<float>& buffer)
     inputGain.setGainDecibels (inGainDbParam->getCurrentValue() + 25.0f);
     inputGain.process (context);
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        auto* x = buffer.getWritePointer (ch);
-        for (int n = 0; n < buffer.getNumSamples(); ++n)
-        {
-            float input alignas (16)[] = { x[n] };
-            x[n] = neuralNet[ch].forward (input);
-        }
-    }
-
-    dcBlocker.processAudio (buffer);
+    processNeuralNet (state, buffer);
     outputGain.process (context);
 
     for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
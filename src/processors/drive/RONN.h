@@ -2,7 +2,6 @@
 
 #include "../BaseProcessor.h"
 #include "../ParameterHelpers.h"
-#include "../utility/DCBlocker.h"
 
 class RONN : public BaseProcessor,
              private AudioProcessorValueTreeState::Listener
@@ -18,23 +17,29 @@ public:
     void processAudio (AudioBuffer<float>& buffer) override;
 
 private:
-    void doPrebuffering();
+    using NeuralNet = RTNeural::ModelT<float, 1, 1, RTNeural::DenseT<float, 1, 8>, RTNeural::TanhActivationT<float, 8>, RTNeural::Conv1DT<float, 8, 4, 3, 2>, RTNeural::TanhActivationT<float, 4>, RTNeural::GRULayerT<float, 4, 8>, RTNeural::DenseT<float, 8, 1>>;
+
+    struct DSPState
+    {
+        NeuralNet neuralNet[2];
+        chowdsp::SVFHighpass<float> dcBlocker;
+        float makeupGain = 1.0f;
+        bool needsFadeIn = true;
+    };
 
     // model loading utils
-    SpinLock modelLoadingLock;
-    void reloadModel (int randomSeed);
+    static void reloadModel (DSPState& state, int randomSeed);
+    void warmUpState (DSPState& state, double sampleRate, int samplesPerBlock);
+    static void processNeuralNet (DSPState& state, AudioBuffer<float>& buffer);
 
     // input gain
     chowdsp::FloatParameter* inGainDbParam = nullptr;
+    std::atomic<float>* seedParam = nullptr;
     dsp::Gain<float> inputGain;
     dsp::Gain<float> outputGain;
-    float makeupGain = 1.0f;
-
-    RTNeural::ModelT<float, 1, 1, RTNeural::DenseT<float, 1, 8>, RTNeural::TanhActivationT<float, 8>, RTNeural::Conv1DT<float, 8, 4, 3, 2>, RTNeural::TanhActivationT<float, 4>, RTNeural::GRULayerT<float, 4, 8>, RTNeural::DenseT<float, 8, 1>> neuralNet[2];
 
-    std::atomic_bool needsPrebuffering { false };
-    int maxBlockSize = 0;
-    DCBlocker dcBlocker;
+    // the network is re-loaded and settled in the background whenever the seed changes
+    ProcessorStateWarmer<DSPState> stateWarmer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RONN)
 };
@@ -5,23 +5,20 @@ namespace
 {
 inline float f_NL (float x, float fbDrive) noexcept
 {
-    return std::tanh (x) / fbDrive;
+    return FastMath::tanh<FastMath::Accuracy::Balanced> (x) / fbDrive;
 }
 
-inline float f_NL_prime (float x, float fbDrive) noexcept
+inline float func (float y, float tanhYDrive, float x, float Hn, float h0, float G, float fbDrive) noexcept
 {
-    const auto coshX = std::cosh (x);
-    return 1.0f / (coshX * coshX * fbDrive);
+    return y - h0 * (x + G * tanhYDrive / fbDrive) - Hn;
 }
 
-inline float func (float x, float y, float yDrive, float Hn, float h0, float G, float fbDrive) noexcept
+inline float func_deriv (float tanhYDrive, float h0, float G, float fbDrive) noexcept
 {
-    return y - h0 * (x + G * f_NL (yDrive, fbDrive)) - Hn;
-}
-
-inline float func_deriv (float yDrive, float h0, float G, float fbDrive) noexcept
-{
-    return 1.0f - h0 * G * f_NL_prime (yDrive, fbDrive);
+    // f_NL'(x) = (1 - tanh^2(x)) / fbDrive, since 1 / cosh^2(x) = 1 - tanh^2(x).
+    // In float, 1 - tanh^2 loses nearly all of its relative precision for |x| > ~4,
+    // but by then the derivative is tiny next to the 1 here, so the step barely changes.
+    return 1.0f - h0 * G * (1.0f - tanhYDrive * tanhYDrive) / fbDrive;
 }
 
 template <int MAX_ITER>
@@ -29,8 +26,9 @@ inline std::pair<float, float> newton_raphson (float x, float y1, float b, float
 {
     for (size_t k = 0; k < MAX_ITER; ++k)
     {
-        const auto yDrive = y1 * fbDrive;
-        const auto delta = -1.0f * func (x, y1, yDrive, z, b, fbAmount, fbDrive) / func_deriv (yDrive, b, fbAmount, fbDrive);
+        // the function and its derivative share the same tanh
+        const auto tanhYDrive = FastMath::tanh<FastMath::Accuracy::Balanced> (y1 * fbDrive);
+        const auto delta = -1.0f * func (y1, tanhYDrive, x, z, b, fbAmount, fbDrive) / func_deriv (tanhYDrive, b, fbAmount, fbDrive);
 
         y1 += delta;
     }
@@ -116,7 +114,7 @@ void Warp::processAudio (AudioBuffer<float>& buffer)
         f.biquad.processSample (y0, f.driveAmt);
         f.y1 = y1;
 
-        return std::tanh (y1 * 0.5f);
+        return FastMath::tanh<FastMath::Accuracy::Balanced> (y1 * 0.5f);
     };
 
     fbDriveSmooth.process (numSamples);
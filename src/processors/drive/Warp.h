@@ -2,6 +2,7 @@
 
 #include "../BaseProcessor.h"
 #include "../utility/DCBlocker.h"
+#include "../utility/FastMath.h"
 
 class Warp : public BaseProcessor
 {
@@ -33,7 +34,7 @@ private:
             inline float processSample (float x, float driveG) noexcept
             {
                 float y = z[1] + x * b[0];
-                float y_d = std::asinh (y * driveG) / driveG;
+                float y_d = FastMath::asinh<FastMath::Accuracy::Balanced> (y * driveG) / driveG;
                 z[1] = z[2] + x * b[1] - y_d * a[1];
                 z[order] = x * b[order] - y_d * a[order];
                 return y;
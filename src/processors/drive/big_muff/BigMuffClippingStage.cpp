@@ -1,4 +1,5 @@
 #include "BigMuffClippingStage.h"
+#include "../../utility/FastMath.h"
 
 namespace
 {
@@ -18,14 +19,15 @@ constexpr float A = -10000.0f / 150.0f; // BJT Common-Emitter amp gain
 constexpr float VbiasA = 0.7f; // bias point after input filter
 
 // compute sinh and cosh at the same time so it's faster...
-inline auto sinh_cosh (float x) noexcept
+template <FastMath::Accuracy accuracy, typename T>
+inline auto sinh_cosh (T x) noexcept
 {
     // ref: https://en.wikipedia.org/wiki/Hyperbolic_functions#Definitions
     // sinh = (e^(2x) - 1) / (2e^x), cosh = (e^(2x) + 1) / (2e^x)
     // let B = e^x, then sinh = (B^2 - 1) / (2B), cosh = (B^2 + 1) / (2B)
     // simplifying, we get: sinh = 0.5 (B - 1/B), cosh = 0.5 (B + 1/B)
 
-    auto B = std::exp (x);
+    auto B = FastMath::exp<accuracy> (x);
     auto Br = 0.5f / B;
     B *= 0.5f;
 
@@ -35,14 +37,15 @@ inline auto sinh_cosh (float x) noexcept
     return std::make_pair (sinh, cosh);
 }
 
-template <int numIters>
-inline float newton_raphson (float x, float y, float C_12_state, float G_C_12) noexcept
+// in low-quality mode the diode current uses the fast exp(), which only moves the solution by ~1e-4 relative to the exact one
+template <int numIters, FastMath::Accuracy accuracy, typename T>
+inline T newton_raphson (T x, T y, T C_12_state, float G_C_12) noexcept
 {
     for (int k = 0; k < numIters; ++k)
     {
         auto v_drop = y - VbiasA;
 
-        auto [sinh_v, cosh_v] = sinh_cosh (v_drop / Vt);
+        auto [sinh_v, cosh_v] = sinh_cosh<accuracy> (v_drop / Vt);
         auto i_diodes = twoIs * sinh_v;
         auto di_diodes = twoIs_over_Vt * cosh_v;
 
@@ -76,13 +79,11 @@ void BigMuffClippingStage::prepare (double sampleRate)
 
 void BigMuffClippingStage::reset()
 {
-    for (int ch = 0; ch < 2; ++ch)
-    {
-        inputFilter[ch].reset();
+    for (auto& filt : inputFilter)
+        filt.reset();
 
-        y_1[ch] = 0.0f;
-        C_12_1[ch] = 0.0f;
-    }
+    y_1 = Vec (0.0f);
+    C_12_1 = Vec (0.0f);
 }
 
 float BigMuffClippingStage::getGC12 (float fs, float smoothing)
@@ -91,45 +92,48 @@ float BigMuffClippingStage::getGC12 (float fs, float smoothing)
     return 2.0f * (C12 + smoothing * 200.0e-12f) * fs;
 }
 
-template <bool highQuality>
-void BigMuffClippingStage::processBlock (AudioBuffer<float>& buffer, const chowdsp::SmoothedBufferValue<float>& gc12Smoothed) noexcept
+void BigMuffClippingStage::processInputFilter (AudioBuffer<float>& buffer) noexcept
 {
-    const auto numChannels = buffer.getNumChannels();
-    const auto numSamples = buffer.getNumSamples();
-
-    const auto processSample = [this] (int ch, float x, float G_C_12)
-    {
-        // input filter
-        auto u_n = inputFilter[ch].processSample (x);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        inputFilter[ch].processBlock (buffer.getWritePointer (ch), buffer.getNumSamples());
+}
 
-        // newton-raphson
-        float y_k = newton_raphson<(highQuality ? 8 : 4)> (u_n, y_1[ch], C_12_1[ch], G_C_12);
+template <bool highQuality>
+BigMuffClippingStage::Vec BigMuffClippingStage::processSample (Vec u_n, float G_C_12) noexcept
+{
+    // newton-raphson
+    auto y_k = newton_raphson<(highQuality ? 8 : 4), (highQuality ? FastMath::Accuracy::Balanced : FastMath::Accuracy::Fast)> (u_n, y_1, C_12_1, G_C_12);
 
-        // update state
-        C_12_1[ch] = 2.0f * (y_k - VbiasA) * G_C_12 - C_12_1[ch];
-        y_1[ch] = y_k;
+    // update state
+    C_12_1 = 2.0f * (y_k - VbiasA) * G_C_12 - C_12_1;
+    y_1 = y_k;
 
-        return y_k;
-    };
+    return y_k;
+}
 
-    for (int ch = 0; ch < numChannels; ++ch)
+template <bool highQuality>
+void BigMuffClippingStage::processBlock (AudioBuffer<float>& buffer, const chowdsp::SmoothedBufferValue<float>& gc12Smoothed) noexcept
+{
+    if (! gc12Smoothed.isSmoothing())
     {
-        auto* x = buffer.getWritePointer (ch);
-
-        if (gc12Smoothed.isSmoothing())
-        {
-            const auto G_C_12_data = gc12Smoothed.getSmoothedBuffer();
-            for (int n = 0; n < numSamples; ++n)
-                x[n] = processSample (ch, x[n], G_C_12_data[n]);
-        }
-        else
-        {
-            const auto G_C_12 = gc12Smoothed.getCurrentValue();
-            for (int n = 0; n < numSamples; ++n)
-                x[n] = processSample (ch, x[n], G_C_12);
-        }
+        processBlock<highQuality> (buffer, gc12Smoothed.getCurrentValue());
+        return;
     }
+
+    processInputFilter (buffer);
+
+    const auto* G_C_12_data = gc12Smoothed.getSmoothedBuffer();
+    ChannelBatch::process<Vec> (buffer, [this, G_C_12_data, n = 0] (Vec u_n) mutable { return processSample<highQuality> (u_n, G_C_12_data[n++]); });
+}
+
+template <bool highQuality>
+void BigMuffClippingStage::processBlock (AudioBuffer<float>& buffer, float G_C_12) noexcept
+{
+    processInputFilter (buffer);
+    ChannelBatch::process<Vec> (buffer, [this, G_C_12] (Vec u_n) { return processSample<highQuality> (u_n, G_C_12); });
 }
 
 template void BigMuffClippingStage::processBlock<true> (AudioBuffer<float>&, const chowdsp::SmoothedBufferValue<float>&) noexcept;
 template void BigMuffClippingStage::processBlock<false> (AudioBuffer<float>&, const chowdsp::SmoothedBufferValue<float>&) noexcept;
+template void BigMuffClippingStage::processBlock<true> (AudioBuffer<float>&, float) noexcept;
+template void BigMuffClippingStage::processBlock<false> (AudioBuffer<float>&, float) noexcept;
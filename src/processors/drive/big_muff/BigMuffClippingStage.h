@@ -1,7 +1,11 @@
 #pragma once
 
-#include <pch.h>
+#include "../../utility/ChannelBatch.h"
 
+/**
+ * One clipping stage from the Big Muff. The input filter runs on each channel
+ * separately, and the Newton-Raphson solver processes all channels at once.
+ */
 class BigMuffClippingStage
 {
 public:
@@ -13,14 +17,25 @@ public:
     template <bool highQuality>
     void processBlock (AudioBuffer<float>& buffer, const chowdsp::SmoothedBufferValue<float>& gc12Smoothed) noexcept;
 
+    /** Processes a block with a fixed value for the C12 admittance. */
+    template <bool highQuality>
+    void processBlock (AudioBuffer<float>& buffer, float G_C_12) noexcept;
+
     static float getGC12 (float fs, float smoothing);
 
 private:
+    using Vec = ChannelBatch::Vec;
+
+    void processInputFilter (AudioBuffer<float>& buffer) noexcept;
+
+    template <bool highQuality>
+    Vec processSample (Vec u_n, float G_C_12) noexcept;
+
     chowdsp::IIRFilter<1, float> inputFilter[2];
 
     float fs = 48000.0f;
-    float y_1[2] {}; // newton-raphson state
-    float C_12_1[2] {}; // capacitor C12 state
+    Vec y_1 { 0.0f }; // newton-raphson state
+    Vec C_12_1 { 0.0f }; // capacitor C12 state
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BigMuffClippingStage)
 };
@@ -13,13 +13,17 @@ const auto sustainRange = ParameterHelpers::createNormalisableRange (0.4f, 2.0f,
 const auto levelRange = ParameterHelpers::createNormalisableRange (-60.0f, 0.0f, -9.0f);
 } // namespace
 
-BigMuffDrive::BigMuffDrive (UndoManager* um) : BaseProcessor ("Muff Drive", createParameterLayout(), um)
+BigMuffDrive::BigMuffDrive (UndoManager* um) : BaseProcessor ("Muff Drive", createParameterLayout(), um),
+                                               stateWarmer (getSharedWarmUpThread(),
+                                                            [this] (DSPState& state, double sampleRate, int samplesPerBlock)
+                                                            { warmUpState (state, sampleRate, samplesPerBlock); })
 {
     using namespace ParameterHelpers;
     loadParameterPointer (sustainParam, vts, "sustain");
     loadParameterPointer (harmParam, vts, "harmonics");
     loadParameterPointer (levelParam, vts, "level");
-    smoothingParam.setParameterHandle (getParameterPointer<chowdsp::FloatParameter*> (vts, "smoothing"));
+    loadParameterPointer (smoothingAmountParam, vts, "smoothing");
+    smoothingParam.setParameterHandle (smoothingAmountParam);
     nStagesParam = vts.getRawParameterValue ("n_stages");
     hiQParam = vts.getRawParameterValue ("high_q");
 
@@ -67,9 +71,6 @@ void BigMuffDrive::prepare (double sampleRate, int samplesPerBlock)
     };
     smoothingParam.prepare (sampleRate, samplesPerBlock);
 
-    for (auto& stage : stages)
-        stage.prepare (sampleRate);
-
     auto spec = dsp::ProcessSpec { sampleRate, (uint32) samplesPerBlock, 2 };
 
     sustainGain.prepare (spec);
@@ -78,24 +79,39 @@ void BigMuffDrive::prepare (double sampleRate, int samplesPerBlock)
     outLevel.prepare (spec);
     outLevel.setRampDurationSeconds (0.02);
 
-    for (auto& filt : dcBlocker)
-    {
-        filt.calcCoefs (16.0f, fs);
-        filt.reset();
-    }
-
     prevNumStages = (int) *nStagesParam + 1;
-    maxBlockSize = samplesPerBlock;
-    doPrebuffering();
+    stateWarmer.warmUpNow (sampleRate, samplesPerBlock);
 }
 
-void BigMuffDrive::doPrebuffering()
+void BigMuffDrive::warmUpState (DSPState& state, double sampleRate, int samplesPerBlock)
 {
-    AudioBuffer<float> buffer (2, maxBlockSize);
-    for (int i = 0; i < 10000; i += maxBlockSize)
+    state.numStages = (int) *nStagesParam + 1;
+    for (auto& stage : state.stages)
+        stage.prepare (sampleRate);
+
+    for (auto& filt : state.dcBlocker)
+    {
+        filt.calcCoefs (16.0f, (float) sampleRate);
+        filt.reset();
+    }
+
+    // run silence through the clipping stages until the bias points have settled
+    const auto G_C_12 = BigMuffClippingStage::getGC12 ((float) sampleRate, smoothingAmountParam->getCurrentValue());
+    const auto useHighQualityMode = hiQParam->load() == 1.0f;
+    AudioBuffer<float> buffer (2, samplesPerBlock);
+    for (int i = 0; i < 10000; i += samplesPerBlock)
     {
         buffer.clear();
-        processAudio (buffer);
+        for (int stageIdx = 0; stageIdx < state.numStages; ++stageIdx)
+        {
+            if (useHighQualityMode)
+                state.stages[stageIdx].processBlock<true> (buffer, G_C_12);
+            else
+                state.stages[stageIdx].processBlock<false> (buffer, G_C_12);
+        }
+
+        for (int ch = 0; ch < 2; ++ch)
+            state.dcBlocker[ch].processBlock (buffer.getWritePointer (ch), samplesPerBlock);
     }
 }
 
@@ -148,13 +164,17 @@ void BigMuffDrive::processInputStage (AudioBuffer<float>& buffer)
 
 void BigMuffDrive::processAudio (AudioBuffer<float>& buffer)
 {
-    const int numStages = (int) *nStagesParam + 1;
-    if (numStages != prevNumStages)
+    const int requestedNumStages = (int) *nStagesParam + 1;
+    if (requestedNumStages != prevNumStages)
     {
-        prevNumStages = numStages;
-        doPrebuffering();
+        prevNumStages = requestedNumStages;
+        stateWarmer.requestWarmUp();
     }
 
+    // keep using the old number of stages until the new stages have settled
+    auto& state = stateWarmer.getStateForBlock();
+    const int numStages = state.numStages;
+
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
@@ -165,16 +185,16 @@ void BigMuffDrive::processAudio (AudioBuffer<float>& buffer)
     if (useHighQualityMode)
     {
         for (int i = 0; i < numStages; ++i)
-            stages[i].processBlock<true> (buffer, smoothingParam);
+            state.stages[i].processBlock<true> (buffer, smoothingParam);
     }
     else
     {
         for (int i = 0; i < numStages; ++i)
-            stages[i].processBlock<false> (buffer, smoothingParam);
+            state.stages[i].processBlock<false> (buffer, smoothingParam);
     }
 
     for (int ch = 0; ch < numChannels; ++ch)
-        dcBlocker[ch].processBlock (buffer.getWritePointer (ch), numSamples);
+        state.dcBlocker[ch].processBlock (buffer.getWritePointer (ch), numSamples);
 
     auto outGain = Decibels::decibelsToGain (levelRange.convertFrom0to1 (*levelParam), levelRange.start);
     outGain *= Decibels::decibelsToGain (13.0f); // makeup from level lost in clipping stages
@@ -15,12 +15,20 @@ public:
     void processAudio (AudioBuffer<float>& buffer) override;
 
 private:
-    void doPrebuffering();
+    struct DSPState
+    {
+        BigMuffClippingStage stages[4];
+        chowdsp::FirstOrderHPF<float> dcBlocker[2];
+        int numStages = 1;
+    };
+
+    void warmUpState (DSPState& state, double sampleRate, int samplesPerBlock);
     void processInputStage (AudioBuffer<float>& buffer);
 
     chowdsp::FloatParameter* sustainParam = nullptr;
     chowdsp::FloatParameter* harmParam = nullptr;
     chowdsp::FloatParameter* levelParam = nullptr;
+    chowdsp::FloatParameter* smoothingAmountParam = nullptr;
     chowdsp::SmoothedBufferValue<float> smoothingParam;
     std::atomic<float>* nStagesParam = nullptr;
     std::atomic<float>* hiQParam = nullptr;
@@ -29,14 +37,13 @@ private:
     SmoothedValue<float, ValueSmoothingTypes::Multiplicative> cutoffSmooth;
     dsp::Gain<float> sustainGain;
 
-    BigMuffClippingStage stages[4];
+    // the clipping stages are re-settled in the background whenever the number of stages changes
+    ProcessorStateWarmer<DSPState> stateWarmer;
     int prevNumStages = 0;
 
-    chowdsp::FirstOrderHPF<float> dcBlocker[2];
     dsp::Gain<float> outLevel;
 
     float fs = 48000.0f;
-    int maxBlockSize = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BigMuffDrive)
 };
@@ -57,6 +57,12 @@ void Centaur::prepare (double sampleRate, int samplesPerBlock)
     }
 }
 
+size_t Centaur::getMemoryFootprint() const
+{
+    const auto fadeBufferBytes = (size_t) fadeBuffer.getNumChannels() * (size_t) fadeBuffer.getNumSamples() * sizeof (float);
+    return BaseProcessor::getMemoryFootprint() + gainStageML.getMemoryFootprint() + fadeBufferBytes;
+}
+
 void Centaur::processAudio (AudioBuffer<float>& buffer)
 {
     const auto numSamples = buffer.getNumSamples();
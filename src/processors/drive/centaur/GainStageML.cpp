@@ -2,38 +2,34 @@
 
 GainStageML::GainStageML (AudioProcessorValueTreeState& vts)
 {
-    loadModel (gainStageML[0], BinaryData::centaur_0_json, BinaryData::centaur_0_jsonSize);
-    loadModel (gainStageML[1], BinaryData::centaur_25_json, BinaryData::centaur_25_jsonSize);
-    loadModel (gainStageML[2], BinaryData::centaur_50_json, BinaryData::centaur_50_jsonSize);
-    loadModel (gainStageML[3], BinaryData::centaur_75_json, BinaryData::centaur_75_jsonSize);
-    loadModel (gainStageML[4], BinaryData::centaur_100_json, BinaryData::centaur_100_jsonSize);
+    loadModel (gainStageML[0], BinaryData::centaur_0_bnnm, BinaryData::centaur_0_bnnmSize);
+    loadModel (gainStageML[1], BinaryData::centaur_25_bnnm, BinaryData::centaur_25_bnnmSize);
+    loadModel (gainStageML[2], BinaryData::centaur_50_bnnm, BinaryData::centaur_50_bnnmSize);
+    loadModel (gainStageML[3], BinaryData::centaur_75_bnnm, BinaryData::centaur_75_bnnmSize);
+    loadModel (gainStageML[4], BinaryData::centaur_100_bnnm, BinaryData::centaur_100_bnnmSize);
 
     chowdsp::ParamUtils::loadParameterPointer (gainParam, vts, "gain");
 }
 
-void GainStageML::loadModel (ModelPair& model, const char* data, int size)
+void GainStageML::loadModel (RNNModel& model, const char* data, int size)
 {
-    for (auto& channelModel : model)
-        channelModel.initialise (data, size, 44100.0);
+    model.initialise (data, size, 44100.0);
 }
 
 void GainStageML::reset (double sampleRate, int samplesPerBlock)
 {
     fadeBuffer.setSize (2, samplesPerBlock);
 
-    for (int i = 0; i < numModels; ++i)
+    for (auto& model : gainStageML)
     {
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            gainStageML[i][ch].prepare (sampleRate, samplesPerBlock);
+        model.prepare (sampleRate, samplesPerBlock);
 
-            // pre-buffer to avoid "click" on initialisation
-            for (int k = 0; k < int (0.1 * sampleRate); k += samplesPerBlock)
-            {
-                fadeBuffer.clear();
-                auto&& preBufferBlock = dsp::AudioBlock<float> { fadeBuffer }.getSingleChannelBlock (0);
-                gainStageML[i][ch].process (preBufferBlock);
-            }
+        // pre-buffer to avoid "click" on initialisation
+        for (int k = 0; k < int (0.1 * sampleRate); k += samplesPerBlock)
+        {
+            fadeBuffer.clear();
+            auto&& preBufferBlock = dsp::AudioBlock<float> { fadeBuffer };
+            model.process (preBufferBlock);
         }
     }
 
@@ -41,14 +37,19 @@ void GainStageML::reset (double sampleRate, int samplesPerBlock)
     lastModelIdx = getModelIdx();
 }
 
-void GainStageML::processModel (AudioBuffer<float>& buffer, ModelPair& model)
+size_t GainStageML::getMemoryFootprint() const noexcept
+{
+    size_t numBytes = (size_t) fadeBuffer.getNumChannels() * (size_t) fadeBuffer.getNumSamples() * sizeof (float);
+    for (const auto& model : gainStageML)
+        numBytes += model.getMemoryFootprint();
+
+    return numBytes;
+}
+
+void GainStageML::processModel (AudioBuffer<float>& buffer, RNNModel& model)
 {
     auto&& block = dsp::AudioBlock<float> { buffer };
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        auto&& channelBlock = block.getSingleChannelBlock ((size_t) ch);
-        model[ch].process (channelBlock);
-    }
+    model.process (block);
 }
 
 void GainStageML::processBlock (AudioBuffer<float>& buffer)
@@ -10,18 +10,19 @@ public:
     void reset (double sampleRate, int samplesPerBlock);
     void processBlock (AudioBuffer<float>& buffer);
 
+    size_t getMemoryFootprint() const noexcept;
+
 private:
     enum
     {
         numModels = 5,
     };
 
-    using RNNModel = ResampledRNN<8, RTNeural::GRULayerT>;
-    using ModelPair = std::array<RNNModel, 2>;
-    std::array<ModelPair, numModels> gainStageML;
+    using RNNModel = ResampledRNN<8, batched_rnn::GRULayer>; // processes both channels at once
+    std::array<RNNModel, numModels> gainStageML;
 
-    static void loadModel (ModelPair& model, const char* data, int size);
-    static void processModel (AudioBuffer<float>& buffer, ModelPair& model);
+    static void loadModel (RNNModel& model, const char* data, int size);
+    static void processModel (AudioBuffer<float>& buffer, RNNModel& model);
 
     inline int getModelIdx() const noexcept
     {
@@ -22,8 +22,8 @@ private:
     chowdsp::FloatParameter* nDiodesParam = nullptr;
 
     dsp::Gain<float> inGain, outGain;
-    using DiodeClipperDP = DiodeClipperWDF<wdft::DiodePairT>;
-    DiodeClipperDP wdf[2];
+    using DiodeClipperDP = DiodeClipperWDF<ChannelBatch::Vec, wdft::DiodePairT>;
+    DiodeClipperDP wdf; // processes all channels at once
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiodeClipper)
 };
@@ -22,8 +22,8 @@ private:
     chowdsp::FloatParameter* nDiodesParam = nullptr;
 
     dsp::Gain<float> inGain, outGain;
-    using DiodeRectifierWDF = DiodeClipperWDF<wdft::DiodeT>;
-    DiodeRectifierWDF wdf[2];
+    using DiodeRectifierWDF = DiodeClipperWDF<ChannelBatch::Vec, wdft::DiodeT>;
+    DiodeRectifierWDF wdf; // processes all channels at once
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiodeRectifier)
 };
@@ -7,6 +7,9 @@ Hysteresis::Hysteresis (UndoManager* um) : BaseProcessor ("Hysteresis", createPa
     loadParameterPointer (satParam, vts, "sat");
     loadParameterPointer (driveParam, vts, "drive");
     loadParameterPointer (widthParam, vts, "width");
+    loadParameterPointer (lowCPUParam, vts, "low_cpu");
+
+    addPopupMenuParameter ("low_cpu");
 
     uiOptions.backgroundColour = Colour (0xFF8B3232);
     uiOptions.powerColour = Colour (0xFFEAA92C);
@@ -22,29 +25,23 @@ ParamLayout Hysteresis::createParameterLayout()
     createPercentParameter (params, "sat", "Saturation", 0.5f);
     createPercentParameter (params, "drive", "Drive", 0.5f);
     createPercentParameter (params, "width", "Width", 0.5f);
+    emplace_param<chowdsp::BoolParameter> (params, "low_cpu", "Low CPU Mode", false);
 
     return { params.begin(), params.end() };
 }
 
-void Hysteresis::prepare (double sampleRate, int samplesPerBlock)
+void Hysteresis::prepare (double sampleRate, int /*samplesPerBlock*/)
 {
     hysteresisProc.reset();
     hysteresisProc.setSampleRate (sampleRate);
-
-    doubleBuffer.setSize (2, samplesPerBlock);
 }
 
 void Hysteresis::processAudio (AudioBuffer<float>& buffer)
 {
     buffer.applyGain (2.0f);
 
-    doubleBuffer.makeCopyOf (buffer, true);
-
-    auto* leftPtr = doubleBuffer.getWritePointer (0);
-    auto* rightPtr = doubleBuffer.getNumChannels() > 1 ? doubleBuffer.getWritePointer (1) : leftPtr;
-
+    using Solver = decltype (hysteresisProc)::Solver;
+    hysteresisProc.setSolver (lowCPUParam->get() ? Solver::RungeKutta2 : Solver::NewtonRaphson);
     hysteresisProc.setParameters (*driveParam, *widthParam, *satParam);
-    hysteresisProc.processBlock (leftPtr, rightPtr, buffer.getNumSamples());
-
-    buffer.makeCopyOf (doubleBuffer, true);
+    hysteresisProc.processBlock (buffer);
 }
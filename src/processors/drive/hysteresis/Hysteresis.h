@@ -18,9 +18,9 @@ private:
     chowdsp::FloatParameter* satParam = nullptr;
     chowdsp::FloatParameter* driveParam = nullptr;
     chowdsp::FloatParameter* widthParam = nullptr;
+    chowdsp::BoolParameter* lowCPUParam = nullptr;
 
-    HysteresisProcessing hysteresisProc;
-    AudioBuffer<double> doubleBuffer;
+    HysteresisProcessing<xsimd::batch<float>> hysteresisProc; // processes all channels at once
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Hysteresis)
 };
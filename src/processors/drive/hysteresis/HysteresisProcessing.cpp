@@ -1,43 +1,48 @@
 #include "HysteresisProcessing.h"
+#include "../../utility/ChannelBatch.h"
 
-void HysteresisProcessing::reset()
+template <typename Float>
+void HysteresisProcessing<Float>::reset()
 {
     M_n1 = 0.0;
     H_n1 = 0.0;
     H_d_n1 = 0.0;
 
     hpState.coth = 0.0;
-    hpState.nearZero = false;
+    hpState.nearZero = xsimd::batch_bool<NumericType> (false);
 }
 
-void HysteresisProcessing::setSampleRate (double newSR)
+template <typename Float>
+void HysteresisProcessing<Float>::setSampleRate (double newSR)
 {
-    fs = newSR;
-    T = 1.0 / fs;
-    Talpha = T / 1.9;
+    fs = (NumericType) newSR;
+    T = (NumericType) (1.0 / newSR);
+    Talpha = (NumericType) (1.0 / newSR / 1.9);
 
     driveSmooth.reset (newSR, 0.01);
     satSmooth.reset (newSR, 0.01);
     widthSmooth.reset (newSR, 0.01);
 }
 
-void HysteresisProcessing::setParameters (float drive, float width, float sat)
+template <typename Float>
+void HysteresisProcessing<Float>::setParameters (float drive, float width, float sat)
 {
     driveSmooth.setTargetValue (drive);
     satSmooth.setTargetValue (sat);
     widthSmooth.setTargetValue (width);
 }
 
-void HysteresisProcessing::cook (float drive, float width, float sat)
+template <typename Float>
+void HysteresisProcessing<Float>::cook (float drive, float width, float sat)
 {
-    hpState.M_s = 0.5 + 1.5 * (1.0 - (double) sat);
-    hpState.a = hpState.M_s / (0.01 + 6.0 * (double) drive);
-    hpState.c = std::sqrt (1.0f - (double) width) - 0.01;
-    hpState.k = 0.47875;
+    hpState.M_s = (NumericType) (0.5 + 1.5 * (1.0 - (double) sat));
+    hpState.a = (NumericType) ((double) hpState.M_s / (0.01 + 6.0 * (double) drive));
+    hpState.c = (NumericType) (std::sqrt (1.0f - (double) width) - 0.01);
+    hpState.k = (NumericType) 0.47875;
     upperLim = 20.0;
 
-    constexpr auto alpha = HysteresisOps::HysteresisState::alpha;
-    hpState.nc = 1.0 - hpState.c;
+    constexpr auto alpha = HysteresisOps::HysteresisState<Float>::alpha;
+    hpState.nc = (NumericType) 1 - hpState.c;
     hpState.M_s_oa = hpState.M_s / hpState.a;
     hpState.M_s_oa_talpha = alpha * hpState.M_s_oa;
     hpState.M_s_oa_tc = hpState.c * hpState.M_s_oa;
@@ -46,75 +51,58 @@ void HysteresisProcessing::cook (float drive, float width, float sat)
     hpState.M_s_oaSq_tc_talphaSq = alpha * hpState.M_s_oaSq_tc_talpha;
 }
 
-void HysteresisProcessing::processBlock (double* bufferLeft, double* bufferRight, const int numSamples)
+template <typename Float>
+template <typename HysteresisProcessing<Float>::Solver solverType>
+Float HysteresisProcessing<Float>::processSample (Float H) noexcept
 {
-    using Float = xsimd::batch<double>;
+    auto H_d = HysteresisOps::deriv (H, H_n1, H_d_n1, (Float) T);
 
-    bool needsSmoothing = driveSmooth.isSmoothing() || widthSmooth.isSmoothing() || satSmooth.isSmoothing();
+    Float M;
+    if constexpr (solverType == Solver::RungeKutta2)
+        M = RK2Solver (H, H_d);
+    else
+        M = NRSolver (H, H_d);
+
+    // check for instability
+    auto notIllCondition = ! (xsimd::isnan (M) || (xsimd::abs (M) > (Float) upperLim));
+    M = xsimd::select (notIllCondition, M, (Float) 0.0);
+    H_d = xsimd::select (notIllCondition, H_d, (Float) 0.0);
+
+    M_n1 = M;
+    H_n1 = H;
+    H_d_n1 = H_d;
 
-    double stereoVec alignas (16)[2];
+    return M;
+}
+
+template <typename Float>
+template <typename HysteresisProcessing<Float>::Solver solverType>
+void HysteresisProcessing<Float>::processBlockWithSolver (AudioBuffer<NumericType>& buffer) noexcept
+{
+    bool needsSmoothing = driveSmooth.isSmoothing() || widthSmooth.isSmoothing() || satSmooth.isSmoothing();
 
     if (needsSmoothing)
     {
-        for (int n = 0; n < numSamples; ++n)
-        {
-            cook (driveSmooth.getNextValue(), widthSmooth.getNextValue(), satSmooth.getNextValue());
-
-            stereoVec[0] = bufferLeft[n];
-            stereoVec[1] = bufferRight[n];
-            auto H = xsimd::load_aligned (stereoVec);
-            auto H_d = HysteresisOps::deriv (H, H_n1, H_d_n1, (Float) T);
-            auto M = NRSolver<4> (H, H_d);
-
-            // check for instability
-#if HYSTERESIS_USE_SIMD
-            auto notIllCondition = ! (xsimd::isnan (M) || (M > upperLim));
-            M = xsimd::select (notIllCondition, M, (Float) 0.0);
-            H_d = xsimd::select (notIllCondition, H_d, (Float) 0.0);
-#else
-            bool illCondition = std::isnan (M) || M > upperLim;
-            M = illCondition ? 0.0 : M;
-            H_d = illCondition ? 0.0 : H_d;
-#endif
-
-            M_n1 = M;
-            H_n1 = H;
-            H_d_n1 = H_d;
-
-            M.store_aligned (stereoVec);
-            bufferLeft[n] = stereoVec[0];
-            bufferRight[n] = stereoVec[1];
-        }
+        ChannelBatch::process<Float> (buffer,
+                                      [this] (Float H)
+                                      {
+                                          cook (driveSmooth.getNextValue(), widthSmooth.getNextValue(), satSmooth.getNextValue());
+                                          return processSample<solverType> (H);
+                                      });
+        return;
     }
+
+    cook (driveSmooth.getNextValue(), widthSmooth.getNextValue(), satSmooth.getNextValue());
+    ChannelBatch::process<Float> (buffer, [this] (Float H) { return processSample<solverType> (H); });
+}
+
+template <typename Float>
+void HysteresisProcessing<Float>::processBlock (AudioBuffer<NumericType>& buffer) noexcept
+{
+    if (solver == Solver::RungeKutta2)
+        processBlockWithSolver<Solver::RungeKutta2> (buffer);
     else
-    {
-        cook (driveSmooth.getNextValue(), widthSmooth.getNextValue(), satSmooth.getNextValue());
-        for (int n = 0; n < numSamples; ++n)
-        {
-            stereoVec[0] = bufferLeft[n];
-            stereoVec[1] = bufferRight[n];
-            auto H = xsimd::load_aligned (stereoVec);
-            auto H_d = HysteresisOps::deriv (H, H_n1, H_d_n1, (Float) T);
-            auto M = NRSolver<4> (H, H_d);
-
-            // check for instability
-#if HYSTERESIS_USE_SIMD
-            auto notIllCondition = ! (xsimd::isnan (M) || (M > upperLim));
-            M = xsimd::select (notIllCondition, M, (Float) 0.0);
-            H_d = xsimd::select (notIllCondition, H_d, (Float) 0.0);
-#else
-            bool illCondition = std::isnan (M) || M > upperLim;
-            M = illCondition ? 0.0 : M;
-            H_d = illCondition ? 0.0 : H_d;
-#endif
-
-            M_n1 = M;
-            H_n1 = H;
-            H_d_n1 = H_d;
-
-            M.store_aligned (stereoVec);
-            bufferLeft[n] = stereoVec[0];
-            bufferRight[n] = stereoVec[1];
-        }
-    }
+        processBlockWithSolver<Solver::NewtonRaphson> (buffer);
 }
+
+template class HysteresisProcessing<xsimd::batch<float>>;
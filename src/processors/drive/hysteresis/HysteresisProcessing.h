@@ -6,65 +6,95 @@
     Hysteresis processing for a model of an analog tape machine.
     For more information on the DSP happening here, see:
     https://ccrma.stanford.edu/~jatin/420/tape/TapeModel_DAFx.pdf
+
+    All the channels are processed together, with one channel in each lane
+    of the SIMD type. The Newton-Raphson solver stops iterating once every
+    channel has converged. HysteresisTest checks both solvers against the
+    original double-precision model.
 */
+template <typename Float>
 class HysteresisProcessing
 {
 public:
+    using NumericType = typename Float::value_type;
+
+    enum class Solver
+    {
+        NewtonRaphson, // implicit trapezoidal rule
+        RungeKutta2, // explicit midpoint rule, which is much cheaper, but a little less accurate
+    };
+
     HysteresisProcessing() = default;
 
     void reset();
     void setSampleRate (double newSR);
 
     void setParameters (float drive, float width, float sat);
+    void setSolver (Solver newSolver) noexcept { solver = newSolver; }
 
-    void processBlock (double* bufferL, double* bufferR, const int numSamples);
+    void processBlock (AudioBuffer<NumericType>& buffer) noexcept;
 
 private:
-    // newton-raphson solvers
-    template <int nIterations, typename Float>
+    static constexpr int maxNRIterations = 8;
+    static constexpr auto nrTolerance = (NumericType) 1.0e-5;
+
+    // newton-raphson solver
     inline Float NRSolver (Float H, Float H_d) noexcept
     {
-        using namespace chowdsp::SIMDUtils;
-
         Float M = M_n1;
         const Float last_dMdt = HysteresisOps::hysteresisFunc (M_n1, H_n1, H_d_n1, hpState);
 
         Float dMdt;
         Float dMdtPrime;
         Float deltaNR;
-        for (int n = 0; n < nIterations; ++n)
+        for (int n = 0; n < maxNRIterations; ++n)
         {
             dMdt = HysteresisOps::hysteresisFunc (M, H, H_d, hpState);
             dMdtPrime = HysteresisOps::hysteresisFuncPrime (H_d, dMdt, hpState);
             deltaNR = (M - M_n1 - (Float) Talpha * (dMdt + last_dMdt)) / (Float (1.0) - (Float) Talpha * dMdtPrime);
             M -= deltaNR;
+
+            if (xsimd::all (xsimd::abs (deltaNR) < (Float) nrTolerance))
+                break;
         }
 
         return M;
     }
 
+    // runge-kutta solver
+    inline Float RK2Solver (Float H, Float H_d) noexcept
+    {
+        // the trapezoidal rule above integrates over 2 * Talpha (rather than T), so take the same step size here
+        const auto stepSize = (Float) (2 * Talpha);
+        const Float k1 = stepSize * HysteresisOps::hysteresisFunc (M_n1, H_n1, H_d_n1, hpState);
+        const Float k2 = stepSize * HysteresisOps::hysteresisFunc (M_n1 + k1 * (Float) 0.5, (H + H_n1) * (Float) 0.5, (H_d + H_d_n1) * (Float) 0.5, hpState);
+
+        return M_n1 + k2;
+    }
+
+    template <Solver solverType>
+    inline Float processSample (Float H) noexcept;
+
+    template <Solver solverType>
+    void processBlockWithSolver (AudioBuffer<NumericType>& buffer) noexcept;
+
     void cook (float drive, float width, float sat);
 
     SmoothedValue<float, ValueSmoothingTypes::Linear> driveSmooth, satSmooth, widthSmooth;
+    Solver solver = Solver::NewtonRaphson;
 
     // parameter values
-    double fs = 48000.0;
-    double T = 1.0 / fs;
-    double Talpha = T / 1.9;
-    double upperLim = 20.0;
+    NumericType fs = 48000.0;
+    NumericType T = 1.0 / fs;
+    NumericType Talpha = T / 1.9;
+    NumericType upperLim = 20.0;
 
     // state variables
-#if HYSTERESIS_USE_SIMD
-    xsimd::batch<double> M_n1 = 0.0;
-    xsimd::batch<double> H_n1 = 0.0;
-    xsimd::batch<double> H_d_n1 = 0.0;
-#else
-    double M_n1 = 0.0;
-    double H_n1 = 0.0;
-    double H_d_n1 = 0.0;
-#endif
-
-    HysteresisOps::HysteresisState hpState;
+    Float M_n1 = 0.0;
+    Float H_n1 = 0.0;
+    Float H_d_n1 = 0.0;
+
+    HysteresisOps::HysteresisState<Float> hpState;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HysteresisProcessing)
 };
@@ -22,7 +22,7 @@ private:
     chowdsp::ChoiceParameter* stagesParam = nullptr;
 
     using TriodeModel = NeuralTriodeModel<float, TriodeModelELuApprox<float, 4, 8>>;
-    TriodeModel triode_model_4_8_elu { BinaryData::junior_1_stage_json, BinaryData::junior_1_stage_jsonSize };
+    TriodeModel triode_model_4_8_elu { BinaryData::junior_1_stage_bnnm, BinaryData::junior_1_stage_bnnmSize };
 
     struct SingleStageModel
     {
@@ -3,6 +3,11 @@
 #include "EluApprox.h"
 #include <pch.h>
 
+#if JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_IOS
+#include "../neural_utils/BinaryModelData.h"
+#include "processors/SharedAssetCache.h"
+#endif
+
 constexpr int triodeModelNumInputs = 2;
 constexpr int triodeModelNumOutputs = 2;
 
@@ -104,10 +109,21 @@ public:
         constexpr bool debug = false;
 #endif
 
-        juce::MemoryInputStream modelInputStream { modelData, (size_t) modelDataSize, false };
-        auto jsonInput = nlohmann::json::parse (modelInputStream.readEntireStreamAsString().toStdString());
-        removeUnknownLayerFromJson (jsonInput);
-        model.parseJson (jsonInput, debug);
+        const auto loadModelJson = [modelData, modelDataSize]
+        {
+            // RTNeural can only load models from JSON, so we rebuild the JSON from the binary model
+            const auto binaryModel = BinaryModelData::fromMemory (modelData, (size_t) modelDataSize);
+            jassert (binaryModel != nullptr); // invalid model data!
+
+            auto jsonInput = std::make_unique<nlohmann::json> (binaryModel->toJSON());
+            removeUnknownLayerFromJson (*jsonInput);
+            return jsonInput;
+        };
+
+        // the cleaned-up JSON is shared between all the triode models that use the same data
+        const auto modelID = "neural_triode_" + juce::String::toHexString ((juce::pointer_sized_int) modelData);
+        modelJson = juce::SharedResourcePointer<SharedAssetCache>()->getOrCreate<nlohmann::json> (modelID, loadModelJson);
+        model.parseJson (*modelJson, debug);
     }
 #endif
 
@@ -141,4 +157,8 @@ private:
     }
 
     typename ModelType::ModelType model;
+
+#if JUCE_MAC || JUCE_WINDOWS || JUCE_LINUX || JUCE_IOS
+    std::shared_ptr<const nlohmann::json> modelJson;
+#endif
 };
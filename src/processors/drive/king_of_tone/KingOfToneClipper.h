@@ -1,29 +1,31 @@
 #pragma once
 
-#include <pch.h>
+#include "processors/utility/ChannelBatch.h"
 
+template <typename T>
 class KingOfToneClipper
 {
 public:
     KingOfToneClipper() = default;
 
-    void processBlock (float* x, int numSamples) noexcept
+    void process (AudioBuffer<float>& buffer) noexcept
     {
-        for (int n = 0; n < numSamples; ++n)
-        {
-            R12_Vs.setVoltage (x[n]);
+        ChannelBatch::process<T> (buffer,
+                                  [this] (T x)
+                                  {
+                                      R12_Vs.setVoltage (x);
 
-            dp.incident (S1.reflected());
-            S1.incident (dp.reflected());
+                                      dp.incident (S1.reflected());
+                                      S1.incident (dp.reflected());
 
-            x[n] = wdft::voltage<float> (dp);
-        }
+                                      return wdft::voltage<T> (dp);
+                                  });
     }
 
 private:
-    wdft::ResistiveVoltageSourceT<float> R12_Vs { 1.0e3f };
-    wdft::PolarityInverterT<float, decltype (R12_Vs)> S1 { R12_Vs };
-    wdft::DiodePairT<float, decltype (S1)> dp { S1, 2.52e-9f, 25.85e-3f, 1.752f };
+    wdft::ResistiveVoltageSourceT<T> R12_Vs { 1.0e3f };
+    wdft::PolarityInverterT<T, decltype (R12_Vs)> S1 { R12_Vs };
+    wdft::DiodePairT<T, decltype (S1)> dp { S1, 2.52e-9f, 25.85e-3f, 1.752f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KingOfToneClipper)
 };
@@ -70,7 +70,10 @@ void calcDriveaStageBypassedCoefs (FilterType& filter, float fs)
 }
 } // namespace
 
-KingOfToneDrive::KingOfToneDrive (UndoManager* um) : BaseProcessor ("Tone King", createParameterLayout(), um)
+KingOfToneDrive::KingOfToneDrive (UndoManager* um) : BaseProcessor ("Tone King", createParameterLayout(), um),
+                                                     stateWarmer (getSharedWarmUpThread(),
+                                                                  [this] (DSPState& state, double sampleRate, int samplesPerBlock)
+                                                                  { warmUpState (state, sampleRate, samplesPerBlock); })
 {
     chowdsp::ParamUtils::loadParameterPointer (driveParam, vts, "drive");
     modeParam = vts.getRawParameterValue ("mode");
@@ -96,51 +99,59 @@ void KingOfToneDrive::prepare (double sampleRate, int samplesPerBlock)
 {
     fs = (float) sampleRate;
 
-    const auto inputFilterFreq = 1.0f / (MathConstants<float>::twoPi * Components::C3 * Components::R4);
-    for (auto& filt : inputFilter)
+    for (auto& driveParamSm : driveParamSmooth)
     {
-        filt.reset();
-        filt.calcCoefs (inputFilterFreq, fs);
+        driveParamSm.reset (sampleRate, 0.025);
+        driveParamSm.setCurrentAndTargetValue (*driveParam);
     }
 
-    for (auto& filt : driveAmp)
+    prevMode = (int) *modeParam;
+    prevNumChannels = 2;
+
+    stateWarmer.warmUpNow (sampleRate, samplesPerBlock);
+}
+
+void KingOfToneDrive::warmUpState (DSPState& state, double sampleRate, int samplesPerBlock)
+{
+    const auto stateFs = (float) sampleRate;
+    state.mode = (int) *modeParam;
+
+    const auto inputFilterFreq = 1.0f / (MathConstants<float>::twoPi * Components::C3 * Components::R4);
+    for (auto& filt : state.inputFilter)
     {
         filt.reset();
-        calcDriveAmpCoefs (filt, *driveParam, fs);
+        filt.calcCoefs (inputFilterFreq, stateFs);
     }
 
-    for (auto& driveParamSm : driveParamSmooth)
+    for (auto& filt : state.driveAmp)
     {
-        driveParamSm.reset (sampleRate, 0.025);
-        driveParamSm.setCurrentAndTargetValue (*driveParam);
+        filt.reset();
+        calcDriveAmpCoefs (filt, *driveParam, stateFs);
     }
 
-    for (auto& od : overdrive)
-        od.prepare (fs);
+    state.overdrive.prepare (stateFs);
 
-    for (auto& filt : overdriveStageBypass)
+    for (auto& filt : state.overdriveStageBypass)
     {
         filt.reset();
-        calcDriveaStageBypassedCoefs (filt, fs);
+        calcDriveaStageBypassedCoefs (filt, stateFs);
     }
 
-    dcBlocker.prepare (sampleRate, samplesPerBlock);
-
-    prevMode = (int) *modeParam;
-    prevNumChannels = 2;
-
-    preBuffer.setSize (2, samplesPerBlock);
-    doPreBuffering();
-}
+    state.dcBlocker.prepare ({ sampleRate, (uint32) samplesPerBlock, 2 });
+    state.dcBlocker.setCutoffFrequency (30.0f); // same as the default for the DC Blocker module
 
-void KingOfToneDrive::doPreBuffering()
-{
-    preBuffer.setSize (prevNumChannels, preBuffer.getNumSamples(), false, false, true);
-    const auto numSamples = preBuffer.getNumSamples();
-    for (int i = 0; i < (int) fs; i += numSamples)
+    // run silence through the circuit until it has settled around its bias point
+    AudioBuffer<float> buffer (2, samplesPerBlock);
+    for (int i = 0; i < (int) sampleRate; i += samplesPerBlock)
     {
-        preBuffer.clear();
-        processAudio (preBuffer);
+        buffer.clear();
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            state.inputFilter[ch].processBlock (buffer.getWritePointer (ch), samplesPerBlock);
+            state.driveAmp[ch].processBlock (buffer.getWritePointer (ch), samplesPerBlock);
+        }
+
+        processDriveStages (state, buffer);
     }
 }
 
@@ -154,9 +165,12 @@ void KingOfToneDrive::processAudio (AudioBuffer<float>& buffer)
     {
         prevMode = currentMode;
         prevNumChannels = numChannels;
-        doPreBuffering();
+        stateWarmer.requestWarmUp();
     }
 
+    // keep using the old mode until the circuit has settled in the new mode
+    auto& state = stateWarmer.getStateForBlock();
+
     buffer.applyGain (0.2f); // voltage scaling
 
     for (int ch = 0; ch < numChannels; ++ch)
@@ -164,46 +178,63 @@ void KingOfToneDrive::processAudio (AudioBuffer<float>& buffer)
         auto* x = buffer.getWritePointer (ch);
 
         // process input filter
-        inputFilter[ch].processBlock (x, numSamples);
+        state.inputFilter[ch].processBlock (x, numSamples);
 
         // process drive amp
         driveParamSmooth[ch].setTargetValue (*driveParam);
         if (! driveParamSmooth[ch].isSmoothing())
         {
-            calcDriveAmpCoefs (driveAmp[ch], driveParamSmooth[ch].getNextValue(), fs);
-            driveAmp[ch].processBlock (x, numSamples);
+            calcDriveAmpCoefs (state.driveAmp[ch], driveParamSmooth[ch].getNextValue(), fs);
+            state.driveAmp[ch].processBlock (x, numSamples);
         }
         else
         {
             for (int n = 0; n < numSamples; ++n)
             {
-                calcDriveAmpCoefs (driveAmp[ch], driveParamSmooth[ch].getNextValue(), fs);
-                x[n] = driveAmp[ch].processSample (x[n]);
+                calcDriveAmpCoefs (state.driveAmp[ch], driveParamSmooth[ch].getNextValue(), fs);
+                x[n] = state.driveAmp[ch].processSample (x[n]);
             }
         }
+    }
+
+    processDriveStages (state, buffer);
+}
 
-        if (currentMode == 1 || currentMode == 2) // process drive stage
-            overdrive[ch].processBlock (x, numSamples);
-        else // process drive stage bypassed
+void KingOfToneDrive::processDriveStages (DSPState& state, AudioBuffer<float>& buffer)
+{
+    const auto numSamples = (int) buffer.getNumSamples();
+    const auto numChannels = (int) buffer.getNumChannels();
+
+    if (state.mode == 1 || state.mode == 2) // process drive stage
+    {
+        state.overdrive.process (buffer);
+    }
+    else // process drive stage bypassed
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            overdriveStageBypass[ch].processBlock (x, numSamples);
+            auto* x = buffer.getWritePointer (ch);
+            state.overdriveStageBypass[ch].processBlock (x, numSamples);
             FloatVectorOperations::multiply (x, Decibels::decibelsToGain (-30.0f), numSamples);
             FloatVectorOperations::add (x, 4.5f, numSamples);
         }
+    }
 
-        if (currentMode == 0 || currentMode == 2) // process clipper stage
-        {
-            FloatVectorOperations::clip (x, x, 3.0f, 6.0f, numSamples); // clip the signal here so we don't blow out the diode models
-            clipper[ch].processBlock (x, numSamples);
+    if (state.mode == 0 || state.mode == 2) // process clipper stage
+    {
+        // clip the signal here so we don't blow out the diode models
+        for (int ch = 0; ch < numChannels; ++ch)
+            FloatVectorOperations::clip (buffer.getWritePointer (ch), buffer.getReadPointer (ch), 3.0f, 6.0f, numSamples);
 
-            const auto makeupGainDB = currentMode == 0 ? 45.0f : 27.0f;
-            FloatVectorOperations::multiply (x, Decibels::decibelsToGain (makeupGainDB), numSamples);
-        }
-        else
-        {
-            FloatVectorOperations::multiply (x, Decibels::decibelsToGain (-12.0f), numSamples);
-        }
+        state.clipper.process (buffer);
+
+        const auto makeupGainDB = state.mode == 0 ? 45.0f : 27.0f;
+        buffer.applyGain (Decibels::decibelsToGain (makeupGainDB));
+    }
+    else
+    {
+        buffer.applyGain (Decibels::decibelsToGain (-12.0f));
     }
 
-    dcBlocker.processAudio (buffer);
+    state.dcBlocker.processBlock (buffer);
 }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "../../BaseProcessor.h"
-#include "../../utility/DCBlocker.h"
 #include "KingOfToneClipper.h"
 #include "KingOfToneOverdrive.h"
 
@@ -17,7 +16,19 @@ public:
     void processAudio (AudioBuffer<float>& buffer) override;
 
 private:
-    void doPreBuffering();
+    struct DSPState
+    {
+        chowdsp::FirstOrderHPF<float> inputFilter[2];
+        chowdsp::IIRFilter<3, float> driveAmp[2];
+        chowdsp::IIRFilter<1, float> overdriveStageBypass[2];
+        KingOfToneOverdrive<ChannelBatch::Vec> overdrive; // processes all channels at once
+        KingOfToneClipper<ChannelBatch::Vec> clipper; // processes all channels at once
+        chowdsp::SVFHighpass<float> dcBlocker;
+        int mode = 0;
+    };
+
+    void warmUpState (DSPState& state, double sampleRate, int samplesPerBlock);
+    void processDriveStages (DSPState& state, AudioBuffer<float>& buffer);
 
     chowdsp::FloatParameter* driveParam = nullptr;
     std::atomic<float>* modeParam = nullptr;
@@ -27,14 +38,9 @@ private:
     int prevNumChannels = 0;
 
     float fs = 48000.0f;
-    chowdsp::FirstOrderHPF<float> inputFilter[2];
-    chowdsp::IIRFilter<3, float> driveAmp[2];
-    chowdsp::IIRFilter<1, float> overdriveStageBypass[2];
-    KingOfToneOverdrive overdrive[2];
-    KingOfToneClipper clipper[2];
-
-    AudioBuffer<float> preBuffer;
-    DCBlocker dcBlocker;
+
+    // the circuit is re-settled in the background whenever the mode changes
+    ProcessorStateWarmer<DSPState> stateWarmer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KingOfToneDrive)
 };
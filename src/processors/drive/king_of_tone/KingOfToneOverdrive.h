@@ -1,7 +1,8 @@
 #pragma once
 
-#include <pch.h>
+#include "processors/utility/ChannelBatch.h"
 
+template <typename T>
 class KingOfToneOverdrive
 {
 public:
@@ -13,36 +14,37 @@ public:
         Vbias.setVoltage (4.5f);
     }
 
-    void processBlock (float* x, int numSamples) noexcept
+    void process (AudioBuffer<float>& buffer) noexcept
     {
-        for (int n = 0; n < numSamples; ++n)
-        {
-            R9_Vin.setVoltage (x[n]);
+        ChannelBatch::process<T> (buffer,
+                                  [this] (T x)
+                                  {
+                                      R9_Vin.setVoltage (x);
 
-            dp.incident (S2.reflected());
-            S2.incident (dp.reflected());
+                                      dp.incident (S2.reflected());
+                                      S2.incident (dp.reflected());
 
-            x[n] = wdft::voltage<float> (RL);
-        }
+                                      return wdft::voltage<T> (RL);
+                                  });
     }
 
 private:
     // Port A:
-    wdft::ResistiveVoltageSourceT<float> R9_Vin { 10.0e3f };
-    wdft::CapacitorT<float> C7 { 0.1e-6f };
-    wdft::WDFSeriesT<float, decltype (R9_Vin), decltype (C7)> S1 { R9_Vin, C7 };
+    wdft::ResistiveVoltageSourceT<T> R9_Vin { 10.0e3f };
+    wdft::CapacitorT<T> C7 { 0.1e-6f };
+    wdft::WDFSeriesT<T, decltype (R9_Vin), decltype (C7)> S1 { R9_Vin, C7 };
 
     // Port B:
-    wdft::ResistiveVoltageSourceT<float> Vbias { 1.0e6f };
+    wdft::ResistiveVoltageSourceT<T> Vbias { 1.0e6f };
 
     // Port C:
-    wdft::ResistorT<float> RL { 1.0e9f };
+    wdft::ResistorT<T> RL { 1.0e9f };
 
     // R-type
     struct ImpedanceCalc
     {
         template <typename RType>
-        static float calcImpedance (RType& R)
+        static T calcImpedance (RType& R)
         {
             constexpr float Ag = 100.0f; // op-amp gain
             constexpr float Ri = 1.0e6f; // op-amp input impedance
@@ -62,15 +64,15 @@ private:
         }
     };
 
-    using RType = wdft::RtypeAdaptor<float, 3, ImpedanceCalc, decltype (S1), decltype (Vbias), decltype (RL)>;
+    using RType = wdft::RtypeAdaptor<T, 3, ImpedanceCalc, decltype (S1), decltype (Vbias), decltype (RL)>;
     RType R { S1, Vbias, RL };
 
     // Port D:
-    wdft::ResistorT<float> R10 { 220.0e3f };
-    wdft::WDFParallelT<float, decltype (R), decltype (R10)> P1 { R, R10 };
-    wdft::ResistorT<float> R11 { 6.8e3f };
-    wdft::WDFSeriesT<float, decltype (R11), decltype (P1)> S2 { R11, P1 };
-    wdft::DiodePairT<float, decltype (S2)> dp { S2, 2.9849127806230505e-10f, 25.85e-3f, 3.187726462543485f };
+    wdft::ResistorT<T> R10 { 220.0e3f };
+    wdft::WDFParallelT<T, decltype (R), decltype (R10)> P1 { R, R10 };
+    wdft::ResistorT<T> R11 { 6.8e3f };
+    wdft::WDFSeriesT<T, decltype (R11), decltype (P1)> S2 { R11, P1 };
+    wdft::DiodePairT<T, decltype (S2)> dp { S2, 2.9849127806230505e-10f, 25.85e-3f, 3.187726462543485f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KingOfToneOverdrive)
 };
@@ -1,10 +1,11 @@
 #pragma once
 
-#include <pch.h>
+#include "processors/utility/ChannelBatch.h"
 
 // This circuit model was originally implemented as part of Sam Schachter's
 // Master's Thesis (https://github.com/schachtersam32/WaveDigitalFilters_Sharc/blob/master/MXR_DistPlus.h).
 // Since then, we've re-derived the R-adaptor to adapt to the port facing the diode pair.
+template <typename T>
 class MXRDistWDF
 {
 public:
@@ -26,44 +27,49 @@ public:
         ResDist_R3.setResistanceValue (distParam * rDistVal + R3Val);
     }
 
-    inline float processSample (float x)
+    inline T processSample (T x) noexcept
     {
         Vin.setVoltage (x);
 
         DP.incident (P3.reflected());
         P3.incident (DP.reflected());
 
-        return wdft::voltage<float> (Rout);
+        return wdft::voltage<T> (Rout);
+    }
+
+    void process (AudioBuffer<float>& buffer) noexcept
+    {
+        ChannelBatch::process<T> (buffer, [this] (T x) { return processSample (x); });
     }
 
 private:
     // Port A
-    wdft::ResistorT<float> R4 { 1.0e6f };
+    wdft::ResistorT<T> R4 { 1.0e6f };
 
     // Port B
-    wdft::ResistiveVoltageSourceT<float> Vin;
-    wdft::CapacitorT<float> C1 { 1.0e-9f };
-    wdft::WDFParallelT<float, decltype (Vin), decltype (C1)> P1 { Vin, C1 };
+    wdft::ResistiveVoltageSourceT<T> Vin;
+    wdft::CapacitorT<T> C1 { 1.0e-9f };
+    wdft::WDFParallelT<T, decltype (Vin), decltype (C1)> P1 { Vin, C1 };
 
-    wdft::ResistorT<float> R1 { 10.0e3f };
-    wdft::CapacitorT<float> C2 { 10.0e-9f };
-    wdft::WDFSeriesT<float, decltype (R1), decltype (C2)> S1 { R1, C2 };
+    wdft::ResistorT<T> R1 { 10.0e3f };
+    wdft::CapacitorT<T> C2 { 10.0e-9f };
+    wdft::WDFSeriesT<T, decltype (R1), decltype (C2)> S1 { R1, C2 };
 
-    wdft::WDFSeriesT<float, decltype (S1), decltype (P1)> S2 { S1, P1 };
-    wdft::ResistiveVoltageSourceT<float> Vb { 1.0e6f }; // encompasses R2
-    wdft::WDFParallelT<float, decltype (Vb), decltype (S2)> P2 { Vb, S2 };
+    wdft::WDFSeriesT<T, decltype (S1), decltype (P1)> S2 { S1, P1 };
+    wdft::ResistiveVoltageSourceT<T> Vb { 1.0e6f }; // encompasses R2
+    wdft::WDFParallelT<T, decltype (Vb), decltype (S2)> P2 { Vb, S2 };
 
     // Port C
     static constexpr float R3Val = 4.7e3f;
     static constexpr float rDistVal = 1.0e6f;
-    wdft::ResistorT<float> ResDist_R3 { rDistVal + R3Val }; //distortion potentiometer
-    wdft::CapacitorT<float> C3 { 47.0e-9f };
-    wdft::WDFSeriesT<float, decltype (ResDist_R3), decltype (C3)> S4 { ResDist_R3, C3 };
+    wdft::ResistorT<T> ResDist_R3 { rDistVal + R3Val }; //distortion potentiometer
+    wdft::CapacitorT<T> C3 { 47.0e-9f };
+    wdft::WDFSeriesT<T, decltype (ResDist_R3), decltype (C3)> S4 { ResDist_R3, C3 };
 
     struct ImpedanceCalc
     {
         template <typename RType>
-        static float calcImpedance (RType& R)
+        static T calcImpedance (RType& R)
         {
             constexpr float A = 100.0f; // op-amp gain
             constexpr float Ri = 1.0e9f; // op-amp input impedance
@@ -83,20 +89,20 @@ private:
         }
     };
 
-    wdft::RtypeAdaptor<float, 3, ImpedanceCalc, decltype (R4), decltype (P2), decltype (S4)> R { R4, P2, S4 };
+    wdft::RtypeAdaptor<T, 3, ImpedanceCalc, decltype (R4), decltype (P2), decltype (S4)> R { R4, P2, S4 };
 
     // Port D
-    wdft::ResistorT<float> R5 { 10.0e3f };
-    wdft::CapacitorT<float> C4 { 1.0e-6f };
-    wdft::WDFSeriesT<float, decltype (R5), decltype (C4)> S6 { R5, C4 };
-    wdft::WDFSeriesT<float, decltype (S6), decltype (R)> S7 { S6, R };
+    wdft::ResistorT<T> R5 { 10.0e3f };
+    wdft::CapacitorT<T> C4 { 1.0e-6f };
+    wdft::WDFSeriesT<T, decltype (R5), decltype (C4)> S6 { R5, C4 };
+    wdft::WDFSeriesT<T, decltype (S6), decltype (R)> S7 { S6, R };
 
-    wdft::ResistorT<float> Rout { 10.0e3f };
-    wdft::WDFParallelT<float, decltype (Rout), decltype (S7)> P4 { Rout, S7 };
-    wdft::CapacitorT<float> C5 { 1.0e-9f };
-    wdft::WDFParallelT<float, decltype (C5), decltype (P4)> P3 { C5, P4 };
+    wdft::ResistorT<T> Rout { 10.0e3f };
+    wdft::WDFParallelT<T, decltype (Rout), decltype (S7)> P4 { Rout, S7 };
+    wdft::CapacitorT<T> C5 { 1.0e-9f };
+    wdft::WDFParallelT<T, decltype (C5), decltype (P4)> P3 { C5, P4 };
 
-    wdft::DiodePairT<float, decltype (P3), wdft::DiodeQuality::Best> DP { P3, 2.52e-9f, 25.85e-3f * 1.75f };
+    wdft::DiodePairT<T, decltype (P3), wdft::DiodeQuality::Best> DP { P3, 2.52e-9f, 25.85e-3f * 1.75f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MXRDistWDF)
 };
@@ -33,11 +33,8 @@ ParamLayout MXRDistortion::createParameterLayout()
 
 void MXRDistortion::prepare (double sampleRate, int samplesPerBlock)
 {
-    for (auto& wdfProc : wdf)
-    {
-        wdfProc.prepare (sampleRate);
-        wdfProc.setParams (paramSkew (*distParam));
-    }
+    wdf.prepare (sampleRate);
+    wdf.setParams (paramSkew (*distParam));
 
     dcBlocker.prepare (sampleRate, samplesPerBlock);
 
@@ -59,14 +56,8 @@ void MXRDistortion::processAudio (AudioBuffer<float>& buffer)
     dsp::AudioBlock<float> block (buffer);
     dsp::ProcessContextReplacing<float> context (block);
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        wdf[ch].setParams (paramSkew (*distParam));
-
-        auto* x = buffer.getWritePointer (ch);
-        for (int n = 0; n < buffer.getNumSamples(); ++n)
-            x[n] = wdf[ch].processSample (x[n]);
-    }
+    wdf.setParams (paramSkew (*distParam));
+    wdf.process (buffer);
 
     dcBlocker.processAudio (buffer);
 
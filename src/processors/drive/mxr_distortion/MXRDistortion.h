@@ -18,7 +18,7 @@ private:
     chowdsp::FloatParameter* distParam = nullptr;
     chowdsp::FloatParameter* levelParam = nullptr;
 
-    MXRDistWDF wdf[2];
+    MXRDistWDF<ChannelBatch::Vec> wdf; // processes all channels at once
 
     dsp::Gain<float> gain;
     DCBlocker dcBlocker;
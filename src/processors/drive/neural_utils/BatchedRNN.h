@@ -0,0 +1,332 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Recurrent neural network models that run both channels of a stereo
+ * signal through the same set of weights at once.
+ *
+ * The state for each channel is stored as one column of a matrix, so
+ * the matrix-vector products that would be done for each channel become
+ * a single (small) matrix-matrix product. The layers are loaded with
+ * weights in the same layout as the corresponding RTNeural layers, and
+ * handle sample rate correction in the same way.
+ *
+ * Each forward pass can be run for the first channel only, so that mono
+ * signals don't pay for the second channel.
+ */
+namespace batched_rnn
+{
+constexpr int numChannels = 2;
+
+using Vec2d = std::vector<std::vector<float>>;
+
+template <int rows>
+using StateType = Eigen::Matrix<float, rows, numChannels>;
+
+template <typename ArrayType>
+inline auto sigmoid (const ArrayType& x) noexcept
+{
+    return (1.0f + (-x).exp()).inverse();
+}
+
+/** Delays the recurrent state, for running a model at a higher sample rate than it was trained at. */
+template <int size, RTNeural::SampleRateCorrectionMode srcMode>
+class StateDelay
+{
+public:
+    StateDelay() { prepare (1.0f); }
+
+    void prepare (float delaySamples)
+    {
+        delaySamples = jmax (1.0f, delaySamples);
+        if constexpr (srcMode == RTNeural::SampleRateCorrectionMode::LinInterp)
+        {
+            const auto delayOffFactor = delaySamples - std::floor (delaySamples);
+            delayMult = 1.0f - delayOffFactor;
+            delayPlus1Mult = delayOffFactor;
+            writeIndex = (int) std::ceil (delaySamples) - (int) std::ceil (delayOffFactor);
+        }
+        else
+        {
+            writeIndex = (int) delaySamples - 1;
+        }
+
+        states.resize ((size_t) writeIndex + 1);
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& state : states)
+            state.setZero();
+    }
+
+    /** The state computed for the current sample should be written here. */
+    StateType<size>& getWriteState() noexcept { return states[(size_t) writeIndex]; }
+
+    /** Reads the delayed state, and moves the delay line along by one sample. */
+    template <int numActiveChannels>
+    void read (StateType<size>& out) noexcept
+    {
+        if constexpr (srcMode == RTNeural::SampleRateCorrectionMode::LinInterp)
+            out.template leftCols<numActiveChannels>() = delayPlus1Mult * states[0].template leftCols<numActiveChannels>()
+                                                         + delayMult * states[1].template leftCols<numActiveChannels>();
+        else
+            out.template leftCols<numActiveChannels>() = states[0].template leftCols<numActiveChannels>();
+
+        for (size_t j = 0; j < (size_t) writeIndex; ++j)
+            states[j].template leftCols<numActiveChannels>() = states[j + 1].template leftCols<numActiveChannels>();
+    }
+
+private:
+    std::vector<StateType<size>> states;
+    int writeIndex = 0;
+    float delayMult = 1.0f;
+    float delayPlus1Mult = 0.0f;
+};
+
+/** LSTM layer with PyTorch-style gates (input, forget, cell, output). */
+template <int inSize, int hiddenSize, RTNeural::SampleRateCorrectionMode srcMode = RTNeural::SampleRateCorrectionMode::None>
+class LSTMLayer
+{
+public:
+    static constexpr int in_size = inSize;
+    static constexpr int out_size = hiddenSize;
+    using InputType = StateType<inSize>;
+
+    LSTMLayer() { reset(); }
+
+    /** Weights are indexed as [input][gate], like RTNeural::LSTMLayerT::setWVals(). */
+    void setWVals (const Vec2d& wVals)
+    {
+        for (int i = 0; i < inSize; ++i)
+            for (int k = 0; k < 4 * hiddenSize; ++k)
+                W (k, i) = wVals[(size_t) i][(size_t) k];
+    }
+
+    /** Weights are indexed as [hidden][gate], like RTNeural::LSTMLayerT::setUVals(). */
+    void setUVals (const Vec2d& uVals)
+    {
+        for (int i = 0; i < hiddenSize; ++i)
+            for (int k = 0; k < 4 * hiddenSize; ++k)
+                U (k, i) = uVals[(size_t) i][(size_t) k];
+    }
+
+    void setBVals (const std::vector<float>& bVals)
+    {
+        for (int k = 0; k < 4 * hiddenSize; ++k)
+            b (k) = bVals[(size_t) k];
+    }
+
+    void prepare (float delaySamples)
+    {
+        hDelay.prepare (delaySamples);
+        cDelay.prepare (delaySamples);
+        reset();
+    }
+
+    void reset()
+    {
+        outs.setZero();
+        cState.setZero();
+        hDelay.reset();
+        cDelay.reset();
+    }
+
+    template <int numActiveChannels>
+    void forward (const InputType& ins) noexcept
+    {
+        auto&& gatesBlock = gates.template leftCols<numActiveChannels>();
+        gatesBlock.noalias() = W * ins.template leftCols<numActiveChannels>();
+        gatesBlock.noalias() += U * outs.template leftCols<numActiveChannels>();
+        gatesBlock.colwise() += b;
+
+        auto&& gatesArray = gatesBlock.array();
+        gatesArray.template topRows<2 * hiddenSize>() = sigmoid (gatesArray.template topRows<2 * hiddenSize>());
+        gatesArray.template middleRows<hiddenSize> (2 * hiddenSize) = gatesArray.template middleRows<hiddenSize> (2 * hiddenSize).tanh();
+        gatesArray.template bottomRows<hiddenSize>() = sigmoid (gatesArray.template bottomRows<hiddenSize>());
+
+        const auto iGate = gatesArray.template topRows<hiddenSize>();
+        const auto fGate = gatesArray.template middleRows<hiddenSize> (hiddenSize);
+        const auto cGate = gatesArray.template middleRows<hiddenSize> (2 * hiddenSize);
+        const auto oGate = gatesArray.template bottomRows<hiddenSize>();
+
+        auto&& cOut = cDelay.getWriteState().template leftCols<numActiveChannels>().array();
+        cOut = fGate * cState.template leftCols<numActiveChannels>().array() + iGate * cGate;
+        hDelay.getWriteState().template leftCols<numActiveChannels>().array() = oGate * cOut.tanh();
+
+        cDelay.template read<numActiveChannels> (cState);
+        hDelay.template read<numActiveChannels> (outs);
+    }
+
+    StateType<hiddenSize> outs;
+
+private:
+    Eigen::Matrix<float, 4 * hiddenSize, inSize> W;
+    Eigen::Matrix<float, 4 * hiddenSize, hiddenSize> U;
+    Eigen::Matrix<float, 4 * hiddenSize, 1> b;
+
+    StateType<4 * hiddenSize> gates;
+    StateType<hiddenSize> cState;
+
+    StateDelay<hiddenSize, srcMode> hDelay;
+    StateDelay<hiddenSize, srcMode> cDelay;
+};
+
+/** GRU layer with Keras-style gates (update, reset, candidate), and separate input and recurrent biases. */
+template <int inSize, int hiddenSize, RTNeural::SampleRateCorrectionMode srcMode = RTNeural::SampleRateCorrectionMode::None>
+class GRULayer
+{
+public:
+    static constexpr int in_size = inSize;
+    static constexpr int out_size = hiddenSize;
+    using InputType = StateType<inSize>;
+
+    GRULayer() { reset(); }
+
+    /** Weights are indexed as [input][gate], like RTNeural::GRULayerT::setWVals(). */
+    void setWVals (const Vec2d& wVals)
+    {
+        for (int i = 0; i < inSize; ++i)
+            for (int k = 0; k < 3 * hiddenSize; ++k)
+                W (k, i) = wVals[(size_t) i][(size_t) k];
+    }
+
+    /** Weights are indexed as [hidden][gate], like RTNeural::GRULayerT::setUVals(). */
+    void setUVals (const Vec2d& uVals)
+    {
+        for (int i = 0; i < hiddenSize; ++i)
+            for (int k = 0; k < 3 * hiddenSize; ++k)
+                U (k, i) = uVals[(size_t) i][(size_t) k];
+    }
+
+    /** Biases are indexed as [input/recurrent][gate], like RTNeural::GRULayerT::setBVals(). */
+    void setBVals (const Vec2d& bVals)
+    {
+        for (int k = 0; k < 3 * hiddenSize; ++k)
+        {
+            bW (k) = bVals[0][(size_t) k];
+            bU (k) = bVals[1][(size_t) k];
+        }
+    }
+
+    void prepare (float delaySamples)
+    {
+        hDelay.prepare (delaySamples);
+        reset();
+    }
+
+    void reset()
+    {
+        outs.setZero();
+        hDelay.reset();
+    }
+
+    template <int numActiveChannels>
+    void forward (const InputType& ins) noexcept
+    {
+        auto&& alphaBlock = alpha.template leftCols<numActiveChannels>();
+        alphaBlock.noalias() = W * ins.template leftCols<numActiveChannels>();
+        alphaBlock.colwise() += bW;
+
+        auto&& gammaBlock = gamma.template leftCols<numActiveChannels>();
+        gammaBlock.noalias() = U * outs.template leftCols<numActiveChannels>();
+        gammaBlock.colwise() += bU;
+
+        auto&& alphaArray = alphaBlock.array();
+        auto&& gammaArray = gammaBlock.array();
+        alphaArray.template topRows<2 * hiddenSize>() = sigmoid (alphaArray.template topRows<2 * hiddenSize>() + gammaArray.template topRows<2 * hiddenSize>());
+
+        const auto zGate = alphaArray.template topRows<hiddenSize>();
+        const auto rGate = alphaArray.template middleRows<hiddenSize> (hiddenSize);
+        const auto cGate = (alphaArray.template bottomRows<hiddenSize>() + rGate * gammaArray.template bottomRows<hiddenSize>()).tanh();
+
+        const auto hPrev = outs.template leftCols<numActiveChannels>().array();
+        hDelay.getWriteState().template leftCols<numActiveChannels>().array() = (1.0f - zGate) * cGate + zGate * hPrev;
+
+        hDelay.template read<numActiveChannels> (outs);
+    }
+
+    StateType<hiddenSize> outs;
+
+private:
+    Eigen::Matrix<float, 3 * hiddenSize, inSize> W;
+    Eigen::Matrix<float, 3 * hiddenSize, hiddenSize> U;
+    Eigen::Matrix<float, 3 * hiddenSize, 1> bW;
+    Eigen::Matrix<float, 3 * hiddenSize, 1> bU;
+
+    StateType<3 * hiddenSize> alpha;
+    StateType<3 * hiddenSize> gamma;
+
+    StateDelay<hiddenSize, srcMode> hDelay;
+};
+
+/** Dense layer with a single output. */
+template <int inSize>
+class DenseLayer
+{
+public:
+    DenseLayer() = default;
+
+    /** Weights are indexed as [output][input], like RTNeural::DenseT::setWeights(). */
+    void setWeights (const Vec2d& weights)
+    {
+        for (int i = 0; i < inSize; ++i)
+            W (0, i) = weights[0][(size_t) i];
+    }
+
+    void setBias (const float* biasVals) { bias = biasVals[0]; }
+
+    template <int numActiveChannels>
+    void forward (const StateType<inSize>& ins) noexcept
+    {
+        outs.template leftCols<numActiveChannels>().noalias() = W * ins.template leftCols<numActiveChannels>();
+        outs.template leftCols<numActiveChannels>().array() += bias;
+    }
+
+    Eigen::Matrix<float, 1, numChannels> outs = Eigen::Matrix<float, 1, numChannels>::Zero();
+
+private:
+    Eigen::Matrix<float, 1, inSize> W = Eigen::Matrix<float, 1, inSize>::Zero();
+    float bias = 0.0f;
+};
+
+/** A recurrent layer followed by a dense layer, with one output for each channel. */
+template <typename RecurrentLayerType>
+class Model
+{
+public:
+    using InputType = typename RecurrentLayerType::InputType;
+
+    Model() = default;
+
+    RecurrentLayerType& getRecurrentLayer() noexcept { return recurrent; }
+    DenseLayer<RecurrentLayerType::out_size>& getDenseLayer() noexcept { return dense; }
+
+    void reset()
+    {
+        recurrent.reset();
+        dense.outs.setZero();
+    }
+
+    /**
+     * Runs the model for one sample, with the input for each channel
+     * in each column of the input matrix. Only the first numActiveChannels
+     * columns of the input and output are used.
+     */
+    template <int numActiveChannels>
+    const auto& forward (const InputType& ins) noexcept
+    {
+        static_assert (numActiveChannels >= 1 && numActiveChannels <= numChannels, "Unsupported number of channels!");
+
+        recurrent.template forward<numActiveChannels> (ins);
+        dense.template forward<numActiveChannels> (recurrent.outs);
+        return dense.outs;
+    }
+
+private:
+    RecurrentLayerType recurrent;
+    DenseLayer<RecurrentLayerType::out_size> dense;
+};
+} // namespace batched_rnn
@@ -0,0 +1,356 @@
+#include "BinaryModelData.h"
+#include "processors/SharedAssetCache.h"
+
+#if JUCE_BIG_ENDIAN
+#error "The binary model format assumes that tensor data can be read as native floats!"
+#endif
+
+namespace
+{
+// needs to stay in sync with scripts/compile_neural_model.py
+constexpr char magic[] = { 'B', 'N', 'N', 'M' };
+constexpr size_t headerSize = 32;
+constexpr size_t tensorEntrySize = 64;
+constexpr size_t tensorNameSize = 48;
+constexpr size_t alignment = 16;
+
+size_t align (size_t offset) noexcept
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+uint32_t readInt (const char* data, size_t offset) noexcept
+{
+    return ByteOrder::littleEndianInt (data + offset);
+}
+
+void writeInt (char* data, size_t offset, size_t value) noexcept
+{
+    const auto intValue = ByteOrder::swapIfBigEndian ((uint32_t) value);
+    std::memcpy (data + offset, &intValue, sizeof (uint32_t));
+}
+
+bool isVector (const nlohmann::json& value)
+{
+    return value.is_array() && ! value.empty() && std::all_of (value.begin(), value.end(), [] (const nlohmann::json& x)
+                                                                { return x.is_number(); });
+}
+
+bool isMatrix (const nlohmann::json& value)
+{
+    return value.is_array() && ! value.empty() && std::all_of (value.begin(), value.end(), [&value] (const nlohmann::json& row)
+                                                                { return isVector (row) && row.size() == value.front().size(); });
+}
+
+std::string escapeKey (std::string key)
+{
+    for (size_t pos = 0; (pos = key.find_first_of ("~/", pos)) != std::string::npos; pos += 2)
+        key.replace (pos, 1, key[pos] == '~' ? "~0" : "~1");
+    return key;
+}
+
+struct TensorToWrite
+{
+    std::string name;
+    int numDims;
+    size_t numRows;
+    size_t numCols;
+    std::vector<float> values;
+};
+
+/** Names cache files by a hash of the JSON text, since the same model could be loaded from different files or presets. */
+String getCacheFileName (const std::string& jsonText)
+{
+    return SharedAssetCache::getContentHash (jsonText.data(), jsonText.size()) + ".bnnm";
+}
+
+/** Replaces all the numeric vectors and matrices in the JSON with nulls, and collects them as tensors. */
+nlohmann::json extractTensors (const nlohmann::json& value, const std::string& path, std::vector<TensorToWrite>& tensors)
+{
+    if (isVector (value))
+    {
+        tensors.push_back ({ path, 1, value.size(), 1, value.get<std::vector<float>>() });
+        return nullptr;
+    }
+
+    if (isMatrix (value))
+    {
+        TensorToWrite tensor { path, 2, value.size(), value.front().size(), {} };
+        tensor.values.reserve (tensor.numRows * tensor.numCols);
+        for (const auto& row : value)
+            for (const auto& x : row)
+                tensor.values.push_back (x.get<float>());
+
+        tensors.push_back (std::move (tensor));
+        return nullptr;
+    }
+
+    if (value.is_object())
+    {
+        auto result = nlohmann::json::object();
+        for (auto iter = value.begin(); iter != value.end(); ++iter)
+            result[iter.key()] = extractTensors (iter.value(), path + "/" + escapeKey (iter.key()), tensors);
+        return result;
+    }
+
+    if (value.is_array())
+    {
+        auto result = nlohmann::json::array();
+        for (size_t i = 0; i < value.size(); ++i)
+            result.push_back (extractTensors (value[i], path + "/" + std::to_string (i), tensors));
+        return result;
+    }
+
+    return value;
+}
+} // namespace
+
+float BinaryModelData::Tensor::operator[] (int index) const noexcept
+{
+    // the tensor data might not be aligned (e.g. in BinaryData), so copy the bytes out
+    float value;
+    std::memcpy (&value, data + sizeof (float) * (size_t) index, sizeof (float));
+    return value;
+}
+
+std::vector<float> BinaryModelData::Tensor::toVector() const
+{
+    std::vector<float> values ((size_t) getNumValues());
+    std::memcpy (values.data(), data, sizeof (float) * values.size());
+    return values;
+}
+
+std::vector<std::vector<float>> BinaryModelData::Tensor::toVec2d (bool transposed) const
+{
+    const auto outerSize = transposed ? numCols : numRows;
+    const auto innerSize = transposed ? numRows : numCols;
+    std::vector<std::vector<float>> values ((size_t) outerSize, std::vector<float> ((size_t) innerSize));
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        for (int col = 0; col < numCols; ++col)
+        {
+            const auto value = (*this)[row * numCols + col];
+            if (transposed)
+                values[(size_t) col][(size_t) row] = value;
+            else
+                values[(size_t) row][(size_t) col] = value;
+        }
+    }
+
+    return values;
+}
+
+std::unique_ptr<BinaryModelData> BinaryModelData::fromMemory (const void* data, size_t dataSize)
+{
+    std::unique_ptr<BinaryModelData> model { new BinaryModelData() };
+    if (! model->initialise (data, dataSize))
+        return {};
+
+    return model;
+}
+
+std::unique_ptr<BinaryModelData> BinaryModelData::fromFile (const File& file)
+{
+    std::unique_ptr<BinaryModelData> model { new BinaryModelData() };
+    model->mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+    if (model->mappedFile->getData() == nullptr || ! model->initialise (model->mappedFile->getData(), model->mappedFile->getSize()))
+        return {};
+
+    return model;
+}
+
+std::unique_ptr<BinaryModelData> BinaryModelData::fromJSON (const nlohmann::json& modelJson)
+{
+    std::unique_ptr<BinaryModelData> model { new BinaryModelData() };
+    model->ownedData = convertJSON (modelJson);
+    if (! model->initialise (model->ownedData.getData(), model->ownedData.getSize()))
+    {
+        jassertfalse; // the converted model should always be valid!
+        return {};
+    }
+
+    return model;
+}
+
+std::unique_ptr<BinaryModelData> BinaryModelData::fromJSONText (const std::string& jsonText, const File& cacheDirectory)
+{
+    const auto cacheFile = cacheDirectory == File {} ? File {} : cacheDirectory.getChildFile (getCacheFileName (jsonText));
+    if (cacheFile.existsAsFile())
+    {
+        if (auto model = fromFile (cacheFile))
+        {
+            cacheFile.setLastModificationTime (Time::getCurrentTime()); // so that the most recently used models stay in the cache
+            return model;
+        }
+
+        cacheFile.deleteFile(); // the cached model is out of date, or corrupted
+    }
+
+    std::unique_ptr<BinaryModelData> model { new BinaryModelData() };
+    model->ownedData = convertJSON (nlohmann::json::parse (jsonText));
+    if (! model->initialise (model->ownedData.getData(), model->ownedData.getSize()))
+        throw std::runtime_error ("Unable to convert model!");
+
+    // if the cache can't be written, we'll just have to convert the model again next time
+    if (cacheFile != File {} && cacheDirectory.createDirectory())
+    {
+        // write to a temporary file first, so that another instance never maps a half-written model
+        TemporaryFile tempFile { cacheFile };
+        if (tempFile.getFile().replaceWithData (model->ownedData.getData(), model->ownedData.getSize())
+            && tempFile.overwriteTargetFileWithTemporary())
+            SharedAssetCache::trimDiskCache (cacheDirectory, maxDiskCacheSize);
+    }
+
+    return model;
+}
+
+MemoryBlock BinaryModelData::convertJSON (const nlohmann::json& modelJson)
+{
+    std::vector<TensorToWrite> tensorsToWrite;
+    const auto metadataText = extractTensors (modelJson, {}, tensorsToWrite).dump();
+
+    const auto metadataOffset = headerSize;
+    const auto tensorTableOffset = align (metadataOffset + metadataText.size());
+    auto dataOffset = align (tensorTableOffset + tensorsToWrite.size() * tensorEntrySize);
+
+    std::vector<size_t> tensorOffsets;
+    for (const auto& tensor : tensorsToWrite)
+    {
+        if (tensor.name.size() >= tensorNameSize)
+            throw std::runtime_error ("Tensor name is too long: " + tensor.name);
+
+        tensorOffsets.push_back (dataOffset);
+        dataOffset = align (dataOffset + sizeof (float) * tensor.values.size());
+    }
+    const auto totalSize = tensorsToWrite.empty() ? tensorTableOffset : tensorOffsets.back() + sizeof (float) * tensorsToWrite.back().values.size();
+
+    MemoryBlock modelData { totalSize, true };
+    auto* data = static_cast<char*> (modelData.getData());
+
+    std::memcpy (data, magic, sizeof (magic));
+    writeInt (data, 4, formatVersion);
+    writeInt (data, 8, tensorsToWrite.size());
+    writeInt (data, 12, metadataOffset);
+    writeInt (data, 16, metadataText.size());
+    writeInt (data, 20, tensorTableOffset);
+    writeInt (data, 24, totalSize);
+    std::memcpy (data + metadataOffset, metadataText.data(), metadataText.size());
+
+    for (size_t i = 0; i < tensorsToWrite.size(); ++i)
+    {
+        const auto& tensor = tensorsToWrite[i];
+        auto* entry = data + tensorTableOffset + i * tensorEntrySize;
+        std::memcpy (entry, tensor.name.data(), tensor.name.size());
+        writeInt (entry, tensorNameSize, (size_t) tensor.numDims);
+        writeInt (entry, tensorNameSize + 4, tensor.numRows);
+        writeInt (entry, tensorNameSize + 8, tensor.numCols);
+        writeInt (entry, tensorNameSize + 12, tensorOffsets[i]);
+        std::memcpy (data + tensorOffsets[i], tensor.values.data(), sizeof (float) * tensor.values.size());
+    }
+
+    return modelData;
+}
+
+bool BinaryModelData::isBinaryModel (const void* data, size_t dataSize) noexcept
+{
+    return dataSize >= headerSize && std::memcmp (data, magic, sizeof (magic)) == 0;
+}
+
+bool BinaryModelData::initialise (const void* modelData, size_t dataSize)
+{
+    if (! isBinaryModel (modelData, dataSize))
+        return false;
+
+    const auto* data = static_cast<const char*> (modelData);
+    if (readInt (data, 4) != formatVersion)
+        return false;
+
+    const auto numTensors = (size_t) readInt (data, 8);
+    const auto metadataOffset = (size_t) readInt (data, 12);
+    const auto metadataSize = (size_t) readInt (data, 16);
+    const auto tensorTableOffset = (size_t) readInt (data, 20);
+    const auto totalSize = (size_t) readInt (data, 24);
+    if (totalSize > dataSize
+        || metadataOffset + metadataSize > totalSize
+        || tensorTableOffset + numTensors * tensorEntrySize > totalSize)
+        return false;
+
+    metadata = nlohmann::json::parse (data + metadataOffset, data + metadataOffset + metadataSize, nullptr, false);
+    if (metadata.is_discarded())
+        return false;
+
+    tensors.clear();
+    tensors.reserve (numTensors);
+    for (size_t i = 0; i < numTensors; ++i)
+    {
+        const auto* entry = data + tensorTableOffset + i * tensorEntrySize;
+        const auto nameLength = std::find (entry, entry + tensorNameSize, '\0') - entry;
+
+        Tensor tensor;
+        tensor.numDims = (int) readInt (entry, tensorNameSize);
+        tensor.numRows = (int) readInt (entry, tensorNameSize + 4);
+        tensor.numCols = (int) readInt (entry, tensorNameSize + 8);
+        const auto tensorOffset = (size_t) readInt (entry, tensorNameSize + 12);
+
+        if (nameLength == (std::ptrdiff_t) tensorNameSize
+            || (tensor.numDims != 1 && tensor.numDims != 2)
+            || tensor.numRows < 0 || tensor.numCols < 0
+            || (uint64) tensorOffset + sizeof (float) * (uint64) tensor.numRows * (uint64) tensor.numCols > (uint64) totalSize)
+            return false;
+
+        tensor.data = data + tensorOffset;
+        tensors.emplace_back (std::string (entry, (size_t) nameLength), tensor);
+    }
+
+    return true;
+}
+
+BinaryModelData::Tensor BinaryModelData::getTensor (const std::string& name) const
+{
+    for (const auto& [tensorName, tensor] : tensors)
+        if (tensorName == name)
+            return tensor;
+
+    return {};
+}
+
+BinaryModelData::Tensor BinaryModelData::getRequiredTensor (const std::string& name) const
+{
+    const auto tensor = getTensor (name);
+    if (! tensor.isValid())
+        throw std::runtime_error ("Model is missing weights: " + name);
+
+    return tensor;
+}
+
+nlohmann::json BinaryModelData::toJSON() const
+{
+    auto modelJson = metadata;
+    for (const auto& [name, tensor] : tensors)
+    {
+        if (tensor.numDims == 1)
+            modelJson[nlohmann::json::json_pointer { name }] = tensor.toVector();
+        else
+            modelJson[nlohmann::json::json_pointer { name }] = tensor.toVec2d();
+    }
+
+    return modelJson;
+}
+
+bool BinaryModelData::hasSameWeights (const BinaryModelData& other) const
+{
+    if (tensors.size() != other.tensors.size())
+        return false;
+
+    for (const auto& [name, tensor] : tensors)
+    {
+        const auto otherTensor = other.getTensor (name);
+        if (otherTensor.numRows != tensor.numRows
+            || otherTensor.numCols != tensor.numCols
+            || std::memcmp (otherTensor.data, tensor.data, sizeof (float) * (size_t) tensor.getNumValues()) != 0)
+            return false;
+    }
+
+    return true;
+}
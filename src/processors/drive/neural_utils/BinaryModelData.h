@@ -0,0 +1,111 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Neural model weights, stored in a compact binary format that can be
+ * loaded without parsing any JSON.
+ *
+ * The bundled models are compiled from JSON into this format at build
+ * time (by scripts/compile_neural_model.py, or bundled as JSON and converted
+ * at load time if Python isn't available), and user-loaded models are
+ * converted when they are first loaded, and cached on disk.
+ *
+ * Any numeric vector or matrix in the original JSON becomes a "tensor",
+ * named by its JSON pointer (e.g. "/state_dict/rec.weight_ih_l0"). The
+ * rest of the JSON (with the tensors replaced by nulls) is kept as the
+ * model's metadata. The file layout (all values little-endian) is:
+ *
+ *  - Header (32 bytes): "BNNM", format version, number of tensors, metadata
+ *    offset, metadata size, tensor table offset, total size, reserved.
+ *  - Metadata: UTF-8 JSON text.
+ *  - Tensor table (64 bytes per tensor): null-terminated name (48 bytes),
+ *    number of dimensions (1 or 2), number of rows, number of columns,
+ *    data offset.
+ *  - Tensor data: row-major float32, each tensor aligned to 16 bytes.
+ *
+ * All offsets are from the start of the file, so that a model file can be
+ * used straight from a memory-mapped file.
+ */
+class BinaryModelData
+{
+public:
+    /** A read-only view of one of the model's weight tensors. */
+    struct Tensor
+    {
+        const char* data = nullptr;
+        int numDims = 0;
+        int numRows = 0;
+        int numCols = 0;
+
+        bool isValid() const noexcept { return data != nullptr; }
+        int getNumValues() const noexcept { return numRows * numCols; }
+        float operator[] (int index) const noexcept;
+
+        /** Returns the tensor as a flat vector. */
+        std::vector<float> toVector() const;
+
+        /** Returns the tensor as a vector of rows (or of columns, if the tensor should be transposed). */
+        std::vector<std::vector<float>> toVec2d (bool transposed = false) const;
+    };
+
+    /** Creates a view of model data that's already in memory (e.g. from BinaryData), without copying it. */
+    static std::unique_ptr<BinaryModelData> fromMemory (const void* data, size_t dataSize);
+
+    /** Memory-maps a binary model file. */
+    static std::unique_ptr<BinaryModelData> fromFile (const File& file);
+
+    /** Converts a model from its JSON representation. */
+    static std::unique_ptr<BinaryModelData> fromJSON (const nlohmann::json& modelJson);
+
+    /**
+     * Loads a model from its JSON text, using the converted model from the cache
+     * directory if the same model has been loaded before. Otherwise the model is
+     * parsed and converted, and the converted model is saved to the cache directory,
+     * which is then trimmed down to maxDiskCacheSize (least recently used models first).
+     * Pass an empty cache directory to skip the cache. Throws if the JSON can't be
+     * parsed or converted.
+     */
+    static std::unique_ptr<BinaryModelData> fromJSONText (const std::string& jsonText, const File& cacheDirectory);
+
+    /** The most disk space that fromJSONText() will use for converted models. */
+    static constexpr int64 maxDiskCacheSize = 32 * 1024 * 1024;
+
+    /** Converts a model from JSON to the binary format. Throws if the model can't be converted. */
+    static MemoryBlock convertJSON (const nlohmann::json& modelJson);
+
+    /** Returns true if this data looks like a binary model. */
+    static bool isBinaryModel (const void* data, size_t dataSize) noexcept;
+
+    /** Returns the model's metadata, i.e. the model JSON, without any of the weights. */
+    const nlohmann::json& getMetadata() const noexcept { return metadata; }
+
+    /** Returns the tensor with this name (JSON pointer), or an invalid tensor if the model doesn't have it. */
+    Tensor getTensor (const std::string& name) const;
+
+    /** Same as getTensor(), but throws if the tensor doesn't exist. */
+    Tensor getRequiredTensor (const std::string& name) const;
+
+    /** Rebuilds the original JSON representation of the model. */
+    nlohmann::json toJSON() const;
+
+    /** Returns true if both models have the same tensors, with the same values (the metadata is ignored). */
+    bool hasSameWeights (const BinaryModelData& other) const;
+
+    /** Returns the size of the model data that this object has allocated (i.e. not memory-mapped, or viewed from BinaryData). */
+    size_t getOwnedDataSize() const noexcept { return ownedData.getSize(); }
+
+    static constexpr uint32_t formatVersion = 1;
+
+private:
+    BinaryModelData() = default;
+    bool initialise (const void* data, size_t dataSize);
+
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    MemoryBlock ownedData;
+
+    nlohmann::json metadata;
+    std::vector<std::pair<std::string, Tensor>> tensors;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BinaryModelData)
+};
@@ -2,79 +2,59 @@
 
 namespace
 {
-using Vec2d = std::vector<std::vector<float>>;
-auto transpose = [] (const Vec2d& x) -> Vec2d
-{
-    auto outer_size = x.size();
-    auto inner_size = x[0].size();
-    Vec2d y (inner_size, std::vector<float> (outer_size, 0.0f));
-
-    for (size_t i = 0; i < outer_size; ++i)
-    {
-        for (size_t j = 0; j < inner_size; ++j)
-            y[j][i] = x[i][j];
-    }
-
-    return std::move (y);
-};
-
 template <typename ModelType>
-void loadLSTMModel (ModelType& model, int hiddenSize, const nlohmann::json& weights_json)
+void loadLSTMModel (ModelType& model, int hiddenSize, const BinaryModelData& weights)
 {
-    auto& lstm = model.template get<0>();
-    auto& dense = model.template get<1>();
-
-    Vec2d lstm_weights_ih = weights_json["/state_dict/rec.weight_ih_l0"_json_pointer];
-    lstm.setWVals (transpose (lstm_weights_ih));
+    auto& lstm = model.getRecurrentLayer();
+    auto& dense = model.getDenseLayer();
 
-    Vec2d lstm_weights_hh = weights_json["/state_dict/rec.weight_hh_l0"_json_pointer];
-    lstm.setUVals (transpose (lstm_weights_hh));
+    lstm.setWVals (weights.getRequiredTensor ("/state_dict/rec.weight_ih_l0").toVec2d (true));
+    lstm.setUVals (weights.getRequiredTensor ("/state_dict/rec.weight_hh_l0").toVec2d (true));
 
-    std::vector<float> lstm_bias_ih = weights_json["/state_dict/rec.bias_ih_l0"_json_pointer];
-    std::vector<float> lstm_bias_hh = weights_json["/state_dict/rec.bias_hh_l0"_json_pointer];
+    const auto lstm_bias_ih = weights.getRequiredTensor ("/state_dict/rec.bias_ih_l0").toVector();
+    auto lstm_bias_hh = weights.getRequiredTensor ("/state_dict/rec.bias_hh_l0").toVector();
     for (int i = 0; i < 4 * hiddenSize; ++i)
         lstm_bias_hh[(size_t) i] += lstm_bias_ih[(size_t) i];
     lstm.setBVals (lstm_bias_hh);
 
-    Vec2d dense_weights = weights_json["/state_dict/lin.weight"_json_pointer];
-    dense.setWeights (dense_weights);
+    dense.setWeights (weights.getRequiredTensor ("/state_dict/lin.weight").toVec2d());
 
-    std::vector<float> dense_bias = weights_json["/state_dict/lin.bias"_json_pointer];
+    const auto dense_bias = weights.getRequiredTensor ("/state_dict/lin.bias").toVector();
     dense.setBias (dense_bias.data());
 }
 
 template <typename ModelType>
-void loadGRUModel (ModelType& model, const nlohmann::json& weights_json)
+void loadGRUModel (ModelType& model, const BinaryModelData& weights)
 {
-    auto json_layers = weights_json["layers"];
-    const auto gru_layer_json = json_layers.at (0);
-    const auto dense_layer_json = json_layers.at (1);
+    auto& gru = model.getRecurrentLayer();
+    auto& dense = model.getDenseLayer();
 
-    auto& gru = model.template get<0>();
-    auto& dense = model.template get<1>();
+    gru.setWVals (weights.getRequiredTensor ("/layers/0/weights/0").toVec2d());
+    gru.setUVals (weights.getRequiredTensor ("/layers/0/weights/1").toVec2d());
+    gru.setBVals (weights.getRequiredTensor ("/layers/0/weights/2").toVec2d());
 
-    int layer_idx = 0;
-    const auto& gru_weights = gru_layer_json["weights"];
-    RTNeural::json_parser::loadGRU<float> (gru, gru_weights);
-    RTNeural::modelt_detail::loadLayer<float> (dense, layer_idx, dense_layer_json, "dense", 1, false);
+    // Keras stores the dense kernel as [input][output]
+    dense.setWeights (weights.getRequiredTensor ("/layers/1/weights/0").toVec2d (true));
+
+    const auto dense_bias = weights.getRequiredTensor ("/layers/1/weights/1").toVector();
+    dense.setBias (dense_bias.data());
 }
 } // namespace
 
-template <int hiddenSize, template <typename, int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType>
+template <int hiddenSize, template <int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType>
 void ResampledRNN<hiddenSize, RecurrentLayerType>::initialise (const void* modelData, int modelDataSize, double modelSampleRate)
 {
     targetSampleRate = modelSampleRate;
 
-    MemoryInputStream jsonInputStream (modelData, (size_t) modelDataSize, false);
-    auto weightsJson = nlohmann::json::parse (jsonInputStream.readEntireStreamAsString().toStdString());
+    modelWeights = SharedResourcePointer<SharedAssetCache>()->getEmbeddedModel (modelData, modelDataSize);
 
-    if constexpr (std::is_same_v<RecurrentLayerTypeComplete, RTNeural::GRULayerT<float, 1, 8, DefaultSRCMode>>) // Centaur model has keras-style weights
-        loadGRUModel (model, weightsJson);
+    if constexpr (std::is_same_v<RecurrentLayerTypeComplete, batched_rnn::GRULayer<1, 8, DefaultSRCMode>>) // Centaur model has keras-style weights
+        loadGRUModel (model, *modelWeights);
     else
-        loadLSTMModel (model, hiddenSize, weightsJson);
+        loadLSTMModel (model, hiddenSize, *modelWeights);
 }
 
-template <int hiddenSize, template <typename, int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType>
+template <int hiddenSize, template <int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType>
 void ResampledRNN<hiddenSize, RecurrentLayerType>::prepare (double sampleRate, int samplesPerBlock)
 {
     const auto [resampleRatio, rnnDelaySamples] = [] (auto curFs, auto targetFs)
@@ -93,13 +73,13 @@ void ResampledRNN<hiddenSize, RecurrentLayerType>::prepare (double sampleRate, i
     }(sampleRate, targetSampleRate);
 
     needsResampling = resampleRatio != 1.0;
-    resampler.prepareWithTargetSampleRate ({ sampleRate, (uint32) samplesPerBlock, 1 }, sampleRate * resampleRatio);
+    resampler.prepareWithTargetSampleRate ({ sampleRate, (uint32) samplesPerBlock, (uint32) batched_rnn::numChannels }, sampleRate * resampleRatio);
 
-    model.template get<0>().prepare (rnnDelaySamples);
+    model.getRecurrentLayer().prepare ((float) rnnDelaySamples);
     model.reset();
 }
 
-template <int hiddenSize, template <typename, int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType>
+template <int hiddenSize, template <int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType>
 void ResampledRNN<hiddenSize, RecurrentLayerType>::reset()
 {
     resampler.reset();
@@ -107,6 +87,6 @@ void ResampledRNN<hiddenSize, RecurrentLayerType>::reset()
 }
 
 //=======================================================
-template class ResampledRNN<20, RTNeural::LSTMLayerT>; // GuitarML
-template class ResampledRNN<28, RTNeural::LSTMLayerT>; // MetalFace
-template class ResampledRNN<8, RTNeural::GRULayerT>; // Centaur
+template class ResampledRNN<20, batched_rnn::LSTMLayer>; // GuitarML
+template class ResampledRNN<28, batched_rnn::LSTMLayer>; // MetalFace
+template class ResampledRNN<8, batched_rnn::GRULayer>; // Centaur
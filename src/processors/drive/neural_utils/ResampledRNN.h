@@ -1,8 +1,10 @@
 #pragma once
 
-#include <pch.h>
+#include "BatchedRNN.h"
+#include "BinaryModelData.h"
+#include "processors/SharedAssetCache.h"
 
-template <int hiddenSize, template <typename, int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType = RTNeural::LSTMLayerT>
+template <int hiddenSize, template <int, int, RTNeural::SampleRateCorrectionMode> typename RecurrentLayerType = batched_rnn::LSTMLayer>
 class ResampledRNN
 {
 public:
@@ -15,24 +17,23 @@ public:
     void prepare (double sampleRate, int samplesPerBlock);
     void reset();
 
+    /** Returns the memory used by the model and its weights, and (roughly) by the resampler, which keeps its buffers inline. */
+    size_t getMemoryFootprint() const noexcept
+    {
+        return sizeof (*this) + (modelWeights != nullptr ? modelWeights->getOwnedDataSize() : 0);
+    }
+
+    /** Processes a mono or stereo block, with both channels going through the model together. */
     template <bool useRedisuals = false>
     void process (juce::dsp::AudioBlock<float>& block)
     {
-        auto processNNInternal = [this] (const chowdsp::BufferView<float>& bufferView)
+        const auto numChannels = (int) block.getNumChannels();
+        auto processNNInternal = [this, numChannels] (const chowdsp::BufferView<float>& bufferView)
         {
-            const auto numSamples = bufferView.getNumSamples();
-            auto* x = bufferView.getWritePointer (0);
-
-            if constexpr (useRedisuals)
-            {
-                for (int i = 0; i < numSamples; ++i)
-                    x[i] += model.forward (&x[i]);
-            }
+            if (numChannels == 1)
+                processNN<useRedisuals, 1> (bufferView);
             else
-            {
-                for (int i = 0; i < numSamples; ++i)
-                    x[i] = model.forward (&x[i]);
-            }
+                processNN<useRedisuals, 2> (bufferView);
         };
 
         if (! needsResampling)
@@ -49,10 +50,38 @@ public:
     }
 
 private:
+    template <bool useRedisuals, int numChannels>
+    void processNN (const chowdsp::BufferView<float>& bufferView) noexcept
+    {
+        const auto numSamples = bufferView.getNumSamples();
+
+        float* x[numChannels];
+        for (int ch = 0; ch < numChannels; ++ch)
+            x[ch] = bufferView.getWritePointer (ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                modelInput (0, ch) = x[ch][i];
+
+            const auto& y = model.template forward<numChannels> (modelInput);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if constexpr (useRedisuals)
+                    x[ch][i] += y (ch);
+                else
+                    x[ch][i] = y (ch);
+            }
+        }
+    }
+
     static constexpr auto DefaultSRCMode = RTNeural::SampleRateCorrectionMode::NoInterp;
-    using RecurrentLayerTypeComplete = RecurrentLayerType<float, 1, hiddenSize, DefaultSRCMode>;
-    using DenseLayerType = RTNeural::DenseT<float, hiddenSize, 1>;
-    RTNeural::ModelT<float, 1, 1, RecurrentLayerTypeComplete, DenseLayerType> model;
+    using RecurrentLayerTypeComplete = RecurrentLayerType<1, hiddenSize, DefaultSRCMode>;
+    using ModelType = batched_rnn::Model<RecurrentLayerTypeComplete>;
+    ModelType model;
+    std::shared_ptr<const BinaryModelData> modelWeights; // keeps the weights in the shared cache while this model is alive
+    typename ModelType::InputType modelInput = ModelType::InputType::Zero();
 
     using ResamplerType = chowdsp::ResamplingTypes::LanczosResampler<8192, 8>;
     chowdsp::ResampledProcess<ResamplerType> resampler;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pch.h>
+#include "../../utility/FastMath.h"
 
 class TubeProc
 {
@@ -12,16 +13,10 @@ public:
         Vp = 0.0;
     }
 
-    template <typename T>
-    inline int sgn (T val) const noexcept
-    {
-        return (T (0) < val) - (val < T (0));
-    }
-
     template <typename T>
     inline T pwrs (T x, T y) const noexcept
     {
-        return sgn (x) * std::pow (std::abs (x), y);
+        return FastMath::signedPow<FastMath::Accuracy::Balanced> (x, y);
     }
 
     inline double getCurrent (double curVg, double curVp) const noexcept
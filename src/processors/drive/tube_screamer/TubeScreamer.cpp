@@ -30,11 +30,8 @@ void TubeScreamer::prepare (double sampleRate, int samplesPerBlock)
 {
     int diodeType = static_cast<int> (*diodeTypeParam);
     auto gainParamSkew = ParameterHelpers::logPot (*gainParam);
-    for (auto& wdfProc : wdf)
-    {
-        wdfProc.prepare (sampleRate);
-        wdfProc.setParameters (gainParamSkew, DiodeParameter::getDiodeIs (diodeType), *nDiodesParam, true);
-    }
+    wdf.prepare (sampleRate);
+    wdf.setParameters (gainParamSkew, DiodeParameter::getDiodeIs (diodeType), *nDiodesParam, true);
 
     dcBlocker.prepare (sampleRate, samplesPerBlock);
 
@@ -53,11 +50,8 @@ void TubeScreamer::processAudio (AudioBuffer<float>& buffer)
 
     int diodeType = static_cast<int> (*diodeTypeParam);
     auto gainParamSkew = ParameterHelpers::logPot (*gainParam);
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        wdf[ch].setParameters (gainParamSkew, DiodeParameter::getDiodeIs (diodeType), *nDiodesParam);
-        wdf[ch].process (buffer.getWritePointer (ch), buffer.getNumSamples());
-    }
+    wdf.setParameters (gainParamSkew, DiodeParameter::getDiodeIs (diodeType), *nDiodesParam);
+    wdf.process (buffer);
 
     dcBlocker.processAudio (buffer);
 
@@ -20,7 +20,7 @@ private:
     std::atomic<float>* diodeTypeParam = nullptr;
     chowdsp::FloatParameter* nDiodesParam = nullptr;
 
-    TubeScreamerWDF wdf[2];
+    TubeScreamerWDF<ChannelBatch::Vec> wdf; // processes all channels at once
     DCBlocker dcBlocker;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TubeScreamer)
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <pch.h>
+#include "processors/utility/ChannelBatch.h"
 
+template <typename T>
 class TubeScreamerWDF
 {
 public:
@@ -35,57 +36,56 @@ public:
         }
     }
 
-    inline float processSample (float x) noexcept
+    inline T processSample (T x) noexcept
     {
         Vin.setVoltage (x);
 
         dp.incident (P3.reflected());
         P3.incident (dp.reflected());
 
-        return wdft::voltage<float> (RL);
+        return wdft::voltage<T> (RL);
     }
 
-    void process (float* buffer, const int numSamples)
+    void process (AudioBuffer<float>& buffer) noexcept
     {
         if (nDiodesSmooth.isSmoothing() || gainSmooth.isSmoothing())
         {
-            for (int n = 0; n < numSamples; ++n)
-            {
-                R6_P1.setResistanceValue (Pot1 * gainSmooth.getNextValue() + R6);
-                dp.setDiodeParameters (curDiodeIs, Vt, nDiodesSmooth.getNextValue());
-
-                buffer[n] = processSample (buffer[n]);
-            }
+            ChannelBatch::process<T> (buffer,
+                                      [this] (T x)
+                                      {
+                                          R6_P1.setResistanceValue (Pot1 * gainSmooth.getNextValue() + R6);
+                                          dp.setDiodeParameters (curDiodeIs, Vt, nDiodesSmooth.getNextValue());
+                                          return processSample (x);
+                                      });
             return;
         }
 
         R6_P1.setResistanceValue (Pot1 * gainSmooth.getNextValue() + R6);
         dp.setDiodeParameters (curDiodeIs, Vt, nDiodesSmooth.getNextValue());
-        for (int n = 0; n < numSamples; ++n)
-            buffer[n] = processSample (buffer[n]);
+        ChannelBatch::process<T> (buffer, [this] (T x) { return processSample (x); });
     }
 
 private:
     // Port B
-    wdft::ResistiveVoltageSourceT<float> Vin;
-    wdft::CapacitorT<float> C2 { 1.0e-6f };
-    wdft::WDFSeriesT<float, decltype (Vin), decltype (C2)> S1 { Vin, C2 };
+    wdft::ResistiveVoltageSourceT<T> Vin;
+    wdft::CapacitorT<T> C2 { 1.0e-6f };
+    wdft::WDFSeriesT<T, decltype (Vin), decltype (C2)> S1 { Vin, C2 };
 
-    wdft::ResistorT<float> R5 { 10.0e3f };
-    wdft::WDFParallelT<float, decltype (S1), decltype (R5)> P1 { S1, R5 };
+    wdft::ResistorT<T> R5 { 10.0e3f };
+    wdft::WDFParallelT<T, decltype (S1), decltype (R5)> P1 { S1, R5 };
 
     // Port C
-    wdft::ResistorT<float> R4 { 4.7e3f };
-    wdft::CapacitorT<float> C3 { 0.047e-6f };
-    wdft::WDFSeriesT<float, decltype (R4), decltype (C3)> S2 { R4, C3 };
+    wdft::ResistorT<T> R4 { 4.7e3f };
+    wdft::CapacitorT<T> C3 { 0.047e-6f };
+    wdft::WDFSeriesT<T, decltype (R4), decltype (C3)> S2 { R4, C3 };
 
     // Port D
-    wdft::ResistorT<float> RL { 1.0e6f };
+    wdft::ResistorT<T> RL { 1.0e6f };
 
     struct ImpedanceCalc
     {
         template <typename RType>
-        static float calcImpedance (RType& R)
+        static T calcImpedance (RType& R)
         {
             constexpr float Ag = 100.0f; // op-amp gain
             constexpr float Ri = 1.0e9f; // op-amp input impedance
@@ -105,18 +105,18 @@ private:
         }
     };
 
-    wdft::RtypeAdaptor<float, 0, ImpedanceCalc, decltype (P1), decltype (S2), decltype (RL)> R { P1, S2, RL };
+    wdft::RtypeAdaptor<T, 0, ImpedanceCalc, decltype (P1), decltype (S2), decltype (RL)> R { P1, S2, RL };
 
     // Port A
     static constexpr float Vt = 0.02585f;
     static constexpr auto R6 = 51.0e3f;
     static constexpr auto Pot1 = 500.0e3f;
-    wdft::ResistorT<float> R6_P1 { R6 };
-    wdft::CapacitorT<float> C4 { 51.0e-12f };
-    wdft::WDFParallelT<float, decltype (R6_P1), decltype (C4)> P2 { R6_P1, C4 };
-    wdft::WDFParallelT<float, decltype (P2), decltype (R)> P3 { P2, R };
+    wdft::ResistorT<T> R6_P1 { R6 };
+    wdft::CapacitorT<T> C4 { 51.0e-12f };
+    wdft::WDFParallelT<T, decltype (R6_P1), decltype (C4)> P2 { R6_P1, C4 };
+    wdft::WDFParallelT<T, decltype (P2), decltype (R)> P3 { P2, R };
 
-    wdft::DiodePairT<float, decltype (P3)> dp { P3, 4.352e-9f, Vt, 1.906f }; // 1N4148
+    wdft::DiodePairT<T, decltype (P3)> dp { P3, 4.352e-9f, Vt, 1.906f }; // 1N4148
 
     SmoothedValue<float, ValueSmoothingTypes::Linear> nDiodesSmooth;
     SmoothedValue<float, ValueSmoothingTypes::Linear> gainSmooth;
@@ -150,20 +150,16 @@ Vec4 WS_PM1_LUT (const float* table, Vec4 in)
     auto frac = x - e;
 
     // on PC write to memory & back as XMM -> GPR is slow on K8
-    float e4 alignas (16)[4];
+    alignas (Vec4::arch_type::alignment()) float e4[Vec4::size];
     e.store_aligned (e4);
 
-    float wsArr alignas (16)[4];
-    wsArr[0] = table[(int) e4[0]];
-    wsArr[1] = table[(int) e4[1]];
-    wsArr[2] = table[(int) e4[2]];
-    wsArr[3] = table[(int) e4[3]];
+    alignas (Vec4::arch_type::alignment()) float wsArr[Vec4::size];
+    for (size_t i = 0; i < Vec4::size; ++i)
+        wsArr[i] = table[(int) e4[i]];
     auto ws = xsimd::load_aligned (wsArr);
 
-    wsArr[0] = table[(int) e4[0] + 1];
-    wsArr[1] = table[(int) e4[1] + 1];
-    wsArr[2] = table[(int) e4[2] + 1];
-    wsArr[3] = table[(int) e4[3] + 1];
+    for (size_t i = 0; i < Vec4::size; ++i)
+        wsArr[i] = table[(int) e4[i] + 1];
     auto wsn = xsimd::load_aligned (wsArr);
 
     auto res = ((one - frac) * ws) + (frac * wsn);
@@ -789,6 +785,41 @@ WaveshaperQFPtr GetQFPtrWaveshaper (int type)
     return nullptr;
 }
 
+bool IsStatelessWaveshaper (int type)
+{
+    switch (type)
+    {
+        case wst_soft:
+        case wst_hard:
+        case wst_asym:
+        case wst_sine:
+        case wst_digital:
+        case wst_cheby3:
+        case wst_cheby5:
+        case wst_add13:
+        case wst_add15:
+        case wst_addsqr3:
+        case wst_sinpx:
+        case wst_sin2xpb:
+        case wst_sin3xpb:
+        case wst_sin7xpb:
+        case wst_sin10xpb:
+        case wst_2cyc:
+        case wst_7cyc:
+        case wst_10cyc:
+        case wst_2cycbound:
+        case wst_7cycbound:
+        case wst_10cycbound:
+        case wst_zamsat:
+        case wst_ojd:
+        case wst_softfold:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 void initializeWaveshaperRegister (int /*type*/, float R[n_waveshaper_registers])
 {
     for (int i = 0; i < n_waveshaper_registers; ++i)
@@ -101,6 +101,13 @@ struct QuadFilterWaveshaperState
 typedef Vec4 (*WaveshaperQFPtr) (QuadFilterWaveshaperState* __restrict, Vec4 in, Vec4 drive);
 WaveshaperQFPtr GetQFPtrWaveshaper (int type);
 
+/*
+ * Returns true if the waveshaper doesn't use the waveshaper state
+ * (i.e. no DC blocker or anti-derivative anti-aliasing), meaning that
+ * the SIMD lanes can be filled with consecutive samples from the same channel.
+ */
+bool IsStatelessWaveshaper (int type);
+
 /*
  * Given the very first sample inbound to a new voice session, return the
  * first set of registers for that voice.
@@ -63,9 +63,13 @@ void Waveshaper::processAudio (AudioBuffer<float>& buffer)
 
     auto wsptr = GetQFPtrWaveshaper (lastShape);
 
-    if (wsptr)
+    if (wsptr && IsStatelessWaveshaper (lastShape))
     {
-        float din alignas (16)[4] = { 0, 0, 0, 0 };
+        processStatelessBlock (buffer, wsptr);
+    }
+    else if (wsptr)
+    {
+        alignas (Vec4::arch_type::alignment()) float din[Vec4::size] {};
         if (numChannels == 1)
         {
             auto* data = buffer.getWritePointer (0);
@@ -78,7 +82,7 @@ void Waveshaper::processAudio (AudioBuffer<float>& buffer)
 
                 dat = wsptr (&wss, dat, drv);
 
-                float res alignas (16)[4];
+                alignas (Vec4::arch_type::alignment()) float res[Vec4::size];
                 dat.store_aligned (res);
 
                 data[i] = res[0];
@@ -98,7 +102,7 @@ void Waveshaper::processAudio (AudioBuffer<float>& buffer)
 
                 dat = wsptr (&wss, dat, drv);
 
-                float res alignas (16)[4];
+                alignas (Vec4::arch_type::alignment()) float res[Vec4::size];
                 dat.store_aligned (res);
 
                 left[i] = res[0];
@@ -108,6 +112,58 @@ void Waveshaper::processAudio (AudioBuffer<float>& buffer)
     }
 }
 
+void Waveshaper::processStatelessBlock (AudioBuffer<float>& buffer, WaveshaperQFPtr wsptr)
+{
+    // Stateless waveshapers don't care which lane holds which sample, so we can
+    // fill every SIMD lane with consecutive samples from the same channel.
+    constexpr int chunkSize = 256;
+    constexpr auto vecSize = (int) Vec4::size;
+    alignas (Vec4::arch_type::alignment()) float driveData[chunkSize];
+
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += chunkSize)
+    {
+        const auto chunkNumSamples = jmin (chunkSize, numSamples - chunkStart);
+
+        const auto isSmoothing = driveSmooth.isSmoothing();
+        if (isSmoothing)
+        {
+            for (int n = 0; n < chunkNumSamples; ++n)
+                driveData[n] = driveSmooth.getNextValue();
+        }
+        else
+        {
+            std::fill (driveData, driveData + chunkNumSamples, driveSmooth.getNextValue());
+        }
+
+        const auto numVecSamples = chunkNumSamples - chunkNumSamples % vecSize;
+        const auto numLeftoverSamples = chunkNumSamples - numVecSamples;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch) + chunkStart;
+            for (int n = 0; n < numVecSamples; n += vecSize)
+            {
+                auto dat = wsptr (&wss, xsimd::load_unaligned (data + n), xsimd::load_aligned (driveData + n));
+                dat.store_unaligned (data + n);
+            }
+
+            if (numLeftoverSamples > 0)
+            {
+                alignas (Vec4::arch_type::alignment()) float din[Vec4::size] {};
+                alignas (Vec4::arch_type::alignment()) float drv[Vec4::size];
+                std::copy (data + numVecSamples, data + chunkNumSamples, din);
+                std::copy (driveData + numVecSamples, driveData + chunkNumSamples, drv);
+                std::fill (drv + numLeftoverSamples, drv + vecSize, driveData[chunkNumSamples - 1]);
+
+                auto dat = wsptr (&wss, xsimd::load_aligned (din), xsimd::load_aligned (drv));
+                dat.store_aligned (din);
+                std::copy (din, din + numLeftoverSamples, data + numVecSamples);
+            }
+        }
+    }
+}
+
 bool Waveshaper::getCustomComponents (OwnedArray<Component>& customComps, chowdsp::HostContextProvider& hcp)
 {
     struct CustomBoxAttach : private ComboBox::Listener
@@ -17,6 +17,8 @@ public:
     bool getCustomComponents (OwnedArray<Component>& customComps, chowdsp::HostContextProvider& hcp) override;
 
 private:
+    void processStatelessBlock (AudioBuffer<float>& buffer, SurgeWaveshapers::WaveshaperQFPtr wsptr);
+
     chowdsp::FloatParameter* driveParam = nullptr;
     std::atomic<float>* shapeParam = nullptr;
 
@@ -24,11 +24,8 @@ ParamLayout ZenDrive::createParameterLayout()
 
 void ZenDrive::prepare (double sampleRate, int samplesPerBlock)
 {
-    for (auto& wdfProc : wdf)
-    {
-        wdfProc.prepare (sampleRate);
-        wdfProc.setParameters (1.0f - *voiceParam, ParameterHelpers::logPot (*gainParam));
-    }
+    wdf.prepare (sampleRate);
+    wdf.setParameters (1.0f - *voiceParam, ParameterHelpers::logPot (*gainParam));
 
     dcBlocker.prepare (sampleRate, samplesPerBlock);
 
@@ -45,11 +42,8 @@ void ZenDrive::processAudio (AudioBuffer<float>& buffer)
 {
     buffer.applyGain (0.5f);
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        wdf[ch].setParameters (1.0f - *voiceParam, ParameterHelpers::logPot (*gainParam));
-        wdf[ch].process (buffer.getWritePointer (ch), buffer.getNumSamples());
-    }
+    wdf.setParameters (1.0f - *voiceParam, ParameterHelpers::logPot (*gainParam));
+    wdf.process (buffer);
 
     dcBlocker.processAudio (buffer);
 
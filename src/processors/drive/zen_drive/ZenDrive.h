@@ -19,7 +19,7 @@ private:
     chowdsp::FloatParameter* voiceParam = nullptr;
     chowdsp::FloatParameter* gainParam = nullptr;
 
-    ZenDriveWDF wdf[2];
+    ZenDriveWDF<ChannelBatch::Vec> wdf; // processes all channels at once
     DCBlocker dcBlocker;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZenDrive)
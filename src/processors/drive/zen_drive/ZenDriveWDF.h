@@ -1,7 +1,8 @@
 #pragma once
 
-#include <pch.h>
+#include "processors/utility/ChannelBatch.h"
 
+template <typename T>
 class ZenDriveWDF
 {
 public:
@@ -37,59 +38,58 @@ public:
         }
     }
 
-    inline float processSample (float x) noexcept
+    inline T processSample (T x) noexcept
     {
         Vin.setVoltage (x);
 
         diodes.incident (P3.reflected());
         P3.incident (diodes.reflected());
 
-        return wdft::voltage<float> (RL);
+        return wdft::voltage<T> (RL);
     }
 
-    void process (float* buffer, const int numSamples)
+    void process (AudioBuffer<float>& buffer) noexcept
     {
         if (voiceSmooth.isSmoothing() || gainSmooth.isSmoothing())
         {
-            for (int n = 0; n < numSamples; ++n)
-            {
-                R5_R6.setResistanceValue (R5 + voiceSmooth.getNextValue() * R6);
-                Rv9.setResistanceValue (R9 * gainSmooth.getNextValue());
-
-                buffer[n] = processSample (buffer[n]);
-            }
+            ChannelBatch::process<T> (buffer,
+                                      [this] (T x)
+                                      {
+                                          R5_R6.setResistanceValue (R5 + voiceSmooth.getNextValue() * R6);
+                                          Rv9.setResistanceValue (R9 * gainSmooth.getNextValue());
+                                          return processSample (x);
+                                      });
             return;
         }
 
         R5_R6.setResistanceValue (R5 + voiceSmooth.getNextValue() * R6);
         Rv9.setResistanceValue (R9 * gainSmooth.getNextValue());
-        for (int n = 0; n < numSamples; ++n)
-            buffer[n] = processSample (buffer[n]);
+        ChannelBatch::process<T> (buffer, [this] (T x) { return processSample (x); });
     }
 
 private:
     // Port B
-    wdft::ResistiveVoltageSourceT<float> Vin;
-    wdft::CapacitorT<float> C3 { 47.0e-9f };
-    wdft::WDFSeriesT<float, decltype (Vin), decltype (C3)> S1 { Vin, C3 };
+    wdft::ResistiveVoltageSourceT<T> Vin;
+    wdft::CapacitorT<T> C3 { 47.0e-9f };
+    wdft::WDFSeriesT<T, decltype (Vin), decltype (C3)> S1 { Vin, C3 };
 
-    wdft::ResistiveVoltageSourceT<float> R4 { 470.0e3f };
-    wdft::WDFParallelT<float, decltype (S1), decltype (R4)> P1 { S1, R4 };
+    wdft::ResistiveVoltageSourceT<T> R4 { 470.0e3f };
+    wdft::WDFParallelT<T, decltype (S1), decltype (R4)> P1 { S1, R4 };
 
     // Port C
     static constexpr auto R5 = 1.0e3f;
     static constexpr auto R6 = 10.0e3f;
-    wdft::ResistorT<float> R5_R6 { R5 + R6 };
-    wdft::CapacitorT<float> C5 { 100.0e-9f };
-    wdft::WDFSeriesT<float, decltype (R5_R6), decltype (C5)> S2 { R5_R6, C5 };
+    wdft::ResistorT<T> R5_R6 { R5 + R6 };
+    wdft::CapacitorT<T> C5 { 100.0e-9f };
+    wdft::WDFSeriesT<T, decltype (R5_R6), decltype (C5)> S2 { R5_R6, C5 };
 
     // Port D
-    wdft::ResistorT<float> RL { 1.0e6f };
+    wdft::ResistorT<T> RL { 1.0e6f };
 
     struct ImpedanceCalc
     {
         template <typename RType>
-        static float calcImpedance (RType& R)
+        static T calcImpedance (RType& R)
         {
             constexpr float Ag = 100.0f; // op-amp gain
             constexpr float Ri = 1.0e9f; // op-amp input impedance
@@ -109,16 +109,16 @@ private:
         }
     };
 
-    wdft::RtypeAdaptor<float, 0, ImpedanceCalc, decltype (P1), decltype (S2), decltype (RL)> R { P1, S2, RL };
+    wdft::RtypeAdaptor<T, 0, ImpedanceCalc, decltype (P1), decltype (S2), decltype (RL)> R { P1, S2, RL };
 
     // Port A
     static constexpr auto R9 = 500.0e3f;
-    wdft::ResistorT<float> Rv9 { R9 };
-    wdft::CapacitorT<float> C4 { 100.0e-12f };
-    wdft::WDFParallelT<float, decltype (Rv9), decltype (C4)> P2 { Rv9, C4 };
-    wdft::WDFParallelT<float, decltype (P2), decltype (R)> P3 { P2, R };
+    wdft::ResistorT<T> Rv9 { R9 };
+    wdft::CapacitorT<T> C4 { 100.0e-12f };
+    wdft::WDFParallelT<T, decltype (Rv9), decltype (C4)> P2 { Rv9, C4 };
+    wdft::WDFParallelT<T, decltype (P2), decltype (R)> P3 { P2, R };
 
-    wdft::DiodePairT<float, decltype (P1)> diodes { P1, 5.241435962608312e-10f, 0.07877217375325735f };
+    wdft::DiodePairT<T, decltype (P1)> diodes { P1, 5.241435962608312e-10f, 0.07877217375325735f };
 
     SmoothedValue<float, ValueSmoothingTypes::Linear> voiceSmooth;
     SmoothedValue<float, ValueSmoothingTypes::Linear> gainSmooth;
@@ -108,7 +108,7 @@ void Chorus::prepare (double sampleRate, int samplesPerBlock)
 void Chorus::processModulation (int numSamples)
 {
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput))
+    if (isInputConnected (ModulationInput))
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -231,7 +231,7 @@ void Chorus::processAudio (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
     processModulation (numSamples);
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numInChannels = audioInBuffer.getNumChannels();
@@ -297,7 +297,7 @@ void Chorus::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -308,7 +308,7 @@ void Chorus::processAudioBypassed (AudioBuffer<float>& buffer)
         modOutBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
@@ -108,7 +108,7 @@ void Flanger::prepare (double sampleRate, int samplesPerBlock)
 void Flanger::processModulation (int numSamples)
 {
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput))
+    if (isInputConnected (ModulationInput))
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -205,7 +205,7 @@ void Flanger::processAudio (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
     processModulation (numSamples);
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numInChannels = audioInBuffer.getNumChannels();
@@ -271,7 +271,7 @@ void Flanger::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -282,7 +282,7 @@ void Flanger::processAudioBypassed (AudioBuffer<float>& buffer)
         modOutBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
@@ -108,7 +108,7 @@ void Panner::generateModulationSignal (int numSamples)
     auto&& modBlock = dsp::AudioBlock<float> { modulationBuffer };
     auto&& modContext = dsp::ProcessContextReplacing<float> { modBlock };
 
-    if (inputsConnected.contains (ModulationInput))
+    if (isInputConnected (ModulationInput))
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -136,7 +136,7 @@ void Panner::processAudio (AudioBuffer<float>& buffer)
     stereoBuffer.setSize (2, numSamples, false, false, true);
     stereoBuffer.clear();
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& inputBuffer = getInputBuffer (AudioInput);
         const auto numChannels = inputBuffer.getNumChannels();
@@ -212,7 +212,7 @@ void Panner::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modulationBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -224,7 +224,7 @@ void Panner::processAudioBypassed (AudioBuffer<float>& buffer)
     }
 
     stereoBuffer.setSize (2, numSamples, false, false, true);
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
@@ -93,7 +93,7 @@ void Rotary::processModulation (int numSamples)
     modulationBuffer.setSize (1, numSamples, false, false, true);
     modulationBuffer.clear();
 
-    if (inputsConnected.contains (ModulationInput))
+    if (isInputConnected (ModulationInput))
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -164,7 +164,7 @@ void Rotary::processAudio (AudioBuffer<float>& buffer)
     spectralDepthSmoothed.process (numSamples);
     chorusDepthSmoothed.process (numSamples);
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto stereoMode = stereoParam->get();
         const auto& audioInBuffer = getInputBuffer (AudioInput);
@@ -210,7 +210,7 @@ void Rotary::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modulationBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -221,7 +221,7 @@ void Rotary::processAudioBypassed (AudioBuffer<float>& buffer)
         modulationBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
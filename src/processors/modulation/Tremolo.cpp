@@ -140,7 +140,7 @@ void Tremolo::processAudio (AudioBuffer<float>& buffer)
     phaseSmooth.setTargetValue (*rateParam * MathConstants<float>::pi / fs);
     waveSmooth.setTargetValue (*waveParam);
 
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -156,7 +156,7 @@ void Tremolo::processAudio (AudioBuffer<float>& buffer)
         filter.process (dsp::ProcessContextReplacing<float> { modBlock });
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto stereoMode = stereoParam->get();
         const auto& audioInBuffer = getInputBuffer (AudioInput);
@@ -216,7 +216,7 @@ void Tremolo::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
     modOutBuffer.setSize (1, numSamples, false, false, true);
 
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -227,7 +227,7 @@ void Tremolo::processAudioBypassed (AudioBuffer<float>& buffer)
         modOutBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
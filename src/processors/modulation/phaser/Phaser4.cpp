@@ -30,13 +30,19 @@ Phaser4::Phaser4 (UndoManager* um) : BaseProcessor ("Phaser4",
     feedbackParam.mappingFunction = [] (float x)
     { return 0.95f * x; };
 
-    lfoShaper.initialise ([] (float x)
-                          {
-                              static constexpr auto skewFactor = gcem::pow (2.0f, -0.5f);
-                              return 2.0f * std::pow ((x + 1.0f) * 0.5f, skewFactor) - 1.0f; },
-                          -1.0f,
-                          1.0f,
-                          2048);
+    const auto createLFOShaper = []
+    {
+        auto table = std::make_unique<chowdsp::LookupTableTransform<float>>();
+        table->initialise ([] (float x)
+                           {
+                               static constexpr auto skewFactor = gcem::pow (2.0f, -0.5f);
+                               return 2.0f * std::pow ((x + 1.0f) * 0.5f, skewFactor) - 1.0f; },
+                           -1.0f,
+                           1.0f,
+                           2048);
+        return table;
+    };
+    lfoShaper = getSharedAssetCache().getOrCreate<chowdsp::LookupTableTransform<float>> ("phaser4_lfo_shaper", createLFOShaper);
 
     addPopupMenuParameter (stereoTag);
     routeExternalModulation ({ ModulationInput }, { ModulationOutput });
@@ -90,7 +96,7 @@ void Phaser4::prepare (double sampleRate, int samplesPerBlock)
 void Phaser4::processModulation (int numSamples)
 {
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput))
+    if (isInputConnected (ModulationInput))
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -102,9 +108,9 @@ void Phaser4::processModulation (int numSamples)
         modOutBuffer.clear();
         triangleLfo.processBlock (modOutBuffer);
 
-        lfoShaper.process (modOutBuffer.getReadPointer (0),
-                           modOutBuffer.getWritePointer (0),
-                           numSamples);
+        lfoShaper->process (modOutBuffer.getReadPointer (0),
+                            modOutBuffer.getWritePointer (0),
+                            numSamples);
     }
 
     FloatVectorOperations::multiply (modData.data(),
@@ -122,7 +128,7 @@ void Phaser4::processAudio (AudioBuffer<float>& buffer)
     feedbackParam.process (numSamples);
     processModulation (numSamples);
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numInChannels = audioInBuffer.getNumChannels();
@@ -169,7 +175,7 @@ void Phaser4::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -180,7 +186,7 @@ void Phaser4::processAudioBypassed (AudioBuffer<float>& buffer)
         modOutBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
@@ -26,7 +26,7 @@ private:
 
     chowdsp::TriangleWave<float> triangleLfo;
     std::vector<float> modData {};
-    chowdsp::LookupTableTransform<float> lfoShaper;
+    std::shared_ptr<const chowdsp::LookupTableTransform<float>> lfoShaper;
 
     Phase90Filters::Phase90_FB4 fb4Filter[2];
     Phase90Filters::Phase90_FB3 fb3Filter[2];
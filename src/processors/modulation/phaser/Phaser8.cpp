@@ -32,13 +32,19 @@ Phaser8::Phaser8 (UndoManager* um) : BaseProcessor ("Phaser8",
     noModSmooth.mappingFunction = [] (float x)
     { return 1.0f - x; };
 
-    lfoShaper.initialise ([] (float x)
-                          {
-                              static constexpr auto skewFactor = gcem::pow (2.0f, -0.25f);
-                              return 2.0f * std::pow ((x + 1.0f) * 0.5f, skewFactor) - 1.0f; },
-                          -1.0f,
-                          1.0f,
-                          2048);
+    const auto createLFOShaper = []
+    {
+        auto table = std::make_unique<chowdsp::LookupTableTransform<float>>();
+        table->initialise ([] (float x)
+                           {
+                               static constexpr auto skewFactor = gcem::pow (2.0f, -0.25f);
+                               return 2.0f * std::pow ((x + 1.0f) * 0.5f, skewFactor) - 1.0f; },
+                           -1.0f,
+                           1.0f,
+                           2048);
+        return table;
+    };
+    lfoShaper = getSharedAssetCache().getOrCreate<chowdsp::LookupTableTransform<float>> ("phaser8_lfo_shaper", createLFOShaper);
 
     routeExternalModulation ({ ModulationInput }, { ModulationOutput });
     disableWhenInputConnected ({ rateTag }, ModulationInput);
@@ -88,7 +94,7 @@ void Phaser8::prepare (double sampleRate, int samplesPerBlock)
 void Phaser8::processModulation (int numSamples)
 {
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput))
+    if (isInputConnected (ModulationInput))
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -100,9 +106,9 @@ void Phaser8::processModulation (int numSamples)
         modOutBuffer.clear();
         sineLFO.processBlock (modOutBuffer);
 
-        lfoShaper.process (modOutBuffer.getReadPointer (0),
-                           modOutBuffer.getWritePointer (0),
-                           numSamples);
+        lfoShaper->process (modOutBuffer.getReadPointer (0),
+                            modOutBuffer.getWritePointer (0),
+                            numSamples);
     }
 
     FloatVectorOperations::multiply (modData.data(),
@@ -122,7 +128,7 @@ void Phaser8::processAudio (AudioBuffer<float>& buffer)
     noModSmooth.process (numSamples);
     processModulation (numSamples);
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         modulatedOutBuffer.setSize (1, numSamples, false, false, true);
@@ -161,7 +167,7 @@ void Phaser8::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -172,7 +178,7 @@ void Phaser8::processAudioBypassed (AudioBuffer<float>& buffer)
         modOutBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
 
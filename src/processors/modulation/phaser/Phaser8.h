@@ -32,7 +32,7 @@ private:
 
     chowdsp::SineWave<float> sineLFO;
     std::vector<float> modData {};
-    chowdsp::LookupTableTransform<float> lfoShaper;
+    std::shared_ptr<const chowdsp::LookupTableTransform<float>> lfoShaper;
 
     enum InputPort
     {
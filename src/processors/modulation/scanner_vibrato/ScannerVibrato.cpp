@@ -21,6 +21,35 @@ float ramp_down (float x, int off)
     const auto y = 1.0f - 16.0f * (x - (float) off * o16);
     return (y > 1.0f || y < 0.0f) ? 0.0f : y;
 }
+
+std::unique_ptr<ScannerVibrato::TapMixTables> createTapMixTables()
+{
+    auto tables = std::make_unique<ScannerVibrato::TapMixTables>();
+    const auto initTable = [&tables] (int index, auto&& func)
+    {
+        (*tables)[(size_t) index].initialise (func, 0.0f, 1.0f, 1024);
+    };
+    initTable (0, [] (float x)
+               { return ramp_up (x, 0) + ramp_down (x, 1); });
+    initTable (1, [] (float x)
+               { return ramp_up (x, 1) + ramp_down (x, 2) + ramp_up (x, 15) + ramp_down (x, 0); });
+    initTable (2, [] (float x)
+               { return ramp_up (x, 2) + ramp_down (x, 3) + ramp_up (x, 14) + ramp_down (x, 15); });
+    initTable (3, [] (float x)
+               { return ramp_up (x, 3) + ramp_down (x, 4) + ramp_up (x, 13) + ramp_down (x, 14); });
+    initTable (4, [] (float x)
+               { return ramp_up (x, 4) + ramp_down (x, 5) + ramp_up (x, 12) + ramp_down (x, 13); });
+    initTable (5, [] (float x)
+               { return ramp_up (x, 5) + ramp_down (x, 6) + ramp_up (x, 11) + ramp_down (x, 12); });
+    initTable (6, [] (float x)
+               { return ramp_up (x, 6) + ramp_down (x, 7) + ramp_up (x, 10) + ramp_down (x, 11); });
+    initTable (7, [] (float x)
+               { return ramp_up (x, 7) + ramp_down (x, 8) + ramp_up (x, 9) + ramp_down (x, 10); });
+    initTable (8, [] (float x)
+               { return ramp_up (x, 8) + ramp_down (x, 9); });
+
+    return tables;
+}
 } // namespace
 
 ScannerVibrato::ScannerVibrato (UndoManager* um) : BaseProcessor ("Scanner Vibrato",
@@ -44,28 +73,7 @@ ScannerVibrato::ScannerVibrato (UndoManager* um) : BaseProcessor ("Scanner Vibra
         return 0.5f * x;
     };
 
-    const auto initTable = [this] (int index, auto&& func)
-    {
-        tapMixTable[index].initialise (func, 0.0f, 1.0f, 1024);
-    };
-    initTable (0, [] (float x)
-               { return ramp_up (x, 0) + ramp_down (x, 1); });
-    initTable (1, [] (float x)
-               { return ramp_up (x, 1) + ramp_down (x, 2) + ramp_up (x, 15) + ramp_down (x, 0); });
-    initTable (2, [] (float x)
-               { return ramp_up (x, 2) + ramp_down (x, 3) + ramp_up (x, 14) + ramp_down (x, 15); });
-    initTable (3, [] (float x)
-               { return ramp_up (x, 3) + ramp_down (x, 4) + ramp_up (x, 13) + ramp_down (x, 14); });
-    initTable (4, [] (float x)
-               { return ramp_up (x, 4) + ramp_down (x, 5) + ramp_up (x, 12) + ramp_down (x, 13); });
-    initTable (5, [] (float x)
-               { return ramp_up (x, 5) + ramp_down (x, 6) + ramp_up (x, 11) + ramp_down (x, 12); });
-    initTable (6, [] (float x)
-               { return ramp_up (x, 6) + ramp_down (x, 7) + ramp_up (x, 10) + ramp_down (x, 11); });
-    initTable (7, [] (float x)
-               { return ramp_up (x, 7) + ramp_down (x, 8) + ramp_up (x, 9) + ramp_down (x, 10); });
-    initTable (8, [] (float x)
-               { return ramp_up (x, 8) + ramp_down (x, 9); });
+    tapMixTable = getSharedAssetCache().getOrCreate<TapMixTables> ("scanner_vibrato_tap_mix", createTapMixTables);
 
     uiOptions.backgroundColour = Colour { 0xff95756d };
     uiOptions.powerColour = Colour { 0xffe5e3dc };
@@ -122,7 +130,7 @@ void ScannerVibrato::processAudio (AudioBuffer<float>& buffer)
     depthParam.process (numSamples);
 
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -135,7 +143,7 @@ void ScannerVibrato::processAudio (AudioBuffer<float>& buffer)
         modSource.processBlock (modOutBuffer);
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto stereoMode = stereoParam->get();
 
@@ -147,7 +155,7 @@ void ScannerVibrato::processAudio (AudioBuffer<float>& buffer)
         // generate mod mix arrays
         auto** modMixData = modsMixBuffer.getArrayOfWritePointers();
         for (int i = 0; i < ScannerVibratoWDF::numTaps; ++i)
-            tapMixTable[i].process (modData01, modMixData[i], numSamples);
+            (*tapMixTable)[(size_t) i].process (modData01, modMixData[i], numSamples);
 
         // handle input num channels
         const auto& audioInBuffer = getInputBuffer (AudioInput);
@@ -199,7 +207,7 @@ void ScannerVibrato::processAudio (AudioBuffer<float>& buffer)
 
                 // recompute mod mix data
                 for (int i = 0; i < ScannerVibratoWDF::numTaps; ++i)
-                    tapMixTable[i].process (modData01, modMixData[i], numSamples);
+                    (*tapMixTable)[(size_t) i].process (modData01, modMixData[i], numSamples);
             }
 
             for (int i = ScannerVibratoWDF::numTaps - 1; i >= 0; --i)
@@ -224,7 +232,7 @@ void ScannerVibrato::processAudioBypassed (AudioBuffer<float>& buffer)
     const auto numSamples = buffer.getNumSamples();
 
     modOutBuffer.setSize (1, numSamples, false, false, true);
-    if (inputsConnected.contains (ModulationInput)) // make mono and pass samples through
+    if (isInputConnected (ModulationInput)) // make mono and pass samples through
     {
         // get modulation buffer from input (-1, 1)
         const auto& modInputBuffer = getInputBuffer (ModulationInput);
@@ -235,7 +243,7 @@ void ScannerVibrato::processAudioBypassed (AudioBuffer<float>& buffer)
         modOutBuffer.clear();
     }
 
-    if (inputsConnected.contains (AudioInput))
+    if (isInputConnected (AudioInput))
     {
         const auto& audioInBuffer = getInputBuffer (AudioInput);
         const auto numChannels = audioInBuffer.getNumChannels();
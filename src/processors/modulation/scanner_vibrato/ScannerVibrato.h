@@ -15,6 +15,9 @@ public:
     void processAudio (AudioBuffer<float>& buffer) override;
     void processAudioBypassed (AudioBuffer<float>& buffer) override;
 
+    /** Lookup tables for the mix of each tap, which are shared between all instances of the processor. */
+    using TapMixTables = std::array<chowdsp::LookupTableTransform<float>, (size_t) ScannerVibratoWDF::numTaps>;
+
 private:
     chowdsp::FloatParameter* rateHzParam = nullptr;
     chowdsp::SmoothedBufferValue<float> depthParam;
@@ -30,7 +33,7 @@ private:
     chowdsp::Buffer<float> modsMixBuffer;
     chowdsp::Buffer<float> tapsOutBuffer[2];
 
-    chowdsp::LookupTableTransform<float> tapMixTable[ScannerVibratoWDF::numTaps];
+    std::shared_ptr<const TapMixTables> tapMixTable;
 
     AudioBuffer<float> modOutBuffer;
     AudioBuffer<float> audioOutBuffer;
@@ -69,6 +69,14 @@ void DelayModule::prepare (double sampleRate, int samplesPerBlock)
     bypassNeedsReset = false;
 }
 
+size_t DelayModule::getMemoryFootprint() const
+{
+    // the clean delay line is much bigger than anything else in here, and keeps two copies of each sample
+    constexpr auto delayLineBytes = 2 * 2 * (size_t) CleanDelayType::maxDelaySamples * sizeof (float);
+    const auto stereoBufferBytes = (size_t) stereoBuffer.getNumChannels() * (size_t) stereoBuffer.getNumSamples() * sizeof (float);
+    return BaseProcessor::getMemoryFootprint() + delayLineBytes + stereoBufferBytes;
+}
+
 template <typename DelayType>
 void DelayModule::processMonoStereoDelay (AudioBuffer<float>& buffer, DelayType& delayLine)
 {
@@ -14,6 +14,8 @@ public:
     void processAudio (AudioBuffer<float>& buffer) override;
     void processAudioBypassed (AudioBuffer<float>& buffer) override;
 
+    size_t getMemoryFootprint() const override;
+
 private:
     template <typename DelayType>
     void processMonoStereoDelay (AudioBuffer<float>& buffer, DelayType& delayLine);
@@ -51,7 +53,8 @@ private:
         inline float popSample (int channel) { return lpf.processSample (channel, delay.popSample (channel)); }
 
         chowdsp::SVFLowpass<float> lpf;
-        chowdsp::DelayLine<float, chowdsp::DelayLineInterpolationTypes::Lagrange5th> delay { 1 << 20 };
+        static constexpr int maxDelaySamples = 1 << 20;
+        chowdsp::DelayLine<float, chowdsp::DelayLineInterpolationTypes::Lagrange5th> delay { maxDelaySamples };
     };
     CleanDelayType cleanDelayLine;
 
@@ -118,6 +118,13 @@ void ShimmerReverb::prepare (double sampleRate, int samplesPerBlock)
     }
 }
 
+size_t ShimmerReverb::getMemoryFootprint() const
+{
+    // each FDN has a pitch shifter, with a (mono) delay buffer that keeps two copies of each sample
+    constexpr auto shifterBytes = 2 * 2 * ((size_t) 1 << 15) * sizeof (float);
+    return BaseProcessor::getMemoryFootprint() + sizeof (fdn) + shifterBytes;
+}
+
 void ShimmerReverb::processAudio (AudioBuffer<float>& buffer)
 {
     const auto numChannels = buffer.getNumChannels();
@@ -12,6 +12,7 @@ public:
 
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
 private:
     chowdsp::SmoothedBufferValue<float> shiftParam;
@@ -80,6 +80,14 @@ void SmoothReverb::prepare (double sampleRate, int samplesPerBlock)
     outBuffer.setSize (2, samplesPerBlock);
 }
 
+size_t SmoothReverb::getMemoryFootprint() const
+{
+    // the (stereo) pre-delay lines are much longer than the diffuser and FDN delays, and keep two copies of each sample
+    constexpr auto preDelayBytes = 2 * 2 * 2 * ((size_t) 1 << 18) * sizeof (float);
+    const auto outBufferBytes = (size_t) outBuffer.getNumChannels() * (size_t) outBuffer.getNumSamples() * sizeof (float);
+    return BaseProcessor::getMemoryFootprint() + preDelayBytes + outBufferBytes;
+}
+
 void SmoothReverb::processReverb (float* left, float* right, int numSamples)
 {
     float curLevel = 0.0f;
@@ -13,6 +13,7 @@ public:
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
     void processAudioBypassed (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
 private:
     void processReverb (float* left, float* right, int numSamples);
@@ -99,6 +99,21 @@ void SpringReverb::setParams (const Params& params)
     reflectionNetwork.setParams (params.size, t60Seconds, reflSkew, params.damping);
 }
 
+size_t SpringReverb::getMemoryFootprint() const noexcept
+{
+    // The delay lines are allocated for their maximum length, and keep two copies of each sample.
+    // There's the (stereo) spring delay, four more for the early reflections, and two SIMD delays
+    // (one of them nested) in each of the allpass stages.
+    constexpr auto delayLineBytes = 2 * ((size_t) 1 << 18) * sizeof (float);
+    constexpr auto stereoDelayBytes = (1 + 4) * 2 * delayLineBytes;
+    constexpr auto allpassDelayBytes = allpassStages * 2 * delayLineBytes * Vec::size;
+
+    const auto bufferBytes = [] (const AudioBuffer<float>& buffer)
+    { return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (float); };
+
+    return stereoDelayBytes + allpassDelayBytes + bufferBytes (downsampledBuffer) + bufferBytes (shakeBuffer) + bufferBytes (shortShakeBuffer);
+}
+
 void SpringReverb::processRebufferedBlock (const chowdsp::BufferView<float>& buffer)
 {
     const auto numSamples = buffer.getNumSamples();
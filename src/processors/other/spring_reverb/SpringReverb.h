@@ -24,6 +24,9 @@ public:
     int prepareRebuffering (const dsp::ProcessSpec& spec) override;
     void processRebufferedBlock (const chowdsp::BufferView<float>& buffer) override;
 
+    /** Returns the memory used by the reverb's delay lines and buffers. */
+    size_t getMemoryFootprint() const noexcept;
+
 private:
     void processDownsampledBuffer (AudioBuffer<float>& buffer);
 
@@ -47,6 +47,12 @@ void SpringReverbProcessor::prepare (double sampleRate, int samplesPerBlock)
     wetGain.setRampDurationSeconds (0.1);
 }
 
+size_t SpringReverbProcessor::getMemoryFootprint() const
+{
+    const auto dryBufferBytes = (size_t) dryBuffer.getNumChannels() * (size_t) dryBuffer.getNumSamples() * sizeof (float);
+    return BaseProcessor::getMemoryFootprint() + reverb.getMemoryFootprint() + dryBufferBytes;
+}
+
 void SpringReverbProcessor::processAudio (AudioBuffer<float>& buffer)
 {
     if (numChannels != buffer.getNumChannels())
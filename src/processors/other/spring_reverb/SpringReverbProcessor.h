@@ -13,6 +13,7 @@ public:
 
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
 private:
     chowdsp::FloatParameter* sizeParam = nullptr;
@@ -1,6 +1,7 @@
 #include "AmpIRs.h"
 #include "../ParameterHelpers.h"
 #include "gui/utils/ErrorMessageView.h"
+#include "ir_utils/IROptimiser.h"
 
 namespace
 {
@@ -15,10 +16,20 @@ const StringArray irNames {
 const String irTag = "ir";
 const String mixTag = "mix";
 const String gainTag = "gain";
+const String optimiseTag = "optimise_ir";
+
+/** User IRs are cached on disk once they've been prepared, since they can't be re-loaded from the plugin binary. */
+File getIRCacheDirectory()
+{
+    return File::getSpecialLocation (File::userApplicationDataDirectory).getChildFile ("ChowdhuryDSP/BYOD/IRCache");
+}
 } // namespace
 
 AmpIRs::AmpIRs (UndoManager* um) : BaseProcessor ("Amp IRs", createParameterLayout(), um),
-                                   convolution (getSharedConvolutionMessageQueue())
+                                   convolution (getSharedConvolutionMessageQueue(),
+                                                getSharedWarmUpThread(),
+                                                [this] (double sampleRate)
+                                                { return prepareSelectedIR (sampleRate, true); })
 {
     for (const auto& irName : StringArray (irNames.begin(), irNames.size() - 1))
     {
@@ -26,15 +37,17 @@ AmpIRs::AmpIRs (UndoManager* um) : BaseProcessor ("Amp IRs", createParameterLayo
         int binarySize;
         auto* irData = BinaryData::getNamedResource (binaryName.getCharPointer(), binarySize);
 
-        irMap.insert (std::make_pair (irName, std::make_pair ((void*) irData, (size_t) binarySize)));
+        irMap.insert (std::make_pair (irName, getSharedAssetCache().getEmbeddedIR (irData, binarySize)));
     }
 
     using namespace ParameterHelpers;
     vts.addParameterListener (irTag, this);
+    vts.addParameterListener (optimiseTag, this);
     loadParameterPointer (mixParam, vts, mixTag);
     loadParameterPointer (gainParam, vts, gainTag);
+    loadParameterPointer (optimiseParam, vts, optimiseTag);
 
-    parameterChanged (irTag, vts.getRawParameterValue (irTag)->load());
+    addPopupMenuParameter (optimiseTag);
 
     uiOptions.backgroundColour = Colours::darkcyan.brighter (0.1f);
     uiOptions.powerColour = Colours::red.brighter (0.0f);
@@ -45,6 +58,7 @@ AmpIRs::AmpIRs (UndoManager* um) : BaseProcessor ("Amp IRs", createParameterLayo
 AmpIRs::~AmpIRs()
 {
     vts.removeParameterListener (irTag, this);
+    vts.removeParameterListener (optimiseTag, this);
 }
 
 ParamLayout AmpIRs::createParameterLayout()
@@ -59,32 +73,89 @@ ParamLayout AmpIRs::createParameterLayout()
 
     createGainDBParameter (params, gainTag, "Gain", -18.0f, 18.0f, 0.0f);
     createPercentParameter (params, mixTag, "Mix", 1.0f);
+    emplace_param<chowdsp::BoolParameter> (params, optimiseTag, "Optimise IR", false);
 
     return { params.begin(), params.end() };
 }
 
-void AmpIRs::setMakeupGain (float irSampleRate)
+bool AmpIRs::isCustomIRSelected() const
 {
-    makeupGainDB.store (Decibels::gainToDecibels (std::sqrt (irSampleRate / fs)));
+    return (int) vts.getRawParameterValue (irTag)->load() >= irNames.size() - 1;
 }
 
-void AmpIRs::parameterChanged (const String& parameterID, float newValue)
+void AmpIRs::setMakeupGain (float irSampleRate, double sampleRate)
 {
-    if (parameterID != irTag)
-        return;
+    makeupGainDB.store (Decibels::gainToDecibels (std::sqrt (irSampleRate / (float) sampleRate)));
+}
 
-    auto irIdx = (int) newValue;
-    if (irIdx >= irNames.size() - 1)
-        return;
+void AmpIRs::parameterChanged (const String& parameterID, float)
+{
+    // this can be called from the audio thread, so the new IR is prepared on the warm-up thread
+    if (parameterID == irTag || parameterID == optimiseTag)
+        convolution.requestImpulseResponse();
+}
 
-    const auto& irName = irNames[irIdx];
-    auto& irData = irMap[irName];
-    curFile = File();
+std::shared_ptr<const SharedAssetCache::DecodedIR> AmpIRs::prepareSelectedIR (double sampleRate, bool canOptimise)
+{
+    const auto isUserIR = isCustomIRSelected();
+    const auto sourceIR = [this, isUserIR]
+    {
+        if (! isUserIR)
+            return irMap.at (irNames[(int) vts.getRawParameterValue (irTag)->load()]);
+
+        ScopedLock sl (irMutex);
+        return userIR;
+    }();
+
+    if (sourceIR == nullptr)
+        return nullptr;
+
+    // the IR is prepared without holding irMutex, so that the message thread never has to wait for it
+    auto preparedIR = getPreparedIR (sourceIR, isUserIR, sampleRate, canOptimise);
+    setMakeupGain (isUserIR ? (float) sourceIR->sampleRate : 96000.0f, sampleRate);
+    return preparedIR;
+}
+
+std::shared_ptr<const SharedAssetCache::DecodedIR> AmpIRs::getPreparedIR (const std::shared_ptr<const SharedAssetCache::DecodedIR>& sourceIR, bool isUserIR, double sampleRate, bool canOptimise)
+{
+    const auto diskCacheDirectory = isUserIR ? getIRCacheDirectory() : File {};
+    if (! optimiseParam->get())
+        return getSharedAssetCache().getPreparedIR (sourceIR, sampleRate, diskCacheDirectory);
+
+    // until the optimised IR is ready, keep using the original IR
+    auto newOptimisedIR = getOptimisedIR (sourceIR, canOptimise);
+    {
+        ScopedLock sl (irMutex);
+        optimisedIR = newOptimisedIR;
+    }
 
-    setMakeupGain (96000.0f);
+    return getSharedAssetCache().getPreparedIR (newOptimisedIR != nullptr ? newOptimisedIR : sourceIR, sampleRate, diskCacheDirectory);
+}
 
-    ScopedLock sl (irMutex);
-    convolution.loadImpulseResponse (irData.first, irData.second, dsp::Convolution::Stereo::yes, dsp::Convolution::Trim::yes, 0);
+std::shared_ptr<const SharedAssetCache::DecodedIR> AmpIRs::getOptimisedIR (const std::shared_ptr<const SharedAssetCache::DecodedIR>& sourceIR, bool canOptimise)
+{
+    // the IR is optimised at its original sample rate, and then only needs to be resampled once
+    const IROptimiser::Settings optimiserSettings {};
+    const auto optimisedIRID = sourceIR->sourceID + "_" + IROptimiser::getSettingsID (optimiserSettings);
+    if (auto cachedIR = getSharedAssetCache().find<SharedAssetCache::DecodedIR> (optimisedIRID))
+        return cachedIR;
+
+    if (! canOptimise)
+        return {};
+
+    // optimising can take a while, so it's done without holding the cache lock
+    auto result = IROptimiser::optimise (sourceIR->buffer, sourceIR->sampleRate, optimiserSettings);
+    Logger::writeToLog ("AmpIRs optimised IR from " + String (result.originalLength) + " to " + String (result.optimisedLength)
+                        + " samples, with " + String (result.spectralErrorDB, 2) + " dB spectral error");
+
+    auto ir = std::make_unique<SharedAssetCache::DecodedIR>();
+    ir->buffer = std::move (result.ir);
+    ir->sampleRate = sourceIR->sampleRate;
+    ir->sourceID = optimisedIRID;
+
+    // if another instance got there first, use its IR instead
+    return getSharedAssetCache().getOrCreate<SharedAssetCache::DecodedIR> (optimisedIRID, [&ir]
+                                                                           { return std::move (ir); });
 }
 
 void AmpIRs::loadIRFromStream (std::unique_ptr<InputStream>&& stream, Component* associatedComp)
@@ -104,56 +175,51 @@ void AmpIRs::loadIRFromStream (std::unique_ptr<InputStream>&& stream, Component*
         return File {};
     }();
 
-    AudioFormatManager manager;
-    manager.registerBasicFormats();
-    std::unique_ptr<AudioFormatReader> formatReader (manager.createReaderFor (std::move (stream)));
-
-    if (formatReader == nullptr)
+    MemoryBlock fileData;
+    if (stream == nullptr || stream->readIntoMemoryBlock (fileData) == 0)
     {
-        failToLoad (file, "The following IR file was not valid: " + file.getFullPathName());
+        failToLoad (file, "Unable to read from IR file: " + file.getFullPathName());
         return;
     }
 
-    const auto fileLength = static_cast<size_t> (formatReader->lengthInSamples);
-    AudioBuffer<float> resultBuffer { jlimit (1, 2, static_cast<int> (formatReader->numChannels)), static_cast<int> (fileLength) };
-
-    if (! formatReader->read (resultBuffer.getArrayOfWritePointers(),
-                              resultBuffer.getNumChannels(),
-                              0,
-                              resultBuffer.getNumSamples()))
+    // if this IR has been loaded before (by any instance), it won't need to be decoded again
+    auto newIR = getSharedAssetCache().getIRFromFileData (fileData);
+    if (newIR == nullptr)
     {
-        failToLoad (file, "Unable to read from IR file: " + file.getFullPathName());
+        failToLoad (file, "The following IR file was not valid: " + file.getFullPathName());
         return;
     }
 
     irFiles.addIfNotAlreadyThere (file);
     curFile = file;
+    {
+        ScopedLock sl (irMutex);
+        userIR = std::move (newIR);
+    }
     irChangedBroadcaster();
     vts.getParameter (irTag)->setValueNotifyingHost (1.0f);
-
-    setMakeupGain ((float) formatReader->sampleRate);
-
-    ScopedLock sl (irMutex);
-    convolution.loadImpulseResponse (std::move (resultBuffer), formatReader->sampleRate, dsp::Convolution::Stereo::yes, dsp::Convolution::Trim::yes, dsp::Convolution::Normalise::yes);
+    convolution.requestImpulseResponse(); // in case the "Custom" IR was already selected
 }
 
 void AmpIRs::prepare (double sampleRate, int samplesPerBlock)
 {
-    fs = (float) sampleRate;
-
     dsp::ProcessSpec spec { sampleRate, (uint32) samplesPerBlock, 2 };
-    convolution.prepare (spec);
+    convolution.prepare (spec, prepareSelectedIR (sampleRate, false));
+
+    // the IR gets optimised on the warm-up thread, and then swapped in
+    if (optimiseParam->get())
+        convolution.requestImpulseResponse();
 
     gain.prepare (spec);
     gain.setRampDurationSeconds (0.01);
 
     dryWetMixer.prepare (spec);
     dryWetMixerMono.prepare ({ sampleRate, (uint32) samplesPerBlock, 1 });
+}
 
-    if (curFile == File {})
-        parameterChanged (irTag, vts.getRawParameterValue (irTag)->load());
-    else
-        loadIRFromStream (curFile.createInputStream());
+size_t AmpIRs::getMemoryFootprint() const
+{
+    return BaseProcessor::getMemoryFootprint() + convolution.getMemoryFootprint();
 }
 
 void AmpIRs::processAudio (AudioBuffer<float>& buffer)
@@ -168,7 +234,7 @@ void AmpIRs::processAudio (AudioBuffer<float>& buffer)
     gain.setGainDecibels (gainParam->getCurrentValue() + makeupGainDB.load());
 
     dryWet.pushDrySamples (block);
-    convolution.process (context);
+    convolution.process (block);
     gain.process (context);
     dryWet.mixWetSamples (block);
 }
@@ -176,7 +242,7 @@ void AmpIRs::processAudio (AudioBuffer<float>& buffer)
 std::unique_ptr<XmlElement> AmpIRs::toXML()
 {
     auto xml = BaseProcessor::toXML();
-    xml->setAttribute ("ir_file", curFile.getFullPathName());
+    xml->setAttribute ("ir_file", isCustomIRSelected() ? curFile.getFullPathName() : String {});
 
     return std::move (xml);
 }
@@ -186,10 +252,10 @@ void AmpIRs::fromXML (XmlElement* xml, const chowdsp::Version& version, bool loa
     BaseProcessor::fromXML (xml, version, loadPosition);
 
     auto irFile = File (xml->getStringAttribute ("ir_file"));
-    if (irFile.getFullPathName().isNotEmpty())
-        loadIRFromStream (irFile.createInputStream());
-    else
+    if (irFile.getFullPathName().isEmpty())
         curFile = File();
+    else if (irFile != curFile || userIR == nullptr) // no need to re-load the IR that's already loaded
+        loadIRFromStream (irFile.createInputStream());
 }
 
 //==========================================================================
@@ -289,7 +355,7 @@ bool AmpIRs::getCustomComponents (OwnedArray<Component>& customComps, chowdsp::H
                     PopupMenu::Item fileItem;
                     fileItem.text = file.getFileName();
                     fileItem.itemID = menuIdx++;
-                    fileItem.isTicked = file == ampIRs.curFile;
+                    fileItem.isTicked = ampIRs.isCustomIRSelected() && file == ampIRs.curFile;
                     fileItem.action = [this, file]
                     {
                         ampIRs.loadIRFromStream (file.createInputStream(), getParentComponent());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../BaseProcessor.h"
+#include "ir_utils/IRConvolution.h"
 
 class AmpIRs : public BaseProcessor, private AudioProcessorValueTreeState::Listener
 {
@@ -9,6 +10,7 @@ public:
     ~AmpIRs() override;
 
     ProcessorType getProcessorType() const override { return Tone; }
+    ProcessingRate getPreferredProcessingRate() const override { return { ProcessingRate::Type::BaseRate }; }
     static ParamLayout createParameterLayout();
 
     void parameterChanged (const String& parameterID, float newValue) final;
@@ -16,6 +18,7 @@ public:
 
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
     bool getCustomComponents (OwnedArray<Component>& customComps, chowdsp::HostContextProvider& hcp) override;
 
@@ -23,25 +26,31 @@ public:
     void fromXML (XmlElement* xml, const chowdsp::Version& version, bool loadPosition) override;
 
 private:
-    void setMakeupGain (float irSampleRate);
+    bool isCustomIRSelected() const;
+    void setMakeupGain (float irSampleRate, double sampleRate);
+    std::shared_ptr<const SharedAssetCache::DecodedIR> prepareSelectedIR (double sampleRate, bool canOptimise);
+    std::shared_ptr<const SharedAssetCache::DecodedIR> getPreparedIR (const std::shared_ptr<const SharedAssetCache::DecodedIR>& sourceIR, bool isUserIR, double sampleRate, bool canOptimise);
+    std::shared_ptr<const SharedAssetCache::DecodedIR> getOptimisedIR (const std::shared_ptr<const SharedAssetCache::DecodedIR>& sourceIR, bool canOptimise);
 
     chowdsp::FloatParameter* mixParam = nullptr;
     chowdsp::FloatParameter* gainParam = nullptr;
+    chowdsp::BoolParameter* optimiseParam = nullptr;
 
-    using IRType = std::pair<void*, size_t>;
-    std::unordered_map<String, IRType> irMap;
+    // the IRs are prepared on the warm-up thread, so these need to outlive the convolution
+    std::unordered_map<String, std::shared_ptr<const SharedAssetCache::DecodedIR>> irMap;
+    std::shared_ptr<const SharedAssetCache::DecodedIR> userIR; // the decoded contents of curFile
+    std::shared_ptr<const SharedAssetCache::DecodedIR> optimisedIR; // kept alive so the IR isn't re-optimised when the sample rate changes
+    CriticalSection irMutex; // guards userIR and optimisedIR
 
-    dsp::Convolution convolution { juce::dsp::Convolution::NonUniform { 256 } };
+    IRConvolution convolution;
     dsp::Gain<float> gain;
     std::atomic<float> makeupGainDB { 0.0f };
 
     dsp::DryWetMixer<float> dryWetMixer;
     dsp::DryWetMixer<float> dryWetMixerMono;
-    float fs = 48000.0f;
 
     Array<File> irFiles;
-    File curFile = File();
-    CriticalSection irMutex;
+    File curFile = File(); // the most recently loaded IR file, which is used while the "Custom" IR is selected
     chowdsp::Broadcaster<void()> irChangedBroadcaster;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AmpIRs)
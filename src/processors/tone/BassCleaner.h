@@ -8,6 +8,7 @@ public:
     explicit BassCleaner (UndoManager* um = nullptr);
 
     ProcessorType getProcessorType() const override { return Tone; }
+    ProcessingRate getPreferredProcessingRate() const override { return { ProcessingRate::Type::BaseRate }; }
     static ParamLayout createParameterLayout();
 
     void prepare (double sampleRate, int samplesPerBlock) override;
@@ -22,7 +22,10 @@ const String gainTag = "gain";
 } // namespace
 
 LofiIrs::LofiIrs (UndoManager* um) : BaseProcessor ("LoFi IRs", createParameterLayout(), um),
-                                     convolution (getSharedConvolutionMessageQueue())
+                                     convolution (getSharedConvolutionMessageQueue(),
+                                                  getSharedWarmUpThread(),
+                                                  [this] (double sampleRate)
+                                                  { return prepareSelectedIR (sampleRate); })
 {
     for (const auto& irName : irNames)
     {
@@ -30,7 +33,7 @@ LofiIrs::LofiIrs (UndoManager* um) : BaseProcessor ("LoFi IRs", createParameterL
         int binarySize;
         auto* irData = BinaryData::getNamedResource (binaryName.getCharPointer(), binarySize);
 
-        irMap.insert (std::make_pair (irName, std::make_pair ((void*) irData, (size_t) binarySize)));
+        irMap.insert (std::make_pair (irName, getSharedAssetCache().getEmbeddedIR (irData, binarySize)));
     }
 
     using namespace ParameterHelpers;
@@ -65,21 +68,23 @@ ParamLayout LofiIrs::createParameterLayout()
     return { params.begin(), params.end() };
 }
 
-void LofiIrs::parameterChanged (const String& parameterID, float newValue)
+void LofiIrs::parameterChanged (const String& parameterID, float)
 {
-    if (parameterID != irTag)
-        return;
+    // this can be called from the audio thread, so the new IR is prepared on the warm-up thread
+    if (parameterID == irTag)
+        convolution.requestImpulseResponse();
+}
 
-    auto irIdx = (int) newValue;
-    auto& irData = irMap[irNames[irIdx]];
-    convolution.loadImpulseResponse (irData.first, irData.second, dsp::Convolution::Stereo::yes, dsp::Convolution::Trim::yes, 0);
+std::shared_ptr<const SharedAssetCache::DecodedIR> LofiIrs::prepareSelectedIR (double sampleRate)
+{
+    const auto irIdx = (int) vts.getRawParameterValue (irTag)->load();
+    return getSharedAssetCache().getPreparedIR (irMap.at (irNames[irIdx]), sampleRate);
 }
 
 void LofiIrs::prepare (double sampleRate, int samplesPerBlock)
 {
     dsp::ProcessSpec spec { sampleRate, (uint32) samplesPerBlock, 2 };
-    convolution.prepare (spec);
-    parameterChanged (irTag, vts.getRawParameterValue (irTag)->load());
+    convolution.prepare (spec, prepareSelectedIR (sampleRate));
 
     gain.prepare (spec);
     gain.setRampDurationSeconds (0.01);
@@ -90,6 +95,11 @@ void LofiIrs::prepare (double sampleRate, int samplesPerBlock)
     makeupGainDB = Decibels::gainToDecibels (std::sqrt (96000.0f / (float) sampleRate));
 }
 
+size_t LofiIrs::getMemoryFootprint() const
+{
+    return BaseProcessor::getMemoryFootprint() + convolution.getMemoryFootprint();
+}
+
 void LofiIrs::processAudio (AudioBuffer<float>& buffer)
 {
     const auto numChannels = buffer.getNumChannels();
@@ -102,7 +112,7 @@ void LofiIrs::processAudio (AudioBuffer<float>& buffer)
     gain.setGainDecibels (gainParam->getCurrentValue() + makeupGainDB);
 
     dryWet.pushDrySamples (block);
-    convolution.process (context);
+    convolution.process (block);
     gain.process (context);
     dryWet.mixWetSamples (block);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../BaseProcessor.h"
+#include "ir_utils/IRConvolution.h"
 
 class LofiIrs : public BaseProcessor, private AudioProcessorValueTreeState::Listener
 {
@@ -9,21 +10,24 @@ public:
     ~LofiIrs() override;
 
     ProcessorType getProcessorType() const override { return Tone; }
+    ProcessingRate getPreferredProcessingRate() const override { return { ProcessingRate::Type::BaseRate }; }
     static ParamLayout createParameterLayout();
 
     void parameterChanged (const String& parameterID, float newValue) override;
 
     void prepare (double sampleRate, int samplesPerBlock) override;
     void processAudio (AudioBuffer<float>& buffer) override;
+    size_t getMemoryFootprint() const override;
 
 private:
+    std::shared_ptr<const SharedAssetCache::DecodedIR> prepareSelectedIR (double sampleRate);
+
     chowdsp::FloatParameter* mixParam = nullptr;
     chowdsp::FloatParameter* gainParam = nullptr;
 
-    using IRType = std::pair<void*, size_t>;
-    std::unordered_map<String, IRType> irMap;
+    std::unordered_map<String, std::shared_ptr<const SharedAssetCache::DecodedIR>> irMap; // needs to outlive the convolution, which prepares IRs on the warm-up thread
 
-    dsp::Convolution convolution;
+    IRConvolution convolution;
     dsp::Gain<float> gain;
 
     float makeupGainDB = 0.0f;
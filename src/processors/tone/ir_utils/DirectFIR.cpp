@@ -0,0 +1,84 @@
+#include "DirectFIR.h"
+
+namespace
+{
+using Vec = xsimd::batch<float>;
+
+float innerProduct (const float* alignedTaps, const float* history, int numPaddedTaps) noexcept
+{
+    // two accumulators, so that consecutive multiply-adds don't have to wait on each other
+    Vec acc0 (0.0f);
+    Vec acc1 (0.0f);
+
+    int k = 0;
+    for (; k + 2 * (int) Vec::size <= numPaddedTaps; k += 2 * (int) Vec::size)
+    {
+        acc0 = xsimd::fma (xsimd::load_aligned (alignedTaps + k), xsimd::load_unaligned (history + k), acc0);
+        acc1 = xsimd::fma (xsimd::load_aligned (alignedTaps + k + Vec::size), xsimd::load_unaligned (history + k + Vec::size), acc1);
+    }
+
+    for (; k < numPaddedTaps; k += (int) Vec::size)
+        acc0 = xsimd::fma (xsimd::load_aligned (alignedTaps + k), xsimd::load_unaligned (history + k), acc0);
+
+    return xsimd::reduce_add (acc0 + acc1);
+}
+} // namespace
+
+void DirectFIR::setImpulseResponse (const AudioBuffer<float>& ir)
+{
+    numTaps = ir.getNumSamples();
+    numPaddedTaps = (int) Vec::size * ((numTaps + (int) Vec::size - 1) / (int) Vec::size);
+    numIRChannels = jlimit (1, maxNumChannels, ir.getNumChannels());
+
+    for (int ch = 0; ch < maxNumChannels; ++ch)
+    {
+        taps[ch].assign ((size_t) numPaddedTaps, 0.0f);
+        if (ch < numIRChannels)
+        {
+            // the last tap lines up with the newest input sample
+            const auto* h = ir.getReadPointer (ch);
+            for (int k = 0; k < numTaps; ++k)
+                taps[ch][size_t (numPaddedTaps - 1 - k)] = h[k];
+        }
+
+        history[ch].resize (2 * (size_t) numPaddedTaps);
+    }
+
+    reset();
+}
+
+void DirectFIR::reset() noexcept
+{
+    for (int ch = 0; ch < maxNumChannels; ++ch)
+    {
+        std::fill (history[ch].begin(), history[ch].end(), 0.0f);
+        writeIndex[ch] = 0;
+    }
+}
+
+void DirectFIR::process (const dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() <= (size_t) maxNumChannels);
+    if (numPaddedTaps == 0)
+        return;
+
+    const auto numSamples = (int) block.getNumSamples();
+    for (int ch = 0; ch < (int) block.getNumChannels(); ++ch)
+    {
+        auto* x = block.getChannelPointer ((size_t) ch);
+        const auto* h = taps[ch % numIRChannels].data();
+        auto* z = history[ch].data();
+        auto w = writeIndex[ch];
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            // z[w + 1] ... z[w + numPaddedTaps] holds the input history, from oldest to newest
+            z[w] = x[n];
+            z[w + numPaddedTaps] = x[n];
+            x[n] = innerProduct (h, z + w + 1, numPaddedTaps);
+            w = w + 1 == numPaddedTaps ? 0 : w + 1;
+        }
+
+        writeIndex[ch] = w;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * A direct-form FIR filter, for convolving with short impulse responses.
+ *
+ * Each output sample is a SIMD inner product between the (time-reversed)
+ * filter taps and the most recent input samples. The input history is kept
+ * in a circular buffer of twice the filter length, so that it is always
+ * contiguous in memory. Unlike FFT convolution, this has no latency, and the
+ * cost doesn't depend on the block size, but it grows linearly with the
+ * filter length.
+ */
+class DirectFIR
+{
+public:
+    static constexpr int maxNumChannels = 2;
+
+    DirectFIR() = default;
+
+    /** Sets the filter taps from a mono or stereo impulse response, and clears the filter state. This allocates memory! */
+    void setImpulseResponse (const AudioBuffer<float>& ir);
+
+    int getNumTaps() const noexcept { return numTaps; }
+
+    void reset() noexcept;
+
+    /** Filters a mono or stereo block. A mono impulse response is used for both channels. */
+    void process (const dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    using Vec = xsimd::batch<float>;
+    using AlignedVector = std::vector<float, xsimd::aligned_allocator<float>>;
+
+    int numTaps = 0;
+    int numPaddedTaps = 0; // rounded up to a whole number of SIMD registers
+    int numIRChannels = 1;
+
+    AlignedVector taps[maxNumChannels]; // time-reversed, and zero-padded at the start
+    AlignedVector history[maxNumChannels];
+    int writeIndex[maxNumChannels] {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectFIR)
+};
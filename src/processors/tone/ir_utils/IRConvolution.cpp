@@ -0,0 +1,253 @@
+#include "IRConvolution.h"
+
+namespace
+{
+constexpr double crossfadeTimeSeconds = 0.05;
+constexpr int maxLoadWaitMs = 500; // in case the convolution's message queue drops the new IR
+
+/** The convolution message queue only takes commands from one thread at a time, but engines get set up on several threads. */
+CriticalSection& getMessageQueueLock()
+{
+    static CriticalSection messageQueueLock;
+    return messageQueueLock;
+}
+} // namespace
+
+IRConvolution::IRConvolution (dsp::ConvolutionMessageQueue& convolutionQueue, TimeSliceThread& warmUpThread, IRPreparer&& preparer)
+    : messageQueue (convolutionQueue),
+      loaderThread (warmUpThread),
+      irPreparer (std::move (preparer)),
+      engineWarmer (
+          warmUpThread,
+          [this] (EngineState& state, double sampleRate, int samplesPerBlock)
+          { setUpEngine (state, sampleRate, samplesPerBlock); },
+          true)
+{
+    loaderThread.addTimeSliceClient (this);
+}
+
+IRConvolution::~IRConvolution()
+{
+    loaderThread.removeTimeSliceClient (this); // waits for any IR that's being loaded
+}
+
+bool IRConvolution::shouldUseDirectFIR (int irLength, int blockSize) noexcept
+{
+    // The FFT convolution gets relatively more expensive at small block sizes,
+    // while the cost of the direct FIR doesn't depend on the block size at all.
+    // These thresholds haven't been measured yet, so they're on the cautious side.
+    if (blockSize <= 32)
+        return irLength <= 512;
+
+    if (blockSize <= 128)
+        return irLength <= 384;
+
+    return irLength <= 256;
+}
+
+void IRConvolution::setUpEngine (EngineState& state, double sampleRate, int samplesPerBlock)
+{
+    {
+        SpinLock::ScopedLockType pendingIRLocker { pendingIRLock };
+        state.ir = pendingIR;
+    }
+
+    if (state.ir == nullptr)
+        return;
+
+    state.useDirectFIR = shouldUseDirectFIR (state.ir->buffer.getNumSamples(), samplesPerBlock);
+    if (state.useDirectFIR)
+        state.fir.setImpulseResponse (state.ir->buffer);
+    else
+        loadIntoConvolution (state, sampleRate, samplesPerBlock);
+}
+
+void IRConvolution::loadIntoConvolution (EngineState& state, double sampleRate, int samplesPerBlock)
+{
+    const auto irLength = state.ir->buffer.getNumSamples();
+    const auto numChannels = preparedNumChannels.load();
+
+    // the IR has already been trimmed, resampled, and normalised, so the convolution doesn't need to do it again
+    state.convolution = std::make_unique<dsp::Convolution> (messageQueue);
+    {
+        const ScopedLock sl (getMessageQueueLock());
+        state.convolution->prepare ({ sampleRate, (uint32) samplesPerBlock, (uint32) numChannels });
+        state.convolution->loadImpulseResponse (AudioBuffer<float> { state.ir->buffer },
+                                                state.ir->sampleRate,
+                                                dsp::Convolution::Stereo::yes,
+                                                dsp::Convolution::Trim::no,
+                                                dsp::Convolution::Normalise::no);
+    }
+
+    // The IR gets loaded in the background, and swapped in on the next call to process().
+    // This convolution has never had any other IR, so once the sizes match, it's using this one.
+    AudioBuffer<float> silence (numChannels, samplesPerBlock);
+    silence.clear();
+    for (int waitMs = 0; state.convolution->getCurrentIRSize() != irLength && waitMs < maxLoadWaitMs; ++waitMs)
+    {
+        auto&& block = dsp::AudioBlock<float> { silence };
+        state.convolution->process (dsp::ProcessContextReplacing<float> { block });
+        Thread::sleep (1);
+    }
+
+    state.convolution->reset(); // skips the convolution's own crossfade to the new IR
+}
+
+void IRConvolution::prepare (const dsp::ProcessSpec& spec, std::shared_ptr<const DecodedIR> preparedIR)
+{
+    const ScopedLock sl (loadLock);
+
+    {
+        SpinLock::ScopedLockType pendingIRLocker { pendingIRLock };
+        pendingIR = preparedIR;
+    }
+
+    preparedNumChannels.store ((int) spec.numChannels);
+    engineWarmer.warmUpNow (spec.sampleRate, (int) spec.maximumBlockSize);
+    engineWarmer.getActiveState().needsCrossfade = false;
+
+    previousEngineBuffer.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize);
+    crossfadeLengthSamples = (int) (spec.sampleRate * crossfadeTimeSeconds);
+    crossfadeSamplesDone = 0;
+
+    preparedBlockSize.store ((int) spec.maximumBlockSize);
+    preparedSampleRate.store (spec.sampleRate);
+}
+
+size_t IRConvolution::getMemoryFootprint() const
+{
+    std::shared_ptr<const DecodedIR> ir;
+    {
+        SpinLock::ScopedLockType pendingIRLocker { pendingIRLock };
+        ir = pendingIR;
+    }
+
+    const auto bufferBytes = [] (const AudioBuffer<float>& buffer)
+    { return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (float); };
+
+    auto numBytes = bufferBytes (previousEngineBuffer);
+    if (ir == nullptr)
+        return numBytes;
+
+    // The FFT engine keeps the IR's partitions in the frequency domain (about 4 floats per IR sample),
+    // for both channels, and for both the old and new engines while crossfading. The direct FIR keeps
+    // the time-reversed taps, with an input history of twice the filter length.
+    // Either way, we also hold on to the prepared IR itself.
+    const auto irBytes = bufferBytes (ir->buffer);
+    if (shouldUseDirectFIR (ir->buffer.getNumSamples(), preparedBlockSize.load()))
+        numBytes += 3 * irBytes;
+    else
+        numBytes += 2 * 2 * 4 * (size_t) ir->buffer.getNumSamples() * sizeof (float);
+
+    return numBytes + irBytes;
+}
+
+void IRConvolution::loadImpulseResponse (std::shared_ptr<const DecodedIR> preparedIR)
+{
+    if (preparedIR == nullptr)
+        return;
+
+    const ScopedLock sl (loadLock);
+    {
+        SpinLock::ScopedLockType pendingIRLocker { pendingIRLock };
+        if (preparedIR == pendingIR)
+            return; // this IR is already loaded (or loading)
+
+        pendingIR = preparedIR;
+    }
+
+    // if the convolution hasn't been prepared yet, prepare() will load the IR
+    if (preparedBlockSize.load() == 0)
+        return;
+
+    engineWarmer.requestWarmUp();
+}
+
+int IRConvolution::useTimeSlice()
+{
+    if (! irLoadRequested.exchange (false))
+        return loaderPollIntervalMs;
+
+    // if the convolution hasn't been prepared yet, prepare() will load the IR
+    const auto sampleRate = preparedSampleRate.load();
+    if (irPreparer == nullptr || sampleRate <= 0.0)
+        return loaderPollIntervalMs;
+
+    auto preparedIR = irPreparer (sampleRate);
+
+    const ScopedLock sl (loadLock);
+    if (sampleRate != preparedSampleRate.load())
+    {
+        // the convolution was re-prepared at a different sample rate while the IR was being prepared
+        irLoadRequested.store (true);
+        return 0;
+    }
+
+    loadImpulseResponse (std::move (preparedIR));
+    return 0;
+}
+
+void IRConvolution::processWithEngine (EngineState& state, const dsp::AudioBlock<float>& block) noexcept
+{
+    if (state.useDirectFIR)
+    {
+        state.fir.process (block);
+        return;
+    }
+
+    if (state.convolution == nullptr)
+        return; // no IR has been loaded
+
+    auto convolutionBlock = block;
+    state.convolution->process (dsp::ProcessContextReplacing<float> { convolutionBlock });
+}
+
+void IRConvolution::process (const dsp::AudioBlock<float>& block) noexcept
+{
+    auto& state = engineWarmer.getStateForBlock();
+    auto* previousState = engineWarmer.getPreviousState();
+    if (state.needsCrossfade)
+    {
+        state.needsCrossfade = false;
+        crossfadeSamplesDone = 0;
+    }
+
+    if (previousState == nullptr)
+    {
+        processWithEngine (state, block);
+        return;
+    }
+
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+    auto&& previousBlock = dsp::AudioBlock<float> { previousEngineBuffer }
+                               .getSubsetChannelBlock (0, numChannels)
+                               .getSubBlock (0, numSamples);
+    previousBlock.copyFrom (block);
+
+    processWithEngine (*previousState, previousBlock);
+    processWithEngine (state, block);
+    crossfadeFromPreviousEngine (block, previousBlock);
+}
+
+void IRConvolution::crossfadeFromPreviousEngine (const dsp::AudioBlock<float>& block, const dsp::AudioBlock<float>& previousBlock) noexcept
+{
+    const auto numSamples = (int) block.getNumSamples();
+    const auto fadeIncrement = 1.0f / (float) jmax (1, crossfadeLengthSamples);
+    const auto fadeStart = (float) crossfadeSamplesDone * fadeIncrement;
+
+    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+    {
+        auto* x = block.getChannelPointer (ch);
+        const auto* prevX = previousBlock.getChannelPointer (ch);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const auto newEngineGain = jmin (1.0f, fadeStart + (float) n * fadeIncrement);
+            x[n] = prevX[n] + newEngineGain * (x[n] - prevX[n]);
+        }
+    }
+
+    crossfadeSamplesDone += numSamples;
+    if (crossfadeSamplesDone >= crossfadeLengthSamples)
+        engineWarmer.releasePreviousState();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../../ProcessorStateWarmer.h"
+#include "../../SharedAssetCache.h"
+#include "DirectFIR.h"
+
+/**
+ * Convolution with a (prepared) impulse response, which picks the cheaper
+ * engine for the IR length and block size.
+ *
+ * Short IRs are run through a DirectFIR, and longer IRs go to a juce::dsp::Convolution.
+ * When the IR changes, the new engine is set up on a background thread, and
+ * crossfaded in on the audio thread. Each FFT engine gets its own juce::dsp::Convolution,
+ * which is only ever loaded with that engine's IR, and the engine isn't handed over to
+ * the audio thread until the convolution has finished loading it.
+ *
+ * Preparing an IR (trimming, resampling, etc.) can be slow, so processors that
+ * change their IR from a parameter callback should give the convolution an IR
+ * preparer, and call requestImpulseResponse(). The IR is then prepared and loaded
+ * on the warm-up thread, while the audio thread keeps running with the current IR.
+ */
+class IRConvolution : private TimeSliceClient
+{
+public:
+    using DecodedIR = SharedAssetCache::DecodedIR;
+
+    /** Returns the IR to load, prepared for the given sample rate (called on the warm-up thread). */
+    using IRPreparer = std::function<std::shared_ptr<const DecodedIR> (double sampleRate)>;
+
+    IRConvolution (dsp::ConvolutionMessageQueue& convolutionQueue, TimeSliceThread& warmUpThread, IRPreparer&& preparer = {});
+    ~IRConvolution() override;
+
+    /** Prepares the convolution with an IR that has been prepared for the given sample rate. */
+    void prepare (const dsp::ProcessSpec& spec, std::shared_ptr<const DecodedIR> preparedIR);
+
+    /**
+     * Loads a new IR, which should already be trimmed, resampled, and normalised for
+     * the sample rate that the convolution was prepared with. Don't call this from the audio thread.
+     */
+    void loadImpulseResponse (std::shared_ptr<const DecodedIR> preparedIR);
+
+    /** Asks the warm-up thread to load a new IR from the IR preparer (safe to call from any thread). */
+    void requestImpulseResponse() noexcept { irLoadRequested.store (true); }
+
+    /** Convolves a mono or stereo block. */
+    void process (const dsp::AudioBlock<float>& block) noexcept;
+
+    /** Returns a rough estimate of the memory used by the convolution engines for the current IR (message thread only). */
+    size_t getMemoryFootprint() const;
+
+    /**
+     * Returns true if an IR of this length is cheaper to run through the direct FIR at this block size.
+     * The IR should already be prepared for the processing sample rate, so its length includes the
+     * effect of any oversampling. The crossover points are rough estimates for now, which can be
+     * checked against the --benchmark-convolution headless command.
+     */
+    static bool shouldUseDirectFIR (int irLength, int blockSize) noexcept;
+
+private:
+    int useTimeSlice() override;
+
+    struct EngineState
+    {
+        DirectFIR fir;
+        std::unique_ptr<dsp::Convolution> convolution; // only used by the FFT engine
+        std::shared_ptr<const DecodedIR> ir;
+        bool useDirectFIR = false;
+        bool needsCrossfade = true;
+    };
+
+    void setUpEngine (EngineState& state, double sampleRate, int samplesPerBlock);
+    void loadIntoConvolution (EngineState& state, double sampleRate, int samplesPerBlock);
+    static void processWithEngine (EngineState& state, const dsp::AudioBlock<float>& block) noexcept;
+    void crossfadeFromPreviousEngine (const dsp::AudioBlock<float>& block, const dsp::AudioBlock<float>& previousBlock) noexcept;
+
+    dsp::ConvolutionMessageQueue& messageQueue;
+
+    TimeSliceThread& loaderThread;
+    IRPreparer irPreparer;
+    std::atomic_bool irLoadRequested { false };
+    std::atomic<double> preparedSampleRate { 0.0 }; // zero until the convolution has been prepared
+    CriticalSection loadLock; // stops an IR from being loaded while the convolution is being prepared
+    static constexpr int loaderPollIntervalMs = 10;
+
+    SpinLock pendingIRLock;
+    std::shared_ptr<const DecodedIR> pendingIR; // the most recently loaded IR
+    std::atomic_int preparedBlockSize { 0 }; // zero until the convolution has been prepared
+    std::atomic_int preparedNumChannels { 2 };
+
+    ProcessorStateWarmer<EngineState> engineWarmer;
+    AudioBuffer<float> previousEngineBuffer;
+    int crossfadeSamplesDone = 0;
+    int crossfadeLengthSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IRConvolution)
+};
@@ -0,0 +1,214 @@
+#include "IROptimiser.h"
+
+namespace
+{
+constexpr float fadeOutTimeSeconds = 0.002f;
+constexpr float minFrequencyHz = 20.0f;
+constexpr float maxFrequencyHz = 20000.0f;
+constexpr float spectralFloorDB = -60.0f;
+
+int getFFTOrder (int minSize)
+{
+    return jmax (1, roundToInt (std::log2 ((double) nextPowerOfTwo (minSize))));
+}
+
+/** Returns the magnitude response of the signal, for the bins from DC up to Nyquist. */
+std::vector<float> getMagnitudeResponse (const float* x, int numSamples, dsp::FFT& fft)
+{
+    const auto fftSize = fft.getSize();
+    std::vector<float> fftData ((size_t) fftSize * 2, 0.0f);
+    std::copy (x, x + jmin (numSamples, fftSize), fftData.begin());
+
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+    fftData.resize ((size_t) fftSize / 2 + 1);
+    return fftData;
+}
+
+/** Returns the shortest length for which the energy in the rest of the IR is below the threshold. */
+int getTailEnergyLength (const AudioBuffer<float>& ir, float thresholdDB)
+{
+    const auto thresholdGain = Decibels::decibelsToGain (thresholdDB, -400.0f);
+
+    int length = 1;
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        const auto* x = ir.getReadPointer (ch);
+        double totalEnergy = 0.0;
+        for (int n = 0; n < ir.getNumSamples(); ++n)
+            totalEnergy += (double) x[n] * (double) x[n];
+
+        const auto maxTailEnergy = totalEnergy * (double) thresholdGain * (double) thresholdGain;
+        double tailEnergy = 0.0;
+        for (int n = ir.getNumSamples() - 1; n >= 0; --n)
+        {
+            tailEnergy += (double) x[n] * (double) x[n];
+            if (tailEnergy > maxTailEnergy)
+            {
+                length = jmax (length, n + 1);
+                break;
+            }
+        }
+    }
+
+    return length;
+}
+
+/**
+ * Cuts off the IR after some number of samples. The cut is smoothed with a short fade-out
+ * after that point (where the IR is quiet anyway), so that it doesn't add a click.
+ */
+AudioBuffer<float> truncate (const AudioBuffer<float>& ir, int cutLength, double sampleRate)
+{
+    const auto newLength = jmin (ir.getNumSamples(), cutLength + roundToInt (fadeOutTimeSeconds * sampleRate));
+    const auto fadeLength = newLength - cutLength;
+
+    AudioBuffer<float> truncatedIR (ir.getNumChannels(), newLength);
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        truncatedIR.copyFrom (ch, 0, ir, ch, 0, newLength);
+
+        auto* x = truncatedIR.getWritePointer (ch);
+        for (int n = 0; n < fadeLength; ++n)
+        {
+            const auto fadePhase = MathConstants<float>::pi * (float) (n + 1) / (float) (fadeLength + 1);
+            x[cutLength + n] *= 0.5f * (1.0f + std::cos (fadePhase));
+        }
+    }
+
+    return truncatedIR;
+}
+} // namespace
+
+namespace IROptimiser
+{
+AudioBuffer<float> makeMinimumPhase (const AudioBuffer<float>& ir)
+{
+    // Homomorphic method: fold the real cepstrum of the IR onto positive time, then exponentiate it.
+    // The FFT needs to be a few times longer than the IR, so that the cepstrum doesn't alias too much.
+    const auto numSamples = ir.getNumSamples();
+    dsp::FFT fft { getFFTOrder (numSamples) + 2 };
+    const auto fftSize = fft.getSize();
+
+    std::vector<dsp::Complex<float>> timeData ((size_t) fftSize);
+    std::vector<dsp::Complex<float>> freqData ((size_t) fftSize);
+
+    AudioBuffer<float> minPhaseIR (ir.getNumChannels(), numSamples);
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        const auto* x = ir.getReadPointer (ch);
+        std::fill (timeData.begin(), timeData.end(), dsp::Complex<float> {});
+        std::copy (x, x + numSamples, timeData.begin());
+        fft.perform (timeData.data(), freqData.data(), false);
+
+        const auto peakMagnitude = std::abs (*std::max_element (freqData.begin(), freqData.end(), [] (auto a, auto b)
+                                                                { return std::abs (a) < std::abs (b); }));
+        if (peakMagnitude <= 0.0f)
+        {
+            minPhaseIR.clear (ch, 0, numSamples);
+            continue;
+        }
+
+        // log-magnitude (with a floor, since zeros in the spectrum would go to -inf) -> real cepstrum
+        const auto magnitudeFloor = peakMagnitude * Decibels::decibelsToGain (-120.0f);
+        for (int k = 0; k < fftSize; ++k)
+            timeData[(size_t) k] = std::log (jmax (std::abs (freqData[(size_t) k]), magnitudeFloor));
+        fft.perform (timeData.data(), freqData.data(), true);
+
+        // fold the anti-causal part of the cepstrum onto the causal part
+        timeData[0] = freqData[0].real();
+        for (int n = 1; n < fftSize / 2; ++n)
+            timeData[(size_t) n] = 2.0f * freqData[(size_t) n].real();
+        timeData[(size_t) fftSize / 2] = freqData[(size_t) fftSize / 2].real();
+        std::fill (timeData.begin() + fftSize / 2 + 1, timeData.end(), dsp::Complex<float> {});
+
+        // folded cepstrum -> minimum-phase spectrum -> minimum-phase IR
+        fft.perform (timeData.data(), freqData.data(), false);
+        for (int k = 0; k < fftSize; ++k)
+            freqData[(size_t) k] = std::exp (freqData[(size_t) k]);
+        fft.perform (freqData.data(), timeData.data(), true);
+
+        auto* y = minPhaseIR.getWritePointer (ch);
+        for (int n = 0; n < numSamples; ++n)
+            y[n] = timeData[(size_t) n].real();
+    }
+
+    return minPhaseIR;
+}
+
+float getSpectralErrorDB (const AudioBuffer<float>& reference, const AudioBuffer<float>& ir, double sampleRate)
+{
+    const auto numSamples = jmax (reference.getNumSamples(), ir.getNumSamples());
+    dsp::FFT fft { getFFTOrder (numSamples) + 1 };
+    const auto fftSize = fft.getSize();
+
+    const auto binWidth = (float) sampleRate / (float) fftSize;
+    const auto minBin = jmax (1, (int) std::ceil (minFrequencyHz / binWidth));
+    const auto maxBin = jmin (fftSize / 2, (int) (maxFrequencyHz / binWidth));
+
+    float maxError = 0.0f;
+    for (int ch = 0; ch < reference.getNumChannels(); ++ch)
+    {
+        const auto refMagnitudes = getMagnitudeResponse (reference.getReadPointer (ch), reference.getNumSamples(), fft);
+        const auto irMagnitudes = getMagnitudeResponse (ir.getReadPointer (ch % ir.getNumChannels()), ir.getNumSamples(), fft);
+        const auto magnitudeFloor = *std::max_element (refMagnitudes.begin(), refMagnitudes.end()) * Decibels::decibelsToGain (spectralFloorDB);
+
+        // weighting each bin by 1/f gives each octave the same weight
+        double errorSum = 0.0;
+        double weightSum = 0.0;
+        for (int k = minBin; k <= maxBin; ++k)
+        {
+            if (refMagnitudes[(size_t) k] <= magnitudeFloor)
+                continue;
+
+            const auto errorDB = Decibels::gainToDecibels (irMagnitudes[(size_t) k], -200.0f) - Decibels::gainToDecibels (refMagnitudes[(size_t) k], -200.0f);
+            const auto weight = 1.0 / (double) k;
+            errorSum += weight * (double) errorDB * (double) errorDB;
+            weightSum += weight;
+        }
+
+        if (weightSum > 0.0)
+            maxError = jmax (maxError, (float) std::sqrt (errorSum / weightSum));
+    }
+
+    return maxError;
+}
+
+Result optimise (const AudioBuffer<float>& ir, double sampleRate, const Settings& settings)
+{
+    const auto numSamples = ir.getNumSamples();
+    const auto sourceIR = settings.minimumPhase ? makeMinimumPhase (ir) : ir;
+
+    int cutLength = numSamples;
+    if (settings.maxSpectralErrorDB > 0.0f)
+    {
+        // the spectral error (mostly) goes down as the IR gets longer, so binary search for the shortest length that's good enough
+        int minLength = 1;
+        while (minLength < cutLength)
+        {
+            const auto testLength = (minLength + cutLength) / 2;
+            if (getSpectralErrorDB (ir, truncate (sourceIR, testLength, sampleRate), sampleRate) <= settings.maxSpectralErrorDB)
+                cutLength = testLength;
+            else
+                minLength = testLength + 1;
+        }
+    }
+    else
+    {
+        cutLength = getTailEnergyLength (sourceIR, settings.tailEnergyThresholdDB);
+    }
+
+    Result result;
+    result.ir = truncate (sourceIR, cutLength, sampleRate);
+    result.originalLength = numSamples;
+    result.optimisedLength = result.ir.getNumSamples();
+    result.spectralErrorDB = getSpectralErrorDB (ir, result.ir, sampleRate);
+    return result;
+}
+
+String getSettingsID (const Settings& settings)
+{
+    const auto truncationID = settings.maxSpectralErrorDB > 0.0f ? String (settings.maxSpectralErrorDB, 2) + "dBerror"
+                                                                  : String (settings.tailEnergyThresholdDB, 1) + "dBtail";
+    return (settings.minimumPhase ? "minphase_" : "") + truncationID;
+}
+} // namespace IROptimiser
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Tools for making cabinet impulse responses cheaper to convolve with.
+ *
+ * Most of the length of a cab IR is a low-level tail, and in a linear-phase
+ * or mixed-phase IR, some of the energy arrives well after the start. Converting
+ * the IR to minimum phase (with the same magnitude response) moves as much of
+ * the energy as possible to the start of the IR, so that the tail can be cut off
+ * much earlier without changing the frequency response much.
+ */
+namespace IROptimiser
+{
+struct Settings
+{
+    bool minimumPhase = true;
+
+    /** The IR is cut off once the energy left in the tail is this far below the total energy. */
+    float tailEnergyThresholdDB = -60.0f;
+
+    /**
+     * If this is above zero, the IR is instead cut off at the shortest length
+     * that keeps the spectral error (see getSpectralErrorDB()) below this many dB.
+     */
+    float maxSpectralErrorDB = 0.0f;
+};
+
+struct Result
+{
+    AudioBuffer<float> ir;
+    int originalLength = 0;
+    int optimisedLength = 0;
+    float spectralErrorDB = 0.0f; // between the original and optimised IRs
+
+    /** The convolution cost is roughly proportional to the IR length, so this is also the fraction of CPU that gets saved. */
+    float getTapReduction() const noexcept { return originalLength > 0 ? 1.0f - (float) optimisedLength / (float) originalLength : 0.0f; }
+};
+
+/** Converts the IR to minimum phase (if enabled), and truncates it. This can take a while for long IRs, so don't call it from the audio thread! */
+Result optimise (const AudioBuffer<float>& ir, double sampleRate, const Settings& settings = {});
+
+/** Returns an IR with the same magnitude response, and a minimum phase response. */
+AudioBuffer<float> makeMinimumPhase (const AudioBuffer<float>& ir);
+
+/**
+ * Returns the RMS difference between the magnitude responses of two IRs, in decibels,
+ * over the audible frequency range. Each octave is weighted equally, and frequencies where
+ * the reference is more than 60 dB below its peak are ignored.
+ */
+float getSpectralErrorDB (const AudioBuffer<float>& reference, const AudioBuffer<float>& ir, double sampleRate);
+
+/** Returns a short string identifying these settings, e.g. for caching optimised IRs. */
+String getSettingsID (const Settings& settings);
+} // namespace IROptimiser
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Helpers for running a per-sample model (e.g. a wave digital filter)
+ * on every channel of a buffer in a single pass, with each channel
+ * in one lane of a SIMD register.
+ */
+namespace ChannelBatch
+{
+using Vec = xsimd::batch<float>;
+static_assert (Vec::size >= 2, "SIMD registers must be wide enough for a stereo signal!");
+
+/** Loads sample n from each channel into a SIMD register (unused lanes are set to zero). */
+template <typename SampleType>
+inline xsimd::batch<SampleType> load (const SampleType* const* x, int numChannels, int n) noexcept
+{
+    using Batch = xsimd::batch<SampleType>;
+    alignas (Batch::arch_type::alignment()) SampleType frame[Batch::size] {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        frame[ch] = x[ch][n];
+    return xsimd::load_aligned (frame);
+}
+
+/** Stores the lanes of a SIMD register into sample n of each channel. */
+template <typename SampleType>
+inline void store (SampleType* const* x, int numChannels, int n, const xsimd::batch<SampleType>& y) noexcept
+{
+    using Batch = xsimd::batch<SampleType>;
+    alignas (Batch::arch_type::alignment()) SampleType frame[Batch::size];
+    y.store_aligned (frame);
+    for (int ch = 0; ch < numChannels; ++ch)
+        x[ch][n] = frame[ch];
+}
+
+/**
+ * Runs processSample() on each sample of the buffer. If T is a SIMD type,
+ * all the channels are processed together, otherwise the buffer must be mono.
+ */
+template <typename T, typename SampleType, typename ProcessFunc>
+void process (AudioBuffer<SampleType>& buffer, ProcessFunc&& processSample) noexcept
+{
+    const auto numSamples = buffer.getNumSamples();
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        jassert (buffer.getNumChannels() == 1); // scalar models can only process one channel!
+        auto* x = buffer.getWritePointer (0);
+        for (int n = 0; n < numSamples; ++n)
+            x[n] = processSample (x[n]);
+    }
+    else
+    {
+        static_assert (std::is_same_v<T, xsimd::batch<SampleType>>, "Unsupported SIMD type!");
+
+        const auto numChannels = buffer.getNumChannels();
+        jassert (numChannels <= (int) T::size); // too many channels for this SIMD type!
+
+        auto* const* x = buffer.getArrayOfWritePointers();
+        for (int n = 0; n < numSamples; ++n)
+            store (x, numChannels, n, processSample (load (x, numChannels, n)));
+    }
+}
+} // namespace ChannelBatch
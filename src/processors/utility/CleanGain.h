@@ -8,6 +8,7 @@ public:
     explicit CleanGain (UndoManager* um = nullptr);
 
     ProcessorType getProcessorType() const override { return Utility; }
+    ProcessingRate getPreferredProcessingRate() const override { return { ProcessingRate::Type::BaseRate }; }
     static ParamLayout createParameterLayout();
 
     void prepare (double sampleRate, int samplesPerBlock) override;
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <pch.h>
+
+/**
+ * Approximations of the transcendental functions that show up in the
+ * nonlinear drive models, for scalars (float or double) and SIMD registers
+ * (xsimd::batch<float> or xsimd::batch<double>).
+ *
+ * Each function has three accuracy tiers:
+ *  - Fast: good enough for anything that gets corrected by a Newton-Raphson solver (~2e-4 relative error)
+ *  - Balanced: close to single precision (~2e-6 relative error)
+ *  - Exact: the standard library (or xsimd) version, as a reference
+ *
+ * The approximations are only valid for finite inputs, and they don't handle
+ * NaNs or denormals specially. The error bounds are checked in FastMathTest.
+ */
+namespace FastMath
+{
+enum class Accuracy
+{
+    Fast,
+    Balanced,
+    Exact,
+};
+
+namespace detail
+{
+    template <typename T>
+    struct ScalarType
+    {
+        using type = T;
+    };
+
+    template <typename T, typename Arch>
+    struct ScalarType<xsimd::batch<T, Arch>>
+    {
+        using type = T;
+    };
+
+    template <typename T>
+    using ScalarType_t = typename ScalarType<T>::type;
+
+    template <typename T>
+    constexpr bool isScalar = std::is_floating_point_v<T>;
+
+    /** Constants for picking apart IEEE-754 numbers of type S. */
+    template <typename S>
+    struct FloatBits
+    {
+        using IntType = std::conditional_t<std::is_same_v<S, float>, int32_t, int64_t>;
+        static constexpr int numMantissaBits = std::is_same_v<S, float> ? 23 : 52;
+        static constexpr IntType exponentBias = std::is_same_v<S, float> ? 127 : 1023;
+        static constexpr IntType exponentMask = std::is_same_v<S, float> ? 0xff : 0x7ff;
+        static constexpr IntType mantissaMask = ((IntType) 1 << numMantissaBits) - 1;
+
+        // exp() is clamped to this range, so that 2^n stays a normal number
+        static constexpr S maxExpInput = std::is_same_v<S, float> ? (S) 88.0 : (S) 709.0;
+        static constexpr S minExpInput = std::is_same_v<S, float> ? (S) -87.0 : (S) -708.0;
+    };
+
+    template <typename T, typename Mask>
+    inline T select (const Mask& condition, const T& trueValue, const T& falseValue) noexcept
+    {
+        if constexpr (isScalar<T>)
+            return condition ? trueValue : falseValue;
+        else
+            return xsimd::select (condition, trueValue, falseValue);
+    }
+
+    template <typename T>
+    inline T floor (const T& x) noexcept
+    {
+        if constexpr (isScalar<T>)
+            return std::floor (x);
+        else
+            return xsimd::floor (x);
+    }
+
+    template <typename T>
+    inline T abs (const T& x) noexcept
+    {
+        if constexpr (isScalar<T>)
+            return std::abs (x);
+        else
+            return xsimd::abs (x);
+    }
+
+    template <typename T>
+    inline T sqrt (const T& x) noexcept
+    {
+        if constexpr (isScalar<T>)
+            return std::sqrt (x);
+        else
+            return xsimd::sqrt (x);
+    }
+
+    template <typename T>
+    inline T clamp (const T& x, const T& low, const T& high) noexcept
+    {
+        if constexpr (isScalar<T>)
+            return std::min (std::max (x, low), high);
+        else
+            return xsimd::min (xsimd::max (x, low), high);
+    }
+
+    /** Returns y with the sign of x. */
+    template <typename T>
+    inline T withSignOf (const T& y, const T& x) noexcept
+    {
+        return select (x < (T) 0, -y, y);
+    }
+
+    /** Returns 2^n, for integer-valued n in the range of normal exponents. */
+    template <typename T>
+    inline T exp2Int (const T& n) noexcept
+    {
+        using S = ScalarType_t<T>;
+        using Bits = FloatBits<S>;
+
+        if constexpr (isScalar<T>)
+        {
+            const auto bits = (typename Bits::IntType) ((typename Bits::IntType) n + Bits::exponentBias) << Bits::numMantissaBits;
+            T y;
+            std::memcpy (&y, &bits, sizeof (T));
+            return y;
+        }
+        else
+        {
+            const auto bits = (xsimd::to_int (n) + Bits::exponentBias) << Bits::numMantissaBits;
+            return xsimd::bitwise_cast<S> (bits);
+        }
+    }
+
+    /** Splits positive, normal x into x = m * 2^e, with m in [sqrt(1/2), sqrt(2)). */
+    template <typename T>
+    inline std::pair<T, T> splitExponent (const T& x) noexcept
+    {
+        using S = ScalarType_t<T>;
+        using Bits = FloatBits<S>;
+        using IntType = typename Bits::IntType;
+        constexpr auto oneBits = Bits::exponentBias << Bits::numMantissaBits; // the bits for 1.0
+
+        T m, e;
+        if constexpr (isScalar<T>)
+        {
+            IntType bits;
+            std::memcpy (&bits, &x, sizeof (T));
+            e = (T) (((bits >> Bits::numMantissaBits) & Bits::exponentMask) - Bits::exponentBias);
+            bits = (bits & Bits::mantissaMask) | oneBits;
+            std::memcpy (&m, &bits, sizeof (T));
+        }
+        else
+        {
+            const auto bits = xsimd::bitwise_cast<IntType> (x);
+            e = xsimd::to_float (((bits >> Bits::numMantissaBits) & Bits::exponentMask) - Bits::exponentBias);
+            m = xsimd::bitwise_cast<S> ((bits & Bits::mantissaMask) | oneBits);
+        }
+
+        // m is in [1, 2) now, and the series in logOnePlus() converges faster for m close to 1
+        const auto isAboveSqrt2 = m > (T) MathConstants<S>::sqrt2;
+        return { select (isAboveSqrt2, m * (T) 0.5, m), select (isAboveSqrt2, e + (T) 1, e) };
+    }
+
+    /**
+     * Returns log((1 + s) / (1 - s)) = 2 atanh(s), for |s| <= 3 - 2 sqrt(2) ~= 0.17.
+     * The truncated series has a relative error below 2e-4 (Fast) or 2e-8 (Balanced) in that range.
+     */
+    template <Accuracy accuracy, typename T>
+    inline T logSeries (const T& s) noexcept
+    {
+        const auto s2 = s * s;
+        if constexpr (accuracy == Accuracy::Fast)
+            return (T) 2 * s * ((T) 1 + s2 * (T) (1.0 / 3.0));
+        else
+            return (T) 2 * s * ((T) 1 + s2 * ((T) (1.0 / 3.0) + s2 * ((T) (1.0 / 5.0) + s2 * (T) (1.0 / 7.0))));
+    }
+
+    /** Returns e^r, for |r| <= ln(2) / 2. The Taylor series has a relative error below 5e-5 (Fast) or 2e-7 (Balanced) in that range. */
+    template <Accuracy accuracy, typename T>
+    inline T expSeries (const T& r) noexcept
+    {
+        if constexpr (accuracy == Accuracy::Fast)
+            return (T) 1 + r * ((T) 1 + r * ((T) (1.0 / 2.0) + r * ((T) (1.0 / 6.0) + r * (T) (1.0 / 24.0))));
+        else
+            return (T) 1 + r * ((T) 1 + r * ((T) (1.0 / 2.0) + r * ((T) (1.0 / 6.0) + r * ((T) (1.0 / 24.0) + r * ((T) (1.0 / 120.0) + r * (T) (1.0 / 720.0))))));
+    }
+} // namespace detail
+
+/** Returns e^x (clamped to the range of normal numbers). */
+template <Accuracy accuracy = Accuracy::Balanced, typename T>
+inline T exp (T x) noexcept
+{
+    if constexpr (accuracy == Accuracy::Exact)
+    {
+        if constexpr (detail::isScalar<T>)
+            return std::exp (x);
+        else
+            return xsimd::exp (x);
+    }
+    else
+    {
+        using S = detail::ScalarType_t<T>;
+        using Bits = detail::FloatBits<S>;
+
+        // e^x = 2^n * e^r, where r = x - n ln(2) is in [-ln(2) / 2, ln(2) / 2]
+        // (ln(2) is split into two parts, so that r is accurate even for large n)
+        constexpr auto ln2Hi = (S) 0.693145751953125;
+        constexpr auto ln2Lo = (S) 1.428606820309417232e-06;
+
+        x = detail::clamp (x, (T) Bits::minExpInput, (T) Bits::maxExpInput);
+        const auto n = detail::floor (x * (T) MathConstants<S>::log2e + (T) 0.5);
+        const auto r = (x - n * (T) ln2Hi) - n * (T) ln2Lo;
+        return detail::expSeries<accuracy> (r) * detail::exp2Int (n);
+    }
+}
+
+/** Returns the natural logarithm of x, for x > 0. */
+template <Accuracy accuracy = Accuracy::Balanced, typename T>
+inline T log (T x) noexcept
+{
+    if constexpr (accuracy == Accuracy::Exact)
+    {
+        if constexpr (detail::isScalar<T>)
+            return std::log (x);
+        else
+            return xsimd::log (x);
+    }
+    else
+    {
+        using S = detail::ScalarType_t<T>;
+
+        // log(x) = e ln(2) + log(m), and log(m) = 2 atanh((m - 1) / (m + 1))
+        const auto [m, e] = detail::splitExponent (x);
+        return e * (T) MathConstants<S>::ln2 + detail::logSeries<accuracy> ((m - (T) 1) / (m + (T) 1));
+    }
+}
+
+/** Returns x^y, for x > 0. */
+template <Accuracy accuracy = Accuracy::Balanced, typename T>
+inline T pow (T x, T y) noexcept
+{
+    if constexpr (accuracy == Accuracy::Exact)
+    {
+        if constexpr (detail::isScalar<T>)
+            return std::pow (x, y);
+        else
+            return xsimd::pow (x, y);
+    }
+    else
+    {
+        return FastMath::exp<accuracy> (y * FastMath::log<accuracy> (x));
+    }
+}
+
+/** Returns sign(x) * |x|^y, which is zero when x is zero. */
+template <Accuracy accuracy = Accuracy::Balanced, typename T>
+inline T signedPow (T x, T y) noexcept
+{
+    const auto absX = detail::abs (x);
+    const auto absY = FastMath::pow<accuracy> (detail::select (absX > (T) 0, absX, (T) 1), y);
+    return detail::select (absX > (T) 0, detail::withSignOf (absY, x), (T) 0);
+}
+
+/** Returns the inverse hyperbolic sine of x. */
+template <Accuracy accuracy = Accuracy::Balanced, typename T>
+inline T asinh (T x) noexcept
+{
+    if constexpr (accuracy == Accuracy::Exact)
+    {
+        if constexpr (detail::isScalar<T>)
+            return std::asinh (x);
+        else
+            return xsimd::asinh (x);
+    }
+    else
+    {
+        // asinh(|x|) = log(1 + u), with u = |x| + x^2 / (1 + sqrt(1 + x^2)), which keeps the
+        // relative error small near zero, where drive stages divide the output by a small gain.
+        // For small u, log(1 + u) = 2 atanh(u / (2 + u)) can use the series directly.
+        constexpr auto maxSeriesInput = (detail::ScalarType_t<T>) 0.41421356237; // sqrt(2) - 1
+
+        const auto absX = detail::abs (x);
+        const auto sqrtTerm = detail::sqrt (absX * absX + (T) 1);
+        const auto u = absX + absX * absX / ((T) 1 + sqrtTerm);
+
+        const auto useSeries = u < (T) maxSeriesInput;
+        if constexpr (detail::isScalar<T>)
+        {
+            const auto y = useSeries ? detail::logSeries<accuracy> (u / ((T) 2 + u)) : FastMath::log<accuracy> (absX + sqrtTerm);
+            return detail::withSignOf (y, x);
+        }
+        else
+        {
+            const auto y = detail::select (useSeries, detail::logSeries<accuracy> (u / ((T) 2 + u)), FastMath::log<accuracy> (absX + sqrtTerm));
+            return detail::withSignOf (y, x);
+        }
+    }
+}
+
+/** Returns the hyperbolic tangent of x. */
+template <Accuracy accuracy = Accuracy::Balanced, typename T>
+inline T tanh (T x) noexcept
+{
+    if constexpr (accuracy == Accuracy::Exact)
+    {
+        if constexpr (detail::isScalar<T>)
+            return std::tanh (x);
+        else
+            return xsimd::tanh (x);
+    }
+    else
+    {
+        // near zero, (1 - e^-2x) / (1 + e^-2x) would lose the relative accuracy of e^-2x, so use the Taylor series instead
+        constexpr auto maxSeriesInput = (detail::ScalarType_t<T>) 0.3;
+
+        const auto absX = detail::abs (x);
+        const auto x2 = x * x;
+        const auto series = [&x, &x2]
+        {
+            if constexpr (accuracy == Accuracy::Fast)
+                return x * ((T) 1 + x2 * ((T) (-1.0 / 3.0) + x2 * (T) (2.0 / 15.0)));
+            else
+                return x * ((T) 1 + x2 * ((T) (-1.0 / 3.0) + x2 * ((T) (2.0 / 15.0) + x2 * ((T) (-17.0 / 315.0) + x2 * (T) (62.0 / 2835.0)))));
+        };
+        const auto exponential = [&x, &absX]
+        {
+            const auto t = FastMath::exp<accuracy> ((T) -2 * absX);
+            return detail::withSignOf (((T) 1 - t) / ((T) 1 + t), x);
+        };
+
+        if constexpr (detail::isScalar<T>)
+            return absX < (T) maxSeriesInput ? series() : exponential();
+        else
+            return detail::select (absX < (T) maxSeriesInput, series(), exponential());
+    }
+}
+} // namespace FastMath
@@ -49,7 +49,7 @@ void Mixer::processAudio (AudioBuffer<float>& buffer)
     {
         gains[i].setGainDecibels (*gainDBParams[i]);
 
-        if (! inputsConnected.contains (i))
+        if (! isInputConnected (i))
             continue;
 
         numInputsProcessed++;
@@ -106,7 +106,7 @@ void Mixer::processAudioBypassed (AudioBuffer<float>& buffer)
 {
     for (int i = 0; i < numIns; ++i)
     {
-        if (inputsConnected.contains (i))
+        if (isInputConnected (i))
         {
             auto& inBuffer = getInputBuffer (i);
             outputBuffers.getReference (0) = &inBuffer;
@@ -55,8 +55,8 @@ void StereoMerger::processAudio (AudioBuffer<float>& buffer)
         b.applyGain (1.0f / (float) nChannels);
     };
 
-    bool isInput0Connected = inputsConnected.contains (LeftChannel);
-    bool isInput1Connected = inputsConnected.contains (RightChannel);
+    bool isInput0Connected = isInputConnected (LeftChannel);
+    bool isInput1Connected = isInputConnected (RightChannel);
     bool isLeftRight = *modeParam == 0.0f;
 
     if (! isInput0Connected && ! isInput1Connected)
@@ -106,8 +106,8 @@ void StereoMerger::processAudioBypassed (AudioBuffer<float>& buffer)
     stereoBuffer.setSize (2, numSamples, false, false, true);
     stereoBuffer.clear();
 
-    bool isInput0Connected = inputsConnected.contains (LeftChannel);
-    bool isInput1Connected = inputsConnected.contains (RightChannel);
+    bool isInput0Connected = isInputConnected (LeftChannel);
+    bool isInput1Connected = isInputConnected (RightChannel);
 
     if (! isInput0Connected && ! isInput1Connected)
     {
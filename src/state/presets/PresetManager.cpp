@@ -67,6 +67,8 @@ PresetManager::PresetManager (ProcessorChain* chain, AudioProcessorValueTreeStat
     loadBYODFactoryPresets();
     setUserPresetConfigFile (userPresetPath);
 
+    setlist = std::make_unique<PresetSetlist> (*this, *procChain);
+
 #if JUCE_IOS
     const auto groupDir = File::getContainerForSecurityApplicationGroupIdentifier ("group.com.chowdsp.BYOD");
     if (groupDir != File())
@@ -382,3 +384,12 @@ void PresetManager::loadPresetSafe (std::unique_ptr<chowdsp::Preset> presetToLoa
     keepAlivePreset = std::move (presetToLoad);
     loadPreset (*keepAlivePreset);
 }
+
+void PresetManager::setPresetLoadedFromStandby (const chowdsp::Preset& preset)
+{
+    // the processor chain has already cleared the undo history, so there's no ChangePresetAction here
+    keepAlivePreset = std::make_unique<chowdsp::Preset> (preset);
+    currentPreset = keepAlivePreset.get();
+    setIsDirty (false);
+    listeners.call (&chowdsp::PresetManager::Listener::selectedPresetChanged);
+}
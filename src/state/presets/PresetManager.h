@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PresetSetlist.h"
 #include "PresetsServerJobPool.h"
 #include "PresetsServerSyncManager.h"
 #include "PresetsServerUserManager.h"
@@ -41,6 +42,11 @@ public:
     void loadPresetSafe (std::unique_ptr<chowdsp::Preset> presetToLoad, Component* associatedComp);
     void filterPresets (std::vector<chowdsp::Preset>& presets);
 
+    /** Makes a preset the current one, after its processors have been swapped in from a setlist standby board. */
+    void setPresetLoadedFromStandby (const chowdsp::Preset& preset);
+
+    PresetSetlist& getSetlist() { return *setlist; }
+
     static void showErrorMessage (const String& title, const String& message, Component* associatedComp);
 
 #if BYOD_BUILD_PRESET_SERVER
@@ -56,6 +62,7 @@ private:
     void parameterChanged (const juce::String&, float) override {}
 
     ProcessorChain* procChain;
+    std::unique_ptr<PresetSetlist> setlist;
 
 #if BYOD_BUILD_PRESET_SERVER
     SharedPresetsServerUserManager userManager;
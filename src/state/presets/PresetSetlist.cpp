@@ -0,0 +1,187 @@
+#include "PresetSetlist.h"
+#include "../StateManager.h"
+#include "PresetManager.h"
+#include "processors/chain/ProcessorChainStateHelper.h"
+
+namespace
+{
+constexpr int refreshIntervalMs = 50;
+constexpr double warmUpTimeSeconds = 0.25;
+} // namespace
+
+PresetSetlist::PresetSetlist (PresetManager& presetMgr, ProcessorChain& procChain)
+    : presetManager (presetMgr),
+      chain (procChain)
+{
+    startTimer (refreshIntervalMs);
+}
+
+PresetSetlist::~PresetSetlist()
+{
+    stopTimer();
+    buildPool.removeAllJobs (true, -1); // the build job uses the processor chain, so we need to wait for it
+}
+
+void PresetSetlist::setPresets (std::vector<chowdsp::Preset>&& newPresets)
+{
+    sst::cpputils::nodal_erase_if (newPresets, [] (const chowdsp::Preset& preset)
+                                   { return ! preset.isValid(); });
+    presetManager.filterPresets (newPresets);
+
+    presets = std::move (newPresets);
+    currentIndex = -1;
+    presetsGeneration++;
+
+    standbyBoards.clear();
+    isOverBudget = false;
+    refreshStandbyBoards();
+}
+
+bool PresetSetlist::loadPresetAtIndex (int index)
+{
+    if (! isPositiveAndBelow (index, (int) presets.size()))
+        return false;
+
+    const auto& preset = presets[(size_t) index];
+    auto boardIter = std::find_if (standbyBoards.begin(), standbyBoards.end(), [index] (const StandbyBoard& standby)
+                                   { return standby.index == index; });
+
+    if (boardIter != standbyBoards.end() && chain.getStateHelper().loadStandbyBoard (*boardIter->board, crossfadeTimeSeconds))
+    {
+        Logger::writeToLog ("Loaded setlist preset from standby: " + preset.getName());
+        presetManager.setPresetLoadedFromStandby (preset);
+    }
+    else
+    {
+        presetManager.loadPresetSafe (std::make_unique<chowdsp::Preset> (preset), nullptr);
+    }
+
+    currentIndex = index;
+    isOverBudget = false;
+    refreshStandbyBoards();
+
+    return true;
+}
+
+void PresetSetlist::setNumStandbyPresets (int numPresets)
+{
+    numStandbyPresets = jmax (0, numPresets);
+    isOverBudget = false;
+    refreshStandbyBoards();
+}
+
+void PresetSetlist::setMemoryBudget (size_t numBytes)
+{
+    memoryBudget = numBytes;
+
+    // drop the boards furthest from the current preset until we're back under budget
+    std::sort (standbyBoards.begin(), standbyBoards.end(), [] (const StandbyBoard& a, const StandbyBoard& b)
+               { return a.index < b.index; });
+    while (! standbyBoards.empty() && getStandbyMemoryUsage() > memoryBudget)
+        standbyBoards.pop_back();
+
+    isOverBudget = false;
+    refreshStandbyBoards();
+}
+
+bool PresetSetlist::isStandbyBoardReady (int index) const
+{
+    return std::any_of (standbyBoards.begin(), standbyBoards.end(), [index] (const StandbyBoard& standby)
+                        { return standby.index == index; });
+}
+
+size_t PresetSetlist::getStandbyMemoryUsage() const
+{
+    size_t numBytes = 0;
+    for (const auto& standby : standbyBoards)
+        numBytes += standby.memoryFootprint;
+
+    return numBytes;
+}
+
+bool PresetSetlist::isStandbyIndex (int index) const noexcept
+{
+    return index > currentIndex
+           && index <= currentIndex + numStandbyPresets
+           && index < (int) presets.size();
+}
+
+void PresetSetlist::timerCallback()
+{
+    collectFinishedBoard();
+    refreshStandbyBoards();
+}
+
+void PresetSetlist::collectFinishedBoard()
+{
+    if (! buildFinished.exchange (false))
+        return;
+
+    auto board = std::move (finishedBoard);
+    const auto index = std::exchange (boardBeingBuilt, -1);
+    if (board == nullptr || buildGeneration != presetsGeneration || ! isStandbyIndex (index))
+        return;
+
+    const auto memoryFootprint = board->getMemoryFootprint();
+    if (getStandbyMemoryUsage() + memoryFootprint > memoryBudget)
+    {
+        // don't build any more boards until some memory frees up
+        Logger::writeToLog ("Not enough memory budget for standby preset: " + presets[(size_t) index].getName());
+        isOverBudget = true;
+        return;
+    }
+
+    standbyBoards.push_back ({ index, std::move (board), memoryFootprint });
+}
+
+void PresetSetlist::refreshStandbyBoards()
+{
+    // drop the boards that aren't needed any more, or that were prepared for a different sample rate
+    const auto spec = chain.getProcessingSpec();
+    const auto osFactor = chain.getOversamplingFactor();
+    standbyBoards.erase (std::remove_if (standbyBoards.begin(),
+                                         standbyBoards.end(),
+                                         [this, &spec, osFactor] (const StandbyBoard& standby)
+                                         { return ! isStandbyIndex (standby.index) || ! standby.board->isPreparedFor (spec.first, spec.second, osFactor); }),
+                         standbyBoards.end());
+
+    if (boardBeingBuilt >= 0 || isOverBudget)
+        return;
+
+    for (int index = currentIndex + 1; isStandbyIndex (index); ++index)
+    {
+        if (! isStandbyBoardReady (index))
+        {
+            startBuildingBoard (index);
+            return;
+        }
+    }
+}
+
+void PresetSetlist::startBuildingBoard (int index)
+{
+    const auto* presetState = presets[(size_t) index].getState();
+    jassert (presetState != nullptr); // invalid presets should have been filtered out!
+
+    boardBeingBuilt = index;
+    buildGeneration = presetsGeneration;
+
+    // some processors need the message thread in their constructors, so the board gets
+    // created here, and only the preparing and warming up happens on the build thread
+    finishedBoard = chain.getStateHelper().createStandbyBoard (presetState, StateManager::getPluginVersionFromXML (presetState));
+    if (finishedBoard == nullptr)
+    {
+        buildFinished.store (true);
+        return;
+    }
+
+    const auto spec = chain.getProcessingSpec();
+    const auto osFactor = chain.getOversamplingFactor();
+    buildPool.addJob (
+        [this, spec, osFactor]
+        {
+            finishedBoard->prepare (spec.first, spec.second, osFactor);
+            finishedBoard->warmUp (warmUpTimeSeconds);
+            buildFinished.store (true);
+        });
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <pch.h>
+
+class PresetManager;
+class ProcessorChain;
+class ProcessorChainStandbyBoard;
+
+/**
+ * An ordered list of presets to switch between, e.g. for the songs in a gig.
+ *
+ * The setlist keeps the next few presets after the current one ready to go as
+ * standby boards, which are built, prepared, and warmed up on a background thread.
+ * Switching to a preset with a standby board swaps the whole board into the
+ * processor chain at once, and crossfades from the old board to the new one.
+ * Presets without a standby board are loaded the same way as any other preset.
+ *
+ * The number of standby boards is limited by how many presets to look ahead,
+ * and by a memory budget for all of the standby boards together.
+ */
+class PresetSetlist : private Timer
+{
+public:
+    PresetSetlist (PresetManager& presetManager, ProcessorChain& chain);
+    ~PresetSetlist() override;
+
+    void setPresets (std::vector<chowdsp::Preset>&& newPresets);
+    const auto& getPresets() const noexcept { return presets; }
+    int getCurrentIndex() const noexcept { return currentIndex; }
+
+    /** Switches to the preset at this position in the setlist. Returns false if the index is out of range. */
+    bool loadPresetAtIndex (int index);
+    bool loadNextPreset() { return loadPresetAtIndex (currentIndex + 1); }
+    bool loadPreviousPreset() { return loadPresetAtIndex (currentIndex - 1); }
+
+    void setNumStandbyPresets (int numPresets);
+    int getNumStandbyPresets() const noexcept { return numStandbyPresets; }
+
+    void setMemoryBudget (size_t numBytes);
+    size_t getMemoryBudget() const noexcept { return memoryBudget; }
+
+    void setCrossfadeTime (double seconds) noexcept { crossfadeTimeSeconds = seconds; }
+    double getCrossfadeTime() const noexcept { return crossfadeTimeSeconds; }
+
+    /** Returns true if the preset at this position has a standby board that is ready to be swapped in. */
+    bool isStandbyBoardReady (int index) const;
+
+    /** Returns the estimated memory used by all the standby boards. */
+    size_t getStandbyMemoryUsage() const;
+
+private:
+    void timerCallback() override;
+    void collectFinishedBoard();
+    void refreshStandbyBoards();
+    void startBuildingBoard (int index);
+    bool isStandbyIndex (int index) const noexcept;
+
+    PresetManager& presetManager;
+    ProcessorChain& chain;
+
+    std::vector<chowdsp::Preset> presets;
+    int currentIndex = -1;
+
+    int numStandbyPresets = 2;
+    size_t memoryBudget = (size_t) 256 * 1024 * 1024;
+    double crossfadeTimeSeconds = 0.5;
+
+    struct StandbyBoard
+    {
+        int index;
+        std::unique_ptr<ProcessorChainStandbyBoard> board;
+        size_t memoryFootprint;
+    };
+    std::vector<StandbyBoard> standbyBoards;
+    bool isOverBudget = false;
+
+    // standby boards are built one at a time
+    ThreadPool buildPool { 1 };
+    int boardBeingBuilt = -1;
+    uint32_t buildGeneration = 0;
+    uint32_t presetsGeneration = 0;
+    std::unique_ptr<ProcessorChainStandbyBoard> finishedBoard; // owned by the build thread until buildFinished is set
+    std::atomic_bool buildFinished { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetSetlist)
+};